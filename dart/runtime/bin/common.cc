@@ -3,6 +3,7 @@
 // BSD-style license that can be found in the LICENSE file.
 
 #include "bin/builtin.h"
+#include "bin/dartutils.h"
 #include "bin/isolate_data.h"
 #include "include/dart_api.h"
 
@@ -58,5 +59,24 @@ void FUNCTION_NAME(Common_IsBuiltinList)(Dart_NativeArguments args) {
   Dart_ExitScope();
 }
 
+
+void FUNCTION_NAME(Common_NewPinnableBuffer)(Dart_NativeArguments args) {
+  Dart_EnterScope();
+  Dart_Handle length_obj = Dart_GetNativeArgument(args, 0);
+  int64_t length = 0;
+  if (!DartUtils::GetInt64Value(length_obj, &length)) {
+    Dart_Handle error = DartUtils::NewDartArgumentError(
+        "Invalid argument, must be an int.");
+    if (Dart_IsError(error)) Dart_PropagateError(error);
+    Dart_ThrowException(error);
+  }
+  // Data in old space does not move and can be pinned by natives such as
+  // Filter_Process instead of being copied.
+  Dart_Handle result = Dart_NewTypedDataInOldSpace(kUint8, length);
+  if (Dart_IsError(result)) Dart_PropagateError(result);
+  Dart_SetReturnValue(args, result);
+  Dart_ExitScope();
+}
+
 }  // namespace bin
 }  // namespace dart
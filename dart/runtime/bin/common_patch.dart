@@ -5,6 +5,8 @@
 patch class _BufferUtils {
   /* patch */ static bool _isBuiltinList(List buffer)
       native "Common_IsBuiltinList";
+  /* patch */ static Uint8List _newPinnableBuffer(int length)
+      native "Common_NewPinnableBuffer";
 }
 
 patch class _IOCrypto {
@@ -610,6 +610,16 @@ Dart_Handle DartUtils::NewDartOSError(OSError* os_error) {
 }
 
 
+void DartUtils::SetOSErrorReturnValue(Dart_NativeArguments args,
+                                      OSError* os_error) {
+  Dart_EnterScope();
+  Dart_Handle err = NewDartOSError(os_error);
+  if (Dart_IsError(err)) Dart_PropagateError(err);
+  Dart_SetReturnValue(args, err);
+  Dart_ExitScope();
+}
+
+
 Dart_Handle DartUtils::NewDartSocketIOException(const char* message,
                                                 Dart_Handle os_error) {
   // Create a dart:io SocketIOException object.
@@ -136,6 +136,11 @@ class DartUtils {
   static Dart_Handle NewDartOSError();
   // Create a new Dart OSError object with the provided OS error.
   static Dart_Handle NewDartOSError(OSError* os_error);
+  // Set the provided OS error as the return value of a native that has not
+  // entered an API scope. The OS error must be captured by the caller before
+  // anything else can change the last OS error.
+  static void SetOSErrorReturnValue(Dart_NativeArguments args,
+                                    OSError* os_error);
   static Dart_Handle NewDartSocketIOException(const char* message,
                                               Dart_Handle os_error);
   static Dart_Handle NewDartExceptionWithMessage(const char* library_url,
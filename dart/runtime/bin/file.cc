@@ -32,6 +32,17 @@ static File* GetFilePointer(Dart_Handle handle) {
 }
 
 
+// The natives that only take and return primitive values do not enter an API
+// scope on their success path. They read the File pointer with this variant.
+static File* GetFilePointer(Dart_NativeArguments args, int index) {
+  int64_t value = 0;
+  Dart_Handle result = Dart_GetNativeIntegerArgument(args, index, &value);
+  ASSERT(!Dart_IsError(result));
+  return reinterpret_cast<File*>(static_cast<intptr_t>(value));
+}
+
+
+
 bool File::ReadFully(void* buffer, int64_t num_bytes) {
   int64_t remaining = num_bytes;
   char* current_buffer = reinterpret_cast<char*>(buffer);
@@ -113,56 +124,46 @@ void FUNCTION_NAME(File_Exists)(Dart_NativeArguments args) {
 
 
 void FUNCTION_NAME(File_Close)(Dart_NativeArguments args) {
-  Dart_EnterScope();
-  File* file = GetFilePointer(Dart_GetNativeArgument(args, 0));
+  File* file = GetFilePointer(args, 0);
   ASSERT(file != NULL);
   delete file;
-  Dart_SetReturnValue(args, Dart_NewInteger(0));
-  Dart_ExitScope();
+  Dart_SetIntegerReturnValue(args, 0);
 }
 
 
 void FUNCTION_NAME(File_ReadByte)(Dart_NativeArguments args) {
-  Dart_EnterScope();
-  File* file = GetFilePointer(Dart_GetNativeArgument(args, 0));
+  File* file = GetFilePointer(args, 0);
   ASSERT(file != NULL);
   uint8_t buffer;
   int64_t bytes_read = file->Read(reinterpret_cast<void*>(&buffer), 1);
   if (bytes_read == 1) {
-    Dart_SetReturnValue(args, Dart_NewInteger(buffer));
+    Dart_SetIntegerReturnValue(args, buffer);
   } else if (bytes_read == 0) {
-    Dart_SetReturnValue(args, Dart_NewInteger(-1));
+    Dart_SetIntegerReturnValue(args, -1);
   } else {
-    Dart_Handle err = DartUtils::NewDartOSError();
-    if (Dart_IsError(err)) Dart_PropagateError(err);
-    Dart_SetReturnValue(args, err);
+    OSError os_error;
+    DartUtils::SetOSErrorReturnValue(args, &os_error);
   }
-  Dart_ExitScope();
 }
 
 
 void FUNCTION_NAME(File_WriteByte)(Dart_NativeArguments args) {
-  Dart_EnterScope();
-  File* file = GetFilePointer(Dart_GetNativeArgument(args, 0));
+  File* file = GetFilePointer(args, 0);
   ASSERT(file != NULL);
   int64_t byte = 0;
-  if (DartUtils::GetInt64Value(Dart_GetNativeArgument(args, 1), &byte)) {
+  if (!Dart_IsError(Dart_GetNativeIntegerArgument(args, 1, &byte))) {
     uint8_t buffer = static_cast<uint8_t>(byte & 0xff);
     int64_t bytes_written = file->Write(reinterpret_cast<void*>(&buffer), 1);
     if (bytes_written >= 0) {
-      Dart_SetReturnValue(args, Dart_NewInteger(bytes_written));
+      Dart_SetIntegerReturnValue(args, bytes_written);
     } else {
-      Dart_Handle err = DartUtils::NewDartOSError();
-      if (Dart_IsError(err)) Dart_PropagateError(err);
-      Dart_SetReturnValue(args, err);
+      OSError os_error;
+      DartUtils::SetOSErrorReturnValue(args, &os_error);
     }
   } else {
     OSError os_error(-1, "Invalid argument", OSError::kUnknown);
-    Dart_Handle err = DartUtils::NewDartOSError(&os_error);
-    if (Dart_IsError(err)) Dart_PropagateError(err);
-    Dart_SetReturnValue(args, err);
+    DartUtils::SetOSErrorReturnValue(args, &os_error);
   }
-  Dart_ExitScope();
 }
 
 
@@ -287,80 +288,64 @@ void FUNCTION_NAME(File_WriteFrom)(Dart_NativeArguments args) {
 
 
 void FUNCTION_NAME(File_Position)(Dart_NativeArguments args) {
-  Dart_EnterScope();
-  File* file = GetFilePointer(Dart_GetNativeArgument(args, 0));
+  File* file = GetFilePointer(args, 0);
   ASSERT(file != NULL);
   intptr_t return_value = file->Position();
   if (return_value >= 0) {
-    Dart_SetReturnValue(args, Dart_NewInteger(return_value));
+    Dart_SetIntegerReturnValue(args, return_value);
   } else {
-    Dart_Handle err = DartUtils::NewDartOSError();
-    if (Dart_IsError(err)) Dart_PropagateError(err);
-    Dart_SetReturnValue(args, err);
+    OSError os_error;
+    DartUtils::SetOSErrorReturnValue(args, &os_error);
   }
-  Dart_ExitScope();
 }
 
 
 void FUNCTION_NAME(File_SetPosition)(Dart_NativeArguments args) {
-  Dart_EnterScope();
-  File* file = GetFilePointer(Dart_GetNativeArgument(args, 0));
+  File* file = GetFilePointer(args, 0);
   ASSERT(file != NULL);
   int64_t position = 0;
-  if (DartUtils::GetInt64Value(Dart_GetNativeArgument(args, 1), &position)) {
+  if (!Dart_IsError(Dart_GetNativeIntegerArgument(args, 1, &position))) {
     if (file->SetPosition(position)) {
-      Dart_SetReturnValue(args, Dart_True());
+      Dart_SetBooleanReturnValue(args, true);
     } else {
-      Dart_Handle err = DartUtils::NewDartOSError();
-      if (Dart_IsError(err)) Dart_PropagateError(err);
-      Dart_SetReturnValue(args, err);
+      OSError os_error;
+      DartUtils::SetOSErrorReturnValue(args, &os_error);
     }
   } else {
     OSError os_error(-1, "Invalid argument", OSError::kUnknown);
-    Dart_Handle err = DartUtils::NewDartOSError(&os_error);
-    if (Dart_IsError(err)) Dart_PropagateError(err);
-    Dart_SetReturnValue(args, err);
+    DartUtils::SetOSErrorReturnValue(args, &os_error);
   }
-  Dart_ExitScope();
 }
 
 
 void FUNCTION_NAME(File_Truncate)(Dart_NativeArguments args) {
-  Dart_EnterScope();
-  File* file = GetFilePointer(Dart_GetNativeArgument(args, 0));
+  File* file = GetFilePointer(args, 0);
   ASSERT(file != NULL);
   int64_t length = 0;
-  if (DartUtils::GetInt64Value(Dart_GetNativeArgument(args, 1), &length)) {
+  if (!Dart_IsError(Dart_GetNativeIntegerArgument(args, 1, &length))) {
     if (file->Truncate(length)) {
-      Dart_SetReturnValue(args, Dart_True());
+      Dart_SetBooleanReturnValue(args, true);
     } else {
-      Dart_Handle err = DartUtils::NewDartOSError();
-      if (Dart_IsError(err)) Dart_PropagateError(err);
-      Dart_SetReturnValue(args, err);
+      OSError os_error;
+      DartUtils::SetOSErrorReturnValue(args, &os_error);
     }
   } else {
     OSError os_error(-1, "Invalid argument", OSError::kUnknown);
-    Dart_Handle err = DartUtils::NewDartOSError(&os_error);
-    if (Dart_IsError(err)) Dart_PropagateError(err);
-    Dart_SetReturnValue(args, err);
+    DartUtils::SetOSErrorReturnValue(args, &os_error);
   }
-  Dart_ExitScope();
 }
 
 
 void FUNCTION_NAME(File_Length)(Dart_NativeArguments args) {
-  Dart_EnterScope();
-  File* file = GetFilePointer(Dart_GetNativeArgument(args, 0));
+  File* file = GetFilePointer(args, 0);
   ASSERT(file != NULL);
   intptr_t return_value = file->Length();
   if (return_value >= 0) {
-    Dart_SetReturnValue(args, Dart_NewInteger(return_value));
+    Dart_SetIntegerReturnValue(args, return_value);
   } else {
-    Dart_Handle err = DartUtils::NewDartOSError();
-    if (Dart_IsError(err)) Dart_PropagateError(err);
-    Dart_SetReturnValue(args, err);
+    OSError os_error;
+    DartUtils::SetOSErrorReturnValue(args, &os_error);
   }
-  Dart_ExitScope();
 }
 
 
@@ -397,17 +382,14 @@ void FUNCTION_NAME(File_LastModified)(Dart_NativeArguments args) {
 
 
 void FUNCTION_NAME(File_Flush)(Dart_NativeArguments args) {
-  Dart_EnterScope();
-  File* file = GetFilePointer(Dart_GetNativeArgument(args, 0));
+  File* file = GetFilePointer(args, 0);
   ASSERT(file != NULL);
   if (file->Flush()) {
-    Dart_SetReturnValue(args, Dart_True());
+    Dart_SetBooleanReturnValue(args, true);
   } else {
-    Dart_Handle err = DartUtils::NewDartOSError();
-    if (Dart_IsError(err)) Dart_PropagateError(err);
-    Dart_SetReturnValue(args, err);
+    OSError os_error;
+    DartUtils::SetOSErrorReturnValue(args, &os_error);
   }
-  Dart_ExitScope();
 }
 
 
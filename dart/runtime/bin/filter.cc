@@ -90,33 +90,45 @@ void FUNCTION_NAME(Filter_Process)(Dart_NativeArguments args) {
   intptr_t length;
   Dart_TypedData_Type type;
   uint8_t* buffer = NULL;
-  Dart_Handle result = Dart_TypedDataAcquireData(
-      data_obj, &type, reinterpret_cast<void**>(&buffer), &length);
-  if (!Dart_IsError(result)) {
-    uint8_t* zlib_buffer = new uint8_t[length];
-    if (zlib_buffer == NULL) {
+  // Typed data that does not move is handed to zlib directly and stays
+  // pinned until it has been processed. Anything else is copied.
+  Dart_Handle pinned = NULL;
+  Dart_Handle result = Dart_TypedDataPin(
+      data_obj, &type, reinterpret_cast<void**>(&buffer), &length, &pinned);
+  if (Dart_IsError(result)) {
+    pinned = NULL;
+    result = Dart_TypedDataAcquireData(
+        data_obj, &type, reinterpret_cast<void**>(&buffer), &length);
+    if (!Dart_IsError(result)) {
+      uint8_t* zlib_buffer = new uint8_t[length];
+      if (zlib_buffer == NULL) {
+        Dart_TypedDataReleaseData(data_obj);
+        Dart_ThrowException(DartUtils::NewInternalError(
+            "Failed to allocate buffer for zlib"));
+      }
+      memmove(zlib_buffer, buffer, length);
       Dart_TypedDataReleaseData(data_obj);
-      Dart_ThrowException(DartUtils::NewInternalError(
-          "Failed to allocate buffer for zlib"));
-    }
-    memmove(zlib_buffer, buffer, length);
-    Dart_TypedDataReleaseData(data_obj);
-    buffer = zlib_buffer;
-  } else {
-    if (Dart_IsError(Dart_ListLength(data_obj, &length))) {
-      Dart_ThrowException(DartUtils::NewInternalError(
-          "Failed to get list length"));
-    }
-    buffer = new uint8_t[length];
-    if (Dart_IsError(Dart_ListGetAsBytes(data_obj, 0, buffer, length))) {
-      delete[] buffer;
-      Dart_ThrowException(DartUtils::NewInternalError(
-          "Failed to get list bytes"));
+      buffer = zlib_buffer;
+    } else {
+      if (Dart_IsError(Dart_ListLength(data_obj, &length))) {
+        Dart_ThrowException(DartUtils::NewInternalError(
+            "Failed to get list length"));
+      }
+      buffer = new uint8_t[length];
+      if (Dart_IsError(Dart_ListGetAsBytes(data_obj, 0, buffer, length))) {
+        delete[] buffer;
+        Dart_ThrowException(DartUtils::NewInternalError(
+            "Failed to get list bytes"));
+      }
     }
   }
   // Process will take ownership of buffer, if successful.
-  if (!filter->Process(buffer, length)) {
-    delete[] buffer;
+  if (!filter->Process(buffer, length, pinned)) {
+    if (pinned != NULL) {
+      Dart_TypedDataUnpin(pinned);
+    } else {
+      delete[] buffer;
+    }
     EndFilter(filter_obj, filter);
     Dart_ThrowException(DartUtils::NewInternalError(
         "Call to Process while still processing data"));
@@ -182,8 +194,19 @@ Dart_Handle Filter::GetFilterPointerNativeField(Dart_Handle filter,
 }
 
 
+void Filter::ReleaseInput() {
+  if (pinned_input_ != NULL) {
+    Dart_Handle result = Dart_TypedDataUnpin(pinned_input_);
+    ASSERT(!Dart_IsError(result));
+  } else {
+    delete[] input_;
+  }
+  input_ = NULL;
+  pinned_input_ = NULL;
+}
+
+
 ZLibDeflateFilter::~ZLibDeflateFilter() {
-  delete[] current_buffer_;
   if (initialized()) deflateEnd(&stream_);
 }
 
@@ -207,10 +230,13 @@ bool ZLibDeflateFilter::Init() {
 }
 
 
-bool ZLibDeflateFilter::Process(uint8_t* data, intptr_t length) {
-  if (current_buffer_ != NULL) return false;
+bool ZLibDeflateFilter::Process(uint8_t* data,
+                                intptr_t length,
+                                Dart_Handle pinned) {
+  if (has_input()) return false;
+  TakeInput(data, pinned);
   stream_.avail_in = length;
-  stream_.next_in = current_buffer_ = data;
+  stream_.next_in = data;
   return true;
 }
 
@@ -223,8 +249,7 @@ intptr_t ZLibDeflateFilter::Processed(uint8_t* buffer,
     case Z_OK: {
       intptr_t processed = length - stream_.avail_out;
       if (processed == 0) {
-        delete[] current_buffer_;
-        current_buffer_ = NULL;
+        ReleaseInput();
         return 0;
       } else {
         // We processed data, should be called again.
@@ -235,22 +260,19 @@ intptr_t ZLibDeflateFilter::Processed(uint8_t* buffer,
     case Z_STREAM_END:
     case Z_BUF_ERROR:
       // We processed all available input data.
-      delete[] current_buffer_;
-      current_buffer_ = NULL;
+      ReleaseInput();
       return 0;
 
     default:
     case Z_STREAM_ERROR:
       // An error occoured.
-      delete[] current_buffer_;
-      current_buffer_ = NULL;
+      ReleaseInput();
       return -1;
   }
 }
 
 
 ZLibInflateFilter::~ZLibInflateFilter() {
-  delete[] current_buffer_;
   if (initialized()) inflateEnd(&stream_);
 }
 
@@ -269,10 +291,13 @@ bool ZLibInflateFilter::Init() {
 }
 
 
-bool ZLibInflateFilter::Process(uint8_t* data, intptr_t length) {
-  if (current_buffer_ != NULL) return false;
+bool ZLibInflateFilter::Process(uint8_t* data,
+                                intptr_t length,
+                                Dart_Handle pinned) {
+  if (has_input()) return false;
+  TakeInput(data, pinned);
   stream_.avail_in = length;
-  stream_.next_in = current_buffer_ = data;
+  stream_.next_in = data;
   return true;
 }
 
@@ -288,8 +313,7 @@ intptr_t ZLibInflateFilter::Processed(uint8_t* buffer,
     case Z_OK: {
       intptr_t processed = length - stream_.avail_out;
       if (processed == 0) {
-        delete[] current_buffer_;
-        current_buffer_ = NULL;
+        ReleaseInput();
         return 0;
       } else {
         // We processed data, should be called again.
@@ -303,8 +327,7 @@ intptr_t ZLibInflateFilter::Processed(uint8_t* buffer,
     case Z_DATA_ERROR:
     case Z_STREAM_ERROR:
       // An error occoured.
-      delete[] current_buffer_;
-      current_buffer_ = NULL;
+      ReleaseInput();
       return -1;
   }
 }
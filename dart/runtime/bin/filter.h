@@ -16,16 +16,17 @@ namespace bin {
 
 class Filter {
  public:
-  virtual ~Filter() {}
+  virtual ~Filter() { ReleaseInput(); }
 
   virtual bool Init() = 0;
 
   /**
    * On a succesfull call to Process, Process will take ownership of data. On
-   * successive calls to either Processed or ~Filter, data will be freed with
-   * a delete[] call.
+   * successive calls to either Processed or ~Filter, data will be released.
+   * If pinned is NULL data is freed with a delete[] call, otherwise data
+   * points into the typed data pinned by pinned, which is unpinned.
    */
-  virtual bool Process(uint8_t* data, intptr_t length) = 0;
+  virtual bool Process(uint8_t* data, intptr_t length, Dart_Handle pinned) = 0;
   virtual intptr_t Processed(uint8_t* buffer, intptr_t length, bool finish) = 0;
 
   static Dart_Handle SetFilterPointerNativeField(Dart_Handle filter,
@@ -39,12 +40,24 @@ class Filter {
   intptr_t processed_buffer_size() const { return kFilterBufferSize; }
 
  protected:
-  Filter() : initialized_(false) {}
+  Filter() : initialized_(false), input_(NULL), pinned_input_(NULL) {}
+
+  bool has_input() const {
+    return (input_ != NULL) || (pinned_input_ != NULL);
+  }
+  void TakeInput(uint8_t* data, Dart_Handle pinned) {
+    ASSERT(!has_input());
+    input_ = data;
+    pinned_input_ = pinned;
+  }
+  void ReleaseInput();
 
  private:
   static const intptr_t kFilterBufferSize = 64 * KB;
   uint8_t processed_buffer_[kFilterBufferSize];
   bool initialized_;
+  uint8_t* input_;
+  Dart_Handle pinned_input_;
 
   DISALLOW_COPY_AND_ASSIGN(Filter);
 };
@@ -52,17 +65,16 @@ class Filter {
 class ZLibDeflateFilter : public Filter {
  public:
   ZLibDeflateFilter(bool gzip = false, int level = 6)
-    : gzip_(gzip), level_(level), current_buffer_(NULL) {}
+    : gzip_(gzip), level_(level) {}
   virtual ~ZLibDeflateFilter();
 
   virtual bool Init();
-  virtual bool Process(uint8_t* data, intptr_t length);
+  virtual bool Process(uint8_t* data, intptr_t length, Dart_Handle pinned);
   virtual intptr_t Processed(uint8_t* buffer, intptr_t length, bool finish);
 
  private:
   const bool gzip_;
   const int level_;
-  uint8_t* current_buffer_;
   z_stream stream_;
 
   DISALLOW_COPY_AND_ASSIGN(ZLibDeflateFilter);
@@ -70,15 +82,14 @@ class ZLibDeflateFilter : public Filter {
 
 class ZLibInflateFilter : public Filter {
  public:
-  ZLibInflateFilter() : current_buffer_(NULL) {}
+  ZLibInflateFilter() {}
   virtual ~ZLibInflateFilter();
 
   virtual bool Init();
-  virtual bool Process(uint8_t* data, intptr_t length);
+  virtual bool Process(uint8_t* data, intptr_t length, Dart_Handle pinned);
   virtual intptr_t Processed(uint8_t* buffer, intptr_t length, bool finish);
 
  private:
-  uint8_t* current_buffer_;
   z_stream stream_;
 
   DISALLOW_COPY_AND_ASSIGN(ZLibInflateFilter);
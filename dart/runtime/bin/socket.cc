@@ -113,18 +113,17 @@ void FUNCTION_NAME(Socket_CreateConnect)(Dart_NativeArguments args) {
 
 
 void FUNCTION_NAME(Socket_Available)(Dart_NativeArguments args) {
-  Dart_EnterScope();
-  Dart_Handle socket_obj = Dart_GetNativeArgument(args, 0);
   intptr_t socket = 0;
-  Dart_Handle err = Socket::GetSocketIdNativeField(socket_obj, &socket);
+  Dart_Handle err =
+      Dart_GetNativeFieldOfArgument(args, 0, kSocketIdNativeField, &socket);
   if (Dart_IsError(err)) Dart_PropagateError(err);
   intptr_t available = Socket::Available(socket);
   if (available >= 0) {
-    Dart_SetReturnValue(args, Dart_NewInteger(available));
+    Dart_SetIntegerReturnValue(args, available);
   } else {
-    Dart_SetReturnValue(args, DartUtils::NewDartOSError());
+    OSError os_error;
+    DartUtils::SetOSErrorReturnValue(args, &os_error);
   }
-  Dart_ExitScope();
 }
 
 
@@ -187,29 +186,43 @@ void FUNCTION_NAME(Socket_ReadList)(Dart_NativeArguments args) {
   int64_t length = 0;
   Dart_Handle offset_obj = Dart_GetNativeArgument(args, 2);
   Dart_Handle length_obj = Dart_GetNativeArgument(args, 3);
+  intptr_t buffer_len = 0;
   if (Dart_IsList(buffer_obj) &&
       DartUtils::GetInt64Value(offset_obj, &offset) &&
-      DartUtils::GetInt64Value(length_obj, &length)) {
-    intptr_t buffer_len = 0;
-    Dart_Handle result = Dart_ListLength(buffer_obj, &buffer_len);
-    if (Dart_IsError(result)) {
-      Dart_PropagateError(result);
-    }
-    ASSERT((offset + length) <= buffer_len);
+      DartUtils::GetInt64Value(length_obj, &length) &&
+      !Dart_IsError(Dart_ListLength(buffer_obj, &buffer_len)) &&
+      (offset >= 0) && (length >= 0) && (offset <= buffer_len) &&
+      (length <= (buffer_len - offset))) {
     if (short_socket_reads) {
       length = (length + 1) / 2;
     }
-    uint8_t* buffer = new uint8_t[length];
-    intptr_t bytes_read = Socket::Read(socket, buffer, length);
-    if (bytes_read > 0) {
-      Dart_Handle result =
-          Dart_ListSetAsBytes(buffer_obj, offset, buffer, bytes_read);
-      if (Dart_IsError(result)) {
-        delete[] buffer;
-        Dart_PropagateError(result);
+    intptr_t bytes_read = 0;
+    Dart_TypedData_Type type;
+    uint8_t* data = NULL;
+    intptr_t data_length = 0;
+    Dart_Handle result = Dart_TypedDataAcquireData(
+        buffer_obj, &type, reinterpret_cast<void**>(&data), &data_length);
+    if (!Dart_IsError(result) &&
+        ((type == kUint8) || (type == kInt8) || (type == kUint8Clamped)) &&
+        ((offset + length) <= data_length)) {
+      // Read directly into a byte list.
+      bytes_read = Socket::Read(socket, data + offset, length);
+      Dart_TypedDataReleaseData(buffer_obj);
+    } else {
+      if (!Dart_IsError(result)) {
+        Dart_TypedDataReleaseData(buffer_obj);
       }
+      uint8_t* buffer = new uint8_t[length];
+      bytes_read = Socket::Read(socket, buffer, length);
+      if (bytes_read > 0) {
+        result = Dart_ListSetAsBytes(buffer_obj, offset, buffer, bytes_read);
+        if (Dart_IsError(result)) {
+          delete[] buffer;
+          Dart_PropagateError(result);
+        }
+      }
+      delete[] buffer;
     }
-    delete[] buffer;
     if (bytes_read >= 0) {
       Dart_SetReturnValue(args, Dart_NewInteger(bytes_read));
     } else {
@@ -294,19 +307,17 @@ void FUNCTION_NAME(Socket_WriteList)(Dart_NativeArguments args) {
 
 
 void FUNCTION_NAME(Socket_GetPort)(Dart_NativeArguments args) {
-  Dart_EnterScope();
-  Dart_Handle socket_obj = Dart_GetNativeArgument(args, 0);
   intptr_t socket = 0;
-  Dart_Handle err = Socket::GetSocketIdNativeField(socket_obj, &socket);
+  Dart_Handle err =
+      Dart_GetNativeFieldOfArgument(args, 0, kSocketIdNativeField, &socket);
   if (Dart_IsError(err)) Dart_PropagateError(err);
-  OSError os_error;
   intptr_t port = Socket::GetPort(socket);
   if (port > 0) {
-    Dart_SetReturnValue(args, Dart_NewInteger(port));
+    Dart_SetIntegerReturnValue(args, port);
   } else {
-    Dart_SetReturnValue(args, DartUtils::NewDartOSError());
+    OSError os_error;
+    DartUtils::SetOSErrorReturnValue(args, &os_error);
   }
-  Dart_ExitScope();
 }
 
 
@@ -346,18 +357,15 @@ void FUNCTION_NAME(Socket_GetError)(Dart_NativeArguments args) {
 
 
 void FUNCTION_NAME(Socket_GetType)(Dart_NativeArguments args) {
-  Dart_EnterScope();
-  Dart_Handle socket_obj = Dart_GetNativeArgument(args, 0);
   intptr_t socket = 0;
-  Socket::GetSocketIdNativeField(socket_obj, &socket);
-  OSError os_error;
+  Dart_GetNativeFieldOfArgument(args, 0, kSocketIdNativeField, &socket);
   intptr_t type = Socket::GetType(socket);
   if (type >= 0) {
-    Dart_SetReturnValue(args, Dart_NewInteger(type));
+    Dart_SetIntegerReturnValue(args, type);
   } else {
-    Dart_SetReturnValue(args, DartUtils::NewDartOSError());
+    OSError os_error;
+    DartUtils::SetOSErrorReturnValue(args, &os_error);
   }
-  Dart_ExitScope();
 }
 
 
@@ -547,20 +555,21 @@ void FUNCTION_NAME(Socket_NewServicePort)(Dart_NativeArguments args) {
 
 
 void FUNCTION_NAME(Socket_SetOption)(Dart_NativeArguments args) {
-  Dart_EnterScope();
-  Dart_Handle socket_obj = Dart_GetNativeArgument(args, 0);
-  intptr_t socket = 0;
-  bool result = false;
-  Dart_Handle err = Socket::GetSocketIdNativeField(socket_obj, &socket);
-  if (Dart_IsError(err)) Dart_PropagateError(err);
-  Dart_Handle option_obj = Dart_GetNativeArgument(args, 1);
-  int64_t option;
-  err = Dart_IntegerToInt64(option_obj, &option);
-  if (Dart_IsError(err)) Dart_PropagateError(err);
-  Dart_Handle enabled_obj = Dart_GetNativeArgument(args, 2);
-  bool enabled;
-  err = Dart_BooleanValue(enabled_obj, &enabled);
+  static const Dart_NativeArgument_Descriptor kDescriptors[] = {
+    { Dart_NativeArgument_kNativeFields, 0 },
+    { Dart_NativeArgument_kInt64, 1 },
+    { Dart_NativeArgument_kBool, 2 },
+  };
+  intptr_t fields[kSocketIdNativeField + 1];
+  Dart_NativeArgument_Value values[3];
+  values[0].as_native_fields.num_fields = kSocketIdNativeField + 1;
+  values[0].as_native_fields.values = fields;
+  Dart_Handle err = Dart_GetNativeArguments(args, 3, kDescriptors, values);
   if (Dart_IsError(err)) Dart_PropagateError(err);
+  intptr_t socket = fields[kSocketIdNativeField];
+  int64_t option = values[1].as_int64;
+  bool enabled = values[2].as_bool;
+  bool result = false;
   switch (option) {
     case 0:  // TCP_NODELAY.
       result = Socket::SetNoDelay(socket, enabled);
@@ -568,8 +577,7 @@ void FUNCTION_NAME(Socket_SetOption)(Dart_NativeArguments args) {
     default:
       break;
   }
-  Dart_SetReturnValue(args, Dart_NewBoolean(result));
-  Dart_ExitScope();
+  Dart_SetBooleanReturnValue(args, result);
 }
 
 
@@ -1753,6 +1753,22 @@ DART_EXPORT Dart_TypedData_Type Dart_GetTypeOfExternalTypedData(
 DART_EXPORT Dart_Handle Dart_NewTypedData(Dart_TypedData_Type type,
                                           intptr_t length);
 
+/**
+ * Returns a TypedData object of the desired length and type whose data is
+ * allocated in old space. Such data is not moved by the garbage collector
+ * and can be pinned with Dart_TypedDataPin, e.g. to hand it to native code
+ * without copying. Allocation in old space is more expensive, so this
+ * should only be used for buffers that are meant to be pinned.
+ *
+ * \param type The type of the TypedData object. kByteData is not supported.
+ * \param length The length of the TypedData object (length in type units).
+ *
+ * \return The TypedData object if no error occurs. Otherwise returns
+ *   an error handle.
+ */
+DART_EXPORT Dart_Handle Dart_NewTypedDataInOldSpace(Dart_TypedData_Type type,
+                                                    intptr_t length);
+
 /**
  * Returns a TypedData object which references an external data array.
  *
@@ -1812,6 +1828,45 @@ DART_EXPORT Dart_Handle Dart_TypedDataAcquireData(Dart_Handle object,
  */
 DART_EXPORT Dart_Handle Dart_TypedDataReleaseData(Dart_Handle array);
 
+/**
+ * Pins the data of a TypedData object so that its address stays valid
+ * until Dart_TypedDataUnpin is called, including across native calls and
+ * messages. Unlike Dart_TypedDataAcquireData this does not block garbage
+ * collection or other Dart API calls.
+ *
+ * Only data that the garbage collector does not move can be pinned: that
+ * of external TypedData objects and of TypedData objects which have been
+ * allocated in or promoted to old space, and of views on either. Use
+ * Dart_NewTypedDataInOldSpace to allocate data that can be pinned.
+ *
+ * \param object The typed data object whose data is to be pinned.
+ * \param type The type of the object is returned here.
+ * \param data The address of the data is returned here.
+ * \param len Size of the typed array is returned here.
+ * \param pinned A persistent handle keeping the object alive is returned
+ *   here. It must be released with Dart_TypedDataUnpin.
+ *
+ * \return Success if the data is pinned. Otherwise returns an error handle,
+ *   in which case the caller has to copy the data instead.
+ */
+DART_EXPORT Dart_Handle Dart_TypedDataPin(Dart_Handle object,
+                                          Dart_TypedData_Type* type,
+                                          void** data,
+                                          intptr_t* len,
+                                          Dart_Handle* pinned);
+
+/**
+ * Releases data pinned with Dart_TypedDataPin.
+ *
+ * \param pinned The persistent handle returned by Dart_TypedDataPin. It is
+ *   deleted by this call.
+ *
+ * \return Success if the data is unpinned. Otherwise returns an error
+ *   handle, e.g. if 'pinned' was not returned by Dart_TypedDataPin or has
+ *   already been unpinned.
+ */
+DART_EXPORT Dart_Handle Dart_TypedDataUnpin(Dart_Handle pinned);
+
 
 // --- Closures ---
 
@@ -2236,6 +2291,72 @@ DART_EXPORT Dart_Handle Dart_Invoke(Dart_Handle target,
                                     Dart_Handle* arguments);
 // TODO(turnidge): Document how to invoke operators.
 
+/**
+ * A prepared invocation of a method or function.
+ *
+ * A prepared invocation binds the function to call and the shape of its
+ * arguments once, so that repeated calls from the embedder skip the lookup
+ * done by Dart_Invoke.
+ */
+typedef struct _Dart_PreparedInvocation* Dart_PreparedInvocation;
+
+/**
+ * Prepares the invocation of a method or function.
+ *
+ * The 'target' parameter is interpreted as in Dart_Invoke. If 'target'
+ * is a class or a library, the static method or top-level function is
+ * looked up once. If 'target' is an object, the instance method is
+ * looked up for the class of the object, and only looked up again when
+ * the invocation is later called with a receiver of another class.
+ *
+ * This function ignores visibility (leading underscores in names).
+ *
+ * \param target An object, class, or library.
+ * \param name The name of the function or method to invoke.
+ * \param number_of_arguments The number of arguments passed on each
+ *   invocation, including the named arguments.
+ * \param argument_names A list of the names of the trailing named
+ *   arguments, or Dart_Null() if all arguments are positional.
+ * \param invocation Returns the prepared invocation. It remains valid
+ *   until deleted with Dart_DeletePreparedInvocation.
+ *
+ * \return A valid handle if no error occurs.
+ */
+DART_EXPORT Dart_Handle Dart_PrepareInvocation(
+    Dart_Handle target,
+    Dart_Handle name,
+    int number_of_arguments,
+    Dart_Handle argument_names,
+    Dart_PreparedInvocation* invocation);
+
+/**
+ * Invokes a prepared method or function.
+ *
+ * May generate an unhandled exception error.
+ *
+ * \param invocation An invocation prepared with Dart_PrepareInvocation.
+ * \param receiver The receiver of a prepared instance method invocation.
+ *   Ignored if the invocation was prepared for a class or library.
+ * \param number_of_arguments Size of the arguments array. Must match the
+ *   number of arguments the invocation was prepared with.
+ * \param arguments An array of arguments to the function, the named
+ *   arguments last and in the order of their names.
+ *
+ * \return If the function or method is called and completes
+ *   successfully, then the return value is returned. If an error
+ *   occurs during execution, then an error handle is returned.
+ */
+DART_EXPORT Dart_Handle Dart_InvokePrepared(Dart_PreparedInvocation invocation,
+                                            Dart_Handle receiver,
+                                            int number_of_arguments,
+                                            Dart_Handle* arguments);
+
+/**
+ * Deletes a prepared invocation.
+ */
+DART_EXPORT void Dart_DeletePreparedInvocation(
+    Dart_PreparedInvocation invocation);
+
 /**
  * Gets the value of a field.
  *
@@ -2378,6 +2499,110 @@ DART_EXPORT int Dart_GetNativeArgumentCount(Dart_NativeArguments args);
 DART_EXPORT void Dart_SetReturnValue(Dart_NativeArguments args,
                                      Dart_Handle retval);
 
+/*
+ * The functions below read primitive arguments and set primitive return
+ * values without creating any handles in the current scope. A native
+ * function that only deals in such values does not need to enter a scope
+ * (see Dart_EnterScope) at all, which removes most of the per call
+ * overhead of short natives.
+ *
+ * On an out of range index or a type mismatch the accessors return an
+ * error handle that is allocated once per isolate, so no scope is needed
+ * to receive it or to pass it to Dart_PropagateError. The error does not
+ * say which argument was wrong.
+ */
+
+typedef enum {
+  Dart_NativeArgument_kBool = 0,
+  Dart_NativeArgument_kInt32,
+  Dart_NativeArgument_kInt64,
+  Dart_NativeArgument_kDouble,
+  Dart_NativeArgument_kNativeFields
+} Dart_NativeArgument_Type;
+
+typedef struct _Dart_NativeArgument_Descriptor {
+  uint8_t type;  /* A Dart_NativeArgument_Type. */
+  uint8_t index;  /* Index of the native argument. */
+} Dart_NativeArgument_Descriptor;
+
+typedef union _Dart_NativeArgument_Value {
+  bool as_bool;
+  int32_t as_int32;
+  int64_t as_int64;
+  double as_double;
+  struct {
+    int num_fields;  /* Set by the caller. */
+    intptr_t* values;  /* Buffer of num_fields entries set by the caller. */
+  } as_native_fields;
+} Dart_NativeArgument_Value;
+
+/**
+ * Gets several primitive native arguments in one call.
+ *
+ * \param args The native arguments.
+ * \param num_arguments Number of entries in descriptors and values.
+ * \param descriptors The index and expected type of each argument.
+ * \param values Receives the value of each argument. For arguments of
+ *   type Dart_NativeArgument_kNativeFields the caller sets num_fields and
+ *   values, and the first num_fields native fields of the argument are
+ *   copied into values.
+ *
+ * \return Success if every argument had the expected type, an error
+ *   handle otherwise.
+ */
+DART_EXPORT Dart_Handle Dart_GetNativeArguments(
+    Dart_NativeArguments args,
+    int num_arguments,
+    const Dart_NativeArgument_Descriptor* descriptors,
+    Dart_NativeArgument_Value* values);
+
+/**
+ * Gets the value of an integer native argument that fits in 64 bits.
+ */
+DART_EXPORT Dart_Handle Dart_GetNativeIntegerArgument(Dart_NativeArguments args,
+                                                      int index,
+                                                      int64_t* value);
+
+/**
+ * Gets the value of a boolean native argument.
+ */
+DART_EXPORT Dart_Handle Dart_GetNativeBooleanArgument(Dart_NativeArguments args,
+                                                      int index,
+                                                      bool* value);
+
+/**
+ * Gets the value of a double native argument.
+ */
+DART_EXPORT Dart_Handle Dart_GetNativeDoubleArgument(Dart_NativeArguments args,
+                                                     int index,
+                                                     double* value);
+
+/**
+ * Gets a native field of a native argument.
+ */
+DART_EXPORT Dart_Handle Dart_GetNativeFieldOfArgument(Dart_NativeArguments args,
+                                                      int arg_index,
+                                                      int fld_index,
+                                                      intptr_t* value);
+
+/**
+ * Sets a boolean return value for a native function.
+ */
+DART_EXPORT void Dart_SetBooleanReturnValue(Dart_NativeArguments args,
+                                            bool retval);
+
+/**
+ * Sets an integer return value for a native function.
+ */
+DART_EXPORT void Dart_SetIntegerReturnValue(Dart_NativeArguments args,
+                                            int64_t retval);
+
+/**
+ * Sets a double return value for a native function.
+ */
+DART_EXPORT void Dart_SetDoubleReturnValue(Dart_NativeArguments args,
+                                           double retval);
+
 /**
  * A native function.
  */
@@ -3,9 +3,9 @@
 // BSD-style license that can be found in the LICENSE file.
 
 patch class HashMap<K, V> {
-  final _HashMapTable<K, V> _hashTable = new _HashMapTable<K, V>();
+  final _CompactHashTable<K, V> _hashTable;
 
-  /* patch */ HashMap() {
+  /* patch */ HashMap() : _hashTable = new _CompactHashTable<K, V>() {
     _hashTable._container = this;
   }
 
@@ -14,97 +14,80 @@ patch class HashMap<K, V> {
   }
 
   /* patch */ bool containsValue(V value) {
-    List table = _hashTable._table;
-    int entrySize = _hashTable._entrySize;
-    for (int offset = 0; offset < table.length; offset += entrySize) {
-      if (!_hashTable._isFree(table[offset]) &&
-          _hashTable._value(offset) == value) {
+    int modificationCount = _hashTable._modificationCount;
+    List data = _hashTable._data;
+    for (int offset = 0; offset < _hashTable._usedData; offset += 2) {
+      if (!identical(data[offset], _TOMBSTONE) && (data[offset + 1] == value)) {
         return true;
       }
+      // The == call may modify the table.
+      _hashTable._checkModification(modificationCount);
     }
     return false;
   }
 
   /* patch */ void addAll(Map<K, V> other) {
     other.forEach((K key, V value) {
-      int offset = _hashTable._put(key);
-      _hashTable._setValue(offset, value);
-      _hashTable._checkCapacity();
+      int pair = _hashTable._put(key);
+      _hashTable._setValue(pair, value);
     });
   }
 
   /* patch */ V operator [](K key) {
-    int offset = _hashTable._get(key);
-    if (offset >= 0) return _hashTable._value(offset);
+    int pair = _hashTable._get(key);
+    if (pair >= 0) return _hashTable._value(pair);
     return null;
   }
 
   /* patch */ void operator []=(K key, V value) {
-    int offset = _hashTable._put(key);
-    _hashTable._setValue(offset, value);
-    _hashTable._checkCapacity();
+    int pair = _hashTable._put(key);
+    _hashTable._setValue(pair, value);
   }
 
   /* patch */ V putIfAbsent(K key, V ifAbsent()) {
-    int offset = _hashTable._probeForAdd(_hashTable._hashCodeOf(key), key);
-    Object entry = _hashTable._table[offset];
-    if (!_hashTable._isFree(entry)) {
-      return _hashTable._value(offset);
+    int hash = _hashTable._hashCodeOf(key);
+    int pair = _hashTable._findPair(key, hash);
+    if (pair >= 0) {
+      return _hashTable._value(pair);
     }
     int modificationCount = _hashTable._modificationCount;
     V value = ifAbsent();
     if (modificationCount == _hashTable._modificationCount) {
-      _hashTable._setKey(offset, key);
-      _hashTable._setValue(offset, value);
-      if (entry == null) {
-        _hashTable._entryCount++;
-        _hashTable._checkCapacity();
-      } else {
-        assert(identical(entry, _TOMBSTONE));
-        _hashTable._deletedCount--;
-      }
-      _hashTable._recordModification();
+      pair = _hashTable._add(key, hash);
     } else {
-      // The table might have changed, so we can't trust [offset] any more.
-      // Do another lookup before setting the value.
-      offset = _hashTable._put(key);
-      _hashTable._setValue(offset, value);
-      _hashTable._checkCapacity();
+      // The table might have changed, so the key has to be looked up again.
+      pair = _hashTable._put(key);
     }
+    _hashTable._setValue(pair, value);
     return value;
   }
 
   /* patch */ V remove(K key) {
-    int offset = _hashTable._remove(key);
-    if (offset < 0) return null;
-    V oldValue = _hashTable._value(offset);
-    _hashTable._setValue(offset, null);
-    _hashTable._checkCapacity();
-    return oldValue;
+    return _hashTable._remove(key);
   }
 
   /* patch */ void clear() {
     _hashTable._clear();
   }
 
-  /* patch */ void forEach(void action(K key, V value)) {
+  /* patch */ void forEach(void action (K key, V value)) {
     int modificationCount = _hashTable._modificationCount;
-    List table = _hashTable._table;
-    int entrySize = _hashTable._entrySize;
-    for (int offset = 0; offset < table.length; offset += entrySize) {
-      Object entry = table[offset];
-      if (!_hashTable._isFree(entry)) {
-        K key = entry;
-        V value = _hashTable._value(offset);
-        action(key, value);
+    List data = _hashTable._data;
+    for (int offset = 0; offset < _hashTable._usedData; offset += 2) {
+      Object key = data[offset];
+      if (!identical(key, _TOMBSTONE)) {
+        action(key, data[offset + 1]);
         _hashTable._checkModification(modificationCount);
       }
     }
   }
 
-  /* patch */ Iterable<K> get keys => new _HashTableKeyIterable<K>(_hashTable);
+  /* patch */ Iterable<K> get keys =>
+      new _CompactHashTableKeyIterable<K>(_hashTable);
+
   /* patch */ Iterable<V> get values =>
-      new _HashTableValueIterable<V>(_hashTable, _HashMapTable._VALUE_INDEX);
+      new _CompactHashTableIterable<V>(_hashTable,
+                                       _CompactHashTable._VALUE_INDEX);
 
   /* patch */ int get length => _hashTable._elementCount;
 
@@ -193,9 +176,9 @@ patch class HashSet<E> {
  * A hash-based map that iterates keys and values in key insertion order.
  */
 patch class LinkedHashMap<K, V> {
-  final _LinkedHashMapTable _hashTable;
+  final _CompactHashTable<K, V> _hashTable;
 
-  /* patch */ LinkedHashMap() : _hashTable = new _LinkedHashMapTable<K, V>() {
+  /* patch */ LinkedHashMap() : _hashTable = new _CompactHashTable<K, V>() {
     _hashTable._container = this;
   }
 
@@ -205,10 +188,9 @@ patch class LinkedHashMap<K, V> {
 
   /* patch */ bool containsValue(V value) {
     int modificationCount = _hashTable._modificationCount;
-    for (int offset = _hashTable._next(_LinkedHashTable._HEAD_OFFSET);
-         offset != _LinkedHashTable._HEAD_OFFSET;
-         offset = _hashTable._next(offset)) {
-      if (_hashTable._value(offset) == value) {
+    List data = _hashTable._data;
+    for (int offset = 0; offset < _hashTable._usedData; offset += 2) {
+      if (!identical(data[offset], _TOMBSTONE) && (data[offset + 1] == value)) {
         return true;
       }
       // The == call may modify the table.
@@ -219,61 +201,42 @@ patch class LinkedHashMap<K, V> {
 
   /* patch */ void addAll(Map<K, V> other) {
     other.forEach((K key, V value) {
-      int offset = _hashTable._put(key);
-      _hashTable._setValue(offset, value);
-      _hashTable._checkCapacity();
+      int pair = _hashTable._put(key);
+      _hashTable._setValue(pair, value);
     });
   }
 
   /* patch */ V operator [](K key) {
-    int offset = _hashTable._get(key);
-    if (offset >= 0) return _hashTable._value(offset);
+    int pair = _hashTable._get(key);
+    if (pair >= 0) return _hashTable._value(pair);
     return null;
   }
 
   /* patch */ void operator []=(K key, V value) {
-    int offset = _hashTable._put(key);
-    _hashTable._setValue(offset, value);
-    _hashTable._checkCapacity();
+    int pair = _hashTable._put(key);
+    _hashTable._setValue(pair, value);
   }
 
   /* patch */ V putIfAbsent(K key, V ifAbsent()) {
-    int offset = _hashTable._probeForAdd(_hashTable._hashCodeOf(key), key);
-    Object entry = _hashTable._table[offset];
-    if (!_hashTable._isFree(entry)) {
-      return _hashTable._value(offset);
+    int hash = _hashTable._hashCodeOf(key);
+    int pair = _hashTable._findPair(key, hash);
+    if (pair >= 0) {
+      return _hashTable._value(pair);
     }
     int modificationCount = _hashTable._modificationCount;
     V value = ifAbsent();
     if (modificationCount == _hashTable._modificationCount) {
-      _hashTable._setKey(offset, key);
-      _hashTable._setValue(offset, value);
-      _hashTable._linkLast(offset);
-      if (entry == null) {
-        _hashTable._entryCount++;
-        _hashTable._checkCapacity();
-      } else {
-        assert(identical(entry, _TOMBSTONE));
-        _hashTable._deletedCount--;
-      }
-      _hashTable._recordModification();
+      pair = _hashTable._add(key, hash);
     } else {
-      // The table might have changed, so we can't trust [offset] any more.
-      // Do another lookup before setting the value.
-      offset = _hashTable._put(key);
-      _hashTable._setValue(offset, value);
-      _hashTable._checkCapacity();
+      // The table might have changed, so the key has to be looked up again.
+      pair = _hashTable._put(key);
     }
+    _hashTable._setValue(pair, value);
     return value;
   }
 
   /* patch */ V remove(K key) {
-    int offset = _hashTable._remove(key);
-    if (offset < 0) return null;
-    Object oldValue = _hashTable._value(offset);
-    _hashTable._setValue(offset, null);
-    _hashTable._checkCapacity();
-    return oldValue;
+    return _hashTable._remove(key);
   }
 
   /* patch */ void clear() {
@@ -282,20 +245,22 @@ patch class LinkedHashMap<K, V> {
 
   /* patch */ void forEach(void action (K key, V value)) {
     int modificationCount = _hashTable._modificationCount;
-    for (int offset = _hashTable._next(_LinkedHashTable._HEAD_OFFSET);
-         offset != _LinkedHashTable._HEAD_OFFSET;
-         offset = _hashTable._next(offset)) {
-      action(_hashTable._key(offset), _hashTable._value(offset));
-      _hashTable._checkModification(modificationCount);
+    List data = _hashTable._data;
+    for (int offset = 0; offset < _hashTable._usedData; offset += 2) {
+      Object key = data[offset];
+      if (!identical(key, _TOMBSTONE)) {
+        action(key, data[offset + 1]);
+        _hashTable._checkModification(modificationCount);
+      }
     }
   }
 
   /* patch */ Iterable<K> get keys =>
-      new _LinkedHashTableKeyIterable<K>(_hashTable);
+      new _CompactHashTableKeyIterable<K>(_hashTable);
 
   /* patch */ Iterable<V> get values =>
-      new _LinkedHashTableValueIterable<V>(_hashTable,
-                                           _LinkedHashMapTable._VALUE_INDEX);
+      new _CompactHashTableIterable<V>(_hashTable,
+                                       _CompactHashTable._VALUE_INDEX);
 
   /* patch */ int get length => _hashTable._elementCount;
 
@@ -697,39 +662,6 @@ class _HashTable<K> {
   }
 }
 
-/**
- * Generic iterable based on a [_HashTable].
- */
-abstract class _HashTableIterable<E> extends IterableBase<E> {
-  final _HashTable _hashTable;
-  _HashTableIterable(this._hashTable);
-
-  Iterator<E> get iterator;
-
-  /**
-   * Return the iterated value for a given entry.
-   */
-  E _valueAt(int offset, Object key);
-
-  int get length => _hashTable._elementCount;
-
-  bool get isEmpty => _hashTable._elementCount == 0;
-
-  void forEach(void action(E element)) {
-    int entrySize = _hashTable._entrySize;
-    List table = _hashTable._table;
-    int modificationCount = _hashTable._modificationCount;
-    for (int offset = 0; offset < table.length; offset += entrySize) {
-      Object entry = table[offset];
-      if (!_hashTable._isFree(entry)) {
-        E value = _valueAt(offset, entry);
-        action(value);
-      }
-      _hashTable._checkModification(modificationCount);
-    }
-  }
-}
-
 abstract class _HashTableIterator<E> implements Iterator<E> {
   final _HashTable _hashTable;
   final int _modificationCount;
@@ -765,19 +697,6 @@ abstract class _HashTableIterator<E> implements Iterator<E> {
   E _valueAt(int offset, Object key);
 }
 
-class _HashTableKeyIterable<K> extends _HashTableIterable<K> {
-  _HashTableKeyIterable(_HashTable<K> hashTable) : super(hashTable);
-
-  Iterator<K> get iterator => new _HashTableKeyIterator<K>(_hashTable);
-
-  K _valueAt(int offset, Object key) {
-    if (identical(key, _NULL)) return null;
-    return key;
-  }
-
-  bool contains(Object value) => _hashTable._get(value) >= 0;
-}
-
 class _HashTableKeyIterator<K> extends _HashTableIterator<K> {
   _HashTableKeyIterator(_HashTable hashTable) : super(hashTable);
 
@@ -787,44 +706,6 @@ class _HashTableKeyIterator<K> extends _HashTableIterator<K> {
   }
 }
 
-class _HashTableValueIterable<V> extends _HashTableIterable<V> {
-  final int _entryIndex;
-
-  _HashTableValueIterable(_HashTable hashTable, this._entryIndex)
-      : super(hashTable);
-
-  Iterator<V> get iterator {
-    return new _HashTableValueIterator<V>(_hashTable, _entryIndex);
-  }
-
-  V _valueAt(int offset, Object key) => _hashTable._table[offset + _entryIndex];
-}
-
-class _HashTableValueIterator<V> extends _HashTableIterator<V> {
-  final int _entryIndex;
-
-  _HashTableValueIterator(_HashTable hashTable, this._entryIndex)
-      : super(hashTable);
-
-  V _valueAt(int offset, Object key) => _hashTable._table[offset + _entryIndex];
-}
-
-class _HashMapTable<K, V> extends _HashTable<K> {
-  static const int _INITIAL_CAPACITY = 8;
-  static const int _VALUE_INDEX = 1;
-
-  _HashMapTable() : super(_INITIAL_CAPACITY);
-
-  int get _entrySize => 2;
-
-  V _value(int offset) => _table[offset + _VALUE_INDEX];
-  void _setValue(int offset, V value) { _table[offset + _VALUE_INDEX] = value; }
-
-  _copyEntry(List fromTable, int fromOffset, int toOffset) {
-    _table[toOffset + _VALUE_INDEX] = fromTable[fromOffset + _VALUE_INDEX];
-  }
-}
-
 /** Unique marker object for the head of a linked list of entries. */
 class _LinkedHashTableHeadMarker {
   const _LinkedHashTableHeadMarker();
@@ -924,40 +805,12 @@ class _LinkedHashTable<K> extends _HashTable<K> {
   }
 }
 
-class _LinkedHashTableKeyIterable<K> extends IterableBase<K> {
-  final _LinkedHashTable<K> _table;
-  _LinkedHashTableKeyIterable(this._table);
-  Iterator<K> get iterator => new _LinkedHashTableKeyIterator<K>(_table);
-
-  bool contains(Object value) => _table._get(value) >= 0;
-
-  int get length => _table._elementCount;
-}
-
 class _LinkedHashTableKeyIterator<K> extends _LinkedHashTableIterator<K> {
   _LinkedHashTableKeyIterator(_LinkedHashTable<K> hashTable): super(hashTable);
 
   K _getCurrent(int offset) => _hashTable._key(offset);
 }
 
-class _LinkedHashTableValueIterable<V> extends IterableBase<V> {
-  final _LinkedHashTable _hashTable;
-  final int _valueIndex;
-  _LinkedHashTableValueIterable(this._hashTable, this._valueIndex);
-  Iterator<V> get iterator =>
-      new _LinkedHashTableValueIterator<V>(_hashTable, _valueIndex);
-  int get length => _hashTable._elementCount;
-}
-
-class _LinkedHashTableValueIterator<V> extends _LinkedHashTableIterator<V> {
-  final int _valueIndex;
-
-  _LinkedHashTableValueIterator(_LinkedHashTable hashTable, this._valueIndex)
-      : super(hashTable);
-
-  V _getCurrent(int offset) => _hashTable._table[offset + _valueIndex];
-}
-
 abstract class _LinkedHashTableIterator<T> implements Iterator<T> {
   final _LinkedHashTable _hashTable;
   final int _modificationCount;
@@ -985,18 +838,232 @@ abstract class _LinkedHashTableIterator<T> implements Iterator<T> {
   T get current => _current;
 }
 
-class _LinkedHashMapTable<K, V> extends _LinkedHashTable<K> {
-  static const int _INITIAL_CAPACITY = 8;
-  static const int _VALUE_INDEX = 3;
+/**
+ * Hash table of a [HashMap] or a [LinkedHashMap].
+ *
+ * The entries are kept densely in insertion order in [_data] as alternating
+ * keys and values, so no object is allocated per entry and iteration is a
+ * linear walk. Keys are found through the open addressing [_index], whose
+ * entries hold the pair number of the key in [_data] in the bits below
+ * [_indexMask] and the remaining bits of the key's hash code above. Most
+ * mismatching keys are thus skipped without calling [Object.==].
+ *
+ * Removed pairs stay in [_data] as [_TOMBSTONE] keys until the table is
+ * rebuilt, which happens when [_data] is full.
+ */
+class _CompactHashTable<K, V> {
+  static const int _INITIAL_INDEX_SIZE = 16;
+  static const int _VALUE_INDEX = 1;
+  static const int _HASH_MASK = 0x3FFFFFFF;
+  /** Index entry of a removed pair. Free entries are null. */
+  static const int _DELETED = 0;
+
+  /** Power of two size, at least twice the number of pairs in [_data]. */
+  List<int> _index;
+  int _indexMask;
+  List _data;
+  /** Number of used slots in [_data], including removed pairs. */
+  int _usedData = 0;
+  int _deletedKeys = 0;
+  /** Counter incremented when keys are added or removed. */
+  int _modificationCount = 0;
+  /** If set, used as the source object for [ConcurrentModificationError]s. */
+  Object _container;
+
+  _CompactHashTable() {
+    _init(_INITIAL_INDEX_SIZE);
+  }
+
+  void _init(int indexSize) {
+    _index = new List<int>(indexSize);
+    _indexMask = indexSize - 1;
+    // The index is at most half full.
+    _data = new List(indexSize);
+    _usedData = 0;
+    _deletedKeys = 0;
+  }
+
+  int get _elementCount => (_usedData >> 1) - _deletedKeys;
+
+  int _hashCodeOf(Object key) => key.hashCode & _HASH_MASK;
+
+  V _value(int pair) => _data[(pair << 1) + _VALUE_INDEX];
+  void _setValue(int pair, V value) {
+    _data[(pair << 1) + _VALUE_INDEX] = value;
+  }
+
+  void _checkModification(int expectedModificationCount) {
+    if (_modificationCount != expectedModificationCount) {
+      throw new ConcurrentModificationError(_container);
+    }
+  }
+
+  void _recordModification() {
+    _modificationCount = (_modificationCount + 1) & (0x3FFFFFFF);
+  }
 
-  int get _entrySize => 4;
+  /**
+   * Returns the position in [_index] of the entry for [key], or a negative
+   * value if [key] is not in the table.
+   */
+  int _findIndex(Object key, int hash) {
+    final int mask = _indexMask;
+    final int hashPattern = hash & ~mask;
+    int index = hash & mask;
+    int probeCount = 0;
+    int entry = _index[index];
+    while (entry != null) {
+      if ((entry != _DELETED) && ((entry & ~mask) == hashPattern)) {
+        int offset = ((entry & mask) - 1) << 1;
+        if (_data[offset] == key) return index;
+      }
+      // Triangular probing hits every position of the power of two sized
+      // index exactly once.
+      index = (index + ++probeCount) & mask;
+      entry = _index[index];
+    }
+    return -1;
+  }
 
-  _LinkedHashMapTable() : super(_INITIAL_CAPACITY);
+  /** Returns the pair number of [key] or a negative value if absent. */
+  int _findPair(Object key, int hash) {
+    int index = _findIndex(key, hash);
+    if (index < 0) return -1;
+    return (_index[index] & _indexMask) - 1;
+  }
+
+  int _get(Object key) => _findPair(key, _hashCodeOf(key));
+
+  /**
+   * Returns the pair number of [key], adding it with a null value if it is
+   * not in the table yet.
+   */
+  int _put(K key) {
+    int hash = _hashCodeOf(key);
+    int pair = _findPair(key, hash);
+    if (pair >= 0) return pair;
+    return _add(key, hash);
+  }
 
-  V _value(int offset) => _table[offset + _VALUE_INDEX];
-  void _setValue(int offset, V value) { _table[offset + _VALUE_INDEX] = value; }
+  /** Appends [key], which must not be in the table, to [_data]. */
+  int _add(K key, int hash) {
+    if (_usedData == _data.length) {
+      _rebuild();
+    }
+    int pair = _usedData >> 1;
+    _data[_usedData] = key;
+    _data[_usedData + _VALUE_INDEX] = null;
+    _usedData += 2;
+    _insertIndex(pair, hash);
+    _recordModification();
+    return pair;
+  }
 
-  _copyEntry(List oldTable, int fromOffset, int toOffset) {
-    _table[toOffset + _VALUE_INDEX] = oldTable[fromOffset + _VALUE_INDEX];
+  void _insertIndex(int pair, int hash) {
+    final int mask = _indexMask;
+    int index = hash & mask;
+    int probeCount = 0;
+    int entry = _index[index];
+    while ((entry != null) && (entry != _DELETED)) {
+      index = (index + ++probeCount) & mask;
+      entry = _index[index];
+    }
+    _index[index] = (hash & ~mask) | (pair + 1);
+  }
+
+  /** Removes [key] and returns its value, or null if it is not there. */
+  V _remove(Object key) {
+    int index = _findIndex(key, _hashCodeOf(key));
+    if (index < 0) return null;
+    int offset = ((_index[index] & _indexMask) - 1) << 1;
+    V value = _data[offset + _VALUE_INDEX];
+    _index[index] = _DELETED;
+    _data[offset] = _TOMBSTONE;
+    _data[offset + _VALUE_INDEX] = null;
+    _deletedKeys++;
+    _recordModification();
+    return value;
   }
+
+  void _clear() {
+    if (_elementCount == 0) return;
+    _init(_INITIAL_INDEX_SIZE);
+    _recordModification();
+  }
+
+  /**
+   * Moves the remaining pairs to the front of a new [_data] and rebuilds the
+   * index. The table grows unless at least half of the pairs were removed.
+   */
+  void _rebuild() {
+    List oldData = _data;
+    int oldUsedData = _usedData;
+    int indexSize = _index.length;
+    if ((_deletedKeys << 1) < (oldUsedData >> 1)) {
+      indexSize <<= 1;
+    }
+    _init(indexSize);
+    for (int offset = 0; offset < oldUsedData; offset += 2) {
+      Object key = oldData[offset];
+      if (!identical(key, _TOMBSTONE)) {
+        int pair = _usedData >> 1;
+        _data[_usedData] = key;
+        _data[_usedData + _VALUE_INDEX] = oldData[offset + _VALUE_INDEX];
+        _usedData += 2;
+        _insertIndex(pair, _hashCodeOf(key));
+      }
+    }
+    _recordModification();
+  }
+}
+
+class _CompactHashTableIterable<E> extends IterableBase<E> {
+  final _CompactHashTable _hashTable;
+  final int _entryIndex;
+
+  _CompactHashTableIterable(this._hashTable, this._entryIndex);
+
+  Iterator<E> get iterator =>
+      new _CompactHashTableIterator<E>(_hashTable, _entryIndex);
+
+  int get length => _hashTable._elementCount;
+
+  bool get isEmpty => _hashTable._elementCount == 0;
+}
+
+class _CompactHashTableKeyIterable<K> extends _CompactHashTableIterable<K> {
+  _CompactHashTableKeyIterable(_CompactHashTable hashTable)
+      : super(hashTable, 0);
+
+  bool contains(Object value) => _hashTable._get(value) >= 0;
+}
+
+class _CompactHashTableIterator<E> implements Iterator<E> {
+  final _CompactHashTable _hashTable;
+  final int _modificationCount;
+  final int _entryIndex;
+  /** Offset in the data of the next pair to look at. */
+  int _offset = 0;
+  E _current;
+
+  _CompactHashTableIterator(_CompactHashTable hashTable, this._entryIndex)
+      : _hashTable = hashTable,
+        _modificationCount = hashTable._modificationCount;
+
+  bool moveNext() {
+    _hashTable._checkModification(_modificationCount);
+    List data = _hashTable._data;
+    while (_offset < _hashTable._usedData) {
+      int offset = _offset;
+      _offset = offset + 2;
+      if (!identical(data[offset], _TOMBSTONE)) {
+        _current = data[offset + _entryIndex];
+        return true;
+      }
+    }
+    _current = null;
+    return false;
+  }
+
+  E get current => _current;
 }
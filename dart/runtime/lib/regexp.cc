@@ -9,6 +9,7 @@
 #include "vm/object.h"
 
 #include "lib/regexp_jsc.h"
+#include "lib/regexp_simple.h"
 
 namespace dart {
 
@@ -22,6 +23,11 @@ DEFINE_NATIVE_ENTRY(JSSyntaxRegExp_factory, 4) {
       Instance, handle_case_sensitive, arguments->NativeArgAt(3));
   bool ignore_case = handle_case_sensitive.raw() != Bool::True().raw();
   bool multi_line = handle_multi_line.raw() == Bool::True().raw();
+  const JSRegExp& regexp = JSRegExp::Handle(
+      SimpleRegExp::Compile(pattern, multi_line, ignore_case));
+  if (!regexp.IsNull()) {
+    return regexp.raw();
+  }
   return Jscre::Compile(pattern, multi_line, ignore_case);
 }
 
@@ -69,7 +75,53 @@ DEFINE_NATIVE_ENTRY(JSSyntaxRegExp_ExecuteMatch, 3) {
   ASSERT(!regexp.IsNull());
   GET_NON_NULL_NATIVE_ARGUMENT(String, str, arguments->NativeArgAt(1));
   GET_NON_NULL_NATIVE_ARGUMENT(Smi, start_index, arguments->NativeArgAt(2));
+  if (regexp.is_simple()) {
+    return SimpleRegExp::Execute(regexp, str, start_index.Value());
+  }
   return Jscre::Execute(regexp, str, start_index.Value());
 }
 
+
+// Returns the matches of the regexp in a string in the order allMatches
+// iterates them, converting the string for jscre only once.
+DEFINE_NATIVE_ENTRY(JSSyntaxRegExp_ExecuteAllMatches, 2) {
+  const JSRegExp& regexp = JSRegExp::CheckedHandle(arguments->NativeArgAt(0));
+  ASSERT(!regexp.IsNull());
+  GET_NON_NULL_NATIVE_ARGUMENT(String, str, arguments->NativeArgAt(1));
+  const String& subject = String::Handle(
+      str.IsConsString() ? ConsString::Flatten(str) : str.raw());
+  const bool is_simple = regexp.is_simple();
+  const uint16_t* two_byte_str =
+      is_simple ? NULL : Jscre::GetTwoByteData(subject);
+  const GrowableObjectArray& matches =
+      GrowableObjectArray::Handle(GrowableObjectArray::New());
+  Array& match = Array::Handle();
+  Smi& match_start = Smi::Handle();
+  Smi& match_end = Smi::Handle();
+  const intptr_t length = subject.Length();
+  intptr_t start_index = 0;
+  while (true) {
+    if (is_simple) {
+      match = SimpleRegExp::Execute(regexp, subject, start_index);
+    } else {
+      match = Jscre::Execute(regexp, subject, start_index, two_byte_str);
+    }
+    if (match.IsNull()) {
+      break;
+    }
+    matches.Add(match);
+    match_start ^= match.At(0);
+    match_end ^= match.At(1);
+    if (match_end.Value() == length) {
+      break;
+    } else if (match_start.Value() == match_end.Value()) {
+      // Empty match, advance and restart.
+      start_index++;
+    } else {
+      start_index = match_end.Value();
+    }
+  }
+  return matches.raw();
+}
+
 }  // namespace dart
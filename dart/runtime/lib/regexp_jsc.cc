@@ -10,12 +10,13 @@
 #include "vm/allocation.h"
 #include "vm/exceptions.h"
 #include "vm/globals.h"
+#include "vm/heap.h"
 #include "vm/isolate.h"
 #include "third_party/jscre/pcre.h"
 
 namespace dart {
 
-static uint16_t* GetTwoByteData(const String& str) {
+static uint16_t* ConvertToTwoByte(const String& str) {
   Zone* zone = Isolate::Current()->current_zone();
   uint16_t* two_byte_str = zone->Alloc<uint16_t>(str.Length());
   for (intptr_t i = 0; i < str.Length(); i++) {
@@ -56,7 +57,7 @@ RawJSRegExp* Jscre::Compile(const String& pattern,
                             bool ignore_case) {
   // First convert the pattern to UTF16 format as the jscre library expects
   // strings to be in UTF16 encoding.
-  uint16_t* two_byte_pattern = GetTwoByteData(pattern);
+  uint16_t* two_byte_pattern = ConvertToTwoByte(pattern);
 
   // A Dart regexp is always global.
   bool is_global = true;
@@ -104,17 +105,27 @@ RawJSRegExp* Jscre::Compile(const String& pattern,
 }
 
 
+const uint16_t* Jscre::GetTwoByteData(const String& str) {
+  if ((str.Length() > 0) &&
+      (str.IsTwoByteString() || str.IsExternalTwoByteString())) {
+    return NULL;
+  }
+  // The jscre library expects strings to be in UTF16 encoding.
+  return ConvertToTwoByte(str);
+}
+
+
 RawArray* Jscre::Execute(const JSRegExp& regex,
                          const String& str,
                          intptr_t start_index) {
-  // First convert the input str to UTF16 format as the jscre library expects
-  // strings to be in UTF16 encoding.
-  uint16_t* two_byte_str = GetTwoByteData(str);
+  return Execute(regex, str, start_index, GetTwoByteData(str));
+}
 
-  // Execute a regex match by calling into the jscre library.
-  jscre::JSRegExp* jscregexp =
-      reinterpret_cast<jscre::JSRegExp*>(regex.GetDataStartAddress());
-  ASSERT(jscregexp != NULL);
+
+RawArray* Jscre::Execute(const JSRegExp& regex,
+                         const String& str,
+                         intptr_t start_index,
+                         const uint16_t* two_byte_str) {
   const Smi& num_bracket_exprs = Smi::Handle(regex.num_bracket_expressions());
   intptr_t num_bracket_expressions = num_bracket_exprs.Value();
   Zone* zone = Isolate::Current()->current_zone();
@@ -126,12 +137,31 @@ RawArray* Jscre::Execute(const JSRegExp& regex,
   int offsets_length = (num_bracket_expressions + 1) * kJscreMultiple;
   int* offsets = NULL;
   offsets = zone->Alloc<int>(offsets_length);
-  int retval = jscre::jsRegExpExecute(jscregexp,
-                                      two_byte_str,
-                                      str.Length(),
-                                      start_index,
-                                      offsets,
-                                      offsets_length);
+  int retval;
+  {
+    // Both the compiled regex and the characters of a two-byte subject are
+    // used in place.
+    NoGCScope no_gc;
+    if (two_byte_str == NULL) {
+      if (str.IsTwoByteString()) {
+        two_byte_str = TwoByteString::CharAddr(str, 0);
+      } else {
+        ASSERT(str.IsExternalTwoByteString());
+        two_byte_str = ExternalTwoByteString::CharAddr(str, 0);
+      }
+    }
+
+    // Execute a regex match by calling into the jscre library.
+    jscre::JSRegExp* jscregexp =
+        reinterpret_cast<jscre::JSRegExp*>(regex.GetDataStartAddress());
+    ASSERT(jscregexp != NULL);
+    retval = jscre::jsRegExpExecute(jscregexp,
+                                    two_byte_str,
+                                    str.Length(),
+                                    start_index,
+                                    offsets,
+                                    offsets_length);
+  }
 
   // The KJS JavaScript engine returns null (ie, a failed match) when
   // JSRE's internal match limit is exceeded.  We duplicate that behavior here.
@@ -18,6 +18,17 @@ class Jscre : public AllStatic {
   static RawArray* Execute(const JSRegExp& regex,
                            const String& str,
                            intptr_t index);
+
+  // Returns the characters of 'str' converted to UTF-16, or NULL if 'str' is
+  // a two-byte string whose characters can be matched in place.
+  static const uint16_t* GetTwoByteData(const String& str);
+
+  // Same as above, with 'two_byte_str' the result of GetTwoByteData(str) so
+  // that repeated matches on the same subject only convert it once.
+  static RawArray* Execute(const JSRegExp& regex,
+                           const String& str,
+                           intptr_t index,
+                           const uint16_t* two_byte_str);
 };
 
 }  // namespace dart
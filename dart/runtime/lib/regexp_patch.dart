@@ -66,7 +66,31 @@ class _JSSyntaxRegExp implements RegExp {
   factory _JSSyntaxRegExp(
       String pattern,
       {bool multiLine: false,
-       bool caseSensitive: true}) native "JSSyntaxRegExp_factory";
+       bool caseSensitive: true}) {
+    // Compiled regexps are immutable, so the ones for recently used patterns
+    // are kept in a direct-mapped cache instead of being compiled again.
+    int index = (pattern.hashCode + (multiLine == true ? 1 : 0) +
+                 (caseSensitive == true ? 2 : 0)) & (_CACHE_SIZE - 1);
+    _JSSyntaxRegExp regexp = _cache[index];
+    if ((regexp != null) &&
+        (regexp.pattern == pattern) &&
+        (regexp.isMultiLine == multiLine) &&
+        (regexp.isCaseSensitive == caseSensitive)) {
+      return regexp;
+    }
+    regexp = new _JSSyntaxRegExp._compile(pattern, multiLine, caseSensitive);
+    _cache[index] = regexp;
+    return regexp;
+  }
+
+  factory _JSSyntaxRegExp._compile(
+      String pattern,
+      bool multiLine,
+      bool caseSensitive) native "JSSyntaxRegExp_factory";
+
+  static const int _CACHE_SIZE = 64;
+  static final List<_JSSyntaxRegExp> _cache =
+      new List<_JSSyntaxRegExp>(_CACHE_SIZE);
 
   Match firstMatch(String str) {
     List match = _ExecuteMatch(str, 0);
@@ -79,22 +103,8 @@ class _JSSyntaxRegExp implements RegExp {
   Iterable<Match> allMatches(String str) {
     if (str is! String) throw new ArgumentError(str);
     List<Match> result = new List<Match>();
-    int length = str.length;
-    int startIndex = 0;
-    while (true) {
-      List match = _ExecuteMatch(str, startIndex);
-      if (match == null) {
-        break;
-      }
+    for (List match in _ExecuteAllMatches(str)) {
       result.add(new _JSRegExpMatch(this, str, match));
-      int endIndex = match[1];
-      if (endIndex == length) {
-        break;
-      } else if (match[0] == endIndex) {
-        ++startIndex;  // empty match, advance and restart
-      } else {
-        startIndex = endIndex;
-      }
     }
     return result;
   }
@@ -122,4 +132,7 @@ class _JSSyntaxRegExp implements RegExp {
 
   List _ExecuteMatch(String str, int start_index)
       native "JSSyntaxRegExp_ExecuteMatch";
+
+  List _ExecuteAllMatches(String str)
+      native "JSSyntaxRegExp_ExecuteAllMatches";
 }
@@ -0,0 +1,864 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "lib/regexp_simple.h"
+
+#include "platform/assert.h"
+#include "platform/utils.h"
+#include "vm/flags.h"
+#include "vm/growable_array.h"
+#include "vm/heap.h"
+#include "vm/isolate.h"
+
+namespace dart {
+
+DEFINE_FLAG(bool, simple_regexp, true,
+    "Match regular expressions without groups or alternatives directly on "
+    "the string characters instead of using jscre.");
+
+// A compiled pattern is a program of 16-bit units laid out as follows:
+//   - the number of terms,
+//   - kTermSize units per term: its kind and greediness, its character or
+//     the offset of its character class, and its minimum and maximum
+//     repetition count,
+//   - the character classes: kBitmapLength units holding a bitmap of the
+//     characters below 256, a negation flag, the number of ranges and then
+//     the sorted [from, to] pairs of the characters above 255 in the class.
+enum TermKind {
+  kChar = 0,
+  kCharIgnoreCase,
+  kClass,
+  // Assertions, which never repeat and do not consume characters.
+  kStart,
+  kLineStart,
+  kEnd,
+  kLineEnd,
+  kWordBoundary,
+  kNotWordBoundary,
+};
+
+static const intptr_t kTermSize = 4;
+static const intptr_t kBitmapLength = 256 / 16;
+static const intptr_t kUnbounded = 0xFFFF;
+static const intptr_t kMaxRepetition = kUnbounded - 1;
+static const intptr_t kMaxProgramLength = 0xFFFF;
+// Every repeated term with a variable count adds a level of recursion to the
+// matcher, so patterns with many of them are left to jscre.
+static const intptr_t kMaxVariableTerms = 32;
+// Same limit on backtracking per match attempt as in jscre, where exceeding it
+// makes the match fail.
+static const intptr_t kMatchLimit = 100000;
+
+
+static bool IsNewline(int32_t c) {
+  return (c == 0xA) || (c == 0xD) || (c == 0x2028) || (c == 0x2029);
+}
+
+
+// As in jscre, only ASCII letters, digits and '_' are word characters.
+static bool IsWordCharacter(int32_t c) {
+  return ((c >= 'a') && (c <= 'z')) ||
+         ((c >= 'A') && (c <= 'Z')) ||
+         ((c >= '0') && (c <= '9')) ||
+         (c == '_');
+}
+
+
+static bool IsAsciiLetter(int32_t c) {
+  return ((c | 0x20) >= 'a') && ((c | 0x20) <= 'z');
+}
+
+
+struct CharacterRange {
+  int32_t from;
+  int32_t to;
+};
+
+
+static int CompareRanges(const CharacterRange* a, const CharacterRange* b) {
+  return a->from - b->from;
+}
+
+
+class SimpleRegExpCompiler : public ValueObject {
+ public:
+  SimpleRegExpCompiler(const String& pattern,
+                       bool multi_line,
+                       bool ignore_case)
+      : pattern_(pattern),
+        multi_line_(multi_line),
+        ignore_case_(ignore_case),
+        position_(0),
+        num_variable_terms_(0),
+        terms_(),
+        classes_(),
+        ranges_() { }
+
+  // Returns false if the pattern uses syntax that is not supported.
+  bool Compile();
+
+  intptr_t ProgramLength() const {
+    return 1 + terms_.length() + classes_.length();
+  }
+
+  void WriteProgram(uint16_t* program) const;
+
+ private:
+  bool AtEnd() const { return position_ >= pattern_.Length(); }
+  int32_t Peek() const { return pattern_.CharAt(position_); }
+  int32_t Next() { return pattern_.CharAt(position_++); }
+
+  bool ParseTerm();
+  bool ParseEscape();
+  bool ParseCharacter(int32_t c);
+  bool ParseCharacterEscape(int32_t c, int32_t* result);
+  bool ParseHex(intptr_t num_digits, int32_t* result);
+  bool ParseClass(bool* negated);
+  bool ParseClassAtom(int32_t c, int32_t* result);
+  bool ParseQuantifier(TermKind kind, intptr_t value);
+  bool ParseRepetition(intptr_t* min, intptr_t* max);
+  bool ParseDecimal(intptr_t* result);
+
+  void AddTerm(TermKind kind,
+               intptr_t value,
+               intptr_t min,
+               intptr_t max,
+               bool greedy);
+  void AddRange(int32_t from, int32_t to);
+  void AddClassEscape(int32_t c);
+  void AddCaseRange(int32_t from, int32_t to, int32_t lo, int32_t hi);
+  intptr_t AddClass(bool negated);
+
+  const String& pattern_;
+  const bool multi_line_;
+  const bool ignore_case_;
+  intptr_t position_;
+  intptr_t num_variable_terms_;
+  GrowableArray<uint16_t> terms_;
+  GrowableArray<uint16_t> classes_;
+  // Ranges of the character class being parsed.
+  GrowableArray<CharacterRange> ranges_;
+
+  DISALLOW_COPY_AND_ASSIGN(SimpleRegExpCompiler);
+};
+
+
+bool SimpleRegExpCompiler::Compile() {
+  while (!AtEnd()) {
+    if (!ParseTerm()) {
+      return false;
+    }
+  }
+  return ProgramLength() <= kMaxProgramLength;
+}
+
+
+void SimpleRegExpCompiler::WriteProgram(uint16_t* program) const {
+  const intptr_t classes_start = 1 + terms_.length();
+  program[0] = terms_.length() / kTermSize;
+  for (intptr_t i = 0; i < terms_.length(); i++) {
+    program[1 + i] = terms_[i];
+    if (((i % kTermSize) == 1) && ((terms_[i - 1] & 0xFF) == kClass)) {
+      program[1 + i] += classes_start;
+    }
+  }
+  for (intptr_t i = 0; i < classes_.length(); i++) {
+    program[classes_start + i] = classes_[i];
+  }
+}
+
+
+bool SimpleRegExpCompiler::ParseTerm() {
+  const int32_t c = Next();
+  switch (c) {
+    case '^':
+      AddTerm(multi_line_ ? kLineStart : kStart, 0, 1, 1, true);
+      return true;
+    case '$':
+      AddTerm(multi_line_ ? kLineEnd : kEnd, 0, 1, 1, true);
+      return true;
+    case '.':
+      ranges_.Clear();
+      AddRange('\n', '\n');
+      AddRange('\r', '\r');
+      AddRange(0x2028, 0x2029);
+      return ParseQuantifier(kClass, AddClass(true));
+    case '[': {
+      bool negated = false;
+      if (!ParseClass(&negated)) {
+        return false;
+      }
+      return ParseQuantifier(kClass, AddClass(negated));
+    }
+    case '\\':
+      return ParseEscape();
+    case '(':
+    case ')':
+    case '|':
+    case '*':
+    case '+':
+    case '?':
+    case '{':
+    case '}':
+    case ']':
+      // Groups, alternatives and syntax errors are handled by jscre.
+      return false;
+    default:
+      return ParseCharacter(c);
+  }
+}
+
+
+bool SimpleRegExpCompiler::ParseEscape() {
+  if (AtEnd()) {
+    return false;
+  }
+  const int32_t c = Next();
+  switch (c) {
+    case 'b':
+      AddTerm(kWordBoundary, 0, 1, 1, true);
+      return true;
+    case 'B':
+      AddTerm(kNotWordBoundary, 0, 1, 1, true);
+      return true;
+    case 'd':
+    case 'D':
+    case 'w':
+    case 'W':
+    case 's':
+    case 'S':
+      ranges_.Clear();
+      AddClassEscape(c);
+      return ParseQuantifier(kClass, AddClass(false));
+    default: {
+      int32_t ch = 0;
+      if (!ParseCharacterEscape(c, &ch)) {
+        return false;
+      }
+      return ParseCharacter(ch);
+    }
+  }
+}
+
+
+bool SimpleRegExpCompiler::ParseCharacter(int32_t c) {
+  if (ignore_case_) {
+    // jscre folds non-ASCII characters using the Unicode tables.
+    if (c >= 128) {
+      return false;
+    }
+    if (IsAsciiLetter(c)) {
+      return ParseQuantifier(kCharIgnoreCase, c | 0x20);
+    }
+  }
+  return ParseQuantifier(kChar, c);
+}
+
+
+bool SimpleRegExpCompiler::ParseCharacterEscape(int32_t c, int32_t* result) {
+  switch (c) {
+    case 't': *result = '\t'; return true;
+    case 'n': *result = '\n'; return true;
+    case 'r': *result = '\r'; return true;
+    case 'f': *result = '\f'; return true;
+    case 'v': *result = '\v'; return true;
+    case 'x': return ParseHex(2, result);
+    case 'u': return ParseHex(4, result);
+    default:
+      // Back references, octal and control escapes are left to jscre.
+      if ((c >= 128) || IsWordCharacter(c)) {
+        return false;
+      }
+      *result = c;
+      return true;
+  }
+}
+
+
+bool SimpleRegExpCompiler::ParseHex(intptr_t num_digits, int32_t* result) {
+  int32_t value = 0;
+  for (intptr_t i = 0; i < num_digits; i++) {
+    if (AtEnd()) {
+      return false;
+    }
+    const int32_t c = Next();
+    if ((c >= 128) || !Utils::IsHexDigit(static_cast<char>(c))) {
+      return false;
+    }
+    value = (value << 4) | Utils::HexDigitToInt(static_cast<char>(c));
+  }
+  *result = value;
+  return true;
+}
+
+
+bool SimpleRegExpCompiler::ParseClass(bool* negated) {
+  ranges_.Clear();
+  if (!AtEnd() && (Peek() == '^')) {
+    Next();
+    *negated = true;
+  }
+  // Leave the empty classes [] and [^] to jscre.
+  if (AtEnd() || (Peek() == ']')) {
+    return false;
+  }
+  while (!AtEnd()) {
+    const int32_t c = Next();
+    if (c == ']') {
+      return true;
+    }
+    int32_t from = 0;
+    if (!ParseClassAtom(c, &from)) {
+      return false;
+    }
+    if (from < 0) {
+      // A class escape like \d, a following '-' is a literal.
+      continue;
+    }
+    int32_t to = from;
+    if ((position_ + 1 < pattern_.Length()) &&
+        (Peek() == '-') &&
+        (pattern_.CharAt(position_ + 1) != ']')) {
+      Next();
+      if (!ParseClassAtom(Next(), &to) || (to < from)) {
+        return false;
+      }
+    }
+    if (ignore_case_ && (to >= 128)) {
+      return false;
+    }
+    AddRange(from, to);
+  }
+  // Unterminated class.
+  return false;
+}
+
+
+// Sets 'result' to the character denoted by 'c' and what follows it in a
+// character class, or to -1 after adding the ranges of a class escape.
+bool SimpleRegExpCompiler::ParseClassAtom(int32_t c, int32_t* result) {
+  if (c == '[') {
+    return false;
+  }
+  if (c != '\\') {
+    *result = c;
+    return true;
+  }
+  if (AtEnd()) {
+    return false;
+  }
+  c = Next();
+  switch (c) {
+    case 'd':
+    case 'D':
+    case 'w':
+    case 'W':
+    case 's':
+    case 'S':
+      AddClassEscape(c);
+      *result = -1;
+      return true;
+    case 'b':
+      *result = '\b';
+      return true;
+    default:
+      return ParseCharacterEscape(c, result);
+  }
+}
+
+
+bool SimpleRegExpCompiler::ParseQuantifier(TermKind kind, intptr_t value) {
+  intptr_t min = 1;
+  intptr_t max = 1;
+  bool greedy = true;
+  if (!AtEnd()) {
+    bool is_quantified = true;
+    switch (Peek()) {
+      case '*':
+        Next();
+        min = 0;
+        max = kUnbounded;
+        break;
+      case '+':
+        Next();
+        max = kUnbounded;
+        break;
+      case '?':
+        Next();
+        min = 0;
+        break;
+      case '{':
+        if (!ParseRepetition(&min, &max)) {
+          return false;
+        }
+        break;
+      default:
+        is_quantified = false;
+        break;
+    }
+    if (is_quantified && !AtEnd() && (Peek() == '?')) {
+      Next();
+      greedy = false;
+    }
+  }
+  if ((min != max) && (++num_variable_terms_ > kMaxVariableTerms)) {
+    return false;
+  }
+  AddTerm(kind, value, min, max, greedy);
+  return true;
+}
+
+
+// Parses {n}, {n,} and {n,m}.
+bool SimpleRegExpCompiler::ParseRepetition(intptr_t* min, intptr_t* max) {
+  ASSERT(Peek() == '{');
+  Next();
+  if (!ParseDecimal(min) || AtEnd()) {
+    return false;
+  }
+  if (Peek() == '}') {
+    Next();
+    *max = *min;
+    return true;
+  }
+  if (Next() != ',' || AtEnd()) {
+    return false;
+  }
+  if (Peek() == '}') {
+    Next();
+    *max = kUnbounded;
+    return true;
+  }
+  if (!ParseDecimal(max) || AtEnd() || (Next() != '}')) {
+    return false;
+  }
+  return *min <= *max;
+}
+
+
+bool SimpleRegExpCompiler::ParseDecimal(intptr_t* result) {
+  intptr_t value = 0;
+  intptr_t num_digits = 0;
+  while (!AtEnd() && (Peek() >= '0') && (Peek() <= '9')) {
+    value = value * 10 + (Next() - '0');
+    if (value > kMaxRepetition) {
+      return false;
+    }
+    num_digits++;
+  }
+  *result = value;
+  return num_digits > 0;
+}
+
+
+void SimpleRegExpCompiler::AddTerm(TermKind kind,
+                                   intptr_t value,
+                                   intptr_t min,
+                                   intptr_t max,
+                                   bool greedy) {
+  terms_.Add(kind | (greedy ? 0x100 : 0));
+  terms_.Add(value);
+  terms_.Add(min);
+  terms_.Add(max);
+}
+
+
+void SimpleRegExpCompiler::AddRange(int32_t from, int32_t to) {
+  CharacterRange range;
+  range.from = from;
+  range.to = to;
+  ranges_.Add(range);
+}
+
+
+void SimpleRegExpCompiler::AddClassEscape(int32_t c) {
+  switch (c) {
+    case 'd':
+      AddRange('0', '9');
+      break;
+    case 'D':
+      AddRange(0, '0' - 1);
+      AddRange('9' + 1, 0xFFFF);
+      break;
+    case 'w':
+      AddRange('0', '9');
+      AddRange('A', 'Z');
+      AddRange('_', '_');
+      AddRange('a', 'z');
+      break;
+    case 'W':
+      AddRange(0, '0' - 1);
+      AddRange('9' + 1, 'A' - 1);
+      AddRange('Z' + 1, '_' - 1);
+      AddRange('_' + 1, 'a' - 1);
+      AddRange('z' + 1, 0xFFFF);
+      break;
+    case 's':
+      // As in jscre, only ASCII white space.
+      AddRange('\t', '\r');
+      AddRange(' ', ' ');
+      break;
+    case 'S':
+      AddRange(0, '\t' - 1);
+      AddRange('\r' + 1, ' ' - 1);
+      AddRange(' ' + 1, 0xFFFF);
+      break;
+    default:
+      UNREACHABLE();
+  }
+}
+
+
+// Adds the other case of the letters in both [from, to] and [lo, hi].
+void SimpleRegExpCompiler::AddCaseRange(int32_t from,
+                                        int32_t to,
+                                        int32_t lo,
+                                        int32_t hi) {
+  from = Utils::Maximum(from, lo);
+  to = Utils::Minimum(to, hi);
+  if (from <= to) {
+    AddRange(from ^ 0x20, to ^ 0x20);
+  }
+}
+
+
+// Adds the character class made of ranges_ and returns its offset.
+intptr_t SimpleRegExpCompiler::AddClass(bool negated) {
+  if (ignore_case_) {
+    const intptr_t num_ranges = ranges_.length();
+    for (intptr_t i = 0; i < num_ranges; i++) {
+      const CharacterRange range = ranges_[i];
+      AddCaseRange(range.from, range.to, 'A', 'Z');
+      AddCaseRange(range.from, range.to, 'a', 'z');
+    }
+  }
+  const intptr_t offset = classes_.length();
+  for (intptr_t i = 0; i < kBitmapLength; i++) {
+    classes_.Add(0);
+  }
+  for (intptr_t i = 0; i < ranges_.length(); i++) {
+    const int32_t to = Utils::Minimum(ranges_[i].to, 255);
+    for (int32_t c = ranges_[i].from; c <= to; c++) {
+      classes_[offset + (c >> 4)] |= (1 << (c & 15));
+    }
+  }
+  if (negated) {
+    for (intptr_t i = 0; i < kBitmapLength; i++) {
+      classes_[offset + i] = ~classes_[offset + i];
+    }
+  }
+  classes_.Add(negated ? 1 : 0);
+  const intptr_t count_index = classes_.length();
+  classes_.Add(0);
+  ranges_.Sort(CompareRanges);
+  intptr_t num_ranges = 0;
+  for (intptr_t i = 0; i < ranges_.length(); i++) {
+    const int32_t from = Utils::Maximum(ranges_[i].from, 256);
+    const int32_t to = ranges_[i].to;
+    if (from > to) {
+      continue;
+    }
+    if ((num_ranges > 0) && (from <= classes_.Last() + 1)) {
+      // Merge with the previous range.
+      classes_.Last() = Utils::Maximum(static_cast<int32_t>(classes_.Last()),
+                                       to);
+    } else {
+      classes_.Add(from);
+      classes_.Add(to);
+      num_ranges++;
+    }
+  }
+  classes_[count_index] = num_ranges;
+  return offset;
+}
+
+
+template<typename CharType>
+class SimpleRegExpMatcher : public ValueObject {
+ public:
+  SimpleRegExpMatcher(const uint16_t* program,
+                      const CharType* subject,
+                      intptr_t length)
+      : program_(program),
+        num_terms_(program[0]),
+        subject_(subject),
+        length_(length),
+        steps_(0) { }
+
+  intptr_t num_terms() const { return num_terms_; }
+
+  const uint16_t* Term(intptr_t index) const {
+    return &program_[1 + index * kTermSize];
+  }
+
+  static TermKind Kind(const uint16_t* term) {
+    return static_cast<TermKind>(term[0] & 0xFF);
+  }
+
+  bool MatchesAtom(const uint16_t* term, int32_t c) const {
+    switch (Kind(term)) {
+      case kChar:
+        return c == term[1];
+      case kCharIgnoreCase:
+        return (c | 0x20) == term[1];
+      case kClass:
+        return ClassContains(&program_[term[1]], c);
+      default:
+        UNREACHABLE();
+        return false;
+    }
+  }
+
+  // Returns the end of the match of the terms from 'term_index' on at
+  // 'position', or -1 if there is none.
+  intptr_t MatchFrom(intptr_t term_index, intptr_t position);
+
+  void ResetLimit() { steps_ = 0; }
+  bool hit_limit() const { return steps_ > kMatchLimit; }
+
+ private:
+  static bool ClassContains(const uint16_t* cls, int32_t c) {
+    if (c < 256) {
+      return ((cls[c >> 4] >> (c & 15)) & 1) != 0;
+    }
+    const bool negated = cls[kBitmapLength] != 0;
+    const intptr_t num_ranges = cls[kBitmapLength + 1];
+    const uint16_t* ranges = &cls[kBitmapLength + 2];
+    for (intptr_t i = 0; i < num_ranges; i++) {
+      if (c < ranges[2 * i]) {
+        break;
+      }
+      if (c <= ranges[2 * i + 1]) {
+        return !negated;
+      }
+    }
+    return negated;
+  }
+
+  bool AssertionHolds(TermKind kind, intptr_t position) const {
+    switch (kind) {
+      case kStart:
+        return position == 0;
+      case kLineStart:
+        return (position == 0) || IsNewline(subject_[position - 1]);
+      case kEnd:
+        return position == length_;
+      case kLineEnd:
+        return (position == length_) || IsNewline(subject_[position]);
+      case kWordBoundary:
+      case kNotWordBoundary: {
+        const bool before =
+            (position > 0) && IsWordCharacter(subject_[position - 1]);
+        const bool after =
+            (position < length_) && IsWordCharacter(subject_[position]);
+        return (before != after) == (kind == kWordBoundary);
+      }
+      default:
+        UNREACHABLE();
+        return false;
+    }
+  }
+
+  const uint16_t* program_;
+  const intptr_t num_terms_;
+  const CharType* subject_;
+  const intptr_t length_;
+  intptr_t steps_;
+
+  DISALLOW_COPY_AND_ASSIGN(SimpleRegExpMatcher);
+};
+
+
+template<typename CharType>
+intptr_t SimpleRegExpMatcher<CharType>::MatchFrom(intptr_t term_index,
+                                                  intptr_t position) {
+  for (; term_index < num_terms_; term_index++) {
+    const uint16_t* term = Term(term_index);
+    const TermKind kind = Kind(term);
+    if (kind >= kStart) {
+      if (!AssertionHolds(kind, position)) {
+        return -1;
+      }
+      continue;
+    }
+    const intptr_t min = term[2];
+    const intptr_t max = term[3];
+    if (length_ - position < min) {
+      return -1;
+    }
+    for (intptr_t i = 0; i < min; i++) {
+      if (!MatchesAtom(term, subject_[position])) {
+        return -1;
+      }
+      position++;
+    }
+    if (min == max) {
+      continue;
+    }
+    intptr_t limit = length_ - position;
+    if ((max != kUnbounded) && (max - min < limit)) {
+      limit = max - min;
+    }
+    if ((term[0] >> 8) != 0) {
+      // Greedy: take as many characters as possible, then backtrack.
+      intptr_t count = 0;
+      while ((count < limit) && MatchesAtom(term, subject_[position + count])) {
+        count++;
+      }
+      for (; count >= 0; count--) {
+        if (++steps_ > kMatchLimit) {
+          return -1;
+        }
+        const intptr_t end = MatchFrom(term_index + 1, position + count);
+        if ((end >= 0) || hit_limit()) {
+          return end;
+        }
+      }
+    } else {
+      for (intptr_t count = 0; ; count++) {
+        if (++steps_ > kMatchLimit) {
+          return -1;
+        }
+        const intptr_t end = MatchFrom(term_index + 1, position + count);
+        if ((end >= 0) || hit_limit()) {
+          return end;
+        }
+        if ((count == limit) ||
+            !MatchesAtom(term, subject_[position + count])) {
+          break;
+        }
+      }
+    }
+    return -1;
+  }
+  return position;
+}
+
+
+template<typename CharType>
+bool SimpleRegExp::Search(const uint16_t* program,
+                          const CharType* subject,
+                          intptr_t length,
+                          intptr_t index,
+                          intptr_t* match_start,
+                          intptr_t* match_end) {
+  SimpleRegExpMatcher<CharType> matcher(program, subject, length);
+  bool anchored = false;
+  bool scan_first = false;
+  const uint16_t* first = NULL;
+  if (matcher.num_terms() > 0) {
+    first = matcher.Term(0);
+    const TermKind kind = SimpleRegExpMatcher<CharType>::Kind(first);
+    anchored = (kind == kStart);
+    // Only positions where the first term matches need to be tried.
+    scan_first = (kind < kStart) && (first[2] > 0);
+  }
+  for (intptr_t start = index; start <= length; start++) {
+    if (anchored && (start > 0)) {
+      return false;
+    }
+    if (scan_first) {
+      while ((start < length) && !matcher.MatchesAtom(first, subject[start])) {
+        start++;
+      }
+      if (start == length) {
+        return false;
+      }
+    }
+    matcher.ResetLimit();
+    const intptr_t end = matcher.MatchFrom(0, start);
+    if (end >= 0) {
+      *match_start = start;
+      *match_end = end;
+      return true;
+    }
+    if (matcher.hit_limit()) {
+      // jscre also gives up on the whole match in this case.
+      return false;
+    }
+  }
+  return false;
+}
+
+
+RawJSRegExp* SimpleRegExp::Compile(const String& pattern,
+                                   bool multi_line,
+                                   bool ignore_case) {
+  if (!FLAG_simple_regexp) {
+    return JSRegExp::null();
+  }
+  SimpleRegExpCompiler compiler(pattern, multi_line, ignore_case);
+  if (!compiler.Compile()) {
+    return JSRegExp::null();
+  }
+  const intptr_t length = compiler.ProgramLength();
+  const JSRegExp& regexp =
+      JSRegExp::Handle(JSRegExp::New(length * sizeof(uint16_t)));
+  {
+    NoGCScope no_gc;
+    compiler.WriteProgram(
+        reinterpret_cast<uint16_t*>(regexp.GetDataStartAddress()));
+  }
+  regexp.set_pattern(pattern);
+  if (multi_line) {
+    regexp.set_is_multi_line();
+  }
+  if (ignore_case) {
+    regexp.set_is_ignore_case();
+  }
+  // A Dart regexp is always global.
+  regexp.set_is_global();
+  regexp.set_is_simple();
+  regexp.set_num_bracket_expressions(0);
+  return regexp.raw();
+}
+
+
+RawArray* SimpleRegExp::Execute(const JSRegExp& regex,
+                                const String& str,
+                                intptr_t index) {
+  ASSERT(regex.is_simple());
+  const String& subject = String::Handle(
+      str.IsConsString() ? ConsString::Flatten(str) : str.raw());
+  const intptr_t length = subject.Length();
+  intptr_t match_start = -1;
+  intptr_t match_end = -1;
+  bool found = false;
+  {
+    NoGCScope no_gc;
+    const uint16_t* program =
+        reinterpret_cast<const uint16_t*>(regex.GetDataStartAddress());
+    if (length == 0) {
+      found = Search<uint8_t>(program, NULL, 0, index,
+                              &match_start, &match_end);
+    } else if (subject.IsOneByteString()) {
+      found = Search<uint8_t>(program,
+                              OneByteString::CharAddr(subject, 0),
+                              length, index, &match_start, &match_end);
+    } else if (subject.IsTwoByteString()) {
+      found = Search<uint16_t>(program,
+                               TwoByteString::CharAddr(subject, 0),
+                               length, index, &match_start, &match_end);
+    } else if (subject.IsExternalOneByteString()) {
+      found = Search<uint8_t>(program,
+                              ExternalOneByteString::CharAddr(subject, 0),
+                              length, index, &match_start, &match_end);
+    } else {
+      ASSERT(subject.IsExternalTwoByteString());
+      found = Search<uint16_t>(program,
+                               ExternalTwoByteString::CharAddr(subject, 0),
+                               length, index, &match_start, &match_end);
+    }
+  }
+  if (!found) {
+    return Array::null();
+  }
+  const intptr_t kMatchPair = 2;
+  const Array& array = Array::Handle(Array::New(kMatchPair));
+  array.SetAt(0, Smi::Handle(Smi::New(match_start)));
+  array.SetAt(1, Smi::Handle(Smi::New(match_end)));
+  return array.raw();
+}
+
+}  // namespace dart
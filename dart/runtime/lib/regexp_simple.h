@@ -0,0 +1,40 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef LIB_REGEXP_SIMPLE_H_
+#define LIB_REGEXP_SIMPLE_H_
+
+#include "vm/object.h"
+
+
+namespace dart {
+
+// Matcher for regular expressions without groups, alternatives or back
+// references. Such patterns are compiled to a small program that is executed
+// directly on the characters of one-byte and two-byte strings, whereas the
+// jscre library needs every subject converted to UTF-16 first.
+class SimpleRegExp : public AllStatic {
+ public:
+  // Returns JSRegExp::null() if the pattern uses syntax not handled here, in
+  // which case it has to be compiled by jscre.
+  static RawJSRegExp* Compile(const String& pattern,
+                              bool multi_line,
+                              bool ignore_case);
+  static RawArray* Execute(const JSRegExp& regex,
+                           const String& str,
+                           intptr_t index);
+
+ private:
+  template<typename CharType>
+  static bool Search(const uint16_t* program,
+                     const CharType* subject,
+                     intptr_t length,
+                     intptr_t index,
+                     intptr_t* match_start,
+                     intptr_t* match_end);
+};
+
+}  // namespace dart
+
+#endif  // LIB_REGEXP_SIMPLE_H_
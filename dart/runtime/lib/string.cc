@@ -195,7 +195,14 @@ DEFINE_NATIVE_ENTRY(String_codeUnitAt, 2) {
 DEFINE_NATIVE_ENTRY(String_concat, 2) {
   const String& receiver = String::CheckedHandle(arguments->NativeArgAt(0));
   GET_NON_NULL_NATIVE_ARGUMENT(String, b, arguments->NativeArgAt(1));
-  return String::Concat(receiver, b);
+  return ConsString::Concat(receiver, b);
+}
+
+
+DEFINE_NATIVE_ENTRY(ConsString_flatten, 1) {
+  const String& receiver = String::CheckedHandle(arguments->NativeArgAt(0));
+  ASSERT(receiver.IsConsString());
+  return ConsString::Flatten(receiver);
 }
 
 
@@ -140,6 +140,12 @@ class _StringBase {
     if ((start < 0) || (start >= this.length)) {
       return -1;
     }
+    return _indexOf(other, start);
+  }
+
+  // Searches for the non-empty string 'other' starting at the valid index
+  // 'start'. Intrinsified for one-byte strings.
+  int _indexOf(String other, int start) {
     int len = this.length - other.length + 1;
     for (int index = start; index < len; index++) {
       if (_substringMatches(index, other)) {
@@ -627,6 +633,52 @@ class _ExternalTwoByteString extends _StringBase implements String {
 }
 
 
+class _ConsString extends _StringBase implements String {
+  factory _ConsString._uninstantiable() {
+    throw new UnsupportedError(
+        "_ConsString can only be allocated by the VM");
+  }
+
+  // Returns a flat string with the same characters. The characters are only
+  // copied by the first call, the VM keeps the flat string for later ones.
+  String _flatten() native "ConsString_flatten";
+
+  static String _flat(String str) {
+    return (str is _ConsString) ? str._flatten() : str;
+  }
+
+  String operator [](int index) => _flatten()[index];
+
+  int codeUnitAt(int index) => _flatten().codeUnitAt(index);
+
+  bool operator ==(Object other) {
+    if (identical(this, other)) {
+      return true;
+    }
+    return (other is String) && (_flatten() == _flat(other));
+  }
+
+  int compareTo(String other) => _flatten().compareTo(_flat(other));
+
+  bool _substringMatches(int start, String other) {
+    return _flatten()._substringMatches(start, _flat(other));
+  }
+
+  int _indexOf(String other, int start) {
+    return _flatten()._indexOf(_flat(other), start);
+  }
+
+  // Checks for one-byte whitespaces only.
+  // TODO(srdjan): Investigate if 0x85 (NEL) and 0xA0 (NBSP) are valid
+  // whitespaces. Add checking for multi-byte whitespace codepoints.
+  bool _isWhitespace(int codePoint) {
+    return
+      (codePoint == 32) || // Space.
+      ((9 <= codePoint) && (codePoint <= 13)); // CR, LF, TAB, etc.
+  }
+}
+
+
 class _ExternalFourByteString extends _StringBase implements String {
   factory _ExternalFourByteString._uninstantiable() {
     throw new UnsupportedError(
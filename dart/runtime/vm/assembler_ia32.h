@@ -443,6 +443,7 @@ class Assembler : public ValueObject {
 
   void movmskpd(Register dst, XmmRegister src);
   void movmskps(Register dst, XmmRegister src);
+  void pmovmskb(Register dst, XmmRegister src);
 
   void sqrtsd(XmmRegister dst, XmmRegister src);
   void sqrtss(XmmRegister dst, XmmRegister src);
@@ -457,6 +458,8 @@ class Assembler : public ValueObject {
 
   void orpd(XmmRegister dst, XmmRegister src);
 
+  void pcmpeqb(XmmRegister dst, XmmRegister src);
+
   void pextrd(Register dst, XmmRegister src, const Immediate& imm);
   void pmovsxdq(XmmRegister dst, XmmRegister src);
   void pcmpeqq(XmmRegister dst, XmmRegister src);
@@ -571,6 +574,8 @@ class Assembler : public ValueObject {
   void negl(Register reg);
   void notl(Register reg);
 
+  void bsfl(Register dst, Register src);
+
   void enter(const Immediate& imm);
   void leave();
 
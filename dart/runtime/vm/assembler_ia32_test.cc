@@ -359,6 +359,19 @@ ASSEMBLER_TEST_RUN(Bitwise, test) {
 }
 
 
+ASSEMBLER_TEST_GENERATE(BitScanForward, assembler) {
+  __ movl(ECX, Immediate(0x1200));
+  __ bsfl(EAX, ECX);
+  __ ret();
+}
+
+
+ASSEMBLER_TEST_RUN(BitScanForward, test) {
+  typedef int (*BitScanForward)();
+  EXPECT_EQ(9, reinterpret_cast<BitScanForward>(test->entry())());
+}
+
+
 ASSEMBLER_TEST_GENERATE(LogicalOps, assembler) {
   Label donetest1;
   __ movl(EAX, Immediate(4));
@@ -2353,6 +2366,24 @@ ASSEMBLER_TEST_RUN(ExtractSignBits, test) {
 }
 
 
+ASSEMBLER_TEST_GENERATE(CompareBytes, assembler) {
+  __ movl(ECX, Immediate(0x11223344));
+  __ movd(XMM0, ECX);
+  __ movl(ECX, Immediate(0x11AA3344));
+  __ movd(XMM1, ECX);
+  __ pcmpeqb(XMM0, XMM1);
+  __ pmovmskb(EAX, XMM0);
+  __ ret();
+}
+
+
+ASSEMBLER_TEST_RUN(CompareBytes, test) {
+  typedef int (*CompareBytes)();
+  // Only byte 2 differs, the upper 12 bytes are zero in both registers.
+  EXPECT_EQ(0xFFFB, reinterpret_cast<CompareBytes>(test->entry())());
+}
+
+
 // Return -1 if signed, 1 if not signed and 0 otherwise.
 ASSEMBLER_TEST_GENERATE(ConditionalMovesSign, assembler) {
   // Preserve clobbered callee-saved register (EBX).
@@ -691,6 +691,42 @@ void Assembler::andps(XmmRegister dst, const Address& src) {
 }
 
 
+void Assembler::andpd(XmmRegister dst, XmmRegister src) {
+  ASSERT(dst <= XMM15);
+  ASSERT(src <= XMM15);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitUint8(0x66);
+  EmitREX_RB(dst, src);
+  EmitUint8(0x0F);
+  EmitUint8(0x54);
+  EmitXmmRegisterOperand(dst & 7, src);
+}
+
+
+void Assembler::orpd(XmmRegister dst, XmmRegister src) {
+  ASSERT(dst <= XMM15);
+  ASSERT(src <= XMM15);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitUint8(0x66);
+  EmitREX_RB(dst, src);
+  EmitUint8(0x0F);
+  EmitUint8(0x56);
+  EmitXmmRegisterOperand(dst & 7, src);
+}
+
+
+void Assembler::pcmpeqb(XmmRegister dst, XmmRegister src) {
+  ASSERT(dst <= XMM15);
+  ASSERT(src <= XMM15);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitUint8(0x66);
+  EmitREX_RB(dst, src);
+  EmitUint8(0x0F);
+  EmitUint8(0x74);
+  EmitXmmRegisterOperand(dst & 7, src);
+}
+
+
 void Assembler::orps(XmmRegister dst, XmmRegister src) {
   AssemblerBuffer::EnsureCapacity ensured(&buffer_);
   EmitREX_RB(dst, src);
@@ -892,6 +928,17 @@ void Assembler::movmskps(Register dst, XmmRegister src) {
 }
 
 
+void Assembler::pmovmskb(Register dst, XmmRegister src) {
+  ASSERT(src <= XMM15);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitUint8(0x66);
+  EmitREX_RB(dst, src);
+  EmitUint8(0x0F);
+  EmitUint8(0xD7);
+  EmitXmmRegisterOperand(dst & 7, src);
+}
+
+
 void Assembler::sqrtsd(XmmRegister dst, XmmRegister src) {
   ASSERT(dst <= XMM15);
   ASSERT(src <= XMM15);
@@ -1722,6 +1769,16 @@ void Assembler::notl(Register reg) {
 }
 
 
+void Assembler::bsfl(Register dst, Register src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  Operand operand(src);
+  EmitOperandREX(dst, operand, REX_NONE);
+  EmitUint8(0x0F);
+  EmitUint8(0xBC);
+  EmitOperand(dst & 7, operand);
+}
+
+
 void Assembler::notq(Register reg) {
   AssemblerBuffer::EnsureCapacity ensured(&buffer_);
   EmitRegisterREX(reg, REX_W);
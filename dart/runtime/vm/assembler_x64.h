@@ -539,6 +539,8 @@ class Assembler : public ValueObject {
   void negl(Register reg);
   void negq(Register reg);
   void notl(Register reg);
+
+  void bsfl(Register dst, Register src);
   void notq(Register reg);
 
   void enter(const Immediate& imm);
@@ -547,6 +549,7 @@ class Assembler : public ValueObject {
 
   void movmskpd(Register dst, XmmRegister src);
   void movmskps(Register dst, XmmRegister src);
+  void pmovmskb(Register dst, XmmRegister src);
 
   void sqrtsd(XmmRegister dst, XmmRegister src);
 
@@ -557,6 +560,11 @@ class Assembler : public ValueObject {
   void xorps(XmmRegister dst, XmmRegister src);
 
   void andpd(XmmRegister dst, const Address& src);
+  void andpd(XmmRegister dst, XmmRegister src);
+
+  void orpd(XmmRegister dst, XmmRegister src);
+
+  void pcmpeqb(XmmRegister dst, XmmRegister src);
 
   void fldl(const Address& src);
   void fstpl(const Address& dst);
@@ -629,6 +629,19 @@ ASSEMBLER_TEST_RUN(Bitwise, test) {
 }
 
 
+ASSEMBLER_TEST_GENERATE(BitScanForward, assembler) {
+  __ movl(RCX, Immediate(0x1200));
+  __ bsfl(RAX, RCX);
+  __ ret();
+}
+
+
+ASSEMBLER_TEST_RUN(BitScanForward, test) {
+  typedef int (*BitScanForward)();
+  EXPECT_EQ(9, reinterpret_cast<BitScanForward>(test->entry())());
+}
+
+
 ASSEMBLER_TEST_GENERATE(Bitwise64, assembler) {
   Label error;
   __ movq(RAX, Immediate(42));
@@ -2274,6 +2287,38 @@ ASSEMBLER_TEST_RUN(DoubleAbs, test) {
 }
 
 
+ASSEMBLER_TEST_GENERATE(DoubleOrpd, assembler) {
+  __ orpd(XMM0, XMM1);
+  __ ret();
+}
+
+
+ASSEMBLER_TEST_RUN(DoubleOrpd, test) {
+  typedef double (*DoubleOrpdCode)(double a, double b);
+  double res = reinterpret_cast<DoubleOrpdCode>(test->entry())(0.0, -0.0);
+  EXPECT_EQ(0.0, res);
+  EXPECT(1.0 / res < 0.0);
+  res = reinterpret_cast<DoubleOrpdCode>(test->entry())(12.5, 12.5);
+  EXPECT_EQ(12.5, res);
+}
+
+
+ASSEMBLER_TEST_GENERATE(DoubleAndpd, assembler) {
+  __ andpd(XMM0, XMM1);
+  __ ret();
+}
+
+
+ASSEMBLER_TEST_RUN(DoubleAndpd, test) {
+  typedef double (*DoubleAndpdCode)(double a, double b);
+  double res = reinterpret_cast<DoubleAndpdCode>(test->entry())(-0.0, 0.0);
+  EXPECT_EQ(0.0, res);
+  EXPECT(1.0 / res > 0.0);
+  res = reinterpret_cast<DoubleAndpdCode>(test->entry())(-12.5, -12.5);
+  EXPECT_EQ(-12.5, res);
+}
+
+
 ASSEMBLER_TEST_GENERATE(ExtractSignBits, assembler) {
   __ movmskpd(RAX, XMM0);
   __ andq(RAX, Immediate(0x1));
@@ -2292,6 +2337,24 @@ ASSEMBLER_TEST_RUN(ExtractSignBits, test) {
 }
 
 
+ASSEMBLER_TEST_GENERATE(CompareBytes, assembler) {
+  __ movl(RCX, Immediate(0x11223344));
+  __ movd(XMM0, RCX);
+  __ movl(RCX, Immediate(0x11AA3344));
+  __ movd(XMM1, RCX);
+  __ pcmpeqb(XMM0, XMM1);
+  __ pmovmskb(RAX, XMM0);
+  __ ret();
+}
+
+
+ASSEMBLER_TEST_RUN(CompareBytes, test) {
+  typedef int (*CompareBytes)();
+  // Only byte 2 differs, the upper 12 bytes are zero in both registers.
+  EXPECT_EQ(0xFFFB, reinterpret_cast<CompareBytes>(test->entry())());
+}
+
+
 ASSEMBLER_TEST_GENERATE(TestSetCC, assembler) {
   __ movq(RAX, Immediate(0xFFFFFFFF));
   __ cmpq(RAX, RAX);
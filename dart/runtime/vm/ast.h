@@ -1585,14 +1585,16 @@ class CatchClauseNode : public AstNode {
                   const Array& handler_types,
                   const LocalVariable* context_var,
                   const LocalVariable* exception_var,
-                  const LocalVariable* stacktrace_var)
+                  const LocalVariable* stacktrace_var,
+                  bool needs_stacktrace)
       : AstNode(token_pos),
         try_index_(kInvalidTryIndex),
         catch_block_(catch_block),
         handler_types_(handler_types),
         context_var_(*context_var),
         exception_var_(*exception_var),
-        stacktrace_var_(*stacktrace_var) {
+        stacktrace_var_(*stacktrace_var),
+        needs_stacktrace_(needs_stacktrace) {
     ASSERT(catch_block_ != NULL);
     ASSERT(handler_types.IsZoneHandle());
     ASSERT(context_var != NULL);
@@ -1610,6 +1612,9 @@ class CatchClauseNode : public AstNode {
   const LocalVariable& context_var() const { return context_var_; }
   const LocalVariable& exception_var() const { return exception_var_; }
   const LocalVariable& stacktrace_var() const { return stacktrace_var_; }
+  // True if a catch clause binds the stack trace or the exception may be
+  // rethrown.
+  bool needs_stacktrace() const { return needs_stacktrace_; }
 
   virtual void VisitChildren(AstNodeVisitor* visitor) const {
     catch_block_->Visit(visitor);
@@ -1624,6 +1629,7 @@ class CatchClauseNode : public AstNode {
   const LocalVariable& context_var_;
   const LocalVariable& exception_var_;
   const LocalVariable& stacktrace_var_;
+  const bool needs_stacktrace_;
 
   DISALLOW_COPY_AND_ASSIGN(CatchClauseNode);
 };
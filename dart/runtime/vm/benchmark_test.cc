@@ -8,6 +8,7 @@
 
 #include "platform/assert.h"
 
+#include "vm/bigint_operations.h"
 #include "vm/dart_api_impl.h"
 #include "vm/stack_frame.h"
 #include "vm/unit_test.h"
@@ -187,6 +188,144 @@ BENCHMARK(UseDartApi) {
 }
 
 
+// Same computation as UseDartApi, but without entering a scope and using
+// the primitive argument accessors and return values.
+static void UseDartApiNoScope(Dart_NativeArguments args) {
+  static const Dart_NativeArgument_Descriptor kDescriptors[] = {
+    { Dart_NativeArgument_kNativeFields, 0 },
+    { Dart_NativeArgument_kInt64, 1 },
+  };
+  intptr_t field = 0;
+  Dart_NativeArgument_Value values[2];
+  values[0].as_native_fields.num_fields = 1;
+  values[0].as_native_fields.values = &field;
+  EXPECT_VALID(Dart_GetNativeArguments(args, 2, kDescriptors, values));
+  EXPECT_LE(0, values[1].as_int64);
+  EXPECT_LE(values[1].as_int64, 1000000);
+  EXPECT_EQ(7, field);
+
+  // Return param + receiver.field.
+  Dart_SetIntegerReturnValue(args, values[1].as_int64 * field);
+}
+
+
+static Dart_NativeFunction bm_uda_noscope_lookup(Dart_Handle name,
+                                                 int argument_count) {
+  const char* cstr = NULL;
+  Dart_Handle result = Dart_StringToCString(name, &cstr);
+  EXPECT_VALID(result);
+  if (strcmp(cstr, "init") == 0) {
+    return InitNativeFields;
+  } else {
+    return UseDartApiNoScope;
+  }
+}
+
+
+BENCHMARK(UseDartApiNoScope) {
+  const int kNumIterations = 1000000;
+  const char* kScriptChars =
+      "class Class extends NativeFieldsWrapper{\n"
+      "  int init() native 'init';\n"
+      "  int method(int param1, int param2) native 'method';\n"
+      "}\n"
+      "\n"
+      "void benchmark(int count) {\n"
+      "  Class c = new Class();\n"
+      "  c.init();\n"
+      "  for (int i = 0; i < count; i++) {\n"
+      "    c.method(i,7);\n"
+      "  }\n"
+      "}\n";
+
+  Dart_Handle lib = TestCase::LoadTestScript(
+      kScriptChars,
+      reinterpret_cast<Dart_NativeEntryResolver>(bm_uda_noscope_lookup));
+
+  // Create a native wrapper class with native fields.
+  Dart_Handle result = Dart_CreateNativeWrapperClass(
+      lib, NewString("NativeFieldsWrapper"), 1);
+  EXPECT_VALID(result);
+
+  Dart_Handle args[1];
+  args[0] = Dart_NewInteger(kNumIterations);
+
+  // Warmup first to avoid compilation jitters.
+  Dart_Invoke(lib, NewString("benchmark"), 1, args);
+
+  Timer timer(true, "UseDartApiNoScope benchmark");
+  timer.Start();
+  Dart_Invoke(lib, NewString("benchmark"), 1, args);
+  timer.Stop();
+  int64_t elapsed_time = timer.TotalElapsedTime();
+  benchmark->set_score(elapsed_time);
+}
+
+
+//
+// Measure calling a Dart method from C++ through the dart api, looking it up
+// on every call or using a prepared invocation.
+//
+static const char* kInvokeScriptChars =
+    "class Callback {\n"
+    "  int total = 0;\n"
+    "  int onEvent(int value) => total += value;\n"
+    "}\n"
+    "\n"
+    "Callback newCallback() => new Callback();\n";
+
+
+BENCHMARK(UseDartApiInvoke) {
+  const int kNumIterations = 1000000;
+  Dart_Handle lib = TestCase::LoadTestScript(kInvokeScriptChars, NULL);
+  Dart_Handle callback = Dart_Invoke(lib, NewString("newCallback"), 0, NULL);
+  EXPECT_VALID(callback);
+  Dart_Handle name = NewString("onEvent");
+  Dart_Handle args[1];
+
+  Timer timer(true, "UseDartApiInvoke benchmark");
+  timer.Start();
+  for (int i = 0; i < kNumIterations; i++) {
+    Dart_EnterScope();
+    args[0] = Dart_NewInteger(i);
+    EXPECT_VALID(Dart_Invoke(callback, name, 1, args));
+    Dart_ExitScope();
+  }
+  timer.Stop();
+  int64_t elapsed_time = timer.TotalElapsedTime();
+  benchmark->set_score(elapsed_time);
+}
+
+
+BENCHMARK(UseDartApiInvokePrepared) {
+  const int kNumIterations = 1000000;
+  Dart_Handle lib = TestCase::LoadTestScript(kInvokeScriptChars, NULL);
+  Dart_Handle callback = Dart_Invoke(lib, NewString("newCallback"), 0, NULL);
+  EXPECT_VALID(callback);
+  Dart_PreparedInvocation invocation = NULL;
+  Dart_Handle result = Dart_PrepareInvocation(callback,
+                                              NewString("onEvent"),
+                                              1,
+                                              Dart_Null(),
+                                              &invocation);
+  EXPECT_VALID(result);
+  Dart_Handle args[1];
+
+  Timer timer(true, "UseDartApiInvokePrepared benchmark");
+  timer.Start();
+  for (int i = 0; i < kNumIterations; i++) {
+    Dart_EnterScope();
+    args[0] = Dart_NewInteger(i);
+    EXPECT_VALID(Dart_InvokePrepared(invocation, callback, 1, args));
+    Dart_ExitScope();
+  }
+  timer.Stop();
+  Dart_DeletePreparedInvocation(invocation);
+  int64_t elapsed_time = timer.TotalElapsedTime();
+  benchmark->set_score(elapsed_time);
+}
+
+
 //
 // Measure time accessing internal and external strings.
 //
@@ -221,6 +360,202 @@ BENCHMARK(DartStringAccess) {
 }
 
 
+//
+// Measure the runtime part of inline cache misses at a call site that sees
+// many receiver classes: look up the receiver class, then add a check.
+//
+BENCHMARK(InlineCacheMiss) {
+  const int kNumIterations = 10000;
+  const intptr_t kNumClasses = 30;
+  Isolate* isolate = Isolate::Current();
+  HANDLESCOPE(isolate);
+  const String& name = String::Handle(Symbols::New("InlineCacheMiss"));
+  const Class& owner = Class::Handle(
+      Class::New(name, Script::Handle(), Scanner::kDummyTokenIndex));
+  const Function& target = Function::Handle(
+      Function::New(name, RawFunction::kRegularFunction,
+                    false,  // Not static.
+                    false,  // Not const.
+                    false,  // Not abstract.
+                    false,  // Not external.
+                    owner, 0));
+  Timer timer(true, "InlineCacheMiss benchmark");
+  timer.Start();
+  for (int i = 0; i < kNumIterations; i++) {
+    HANDLESCOPE(isolate);
+    const ICData& ic_data = ICData::Handle(
+        ICData::New(target, name, Isolate::kNoDeoptId, 1));
+    for (intptr_t cid = kNumPredefinedCids;
+         cid < kNumPredefinedCids + kNumClasses;
+         cid++) {
+      if (ic_data.GetTargetForReceiverClassId(cid) == Function::null()) {
+        ic_data.AddReceiverCheck(cid, target);
+      }
+    }
+    EXPECT_EQ(kNumClasses, ic_data.NumberOfChecks());
+  }
+  timer.Stop();
+  int64_t elapsed_time = timer.TotalElapsedTime();
+  benchmark->set_score(elapsed_time);
+}
+
+
+//
+// Measure regular expression matching on one-byte and two-byte subjects.
+//
+static const char* kRegExpScriptChars =
+    "String makeSubject(bool twoByte) {\n"
+    "  var words = ['alpha', 'beta', 'gamma42', 'x_y', 'delta7'];\n"
+    "  var buffer = new StringBuffer();\n"
+    "  for (int i = 0; i < 2000; i++) {\n"
+    "    buffer.write(words[i % words.length]);\n"
+    "    buffer.write((i % 7 == 0) ? '\\n' : ' ');\n"
+    "  }\n"
+    "  if (twoByte) buffer.write('\\u2603');\n"
+    "  return buffer.toString();\n"
+    "}\n"
+    "int benchmark(String pattern, bool twoByte, int count) {\n"
+    "  var re = new RegExp(pattern, multiLine: true);\n"
+    "  var subject = makeSubject(twoByte);\n"
+    "  int matches = 0;\n"
+    "  for (int i = 0; i < count; i++) {\n"
+    "    matches += re.allMatches(subject).length;\n"
+    "  }\n"
+    "  return matches;\n"
+    "}\n";
+
+
+static void RunRegExpBenchmark(Benchmark* benchmark,
+                               const char* name,
+                               const char* pattern,
+                               bool two_byte) {
+  const int kNumIterations = 100;
+  Dart_Handle lib = TestCase::LoadTestScript(kRegExpScriptChars, NULL);
+  EXPECT_VALID(lib);
+  Dart_Handle args[3];
+  args[0] = NewString(pattern);
+  args[1] = Dart_NewBoolean(two_byte);
+  args[2] = Dart_NewInteger(kNumIterations);
+
+  // Warmup first to avoid compilation jitters.
+  EXPECT_VALID(Dart_Invoke(lib, NewString("benchmark"), 3, args));
+
+  Timer timer(true, name);
+  timer.Start();
+  Dart_Handle result = Dart_Invoke(lib, NewString("benchmark"), 3, args);
+  timer.Stop();
+  EXPECT_VALID(result);
+  int64_t elapsed_time = timer.TotalElapsedTime();
+  benchmark->set_score(elapsed_time);
+}
+
+
+BENCHMARK(RegExpLiteral) {
+  RunRegExpBenchmark(benchmark, "RegExpLiteral benchmark", "gamma", false);
+}
+
+
+BENCHMARK(RegExpClasses) {
+  RunRegExpBenchmark(benchmark, "RegExpClasses benchmark",
+                     "\\b[a-z]+\\d\\b", false);
+}
+
+
+BENCHMARK(RegExpLineStart) {
+  RunRegExpBenchmark(benchmark, "RegExpLineStart benchmark",
+                     "^\\w+", false);
+}
+
+
+BENCHMARK(RegExpTwoByte) {
+  RunRegExpBenchmark(benchmark, "RegExpTwoByte benchmark",
+                     "\\w+_\\w+", true);
+}
+
+
+// Groups are matched by jscre.
+BENCHMARK(RegExpGroups) {
+  RunRegExpBenchmark(benchmark, "RegExpGroups benchmark",
+                     "(\\w+)_(\\w+)", false);
+}
+
+
+//
+// Measure multiplication, division and decimal conversion of bigints with
+// 20000 bits.
+//
+static RawBigint* NewBenchmarkBigint(intptr_t hex_digits, uint32_t seed) {
+  Zone* zone = Isolate::Current()->current_zone();
+  char* hex = zone->Alloc<char>(hex_digits + 3);
+  hex[0] = '0';
+  hex[1] = 'x';
+  for (intptr_t i = 0; i < hex_digits; i++) {
+    seed = seed * 1103515245 + 12345;
+    hex[i + 2] = "123456789ABCDEF"[(seed >> 16) % 15];
+  }
+  hex[hex_digits + 2] = '\0';
+  return BigintOperations::NewFromCString(hex);
+}
+
+
+BENCHMARK(BigintMultiply) {
+  const int kNumIterations = 100;
+  Isolate* isolate = Isolate::Current();
+  HANDLESCOPE(isolate);
+  const Bigint& a = Bigint::Handle(NewBenchmarkBigint(5000, 1));
+  const Bigint& b = Bigint::Handle(NewBenchmarkBigint(5000, 2));
+  Timer timer(true, "BigintMultiply benchmark");
+  timer.Start();
+  for (int i = 0; i < kNumIterations; i++) {
+    HANDLESCOPE(isolate);
+    const Bigint& product =
+        Bigint::Handle(BigintOperations::Multiply(a, b));
+    EXPECT(!product.IsZero());
+  }
+  timer.Stop();
+  int64_t elapsed_time = timer.TotalElapsedTime();
+  benchmark->set_score(elapsed_time);
+}
+
+
+BENCHMARK(BigintDivide) {
+  const int kNumIterations = 100;
+  Isolate* isolate = Isolate::Current();
+  HANDLESCOPE(isolate);
+  const Bigint& a = Bigint::Handle(NewBenchmarkBigint(10000, 3));
+  const Bigint& b = Bigint::Handle(NewBenchmarkBigint(5000, 4));
+  Timer timer(true, "BigintDivide benchmark");
+  timer.Start();
+  for (int i = 0; i < kNumIterations; i++) {
+    HANDLESCOPE(isolate);
+    const Bigint& quotient =
+        Bigint::Handle(BigintOperations::Divide(a, b));
+    EXPECT(!quotient.IsZero());
+  }
+  timer.Stop();
+  int64_t elapsed_time = timer.TotalElapsedTime();
+  benchmark->set_score(elapsed_time);
+}
+
+
+BENCHMARK(BigintToDecimal) {
+  const int kNumIterations = 20;
+  Isolate* isolate = Isolate::Current();
+  HANDLESCOPE(isolate);
+  const Bigint& a = Bigint::Handle(NewBenchmarkBigint(5000, 5));
+  Timer timer(true, "BigintToDecimal benchmark");
+  timer.Start();
+  for (int i = 0; i < kNumIterations; i++) {
+    StackZone zone(isolate);
+    const char* str = a.ToCString();
+    EXPECT(str[0] != '-');
+  }
+  timer.Stop();
+  int64_t elapsed_time = timer.TotalElapsedTime();
+  benchmark->set_score(elapsed_time);
+}
+
+
 //
 // Measure compile of all dart2js(compiler) functions.
 //
@@ -344,8 +344,9 @@ const char* BigintOperations::ToDecimalCString(
   int64_t bit_length = length * kDigitBitSize;
   ASSERT(bit_length > length);
   int64_t decimal_length = (bit_length * kLog2Dividend / kLog2Divisor) + 1;
-  // Add one byte for the trailing \0 character.
-  int64_t required_size = decimal_length + 1;
+  // The digits are printed in chunks of 8, so the most significant chunk may
+  // have up to 7 leading zeros. Add one byte for the trailing \0 character.
+  int64_t required_size = decimal_length + 7 + 1;
   if (bigint.IsNegative()) {
     required_size++;
   }
@@ -354,34 +355,43 @@ const char* BigintOperations::ToDecimalCString(
   char* result =
       reinterpret_cast<char*>(allocator(static_cast<intptr_t>(required_size)));
   ASSERT(result != NULL);
-  int result_pos = 0;
 
-  // We divide the input into pieces of ~27 bits which can be efficiently
-  // handled.
-  const intptr_t kChunkDivisor = 100000000;
-  const int kChunkDigits = 8;
-  ASSERT(pow(10.0, kChunkDigits) == kChunkDivisor);
-  ASSERT(static_cast<Chunk>(kChunkDivisor) < kDigitMaxValue);
-  ASSERT(Smi::IsValid(kChunkDivisor));
-  const Bigint& divisor = Bigint::Handle(NewFromInt64(kChunkDivisor));
-
-  // Rest contains the remaining bigint that needs to be printed.
-  Bigint& rest = Bigint::Handle(bigint.raw());
-  Bigint& quotient = Bigint::Handle();
-  Bigint& remainder = Bigint::Handle();
-  while (!rest.IsZero()) {
-    DivideRemainder(rest, divisor, &quotient, &remainder);
-    ASSERT(remainder.Length() <= 1);
-    intptr_t part = (remainder.Length() == 1)
-        ? static_cast<intptr_t>(remainder.GetChunkAt(0))
-        : 0;
-    for (int i = 0; i < kChunkDigits; i++) {
-      result[result_pos++] = '0' + (part % 10);
-      part /= 10;
+  // Convert the absolute value in a nested zone, which releases the scratch
+  // digits on return. Numbers with many digits are split recursively by
+  // powers 10^(8 * 2^k) so that most of the work is done by the subquadratic
+  // division.
+  StackZone zone(Isolate::Current());
+  Chunk* digits = AllocateDigits(length);
+  for (intptr_t i = 0; i < length; i++) {
+    digits[i] = bigint.GetChunkAt(i);
+  }
+  const intptr_t kMaxPowers = kBitsPerWord;
+  Chunk* powers[kMaxPowers];
+  intptr_t power_lengths[kMaxPowers];
+  intptr_t level = -1;
+  if (length >= kDecimalConversionThreshold) {
+    powers[0] = AllocateDigits(1);
+    powers[0][0] = 100000000;
+    power_lengths[0] = 1;
+    level = 0;
+    // Stop at the first power whose square is longer than the number.
+    while (2 * power_lengths[level] - 1 <= length) {
+      ASSERT(level + 1 < kMaxPowers);
+      const Chunk* power = powers[level];
+      intptr_t power_length = power_lengths[level];
+      intptr_t square_length = 2 * power_length;
+      Chunk* square = AllocateDigits(square_length);
+      MultiplyDigits(square, power, power_length, power, power_length);
+      while (square[square_length - 1] == 0) square_length--;
+      level++;
+      powers[level] = square;
+      power_lengths[level] = square_length;
     }
-    ASSERT(part == 0);
-    rest = quotient.raw();
   }
+  intptr_t result_pos = ToDecimalDigits(digits, length,
+                                        powers, power_lengths, level, 0,
+                                        result, 0);
+  ASSERT(result_pos < required_size);
   // Move the resulting position back until we don't have any zeroes anymore.
   // This is done so that we can remove all leading zeroes.
   while (result_pos > 1 && result[result_pos - 1] == '0') {
@@ -700,6 +710,9 @@ RawBigint* BigintOperations::Multiply(const Bigint& a, const Bigint& b) {
 
   intptr_t a_length = a.Length();
   intptr_t b_length = b.Length();
+  if ((a_length == 0) || (b_length == 0)) {
+    return Zero();
+  }
   intptr_t result_length = a_length + b_length;
   const Bigint& result = Bigint::Handle(Bigint::Allocate(result_length));
 
@@ -707,66 +720,16 @@ RawBigint* BigintOperations::Multiply(const Bigint& a, const Bigint& b) {
     result.ToggleSign();
   }
 
-  // Comba multiplication: compute each column separately.
-  // Example: r = a2a1a0 * b2b1b0.
-  //    r =  1    * a0b0 +
-  //        10    * (a1b0 + a0b1) +
-  //        100   * (a2b0 + a1b1 + a0b2) +
-  //        1000  * (a2b1 + a1b2) +
-  //        10000 * a2b2
-  //
-  // Each column will be accumulated in an integer of type DoubleChunk. We
-  // must guarantee that the column-sum will not overflow.
-  //
-  // In the worst case we have to accumulate k = Min(a.length, b.length)
-  // products plus the carry from the previous round.
-  // Each bigint-digit is smaller than beta = 2^kDigitBitSize.
-  // Each product is at most (beta - 1)^2.
-  // If we want to use Comba multiplication the following condition must hold:
-  // k * (beta - 1)^2 + (2^(kDoubleChunkBitSize - kDigitBitSize) - 1) <
-  //        2^kDoubleChunkBitSize.
-  const DoubleChunk square =
-      static_cast<DoubleChunk>(kDigitMaxValue) * kDigitMaxValue;
-  const DoubleChunk kDoubleChunkMaxValue = static_cast<DoubleChunk>(-1);
-  const DoubleChunk left_over_carry = kDoubleChunkMaxValue >> kDigitBitSize;
-  const intptr_t kMaxDigits = (kDoubleChunkMaxValue - left_over_carry) / square;
-  if (Utils::Minimum(a_length, b_length) > kMaxDigits) {
-    // Use the preallocated out of memory exception to avoid calling
-    // into dart code or allocating any code.
-    Isolate* isolate = Isolate::Current();
-    const Instance& exception =
-        Instance::Handle(isolate->object_store()->out_of_memory());
-    Exceptions::Throw(exception);
-    UNREACHABLE();
+  // Schoolbook multiplication for short operands, Karatsuba for long ones.
+  // The digits are multiplied in place; scratch space is taken from nested
+  // zones, which are released as the recursion returns.
+  {
+    NoGCScope no_gc;
+    MultiplyDigits(result.ChunkAddr(0),
+                   a.ChunkAddr(0), a_length,
+                   b.ChunkAddr(0), b_length);
   }
 
-  DoubleChunk accumulator = 0;  // Accumulates the result of one column.
-  for (intptr_t i = 0; i < result_length; i++) {
-    // Example: r = a2a1a0 * b2b1b0.
-    //   For i == 0, compute a0b0.
-    //       i == 1,         a1b0 + a0b1 + overflow from i == 0.
-    //       i == 2,         a2b0 + a1b1 + a0b2 + overflow from i == 1.
-    //       ...
-    // The indices into a and b are such that their sum equals i.
-    intptr_t a_index = Utils::Minimum(a_length - 1, i);
-    intptr_t b_index = i - a_index;
-    ASSERT(a_index + b_index == i);
-
-    // Instead of testing for a_index >= 0 && b_index < b_length we compute the
-    // number of iterations first.
-    intptr_t iterations = Utils::Minimum(b_length - b_index, a_index + 1);
-    for (intptr_t j = 0; j < iterations; j++) {
-      DoubleChunk chunk_a = a.GetChunkAt(a_index);
-      DoubleChunk chunk_b = b.GetChunkAt(b_index);
-      accumulator += chunk_a * chunk_b;
-      a_index--;
-      b_index++;
-    }
-    result.SetChunkAt(i, static_cast<Chunk>(accumulator & kDigitMask));
-    accumulator >>= kDigitBitSize;
-  }
-  ASSERT(accumulator == 0);
-
   Clamp(result);
   return result.raw();
 }
@@ -1459,21 +1422,29 @@ RawBigint* BigintOperations::UnsignedSubtract(const Bigint& a,
 
 RawBigint* BigintOperations::MultiplyWithDigit(
     const Bigint& bigint, Chunk digit) {
-  // TODO(floitsch): implement MultiplyWithDigit.
   ASSERT(digit <= kDigitMaxValue);
   if (digit == 0) return Zero();
 
-  Bigint& tmp = Bigint::Handle(Bigint::Allocate(1));
-  tmp.SetChunkAt(0, digit);
-  return Multiply(bigint, tmp);
+  intptr_t length = bigint.Length();
+  const Bigint& result = Bigint::Handle(Bigint::Allocate(length + 1));
+  for (intptr_t i = 0; i < length; i++) {
+    result.SetChunkAt(i, 0);
+  }
+  Chunk carry;
+  {
+    NoGCScope no_gc;
+    carry = MultiplyAccumulate(result.ChunkAddr(0),
+                               bigint.ChunkAddr(0), length, digit);
+  }
+  result.SetChunkAt(length, carry);
+  result.SetSign(bigint.IsNegative());
+  Clamp(result);
+  return result.raw();
 }
 
 
 void BigintOperations::DivideRemainder(
     const Bigint& a, const Bigint& b, Bigint* quotient, Bigint* remainder) {
-  // TODO(floitsch): This function is very memory-intensive since all
-  // intermediate bigint results are allocated in new memory. It would be
-  // much more efficient to reuse the space of temporary intermediate variables.
   ASSERT(IsClamped(a));
   ASSERT(IsClamped(b));
   ASSERT(!b.IsZero());
@@ -1490,151 +1461,490 @@ void BigintOperations::DivideRemainder(
     return;
   }
 
-  // High level description:
-  // The algorithm is basically the algorithm that is taught in school:
-  // Let a the dividend and b the divisor. We are looking for
-  // the quotient q = truncate(a / b), and
-  // the remainder r = a - q * b.
-  // School algorithm:
-  // q = 0
-  // n = number_of_digits(a) - number_of_digits(b)
-  // for (i = n; i >= 0; i--) {
-  //   Maximize k such that k*y*10^i is less than or equal to a and
-  //                  (k + 1)*y*10^i is greater.
-  //   q = q + k * 10^i   // Add new digit to result.
-  //   a = a - k * b * 10^i
-  // }
-  // r = a
-  //
-  // Instead of working in base 10 we work in base kDigitBitSize.
-
+  // The digits are divided in a nested zone, which releases the scratch
+  // digits on return, and only the results are allocated as bigints.
+  StackZone zone(Isolate::Current());
+  intptr_t a_length = a.Length();
   intptr_t b_length = b.Length();
-  int normalization_shift =
-      kDigitBitSize - CountBits(b.GetChunkAt(b_length - 1));
-  Bigint& dividend = Bigint::Handle(ShiftLeft(a, normalization_shift));
-  const Bigint& divisor = Bigint::Handle(ShiftLeft(b, normalization_shift));
-  dividend.SetSign(false);
-  divisor.SetSign(false);
-
-  intptr_t dividend_length = dividend.Length();
-  intptr_t divisor_length = b_length;
-  ASSERT(divisor_length == divisor.Length());
-
-  intptr_t quotient_length = dividend_length - divisor_length + 1;
+  intptr_t quotient_length = a_length - b_length + 1;
+  Chunk* quotient_digits = AllocateDigits(quotient_length);
+  Chunk* remainder_digits = AllocateDigits(b_length);
+  {
+    NoGCScope no_gc;
+    DivideDigits(quotient_digits, remainder_digits,
+                 a.ChunkAddr(0), a_length, b.ChunkAddr(0), b_length);
+  }
+
   *quotient = Bigint::Allocate(quotient_length);
+  for (intptr_t i = 0; i < quotient_length; i++) {
+    quotient->SetChunkAt(i, quotient_digits[i]);
+  }
+  Clamp(*quotient);
   quotient->SetSign(a.IsNegative() != b.IsNegative());
+  *remainder = Bigint::Allocate(b_length);
+  for (intptr_t i = 0; i < b_length; i++) {
+    remainder->SetChunkAt(i, remainder_digits[i]);
+  }
+  Clamp(*remainder);
+  remainder->SetSign(a.IsNegative());
+}
+
 
-  intptr_t quotient_pos = dividend_length - divisor_length;
-  // Find the first quotient-digit.
-  // The first digit must be computed separately from the other digits because
-  // the preconditions for the loop are not yet satisfied.
-  // For simplicity use a shifted divisor, so that the comparison and
-  // subtraction are easier.
-  int divisor_shift_amount = dividend_length - divisor_length;
-  Bigint& shifted_divisor =
-      Bigint::Handle(DigitsShiftLeft(divisor, divisor_shift_amount));
-  Chunk first_quotient_digit = 0;
-  while (UnsignedCompare(dividend, shifted_divisor) >= 0) {
-    first_quotient_digit++;
-    dividend = Subtract(dividend, shifted_divisor);
-  }
-  quotient->SetChunkAt(quotient_pos--, first_quotient_digit);
-
-  // Find the remainder of the digits.
-
-  Chunk first_divisor_digit = divisor.GetChunkAt(divisor_length - 1);
-  // The short divisor only represents the first two digits of the divisor.
-  // If the divisor has only one digit, then the second part is zeroed out.
-  Bigint& short_divisor = Bigint::Handle(Bigint::Allocate(2));
-  if (divisor_length > 1) {
-    short_divisor.SetChunkAt(0, divisor.GetChunkAt(divisor_length - 2));
+BigintOperations::Chunk* BigintOperations::AllocateDigits(intptr_t length) {
+  return Isolate::Current()->current_zone()->Alloc<Chunk>(length);
+}
+
+
+int BigintOperations::CompareDigits(const Chunk* a, intptr_t a_length,
+                                    const Chunk* b, intptr_t b_length) {
+  while ((a_length > 0) && (a[a_length - 1] == 0)) a_length--;
+  while ((b_length > 0) && (b[b_length - 1] == 0)) b_length--;
+  if (a_length != b_length) {
+    return (a_length < b_length) ? -1 : 1;
+  }
+  for (intptr_t i = a_length - 1; i >= 0; i--) {
+    if (a[i] != b[i]) {
+      return (a[i] < b[i]) ? -1 : 1;
+    }
+  }
+  return 0;
+}
+
+
+BigintOperations::Chunk BigintOperations::AddDigits(
+    Chunk* result,
+    const Chunk* a, intptr_t a_length,
+    const Chunk* b, intptr_t b_length) {
+  ASSERT(a_length >= b_length);
+  Chunk carry = 0;
+  intptr_t i = 0;
+  for (; i < b_length; i++) {
+    Chunk sum = a[i] + b[i] + carry;
+    result[i] = sum & kDigitMask;
+    carry = sum >> kDigitBitSize;
+  }
+  for (; i < a_length; i++) {
+    if ((carry == 0) && (result == a)) break;
+    Chunk sum = a[i] + carry;
+    result[i] = sum & kDigitMask;
+    carry = sum >> kDigitBitSize;
+  }
+  return carry;
+}
+
+
+BigintOperations::Chunk BigintOperations::SubtractDigits(
+    Chunk* result,
+    const Chunk* a, intptr_t a_length,
+    const Chunk* b, intptr_t b_length) {
+  ASSERT(a_length >= b_length);
+  // Since digits have fewer bits than a chunk the top bit of a difference is
+  // set exactly when it underflowed.
+  Chunk borrow = 0;
+  intptr_t i = 0;
+  for (; i < b_length; i++) {
+    Chunk difference = a[i] - b[i] - borrow;
+    result[i] = difference & kDigitMask;
+    borrow = difference >> (kChunkBitSize - 1);
+  }
+  for (; i < a_length; i++) {
+    if ((borrow == 0) && (result == a)) break;
+    Chunk difference = a[i] - borrow;
+    result[i] = difference & kDigitMask;
+    borrow = difference >> (kChunkBitSize - 1);
+  }
+  return borrow;
+}
+
+
+BigintOperations::Chunk BigintOperations::MultiplyAccumulate(
+    Chunk* result, const Chunk* a, intptr_t length, Chunk digit) {
+  // The sum of a product of two digits and two more digits fits into a
+  // DoubleChunk, so the carry can be propagated without overflow checks.
+  DoubleChunk carry = 0;
+  for (intptr_t i = 0; i < length; i++) {
+    DoubleChunk sum =
+        static_cast<DoubleChunk>(a[i]) * digit + result[i] + carry;
+    result[i] = static_cast<Chunk>(sum & kDigitMask);
+    carry = sum >> kDigitBitSize;
+  }
+  return static_cast<Chunk>(carry);
+}
+
+
+void BigintOperations::MultiplyDigits(Chunk* result,
+                                      const Chunk* a, intptr_t a_length,
+                                      const Chunk* b, intptr_t b_length) {
+  if (a_length < b_length) {
+    const Chunk* tmp = a;
+    a = b;
+    b = tmp;
+    intptr_t tmp_length = a_length;
+    a_length = b_length;
+    b_length = tmp_length;
+  }
+  const intptr_t result_length = a_length + b_length;
+
+  if (b_length < kKaratsubaThreshold) {
+    // Schoolbook multiplication: add a * b[i] * beta^i for each digit of the
+    // shorter operand.
+    for (intptr_t i = 0; i < a_length; i++) {
+      result[i] = 0;
+    }
+    for (intptr_t i = 0; i < b_length; i++) {
+      result[i + a_length] = MultiplyAccumulate(&result[i], a, a_length, b[i]);
+    }
+    return;
+  }
+
+  if (2 * b_length <= a_length) {
+    // Unbalanced operands: multiply b with slices of a that have b's length.
+    for (intptr_t i = 0; i < result_length; i++) {
+      result[i] = 0;
+    }
+    StackZone zone(Isolate::Current());
+    Chunk* product = AllocateDigits(2 * b_length);
+    for (intptr_t i = 0; i < a_length; i += b_length) {
+      const intptr_t slice_length = Utils::Minimum(b_length, a_length - i);
+      MultiplyDigits(product, &a[i], slice_length, b, b_length);
+      Chunk carry = AddDigits(&result[i], &result[i], result_length - i,
+                              product, slice_length + b_length);
+      ASSERT(carry == 0);
+      USE(carry);
+    }
+    return;
+  }
+
+  // Karatsuba multiplication. With a = a1 * beta^k + a0 and
+  // b = b1 * beta^k + b0:
+  //   a * b = z2 * beta^2k + z1 * beta^k + z0, where
+  //   z2 = a1 * b1, z0 = a0 * b0 and z1 = (a0 + a1) * (b0 + b1) - z2 - z0.
+  // Since a_length < 2 * b_length, b1 is not empty.
+  const intptr_t k = a_length / 2;
+  const Chunk* a1 = &a[k];
+  const intptr_t a1_length = a_length - k;
+  const Chunk* b1 = &b[k];
+  const intptr_t b1_length = b_length - k;
+  ASSERT((a1_length >= k) && (b1_length > 0));
+
+  // z0 and z2 go directly to the low and high parts of the result.
+  MultiplyDigits(result, a, k, b, k);
+  MultiplyDigits(&result[2 * k], a1, a1_length, b1, b1_length);
+
+  // The scratch digits of each level are released before returning, so the
+  // scratch space in use is bounded by a constant times the operand length.
+  StackZone zone(Isolate::Current());
+  const intptr_t a_sum_length = a1_length + 1;
+  Chunk* a_sum = AllocateDigits(a_sum_length);
+  a_sum[a1_length] = AddDigits(a_sum, a1, a1_length, a, k);
+  const intptr_t b_sum_length = Utils::Maximum(k, b1_length) + 1;
+  Chunk* b_sum = AllocateDigits(b_sum_length);
+  if (b1_length >= k) {
+    b_sum[b_sum_length - 1] = AddDigits(b_sum, b1, b1_length, b, k);
   } else {
-    short_divisor.SetChunkAt(0, 0);
-  }
-  short_divisor.SetChunkAt(1, first_divisor_digit);
-  // The following bigint will be used inside the loop. It is allocated outside
-  // the loop to avoid repeated allocations.
-  Bigint& target = Bigint::Handle(Bigint::Allocate(3));
-  // The dividend_length here must be from the initial dividend.
-  for (intptr_t i = dividend_length - 1; i >= divisor_length; i--) {
-    // Invariant: let t = i - divisor_length
-    //   then dividend / (divisor << (t * kDigitBitSize)) <= kDigitMaxValue.
-    // Ex: dividend: 53451232, and divisor: 535  (with t == 5) is ok.
-    //     dividend: 56822123, and divisor: 563  (with t == 5) is bad.
-    //     dividend:  6822123, and divisor: 563  (with t == 5) is ok.
-
-    // The dividend has changed. So recompute its length.
-    dividend_length = dividend.Length();
-    Chunk dividend_digit;
-    if (i > dividend_length) {
-      quotient->SetChunkAt(quotient_pos--, 0);
-      continue;
-    } else if (i == dividend_length) {
-      dividend_digit = 0;
+    b_sum[b_sum_length - 1] = AddDigits(b_sum, b, k, b1, b1_length);
+  }
+
+  const intptr_t z1_length = a_sum_length + b_sum_length;
+  Chunk* z1 = AllocateDigits(z1_length);
+  MultiplyDigits(z1, a_sum, a_sum_length, b_sum, b_sum_length);
+  Chunk borrow = SubtractDigits(z1, z1, z1_length, result, 2 * k);
+  ASSERT(borrow == 0);
+  borrow = SubtractDigits(z1, z1, z1_length,
+                          &result[2 * k], result_length - 2 * k);
+  ASSERT(borrow == 0);
+
+  // Add z1 * beta^k. Its digits beyond the length of the result are zero.
+  const intptr_t z1_used_length =
+      Utils::Minimum(z1_length, result_length - k);
+  for (intptr_t i = z1_used_length; i < z1_length; i++) {
+    ASSERT(z1[i] == 0);
+  }
+  Chunk carry = AddDigits(&result[k], &result[k], result_length - k,
+                          z1, z1_used_length);
+  ASSERT(carry == 0);
+  USE(borrow);
+  USE(carry);
+}
+
+
+BigintOperations::Chunk BigintOperations::DivideDigit(
+    Chunk* quotient, const Chunk* a, intptr_t length, Chunk digit) {
+  ASSERT(digit != 0);
+  DoubleChunk remainder = 0;
+  for (intptr_t i = length - 1; i >= 0; i--) {
+    DoubleChunk dividend = (remainder << kDigitBitSize) | a[i];
+    quotient[i] = static_cast<Chunk>(dividend / digit);
+    remainder = dividend % digit;
+  }
+  return static_cast<Chunk>(remainder);
+}
+
+
+void BigintOperations::DivideDigits(Chunk* quotient, Chunk* remainder,
+                                    const Chunk* a, intptr_t a_length,
+                                    const Chunk* b, intptr_t b_length) {
+  ASSERT(a_length >= b_length);
+  ASSERT((b_length > 0) && (b[b_length - 1] != 0));
+  if (b_length == 1) {
+    remainder[0] = DivideDigit(quotient, a, a_length, b[0]);
+    return;
+  }
+
+  // Normalize the operands so that the top digit of the divisor is at least
+  // beta / 2. The shifted dividend gets an additional digit, which also
+  // guarantees that it is smaller than b * beta^(quotient length).
+  const int shift = kDigitBitSize - CountBits(b[b_length - 1]);
+  const int reverse_shift = kDigitBitSize - shift;
+  Chunk* v = AllocateDigits(b_length);
+  Chunk carry = 0;
+  for (intptr_t i = 0; i < b_length; i++) {
+    v[i] = ((b[i] << shift) & kDigitMask) | carry;
+    carry = b[i] >> reverse_shift;
+  }
+  ASSERT(carry == 0);
+  Chunk* u = AllocateDigits(a_length + 1);
+  carry = 0;
+  for (intptr_t i = 0; i < a_length; i++) {
+    u[i] = ((a[i] << shift) & kDigitMask) | carry;
+    carry = a[i] >> reverse_shift;
+  }
+  u[a_length] = carry;
+
+  DivideNormalized(quotient, u, a_length + 1, v, b_length);
+
+  // The remainder was left in the low digits of u.
+  for (intptr_t i = 0; i < b_length; i++) {
+    remainder[i] = (u[i] >> shift) | ((u[i + 1] << reverse_shift) & kDigitMask);
+  }
+}
+
+
+void BigintOperations::DivideNormalized(Chunk* quotient,
+                                        Chunk* u, intptr_t u_length,
+                                        const Chunk* b, intptr_t b_length) {
+  intptr_t quotient_length = u_length - b_length;
+  if ((b_length < kRecursiveDivisionThreshold) ||
+      (quotient_length < kRecursiveDivisionThreshold)) {
+    Chunk top = DivideBasecase(quotient, u, u_length, b, b_length);
+    ASSERT(top == 0);
+    USE(top);
+    return;
+  }
+  // Compute the quotient in blocks of b_length digits, each one by dividing
+  // 2 * b_length digits of u by b.
+  while (quotient_length > b_length) {
+    quotient_length -= b_length;
+    Chunk top = DivideRecursive(&quotient[quotient_length], &u[quotient_length],
+                                2 * b_length, b, b_length);
+    ASSERT(top == 0);
+    USE(top);
+  }
+  Chunk top = DivideRecursive(quotient, u, quotient_length + b_length,
+                              b, b_length);
+  ASSERT(top == 0);
+  USE(top);
+}
+
+
+BigintOperations::Chunk BigintOperations::DivideRecursive(
+    Chunk* quotient, Chunk* u, intptr_t u_length,
+    const Chunk* b, intptr_t b_length) {
+  // Recursive division (see algorithm 1.8 in "Modern Computer Arithmetic" by
+  // Brent and Zimmermann). Requires u_length <= 2 * b_length. With
+  // b = b1 * beta^k + b0 the quotient is computed in two halves, each by a
+  // recursive division by b1 followed by a correction for b0.
+  const intptr_t quotient_length = u_length - b_length;
+  ASSERT(quotient_length <= b_length);
+  if (quotient_length < kRecursiveDivisionThreshold) {
+    return DivideBasecase(quotient, u, u_length, b, b_length);
+  }
+  const intptr_t k = quotient_length / 2;
+  const Chunk* b1 = &b[k];
+  const intptr_t b1_length = b_length - k;
+
+  // High half: divide u div beta^2k by b1. The remainder replaces the
+  // divided digits of u.
+  Chunk* high = &quotient[k];
+  const intptr_t high_length = quotient_length - k;
+  Chunk top = DivideRecursive(high, &u[2 * k], u_length - 2 * k,
+                              b1, b1_length);
+  top = SubtractQuotientProduct(&u[k], b, b_length,
+                                high, high_length, top, b, k);
+
+  // Low half: divide the updated u div beta^k by b1.
+  Chunk low_top = DivideRecursive(quotient, &u[k], b_length, b1, b1_length);
+  low_top = SubtractQuotientProduct(u, b, b_length,
+                                    quotient, k, low_top, b, k);
+  if (low_top != 0) {
+    // The low half is beta^k: carry into the high half.
+    intptr_t i = 0;
+    while ((i < high_length) && (high[i] == kDigitMaxValue)) {
+      high[i++] = 0;
+    }
+    if (i == high_length) {
+      top++;
     } else {
-      ASSERT(i + 1 == dividend_length);
-      dividend_digit = dividend.GetChunkAt(i);
+      high[i]++;
     }
-    Chunk quotient_digit;
-    // Compute an estimate of the quotient_digit. The estimate will never
-    // be too small.
-    if (dividend_digit == first_divisor_digit) {
-      // Small shortcut: the else-branch would compute a value > kDigitMaxValue.
-      // However, by hypothesis, we know that the quotient_digit must fit into
-      // a digit. Avoid going through repeated iterations of the adjustment
-      // loop by directly assigning kDigitMaxValue to the quotient_digit.
-      // Ex:  51235 / 523.
-      //    51 / 5 would yield 10 (if computed in the else branch).
-      // However we know that 9 is the maximal value.
-      quotient_digit = kDigitMaxValue;
+  }
+  return top;
+}
+
+
+BigintOperations::Chunk BigintOperations::SubtractQuotientProduct(
+    Chunk* u, const Chunk* b, intptr_t b_length,
+    Chunk* quotient, intptr_t quotient_length, Chunk quotient_top,
+    const Chunk* b_low, intptr_t b_low_length) {
+  const intptr_t product_length = quotient_length + b_low_length + 1;
+  ASSERT(product_length <= b_length + 1);
+  StackZone zone(Isolate::Current());
+  Chunk* product = AllocateDigits(product_length);
+  MultiplyDigits(product, quotient, quotient_length, b_low, b_low_length);
+  product[product_length - 1] = 0;
+  if (quotient_top != 0) {
+    AddDigits(&product[quotient_length], &product[quotient_length],
+              b_low_length + 1, b_low, b_low_length);
+  }
+  // Adding b may temporarily need one more digit.
+  Chunk* difference = AllocateDigits(b_length + 1);
+  for (intptr_t i = 0; i < b_length; i++) {
+    difference[i] = u[i];
+  }
+  difference[b_length] = 0;
+  while (CompareDigits(difference, b_length + 1,
+                       product, product_length) < 0) {
+    // The quotient was too large. This happens at most twice.
+    intptr_t i = 0;
+    while ((i < quotient_length) && (quotient[i] == 0)) {
+      quotient[i++] = kDigitMaxValue;
+    }
+    if (i == quotient_length) {
+      ASSERT(quotient_top != 0);
+      quotient_top--;
     } else {
-      // Compute the estimate by using two digits of the dividend and one of
-      // the divisor.
-      // Ex: 32421 / 535
-      //    32 / 5 -> 6
-      // The estimate would hence be 6.
-      DoubleChunk two_dividend_digits = dividend_digit;
-      two_dividend_digits <<= kDigitBitSize;
-      two_dividend_digits += dividend.GetChunkAt(i - 1);
-      DoubleChunk q = two_dividend_digits / first_divisor_digit;
-      if (q > kDigitMaxValue) q = kDigitMaxValue;
-      quotient_digit = static_cast<Chunk>(q);
+      quotient[i]--;
+    }
+    AddDigits(difference, difference, b_length + 1, b, b_length);
+  }
+  SubtractDigits(difference, difference, b_length + 1,
+                 product, product_length);
+  ASSERT(difference[b_length] == 0);
+  for (intptr_t i = 0; i < b_length; i++) {
+    u[i] = difference[i];
+  }
+  return quotient_top;
+}
+
+
+BigintOperations::Chunk BigintOperations::DivideBasecase(
+    Chunk* quotient, Chunk* u, intptr_t u_length,
+    const Chunk* b, intptr_t b_length) {
+  // Schoolbook division (Knuth, TAOCP vol. 2, algorithm 4.3.1 D).
+  ASSERT(b_length >= 2);
+  ASSERT(CountBits(b[b_length - 1]) == kDigitBitSize);
+  const intptr_t quotient_length = u_length - b_length;
+  Chunk top = 0;
+  if (CompareDigits(&u[quotient_length], b_length, b, b_length) >= 0) {
+    SubtractDigits(&u[quotient_length], &u[quotient_length], b_length,
+                   b, b_length);
+    top = 1;
+  }
+  const Chunk b_top = b[b_length - 1];
+  const Chunk b_next = b[b_length - 2];
+  for (intptr_t j = quotient_length - 1; j >= 0; j--) {
+    // Estimate the quotient digit from the top digits of the dividend and
+    // the divisor. Thanks to the normalization the estimate is at most one
+    // too large after the correction loop.
+    Chunk* window = &u[j];
+    DoubleChunk dividend =
+        (static_cast<DoubleChunk>(window[b_length]) << kDigitBitSize) |
+        window[b_length - 1];
+    DoubleChunk estimate = dividend / b_top;
+    DoubleChunk estimate_remainder = dividend % b_top;
+    while ((estimate > kDigitMaxValue) ||
+           (estimate * b_next >
+            ((estimate_remainder << kDigitBitSize) | window[b_length - 2]))) {
+      estimate--;
+      estimate_remainder += b_top;
+      if (estimate_remainder > kDigitMaxValue) break;
     }
 
-    // Refine estimation.
-    quotient_digit++;  // The following loop will start by decrementing.
-    Bigint& estimation_product = Bigint::Handle();
-    target.SetChunkAt(0, ((i - 2) < 0) ? 0 : dividend.GetChunkAt(i - 2));
-    target.SetChunkAt(1, ((i - 1) < 0) ? 0 : dividend.GetChunkAt(i - 1));
-    target.SetChunkAt(2, dividend_digit);
-    do {
-      quotient_digit = (quotient_digit - 1) & kDigitMask;
-      estimation_product = MultiplyWithDigit(short_divisor, quotient_digit);
-    } while (UnsignedCompareNonClamped(estimation_product, target) > 0);
-    // At this point the quotient_digit is fairly accurate.
-    // At the worst it is off by one.
-    // Remove a multiple of the divisor. If the estimate is incorrect we will
-    // subtract the divisor another time.
-    // Let t = i - divisor_length.
-    // dividend -= (quotient_digit * divisor) << (t * kDigitBitSize);
-    shifted_divisor = MultiplyWithDigit(divisor, quotient_digit);
-    shifted_divisor = DigitsShiftLeft(shifted_divisor, i - divisor_length);
-    dividend = Subtract(dividend, shifted_divisor);
-    if (dividend.IsNegative()) {
-      // The estimation was still too big.
-      quotient_digit--;
-      // TODO(floitsch): allocate space for the shifted_divisor once and reuse
-      // it at every iteration.
-      shifted_divisor = DigitsShiftLeft(divisor, i - divisor_length);
-      // TODO(floitsch): reuse the space of the previous dividend.
-      dividend = Add(dividend, shifted_divisor);
+    // Subtract estimate * b from the window.
+    DoubleChunk carry = 0;
+    Chunk borrow = 0;
+    for (intptr_t i = 0; i < b_length; i++) {
+      DoubleChunk product = estimate * b[i] + carry;
+      carry = product >> kDigitBitSize;
+      Chunk difference =
+          window[i] - static_cast<Chunk>(product & kDigitMask) - borrow;
+      window[i] = difference & kDigitMask;
+      borrow = difference >> (kChunkBitSize - 1);
     }
-    quotient->SetChunkAt(quotient_pos--, quotient_digit);
+    Chunk difference = window[b_length] - static_cast<Chunk>(carry) - borrow;
+    window[b_length] = difference & kDigitMask;
+    if ((difference >> (kChunkBitSize - 1)) != 0) {
+      // The estimate was one too large: add b back.
+      estimate--;
+      window[b_length] += AddDigits(window, window, b_length, b, b_length);
+      window[b_length] &= kDigitMask;
+    }
+    ASSERT(window[b_length] == 0);
+    quotient[j] = static_cast<Chunk>(estimate);
   }
-  ASSERT(quotient_pos == -1);
-  Clamp(*quotient);
-  *remainder = ShiftRight(dividend, normalization_shift);
-  remainder->SetSign(a.IsNegative());
+  return top;
+}
+
+
+intptr_t BigintOperations::ToDecimalDigits(Chunk* digits, intptr_t length,
+                                           Chunk** powers,
+                                           intptr_t* power_lengths,
+                                           intptr_t level, intptr_t width,
+                                           char* result, intptr_t position) {
+  // The decimal chunks are 8 digits wide: 10^8 fits into a digit.
+  const Chunk kChunkDivisor = 100000000;
+  const int kChunkDigits = 8;
+  while ((length > 0) && (digits[length - 1] == 0)) length--;
+  while ((level >= 0) &&
+         (CompareDigits(digits, length,
+                        powers[level], power_lengths[level]) < 0)) {
+    level--;
+  }
+
+  if ((level < 0) || (length < kDecimalConversionThreshold)) {
+    // Repeatedly divide by 10^8 and print the remainders.
+    const intptr_t start = position;
+    while (length > 0) {
+      Chunk part = DivideDigit(digits, digits, length, kChunkDivisor);
+      for (int i = 0; i < kChunkDigits; i++) {
+        result[position++] = '0' + (part % 10);
+        part /= 10;
+      }
+      ASSERT(part == 0);
+      while ((length > 0) && (digits[length - 1] == 0)) length--;
+    }
+    ASSERT((width == 0) || (position - start <= width));
+    while (position - start < width) {
+      result[position++] = '0';
+    }
+    return position;
+  }
+
+  // Split the digits into high * 10^(8 * 2^level) + low and convert both
+  // halves recursively. The low half has exactly 8 * 2^level decimal digits.
+  const Chunk* power = powers[level];
+  const intptr_t power_length = power_lengths[level];
+  const intptr_t high_length = length - power_length + 1;
+  StackZone zone(Isolate::Current());
+  Chunk* high = AllocateDigits(high_length);
+  Chunk* low = AllocateDigits(power_length);
+  DivideDigits(high, low, digits, length, power, power_length);
+  const intptr_t low_width = static_cast<intptr_t>(kChunkDigits) << level;
+  position = ToDecimalDigits(low, power_length, powers, power_lengths,
+                             level - 1, low_width, result, position);
+  return ToDecimalDigits(high, high_length, powers, power_lengths,
+                         level - 1, (width == 0) ? 0 : width - low_width,
+                         result, position);
 }
 
 
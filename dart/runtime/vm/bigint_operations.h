@@ -111,6 +111,12 @@ class BigintOperations : public AllStatic {
   static const int kChunkBitSize = kChunkSize * kBitsPerByte;
   static const int kHexCharsPerDigit = kDigitBitSize / 4;
 
+  // Operands with fewer digits than the following thresholds are handled by
+  // the quadratic schoolbook algorithms.
+  static const intptr_t kKaratsubaThreshold = 32;
+  static const intptr_t kRecursiveDivisionThreshold = 48;
+  static const intptr_t kDecimalConversionThreshold = 48;
+
   static RawBigint* Zero() { return Bigint::Allocate(0); }
   static RawBigint* One() {
     Bigint& result = Bigint::Handle(Bigint::Allocate(1));
@@ -140,6 +146,73 @@ class BigintOperations : public AllStatic {
   static void DivideRemainder(const Bigint& a, const Bigint& b,
                               Bigint* quotient, Bigint* remainder);
 
+  // Helpers for multiplication, division and decimal conversion. They work
+  // on little-endian arrays of digits in the current zone so that the
+  // subquadratic algorithms don't allocate intermediate bigints. Recursive
+  // helpers take their scratch digits from a nested zone that is released
+  // when they return. Unless noted otherwise, results must not overlap the
+  // operands.
+  static Chunk* AllocateDigits(intptr_t length);
+  static int CompareDigits(const Chunk* a, intptr_t a_length,
+                           const Chunk* b, intptr_t b_length);
+  // The following require a_length >= b_length. The result may be a.
+  static Chunk AddDigits(Chunk* result,
+                         const Chunk* a, intptr_t a_length,
+                         const Chunk* b, intptr_t b_length);
+  static Chunk SubtractDigits(Chunk* result,
+                              const Chunk* a, intptr_t a_length,
+                              const Chunk* b, intptr_t b_length);
+  // Adds a * digit to the first 'length' digits of result and returns the
+  // carry.
+  static Chunk MultiplyAccumulate(Chunk* result,
+                                  const Chunk* a, intptr_t length,
+                                  Chunk digit);
+  // Stores a * b in the a_length + b_length digits of result.
+  static void MultiplyDigits(Chunk* result,
+                             const Chunk* a, intptr_t a_length,
+                             const Chunk* b, intptr_t b_length);
+  // Divides a by digit and returns the remainder. The quotient may be a.
+  static Chunk DivideDigit(Chunk* quotient,
+                           const Chunk* a, intptr_t length,
+                           Chunk digit);
+  // Requires a_length >= b_length and a non-zero top digit of b. Stores
+  // a_length - b_length + 1 digits in quotient and b_length in remainder.
+  static void DivideDigits(Chunk* quotient, Chunk* remainder,
+                           const Chunk* a, intptr_t a_length,
+                           const Chunk* b, intptr_t b_length);
+  // Divide the u_length digits of u by the normalized b_length digits of b,
+  // where u < b * beta^(u_length - b_length). The quotient has
+  // u_length - b_length digits and the remainder replaces u.
+  static void DivideNormalized(Chunk* quotient,
+                               Chunk* u, intptr_t u_length,
+                               const Chunk* b, intptr_t b_length);
+  // Like DivideNormalized, but u may be as large as b * beta^(u_length -
+  // b_length + 1). Returns the top quotient digit, which is 0 or 1.
+  static Chunk DivideRecursive(Chunk* quotient,
+                               Chunk* u, intptr_t u_length,
+                               const Chunk* b, intptr_t b_length);
+  static Chunk DivideBasecase(Chunk* quotient,
+                              Chunk* u, intptr_t u_length,
+                              const Chunk* b, intptr_t b_length);
+  // Computes u -= quotient * b_low for the b_length digits of u, where the
+  // quotient has an additional top digit quotient_top. Adds b to u and
+  // decrements the quotient until the result is not negative. Returns the
+  // new top digit.
+  static Chunk SubtractQuotientProduct(Chunk* u,
+                                       const Chunk* b, intptr_t b_length,
+                                       Chunk* quotient,
+                                       intptr_t quotient_length,
+                                       Chunk quotient_top,
+                                       const Chunk* b_low,
+                                       intptr_t b_low_length);
+  // Writes the decimal digits of the given digits (which are destroyed) to
+  // result, least significant first. If width is not 0 the output is padded
+  // with zeros to width characters. Returns the new position.
+  static intptr_t ToDecimalDigits(Chunk* digits, intptr_t length,
+                                  Chunk** powers, intptr_t* power_lengths,
+                                  intptr_t level, intptr_t width,
+                                  char* result, intptr_t position);
+
   // Removes leading zero-chunks by adjusting the bigint's length.
   static void Clamp(const Bigint& bigint);
 
@@ -2231,4 +2231,185 @@ TEST_CASE(BigintDivideRemainder) {
       "01234567890ABCDEE");
 }
 
+
+// Returns a string of 'count' copies of 'c' after the given prefix, followed
+// by the given suffix.
+static const char* RepeatedChars(const char* prefix,
+                                 char c,
+                                 intptr_t count,
+                                 const char* suffix) {
+  intptr_t prefix_length = strlen(prefix);
+  intptr_t suffix_length = strlen(suffix);
+  char* result = reinterpret_cast<char*>(
+      ZoneAllocator(prefix_length + count + suffix_length + 1));
+  memmove(result, prefix, prefix_length);
+  memset(result + prefix_length, c, count);
+  memmove(result + prefix_length + count, suffix, suffix_length + 1);
+  return result;
+}
+
+
+// TestBigintMultiplyDivide is only available on ia32 and x64.
+#if defined(TARGET_ARCH_IA32) || defined(TARGET_ARCH_X64)
+// Returns a hex string of 'count' pseudo-random hex digits.
+static const char* PseudoRandomHex(const char* prefix,
+                                   intptr_t count,
+                                   uint32_t seed) {
+  char* result = const_cast<char*>(RepeatedChars(prefix, '0', count, ""));
+  intptr_t prefix_length = strlen(prefix);
+  for (intptr_t i = 0; i < count; i++) {
+    seed = seed * 1103515245 + 12345;
+    result[prefix_length + i] = "0123456789ABCDEF"[(seed >> 16) & 0xF];
+  }
+  if (result[prefix_length] == '0') {
+    result[prefix_length] = '1';
+  }
+  return result;
+}
+
+
+static void TestBigintDivisionIdentity(const char* a, const char* b) {
+  const Bigint& bigint_a = Bigint::Handle(BigintOperations::NewFromCString(a));
+  const Bigint& bigint_b = Bigint::Handle(BigintOperations::NewFromCString(b));
+  const Bigint& quotient =
+      Bigint::Handle(BigintOperations::Divide(bigint_a, bigint_b));
+  const Bigint& remainder =
+      Bigint::Handle(BigintOperations::Remainder(bigint_a, bigint_b));
+  // The remainder has the sign of a and is smaller than b.
+  EXPECT(remainder.IsZero() ||
+         (remainder.IsNegative() == bigint_a.IsNegative()));
+  Bigint& abs_remainder = Bigint::Handle(remainder.raw());
+  if (remainder.IsNegative()) {
+    abs_remainder = BigintOperations::Subtract(
+        Bigint::Handle(BigintOperations::NewFromCString("0")), remainder);
+  }
+  Bigint& abs_b = Bigint::Handle(bigint_b.raw());
+  if (bigint_b.IsNegative()) {
+    abs_b = BigintOperations::Subtract(
+        Bigint::Handle(BigintOperations::NewFromCString("0")), bigint_b);
+  }
+  EXPECT(BigintOperations::Compare(abs_remainder, abs_b) < 0);
+  // a == quotient * b + remainder.
+  const Bigint& product =
+      Bigint::Handle(BigintOperations::Multiply(quotient, bigint_b));
+  const Bigint& sum =
+      Bigint::Handle(BigintOperations::Add(product, remainder));
+  EXPECT_STREQ(a, BigintOperations::ToHexCString(sum, &ZoneAllocator));
+}
+
+
+TEST_CASE(BigintLargeMultiplyDivide) {
+  // (16^n - 1)^2 = 16^2n - 2 * 16^n + 1, which is printed as n - 1 F's, an E,
+  // n - 1 0's and a 1. The operands are long enough for the Karatsuba
+  // multiplication and the recursive division.
+  const intptr_t kLengths[] = { 100, 500, 1999, 6000 };
+  for (intptr_t i = 0; i < static_cast<intptr_t>(ARRAY_SIZE(kLengths));
+       i++) {
+    intptr_t n = kLengths[i];
+    const char* factor = RepeatedChars("0x", 'F', n, "");
+    const char* high = RepeatedChars("0x", 'F', n - 1, "E");
+    const char* product = RepeatedChars(high, '0', n - 1, "1");
+    TestBigintMultiplyDivide(factor, factor, product);
+    TestBigintMultiplyDivide(
+        factor, "0x10000001", RepeatedChars("0x10000000", 'F', n - 8,
+                                            "EFFFFFFF"));
+  }
+
+  // Unbalanced operands: 16^m * (16^n - 1) = (16^n - 1) followed by m zeros.
+  TestBigintMultiplyDivide(RepeatedChars("0x1", '0', 5000, ""),
+                           RepeatedChars("0x", 'F', 300, ""),
+                           RepeatedChars(RepeatedChars("0x", 'F', 300, ""),
+                                         '0', 5000, ""));
+
+  const intptr_t kDividendLengths[] = { 20, 300, 1000, 5000 };
+  const intptr_t kDivisorLengths[] = { 1, 8, 90, 400, 1200, 4000 };
+  for (intptr_t i = 0; i < static_cast<intptr_t>(ARRAY_SIZE(kDividendLengths));
+       i++) {
+    for (intptr_t j = 0;
+         j < static_cast<intptr_t>(ARRAY_SIZE(kDivisorLengths));
+         j++) {
+      uint32_t seed = static_cast<uint32_t>(i * 31 + j);
+      const char* a = PseudoRandomHex("0x", kDividendLengths[i], seed);
+      const char* b = PseudoRandomHex("0x", kDivisorLengths[j], seed + 7);
+      const char* minus_a = PseudoRandomHex("-0x", kDividendLengths[i], seed);
+      const char* minus_b =
+          PseudoRandomHex("-0x", kDivisorLengths[j], seed + 7);
+      TestBigintDivisionIdentity(a, b);
+      TestBigintDivisionIdentity(minus_a, b);
+      TestBigintDivisionIdentity(a, minus_b);
+      TestBigintDivisionIdentity(minus_a, minus_b);
+    }
+  }
+}
+
+
+TEST_CASE(BigintScratchSpace) {
+  // The scratch digits of the subquadratic algorithms are released as their
+  // recursion returns, so the zone of the caller does not grow with the
+  // amount of work done.
+  const intptr_t n = 60000;
+  const Bigint& a = Bigint::Handle(
+      BigintOperations::NewFromCString(PseudoRandomHex("0x", n, 1)));
+  const Bigint& b = Bigint::Handle(
+      BigintOperations::NewFromCString(PseudoRandomHex("0x", n, 2)));
+  const Bigint& c = Bigint::Handle(
+      BigintOperations::NewFromCString(PseudoRandomHex("0x", n / 2, 3)));
+  Bigint& result = Bigint::Handle();
+  Zone* zone = Isolate::Current()->current_zone();
+  const intptr_t size_before = zone->SizeInBytes();
+  result = BigintOperations::Multiply(a, b);
+  result = BigintOperations::Divide(result, c);
+  result = BigintOperations::Remainder(a, c);
+  const char* str = BigintOperations::ToDecimalCString(a, &ZoneAllocator);
+  EXPECT(str != NULL);
+  EXPECT_LT(zone->SizeInBytes() - size_before, MB);
+}
+#endif
+
+
+static void TestBigintDecimalRoundTrip(const char* str) {
+  const Bigint& bigint =
+      Bigint::Handle(BigintOperations::FromDecimalCString(str));
+  EXPECT_STREQ(str, BigintOperations::ToDecimalCString(bigint,
+                                                       &ZoneAllocator));
+}
+
+
+TEST_CASE(BigintLargeDecimalStrings) {
+  const intptr_t kLengths[] = { 100, 1000, 4321, 20000 };
+  for (intptr_t i = 0; i < static_cast<intptr_t>(ARRAY_SIZE(kLengths));
+       i++) {
+    intptr_t n = kLengths[i];
+    // 10^n - 1, 10^n and 10^n + 1 have many zero chunks in the conversion.
+    TestBigintDecimalRoundTrip(RepeatedChars("", '9', n, ""));
+    TestBigintDecimalRoundTrip(RepeatedChars("1", '0', n, ""));
+    TestBigintDecimalRoundTrip(RepeatedChars("1", '0', n - 1, "1"));
+    TestBigintDecimalRoundTrip(RepeatedChars("123456789", '0', n, "987"));
+    char* digits = const_cast<char*>(RepeatedChars("", '0', n, ""));
+    uint32_t seed = static_cast<uint32_t>(n);
+    for (intptr_t j = 0; j < n; j++) {
+      seed = seed * 1103515245 + 12345;
+      digits[j] = '0' + ((seed >> 16) % 10);
+    }
+    digits[0] = '7';
+    TestBigintDecimalRoundTrip(digits);
+  }
+
+  // 16^n in decimal, cross-checked against repeated multiplication by 16.
+  const intptr_t n = 3000;
+  const Bigint& power = Bigint::Handle(BigintOperations::NewFromCString(
+      RepeatedChars("0x1", '0', n, "")));
+  Bigint& expected = Bigint::Handle(BigintOperations::NewFromCString("1"));
+  const Bigint& sixteen =
+      Bigint::Handle(BigintOperations::NewFromCString("16"));
+  for (intptr_t i = 0; i < n; i++) {
+    expected = BigintOperations::Multiply(expected, sixteen);
+  }
+  EXPECT_EQ(0, BigintOperations::Compare(power, expected));
+  const char* str = BigintOperations::ToDecimalCString(power, &ZoneAllocator);
+  TestBigintDecimalRoundTrip(str);
+  EXPECT_EQ(3613, static_cast<intptr_t>(strlen(str)));
+  EXPECT_STREQ("6", str + strlen(str) - 1);
+}
+
 }  // namespace dart
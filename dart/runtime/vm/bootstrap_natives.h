@@ -72,6 +72,7 @@ namespace dart {
   V(JSSyntaxRegExp_getIsCaseSensitive, 1)                                      \
   V(JSSyntaxRegExp_getGroupCount, 1)                                           \
   V(JSSyntaxRegExp_ExecuteMatch, 3)                                            \
+  V(JSSyntaxRegExp_ExecuteAllMatches, 2)                                       \
   V(ObjectArray_allocate, 2)                                                   \
   V(ObjectArray_getIndexed, 2)                                                 \
   V(ObjectArray_setIndexed, 3)                                                 \
@@ -89,6 +90,7 @@ namespace dart {
   V(String_charAt, 2)                                                          \
   V(String_codeUnitAt, 2)                                                      \
   V(String_concat, 2)                                                          \
+  V(ConsString_flatten, 1)                                                     \
   V(String_toLowerCase, 1)                                                     \
   V(String_toUpperCase, 1)                                                     \
   V(Strings_concatAll, 1)                                                      \
@@ -213,6 +213,8 @@ void ClassFinalizer::VerifyBootstrapClasses() {
   ASSERT(ExternalOneByteString::InstanceSize() == cls.instance_size());
   cls = object_store->external_two_byte_string_class();
   ASSERT(ExternalTwoByteString::InstanceSize() == cls.instance_size());
+  cls = object_store->cons_string_class();
+  ASSERT(ConsString::InstanceSize() == cls.instance_size());
   cls = object_store->double_class();
   ASSERT(Double::InstanceSize() == cls.instance_size());
   cls = object_store->bool_class();
@@ -1462,6 +1464,8 @@ void ClassFinalizer::FinalizeClass(const Class& cls) {
     ASSERT(!super_class.IsNull());
     super_class.AddDirectSubclass(cls);
   }
+  // Add the targets of the selectors already used by megamorphic calls.
+  Isolate::Current()->dispatch_table()->AddClass(cls);
 }
 
 
@@ -1680,6 +1684,7 @@ void ClassFinalizer::ResolveSuperTypeAndInterfaces(
       case kTwoByteStringCid:
       case kExternalOneByteStringCid:
       case kExternalTwoByteStringCid:
+      case kConsStringCid:
       case kBoolCid:
       case kArrayCid:
       case kImmutableArrayCid:
@@ -9,6 +9,7 @@
 #include "vm/bigint_operations.h"
 #include "vm/code_patcher.h"
 #include "vm/compiler.h"
+#include "vm/compiler_stats.h"
 #include "vm/dart_api_impl.h"
 #include "vm/dart_entry.h"
 #include "vm/debugger.h"
@@ -22,6 +23,7 @@
 #include "vm/resolver.h"
 #include "vm/runtime_entry.h"
 #include "vm/stack_frame.h"
+#include "vm/stub_code.h"
 #include "vm/symbols.h"
 #include "vm/verifier.h"
 
@@ -46,10 +48,12 @@ DEFINE_FLAG(int, optimization_counter_threshold, 3000,
 DEFINE_FLAG(int, optimization_counter_threshold, -1,
     "Function's usage-counter value before it is optimized, -1 means never");
 #endif
+DECLARE_FLAG(bool, compiler_stats);
 DECLARE_FLAG(bool, enable_type_checks);
 DECLARE_FLAG(bool, trace_type_checks);
 DECLARE_FLAG(bool, report_usage_count);
 DECLARE_FLAG(int, deoptimization_counter_threshold);
+DECLARE_FLAG(int, max_polymorphic_checks);
 DEFINE_FLAG(charp, optimization_filter, NULL, "Optimize only named function");
 DEFINE_FLAG(bool, trace_failed_optimization_attempts, false,
     "Traces all failed optimization attempts");
@@ -57,6 +61,8 @@ DEFINE_FLAG(bool, trace_optimized_ic_calls, false,
     "Trace IC calls in optimized code.");
 DEFINE_FLAG(int, reoptimization_counter_threshold, 2000,
     "Counter threshold before a function gets reoptimized.");
+DEFINE_FLAG(bool, monomorphic_calls, true,
+    "Call the target of monomorphic instance calls directly.");
 DEFINE_FLAG(int, max_subtype_cache_entries, 100,
     "Maximum number of subtype cache entries (number of checks cached).");
 
@@ -230,9 +236,41 @@ DEFINE_RUNTIME_ENTRY(InstantiateTypeArguments, 2) {
   // Code inlined in the caller should have optimized the case where the
   // instantiator can be reused as type argument vector.
   ASSERT(instantiator.IsNull() || !type_arguments.IsUninstantiatedIdentity());
-  type_arguments = InstantiatedTypeArguments::New(type_arguments, instantiator);
-  ASSERT(type_arguments.IsInstantiated());
-  arguments.SetReturn(type_arguments);
+  if (!type_arguments.IsTypeArguments() || type_arguments.InVMHeap()) {
+    type_arguments =
+        InstantiatedTypeArguments::New(type_arguments, instantiator);
+    ASSERT(type_arguments.IsInstantiated());
+    arguments.SetReturn(type_arguments);
+    return;
+  }
+  // Instantiate the vector eagerly and cache the canonical result in the
+  // uninstantiated vector, where optimized code probes it inline.
+  const TypeArguments& uninstantiated = TypeArguments::Cast(type_arguments);
+  AbstractTypeArguments& result = AbstractTypeArguments::Handle(
+      uninstantiated.LookupInstantiation(instantiator));
+  if (result.IsNull()) {
+    Error& malformed_error = Error::Handle();
+    result = uninstantiated.InstantiateFrom(instantiator, &malformed_error);
+    if (!malformed_error.IsNull()) {
+      // In checked mode, a bound is violated. Do not cache the result, so
+      // that the allocation reports the error when checking the bounds.
+      type_arguments =
+          InstantiatedTypeArguments::New(type_arguments, instantiator);
+      ASSERT(type_arguments.IsInstantiated());
+      arguments.SetReturn(type_arguments);
+      return;
+    }
+    result = result.Canonicalize();
+    if (uninstantiated.AddInstantiation(instantiator, result)) {
+      if (FLAG_compiler_stats) {
+        CompilerStats::num_instantiations_cached++;
+      }
+    } else if (FLAG_compiler_stats) {
+      CompilerStats::num_instantiation_cache_overflows++;
+    }
+  }
+  ASSERT(result.IsInstantiated());
+  arguments.SetReturn(result);
 }
 
 
@@ -454,42 +492,26 @@ static void UpdateTypeTestCache(
     instantiator_type_arguments = instantiator.GetTypeArguments();
   }
 
-  intptr_t last_instance_class_id = -1;
-  AbstractTypeArguments& last_instance_type_arguments =
-      AbstractTypeArguments::Handle();
-  AbstractTypeArguments& last_instantiator_type_arguments =
-      AbstractTypeArguments::Handle();
-  Bool& last_result = Bool::Handle();
   const intptr_t len = new_cache.NumberOfChecks();
   if (len >= FLAG_max_subtype_cache_entries) {
     return;
   }
-  for (intptr_t i = 0; i < len; ++i) {
-    new_cache.GetCheck(
-        i,
-        &last_instance_class_id,
-        &last_instance_type_arguments,
-        &last_instantiator_type_arguments,
-        &last_result);
-    if ((last_instance_class_id == instance_class.id()) &&
-        (last_instance_type_arguments.raw() == instance_type_arguments.raw()) &&
-        (last_instantiator_type_arguments.raw() ==
-         instantiator_type_arguments.raw())) {
-      if (FLAG_trace_type_checks) {
-        OS::PrintErr("%"Pd" ", i);
-        if (type_arguments_replaced) {
-          PrintTypeCheck("Duplicate cache entry (canonical.)", instance, type,
-              instantiator_type_arguments, result);
-        } else {
-          PrintTypeCheck("WARNING Duplicate cache entry", instance, type,
-              instantiator_type_arguments, result);
-        }
+  if (new_cache.HasCheck(instance_class.id(),
+                         instance_type_arguments,
+                         instantiator_type_arguments)) {
+    if (FLAG_trace_type_checks) {
+      if (type_arguments_replaced) {
+        PrintTypeCheck("Duplicate cache entry (canonical.)", instance, type,
+            instantiator_type_arguments, result);
+      } else {
+        PrintTypeCheck("WARNING Duplicate cache entry", instance, type,
+            instantiator_type_arguments, result);
       }
-      // Can occur if we have canonicalized arguments.
-      // TODO(srdjan): Investigate why this assert can fail.
-      // ASSERT(type_arguments_replaced);
-      return;
     }
+    // Can occur if we have canonicalized arguments.
+    // TODO(srdjan): Investigate why this assert can fail.
+    // ASSERT(type_arguments_replaced);
+    return;
   }
   if (!instantiator_type_arguments.IsInstantiatedTypeArguments()) {
     new_cache.AddCheck(instance_class.id(),
@@ -860,6 +882,78 @@ DEFINE_RUNTIME_ENTRY(BreakpointDynamicHandler, 0) {
 }
 
 
+static bool IsInstanceCallAt(const Code& code, uword return_address) {
+  const PcDescriptors& descriptors =
+      PcDescriptors::Handle(code.pc_descriptors());
+  for (intptr_t i = 0; i < descriptors.Length(); i++) {
+    if ((descriptors.PC(i) == return_address) &&
+        (descriptors.DescriptorKind(i) == PcDescriptors::kIcCall)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+
+static bool IsMonomorphicEntry(uword target) {
+  const Code& code = Code::Handle(Code::LookupCode(target));
+  return !code.IsNull() && (code.GetMonomorphicEntryPc() == target);
+}
+
+
+// Returns the address that the unoptimized instance call with the given IC
+// data should call: the monomorphic entry of the target if only one receiver
+// class was seen, the inline cache stub otherwise.
+static uword InstanceCallTarget(const ICData& ic_data) {
+  if (ic_data.NumberOfChecks() == 1) {
+    const Function& target = Function::Handle(ic_data.GetTargetAt(0));
+    // The code of the target may have been dropped by code aging.
+    if (target.HasCode()) {
+      const uword entry =
+          Code::Handle(target.CurrentCode()).GetMonomorphicEntryPc();
+      if (entry != 0) {
+        return entry;
+      }
+    }
+  }
+  return StubCode::OneArgCheckInlineCacheEntryPoint();
+}
+
+
+// Moves the one-argument instance call of unoptimized code at return_address
+// between the monomorphic state (calling the monomorphic entry of the target)
+// and the polymorphic state (calling the inline cache stub).
+static void UpdateInstanceCallSite(uword return_address,
+                                   const Code& caller_code,
+                                   const ICData& ic_data) {
+  ASSERT(!caller_code.is_optimized());
+  ASSERT(ic_data.num_args_tested() == 1);
+  const uword current_target =
+      CodePatcher::GetInstanceCallAt(return_address, caller_code, NULL, NULL);
+  const bool was_monomorphic = IsMonomorphicEntry(current_target);
+  if (!was_monomorphic &&
+      (current_target != StubCode::OneArgCheckInlineCacheEntryPoint())) {
+    // E.g., the call site is patched by the debugger.
+    return;
+  }
+  const uword new_target = InstanceCallTarget(ic_data);
+  if (new_target == current_target) {
+    return;
+  }
+  CodePatcher::PatchInstanceCallAt(return_address, caller_code, new_target);
+  if (FLAG_trace_ic) {
+    const bool is_monomorphic =
+        (new_target != StubCode::OneArgCheckInlineCacheEntryPoint());
+    OS::PrintErr("IC call at %#"Px" %s -> %s (%"Pd" checks) %#"Px"\n",
+        return_address,
+        was_monomorphic ? "monomorphic" : "polymorphic",
+        is_monomorphic ? "monomorphic" : "polymorphic",
+        ic_data.NumberOfChecks(),
+        new_target);
+  }
+}
+
+
 static RawFunction* InlineCacheMissHandler(
     const GrowableArray<const Instance*>& args,
     const ICData& ic_data,
@@ -892,6 +986,15 @@ static RawFunction* InlineCacheMissHandler(
     }
     ic_data.AddCheck(class_ids, target_function);
   }
+  if (FLAG_monomorphic_calls && (args.length() == 1)) {
+    DartFrameIterator iterator;
+    StackFrame* caller_frame = iterator.NextFrame();
+    ASSERT(caller_frame != NULL);
+    const Code& caller = Code::Handle(caller_frame->LookupDartCode());
+    if (!caller.is_optimized()) {
+      UpdateInstanceCallSite(caller_frame->pc(), caller, ic_data);
+    }
+  }
   if (FLAG_trace_ic_miss_in_optimized || FLAG_trace_ic) {
     DartFrameIterator iterator;
     StackFrame* caller_frame = iterator.NextFrame();
@@ -912,6 +1015,12 @@ static RawFunction* InlineCacheMissHandler(
           Class::Handle(receiver.clazz()).ToCString(),
           Class::Handle(receiver.clazz()).id(),
           target_function.ToCString());
+      if (ic_data.NumberOfChecks() == (FLAG_max_polymorphic_checks + 1)) {
+        OS::PrintErr("IC call at %#"Px" polymorphic -> megamorphic "
+                     "(%"Pd" checks)\n",
+            caller_frame->pc(),
+            ic_data.NumberOfChecks());
+      }
     }
   }
   return target_function.raw();
@@ -1047,6 +1156,16 @@ DEFINE_RUNTIME_ENTRY(MegamorphicCacheMissHandler, 3) {
   const Smi& class_id = Smi::Handle(Smi::New(
       is_null ? static_cast<intptr_t>(kNullCid) : cls.id()));
   cache.Insert(class_id, target);
+  if (!target.HasCode()) {
+    // Code aging dropped the code of the target while the cache was grown;
+    // now that it is cached, the target keeps its code.
+    const Error& error = Error::Handle(Compiler::CompileFunction(target));
+    if (!error.IsNull()) {
+      Exceptions::PropagateError(error);
+    }
+    instructions = Code::Handle(target.CurrentCode()).instructions();
+    arguments.SetReturn(instructions);
+  }
   return;
 }
 
@@ -1343,7 +1462,9 @@ DEFINE_RUNTIME_ENTRY(OptimizeInvokedFunction, 1) {
 
 
 // The caller must be a static call in a Dart frame, or an entry frame.
-// Patch static call to point to valid code's entry point.
+// Patch static call to point to valid code's entry point. Instance calls that
+// entered disabled code through its monomorphic entry are patched to call the
+// current code of the target.
 DEFINE_RUNTIME_ENTRY(FixCallersTarget, 0) {
   ASSERT(arguments.ArgCount() ==
       kFixCallersTargetRuntimeEntry.argument_count());
@@ -1361,6 +1482,26 @@ DEFINE_RUNTIME_ENTRY(FixCallersTarget, 0) {
   }
   ASSERT(frame->IsDartFrame());
   const Code& caller_code = Code::Handle(frame->LookupDartCode());
+  if (IsInstanceCallAt(caller_code, frame->pc())) {
+    // The caller entered disabled code through its monomorphic entry after
+    // the receiver class was checked.
+    ICData& ic_data = ICData::Handle();
+    CodePatcher::GetInstanceCallAt(frame->pc(), caller_code, &ic_data, NULL);
+    const Function& target_function =
+        Function::Handle(ic_data.GetTargetAt(0));
+    const Code& target_code = Code::Handle(target_function.CurrentCode());
+    const uword new_target = InstanceCallTarget(ic_data);
+    CodePatcher::PatchInstanceCallAt(frame->pc(), caller_code, new_target);
+    if (FLAG_trace_patching) {
+      OS::PrintErr("FixCallersTarget: patching instance call from %#"Px" "
+                   "to '%s' %#"Px"\n",
+          frame->pc(),
+          target_function.ToFullyQualifiedCString(),
+          new_target);
+    }
+    arguments.SetReturn(target_code);
+    return;
+  }
   const Function& target_function = Function::Handle(
       caller_code.GetStaticCallTargetFunctionAt(frame->pc()));
   const Code& target_code = Code::Handle(target_function.CurrentCode());
@@ -1597,10 +1738,10 @@ static intptr_t DeoptimizeWithDeoptInfo(const Code& code,
   // that describe stack frames. Skip them and defer materialization of
   // objects until the frame is fully reconstructed and it is safe to perform
   // GC.
-  // Arguments (class of the instance to allocate and field-value pairs) are
-  // described as part of the expression stack for the bottom-most deoptimized
-  // frame. They will be used during materialization and removed from the stack
-  // right before control switches to the unoptimized code.
+  // Arguments (class of the object to allocate, array length and slot-value
+  // pairs) are described as part of the expression stack for the bottom-most
+  // deoptimized frame. They will be used during materialization and removed
+  // from the stack right before control switches to the unoptimized code.
   const intptr_t num_materializations = len - frame_size;
   Isolate::Current()->PrepareForDeferredMaterialization(num_materializations);
   for (intptr_t from_index = 0, to_index = 1;
@@ -1765,4 +1906,23 @@ DEFINE_RUNTIME_ENTRY(UpdateFieldCid, 2) {
   field.UpdateCid(Class::Handle(value.clazz()).id());
 }
 
+
+// Copies a mutable box loaded from an unboxed field. Optimized code updates
+// such boxes in place, they must not escape from the field.
+//   Arg0: Mutable Double or Float32x4 box.
+//   Return value: A copy of the box.
+DEFINE_RUNTIME_ENTRY(CloneMutableBox, 1) {
+  ASSERT(arguments.ArgCount() ==
+         kCloneMutableBoxRuntimeEntry.argument_count());
+  const Instance& box = Instance::CheckedHandle(arguments.ArgAt(0));
+  ASSERT(box.raw()->IsMutableBox());
+  if (box.IsDouble()) {
+    arguments.SetReturn(
+        Double::Handle(Double::New(Double::Cast(box).value())));
+  } else {
+    arguments.SetReturn(
+        Float32x4::Handle(Float32x4::New(Float32x4::Cast(box).value())));
+  }
+}
+
 }  // namespace dart
@@ -51,6 +51,7 @@ DECLARE_RUNTIME_ENTRY(TraceFunctionExit);
 DECLARE_RUNTIME_ENTRY(DeoptimizeMaterialize);
 DECLARE_RUNTIME_ENTRY(UpdateICDataTwoArgs);
 DECLARE_RUNTIME_ENTRY(UpdateFieldCid);
+DECLARE_RUNTIME_ENTRY(CloneMutableBox);
 
 
 #define DEOPT_REASONS(V)                                                       \
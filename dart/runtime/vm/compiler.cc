@@ -9,6 +9,8 @@
 #include "vm/ast_printer.h"
 #include "vm/code_generator.h"
 #include "vm/code_patcher.h"
+#include "vm/compiler_stats.h"
+#include "vm/dart.h"
 #include "vm/dart_entry.h"
 #include "vm/debugger.h"
 #include "vm/deopt_instructions.h"
@@ -29,8 +31,11 @@
 #include "vm/os.h"
 #include "vm/parser.h"
 #include "vm/scanner.h"
+#include "vm/stack_frame.h"
+#include "vm/stub_code.h"
 #include "vm/symbols.h"
 #include "vm/timer.h"
+#include "vm/visitor.h"
 
 namespace dart {
 
@@ -53,6 +58,10 @@ DEFINE_FLAG(bool, use_inlining, true, "Enable call-site inlining");
 DEFINE_FLAG(bool, range_analysis, true, "Enable range analysis");
 DEFINE_FLAG(bool, verify_compiler, false,
     "Enable compiler verification assertions");
+DEFINE_FLAG(int, code_aging_threshold, 10,
+    "Drop the unoptimized code of functions that did not run during this "
+    "many old space collections, 0 disables code aging.");
+DEFINE_FLAG(bool, trace_code_aging, false, "Trace dropping of cold code.");
 DECLARE_FLAG(bool, print_flow_graph);
 DECLARE_FLAG(bool, print_flow_graph_optimized);
 DECLARE_FLAG(bool, trace_failed_optimization_attempts);
@@ -72,7 +81,7 @@ DEFINE_RUNTIME_ENTRY(CompileFunction, 1) {
 
 RawError* Compiler::Compile(const Library& library, const Script& script) {
   Isolate* isolate = Isolate::Current();
-  StackZone zone(isolate);
+  StackZone zone(isolate, Zone::kCompiler);
   LongJump* base = isolate->long_jump_base();
   LongJump jump;
   isolate->set_long_jump_base(&jump);
@@ -179,7 +188,10 @@ static bool CompileParsedFunctionHelper(const ParsedFunction& parsed_function,
                        isolate);
 
       FlowGraphOptimizer optimizer(flow_graph, &guarded_fields);
-      optimizer.ApplyICData();
+      {
+        CompilerPassScope pass(CompilerStats::kApplyICDataPass, flow_graph);
+        optimizer.ApplyICData();
+      }
       DEBUG_ASSERT(flow_graph->VerifyUseLists());
 
       // Optimize (a << b) & c patterns. Must occur before
@@ -193,6 +205,7 @@ static bool CompileParsedFunctionHelper(const ParsedFunction& parsed_function,
       if (FLAG_use_inlining) {
         TimerScope timer(FLAG_compiler_stats,
                          &CompilerStats::graphinliner_timer);
+        CompilerPassScope pass(CompilerStats::kInliningPass, flow_graph);
         FlowGraphInliner inliner(flow_graph, &guarded_fields);
         inliner.Inline();
         // Use lists are maintained and validated by the inliner.
@@ -201,6 +214,8 @@ static bool CompileParsedFunctionHelper(const ParsedFunction& parsed_function,
 
       // Propagate types and eliminate more type tests.
       if (FLAG_propagate_types) {
+        CompilerPassScope pass(CompilerStats::kTypePropagationPass,
+                               flow_graph);
         FlowGraphTypePropagator propagator(flow_graph);
         propagator.Propagate();
         DEBUG_ASSERT(flow_graph->VerifyUseLists());
@@ -221,6 +236,8 @@ static bool CompileParsedFunctionHelper(const ParsedFunction& parsed_function,
       DEBUG_ASSERT(flow_graph->VerifyUseLists());
 
       if (FLAG_constant_propagation) {
+        CompilerPassScope pass(CompilerStats::kConstantPropagationPass,
+                               flow_graph);
         ConstantPropagator::Optimize(flow_graph);
         DEBUG_ASSERT(flow_graph->VerifyUseLists());
         // A canonicalization pass to remove e.g. smi checks on smi constants.
@@ -236,6 +253,8 @@ static bool CompileParsedFunctionHelper(const ParsedFunction& parsed_function,
       if (FLAG_propagate_types) {
         // Recompute types after constant propagation to infer more precise
         // types for uses that were previously reached by now eliminated phis.
+        CompilerPassScope pass(CompilerStats::kTypePropagationPass,
+                               flow_graph);
         FlowGraphTypePropagator propagator(flow_graph);
         propagator.Propagate();
         DEBUG_ASSERT(flow_graph->VerifyUseLists());
@@ -253,6 +272,7 @@ static bool CompileParsedFunctionHelper(const ParsedFunction& parsed_function,
       }
 
       if (FLAG_common_subexpression_elimination) {
+        CompilerPassScope pass(CompilerStats::kCSEPass, flow_graph);
         if (DominatorBasedCSE::Optimize(flow_graph)) {
           DEBUG_ASSERT(flow_graph->VerifyUseLists());
           // Do another round of CSE to take secondary effects into account:
@@ -265,6 +285,7 @@ static bool CompileParsedFunctionHelper(const ParsedFunction& parsed_function,
       if (FLAG_loop_invariant_code_motion &&
           (parsed_function.function().deoptimization_counter() <
            (FLAG_deoptimization_counter_threshold - 1))) {
+        CompilerPassScope pass(CompilerStats::kLICMPass, flow_graph);
         LICM licm(flow_graph);
         licm.Optimize();
         DEBUG_ASSERT(flow_graph->VerifyUseLists());
@@ -275,6 +296,7 @@ static bool CompileParsedFunctionHelper(const ParsedFunction& parsed_function,
         // We have to perform range analysis after LICM because it
         // optimistically moves CheckSmi through phis into loop preheaders
         // making some phis smi.
+        CompilerPassScope pass(CompilerStats::kRangeAnalysisPass, flow_graph);
         optimizer.InferSmiRanges();
         DEBUG_ASSERT(flow_graph->VerifyUseLists());
       }
@@ -282,6 +304,8 @@ static bool CompileParsedFunctionHelper(const ParsedFunction& parsed_function,
       if (FLAG_constant_propagation) {
         // Constant propagation can use information from range analysis to
         // find unreachable branch targets.
+        CompilerPassScope pass(CompilerStats::kConstantPropagationPass,
+                               flow_graph);
         ConstantPropagator::OptimizeBranches(flow_graph);
         DEBUG_ASSERT(flow_graph->VerifyUseLists());
       }
@@ -290,6 +314,8 @@ static bool CompileParsedFunctionHelper(const ParsedFunction& parsed_function,
       if (FLAG_propagate_types) {
         // Recompute types after code movement was done to ensure correct
         // reaching types for hoisted values.
+        CompilerPassScope pass(CompilerStats::kTypePropagationPass,
+                               flow_graph);
         FlowGraphTypePropagator propagator(flow_graph);
         propagator.Propagate();
         DEBUG_ASSERT(flow_graph->VerifyUseLists());
@@ -304,6 +330,8 @@ static bool CompileParsedFunctionHelper(const ParsedFunction& parsed_function,
       // the deoptimization path.
       AllocationSinking* sinking = NULL;
       if (FLAG_allocation_sinking) {
+        CompilerPassScope pass(CompilerStats::kAllocationSinkingPass,
+                               flow_graph);
         sinking = new AllocationSinking(flow_graph);
         sinking->Optimize();
       }
@@ -327,8 +355,12 @@ static bool CompileParsedFunctionHelper(const ParsedFunction& parsed_function,
       }
 
       // Perform register allocation on the SSA graph.
-      FlowGraphAllocator allocator(*flow_graph);
-      allocator.AllocateRegisters();
+      {
+        CompilerPassScope pass(CompilerStats::kRegisterAllocationPass,
+                               flow_graph);
+        FlowGraphAllocator allocator(*flow_graph);
+        allocator.AllocateRegisters();
+      }
 
       if (FLAG_print_flow_graph || FLAG_print_flow_graph_optimized) {
         FlowGraphPrinter::PrintGraph("After Optimizations", flow_graph);
@@ -529,10 +561,31 @@ static void DisassembleCode(const Function& function, bool optimized) {
 }
 
 
+// Suspends code aging while a function is being compiled: the compiler
+// refers to the unoptimized code of the function and of inlined callees.
+class CompilationScope : public StackResource {
+ public:
+  explicit CompilationScope(Isolate* isolate)
+      : StackResource(isolate), isolate_(isolate) {
+    isolate_->set_compilation_depth(isolate_->compilation_depth() + 1);
+  }
+
+  ~CompilationScope() {
+    isolate_->set_compilation_depth(isolate_->compilation_depth() - 1);
+  }
+
+ private:
+  Isolate* isolate_;
+
+  DISALLOW_COPY_AND_ASSIGN(CompilationScope);
+};
+
+
 static RawError* CompileFunctionHelper(const Function& function,
                                        bool optimized) {
   Isolate* isolate = Isolate::Current();
-  StackZone zone(isolate);
+  StackZone zone(isolate, Zone::kCompiler);
+  CompilationScope compilation_scope(isolate);
   LongJump* base = isolate->long_jump_base();
   LongJump jump;
   isolate->set_long_jump_base(&jump);
@@ -544,7 +597,8 @@ static RawError* CompileFunctionHelper(const Function& function,
   }
   if (setjmp(*jump.Set()) == 0) {
     TIMERSCOPE(time_compilation);
-    Timer per_compile_timer(FLAG_trace_compiler, "Compilation time");
+    Timer per_compile_timer(FLAG_trace_compiler || FLAG_compiler_stats,
+                            "Compilation time");
     per_compile_timer.Start();
     ParsedFunction* parsed_function = new ParsedFunction(
         Function::ZoneHandle(function.raw()));
@@ -579,6 +633,14 @@ static RawError* CompileFunctionHelper(const Function& function,
     ASSERT(success);
     per_compile_timer.Stop();
 
+    if (FLAG_compiler_stats) {
+      CompilerStats::RecordCompilation(
+          function,
+          optimized,
+          per_compile_timer.TotalElapsedTime(),
+          Code::Handle(function.CurrentCode()).Size());
+    }
+
     if (FLAG_trace_compiler) {
       OS::Print("--> '%s' entry: %#"Px" size: %"Pd" time: %"Pd64" us\n",
                 function.ToFullyQualifiedCString(),
@@ -739,4 +801,227 @@ RawObject* Compiler::ExecuteOnce(SequenceNode* fragment) {
   return Object::null();
 }
 
+
+// Collects the functions, code objects and megamorphic caches of the old
+// space without allocating.
+class CodeAgingVisitor : public ObjectVisitor {
+ public:
+  CodeAgingVisitor(Isolate* isolate,
+                   GrowableArray<RawFunction*>* functions,
+                   GrowableArray<RawCode*>* codes,
+                   GrowableArray<RawMegamorphicCache*>* caches)
+      : ObjectVisitor(isolate),
+        functions_(functions),
+        codes_(codes),
+        caches_(caches) { }
+
+  void VisitObject(RawObject* raw_obj) {
+    const intptr_t cid = raw_obj->GetClassId();
+    if (cid == kFunctionCid) {
+      functions_->Add(reinterpret_cast<RawFunction*>(raw_obj));
+    } else if (cid == kCodeCid) {
+      codes_->Add(reinterpret_cast<RawCode*>(raw_obj));
+    } else if (cid == kMegamorphicCacheCid) {
+      caches_->Add(reinterpret_cast<RawMegamorphicCache*>(raw_obj));
+    }
+  }
+
+ private:
+  GrowableArray<RawFunction*>* functions_;
+  GrowableArray<RawCode*>* codes_;
+  GrowableArray<RawMegamorphicCache*>* caches_;
+
+  DISALLOW_COPY_AND_ASSIGN(CodeAgingVisitor);
+};
+
+
+static int CompareAddresses(const uword* a, const uword* b) {
+  if (*a < *b) return -1;
+  if (*a > *b) return 1;
+  return 0;
+}
+
+
+static bool ContainsAddress(const GrowableArray<uword>& sorted, uword value) {
+  intptr_t low = 0;
+  intptr_t high = sorted.length() - 1;
+  while (low <= high) {
+    const intptr_t mid = low + (high - low) / 2;
+    if (sorted[mid] < value) {
+      low = mid + 1;
+    } else if (sorted[mid] > value) {
+      high = mid - 1;
+    } else {
+      return true;
+    }
+  }
+  return false;
+}
+
+
+// Resets the age of all functions in the array: their unoptimized code is
+// still needed, e.g., to deoptimize into.
+static void KeepFunctionsIn(const Array& array) {
+  Object& obj = Object::Handle();
+  for (intptr_t i = 0; i < array.Length(); i++) {
+    obj = array.At(i);
+    if (obj.IsFunction()) {
+      Function::Cast(obj).set_code_age(0);
+    }
+  }
+}
+
+
+void Compiler::AgeCode(Isolate* isolate) {
+  if ((FLAG_code_aging_threshold <= 0) ||
+      !FlowGraphCompiler::CanOptimize() ||
+      (isolate == Dart::vm_isolate()) ||
+      (isolate->compilation_depth() > 0) ||
+      (isolate->debugger() == NULL) ||
+      isolate->debugger()->HasCodeBreakpoints()) {
+    return;
+  }
+  StackZone zone(isolate, Zone::kCompiler);
+  HANDLESCOPE(isolate);
+  GrowableArray<RawFunction*> functions;
+  GrowableArray<RawCode*> codes;
+  GrowableArray<RawMegamorphicCache*> caches;
+  {
+    NoGCScope no_gc;
+    CodeAgingVisitor visitor(isolate, &functions, &codes, &caches);
+    isolate->heap()->IterateOldObjects(&visitor);
+  }
+
+  // Age all functions running unoptimized code; the prologue of the
+  // unoptimized code resets the age.
+  Function& function = Function::Handle(isolate);
+  Code& code = Code::Handle(isolate);
+  for (intptr_t i = 0; i < functions.length(); i++) {
+    function = functions[i];
+    if (function.HasCode()) {
+      function.set_code_age(function.code_age() + 1);
+    }
+  }
+
+  // Keep the code of functions that optimized code may deoptimize into.
+  for (intptr_t i = 0; i < codes.length(); i++) {
+    code = codes[i];
+    if (code.is_optimized()) {
+      function = code.function();
+      if (!function.IsNull()) {
+        function.set_code_age(0);
+      }
+      KeepFunctionsIn(Array::Handle(isolate, code.object_table()));
+    }
+  }
+  // Keep the code of functions that are active on the stack.
+  StackFrameIterator frames(StackFrameIterator::kDontValidateFrames);
+  for (StackFrame* frame = frames.NextFrame();
+       frame != NULL;
+       frame = frames.NextFrame()) {
+    if (frame->IsDartFrame()) {
+      code = frame->LookupDartCode();
+      if (!code.IsNull()) {
+        function = code.function();
+        if (!function.IsNull()) {
+          function.set_code_age(0);
+        }
+      }
+    }
+  }
+  // Megamorphic call sites jump to the code of cached targets directly.
+  MegamorphicCache& cache = MegamorphicCache::Handle(isolate);
+  for (intptr_t i = 0; i < caches.length(); i++) {
+    cache = caches[i];
+    KeepFunctionsIn(Array::Handle(isolate, cache.buckets()));
+  }
+
+  // Drop the unoptimized code of functions that did not run recently.
+  GrowableArray<uword> dropped_codes;
+  GrowableArray<uword> dropped_entries;
+  PcDescriptors& descriptors = PcDescriptors::Handle(isolate);
+  for (intptr_t i = 0; i < functions.length(); i++) {
+    function = functions[i];
+    if ((function.code_age() <= FLAG_code_aging_threshold) ||
+        !function.HasCode() ||
+        function.HasOptimizedCode() ||
+        !function.is_optimizable()) {
+      continue;
+    }
+    code = function.CurrentCode();
+    if (code.raw() != function.unoptimized_code()) {
+      // E.g., stub code installed by the VM.
+      continue;
+    }
+    descriptors = code.pc_descriptors();
+    if (descriptors.GetPcForKind(PcDescriptors::kEntryPatch) == 0) {
+      // Intrinsified code does not reset the age of the function.
+      continue;
+    }
+    dropped_codes.Add(reinterpret_cast<uword>(code.raw()));
+    const uword monomorphic_entry = code.GetMonomorphicEntryPc();
+    if (monomorphic_entry != 0) {
+      dropped_entries.Add(monomorphic_entry);
+    }
+    CompilerStats::code_reclaimed += code.Size();
+    CompilerStats::num_functions_aged_out++;
+    if (FLAG_trace_code_aging) {
+      OS::Print("Code aging: dropping code of '%s' %#"Px" size: %"Pd"\n",
+                String::Handle(isolate, function.name()).ToCString(),
+                code.EntryPoint(),
+                code.Size());
+    }
+    function.ClearCode();
+  }
+  if (dropped_codes.is_empty()) {
+    return;
+  }
+  dropped_codes.Sort(CompareAddresses);
+  dropped_entries.Sort(CompareAddresses);
+
+  // Unlink call sites that target dropped code: static calls go through the
+  // static call stub again, instance calls through the inline cache stub.
+  const uword call_static_entry = StubCode::CallStaticFunctionEntryPoint();
+  const uword inline_cache_entry =
+      StubCode::OneArgCheckInlineCacheEntryPoint();
+  Array& table = Array::Handle(isolate);
+  Smi& offset = Smi::Handle(isolate);
+  for (intptr_t i = 0; i < codes.length(); i++) {
+    if (ContainsAddress(dropped_codes, reinterpret_cast<uword>(codes[i]))) {
+      continue;
+    }
+    code = codes[i];
+    table = code.static_calls_target_table();
+    if (!table.IsNull()) {
+      for (intptr_t j = 0;
+           j < table.Length();
+           j += Code::kSCallTableEntryLength) {
+        const uword target_code = reinterpret_cast<uword>(
+            table.At(j + Code::kSCallTableCodeEntry));
+        if (ContainsAddress(dropped_codes, target_code)) {
+          offset ^= table.At(j + Code::kSCallTableOffsetEntry);
+          CodePatcher::PatchStaticCallAt(code.EntryPoint() + offset.Value(),
+                                         code,
+                                         call_static_entry);
+          table.SetAt(j + Code::kSCallTableCodeEntry, Code::Handle(isolate));
+        }
+      }
+    }
+    if (code.is_optimized() || dropped_entries.is_empty()) {
+      continue;
+    }
+    descriptors = code.pc_descriptors();
+    for (intptr_t j = 0; j < descriptors.Length(); j++) {
+      if (descriptors.DescriptorKind(j) == PcDescriptors::kIcCall) {
+        const uword target = CodePatcher::GetInstanceCallAt(
+            descriptors.PC(j), code, NULL, NULL);
+        if (ContainsAddress(dropped_entries, target)) {
+          CodePatcher::PatchInstanceCallAt(
+              descriptors.PC(j), code, inline_cache_entry);
+        }
+      }
+    }
+  }
+}
+
 }  // namespace dart
@@ -14,6 +14,7 @@ namespace dart {
 // Forward declarations.
 class Class;
 class Function;
+class Isolate;
 class Library;
 class ParsedFunction;
 class RawInstance;
@@ -58,6 +59,12 @@ class Compiler : public AllStatic {
   //
   // Returns Error::null() if there is no compilation error.
   static RawError* CompileAllFunctions(const Class& cls);
+
+  // Drops the unoptimized code of functions that have not been executed
+  // during the last --code_aging_threshold old space collections. Call sites
+  // targeting dropped code are reset so that the function is compiled again
+  // on its next invocation. Called before old space collections.
+  static void AgeCode(Isolate* isolate);
 };
 
 }  // namespace dart
@@ -4,17 +4,37 @@
 
 #include "vm/compiler_stats.h"
 
+#include "platform/json.h"
+#include "platform/utils.h"
 #include "vm/flags.h"
+#include "vm/flow_graph.h"
+#include "vm/object.h"
 #include "vm/timer.h"
 
 
 namespace dart {
 
 DEFINE_FLAG(bool, compiler_stats, false, "Compiler stat counters.");
+DEFINE_FLAG(bool, compiler_stats_json, false,
+    "Print compiler stat counters as JSON.");
+DEFINE_FLAG(int, compiler_stats_top, 10,
+    "Number of slowest compilations reported by --compiler_stats.");
 
 // Bytes allocated for generated code.
 intptr_t CompilerStats::code_allocated = 0;
 
+// Bytes of unoptimized code dropped by code aging.
+intptr_t CompilerStats::code_reclaimed = 0;
+
+// Number of functions whose unoptimized code was dropped by code aging.
+intptr_t CompilerStats::num_functions_aged_out = 0;
+
+// Number of instantiated type argument vectors added to instantiation caches.
+intptr_t CompilerStats::num_instantiations_cached = 0;
+
+// Number of instantiations not cached because the instantiation cache was full.
+intptr_t CompilerStats::num_instantiation_cache_overflows = 0;
+
 // Total number of characters in source.
 intptr_t CompilerStats::src_length = 0;
 
@@ -61,10 +81,110 @@ intptr_t CompilerStats::num_token_checks = 0;
 intptr_t CompilerStats::num_tokens_rewind = 0;
 intptr_t CompilerStats::num_tokens_lookahead = 0;
 
+intptr_t CompilerStats::pass_count[CompilerStats::kNumPasses] = { 0 };
+int64_t CompilerStats::pass_usecs[CompilerStats::kNumPasses] = { 0 };
+intptr_t CompilerStats::pass_il_before[CompilerStats::kNumPasses] = { 0 };
+intptr_t CompilerStats::pass_il_after[CompilerStats::kNumPasses] = { 0 };
+
+intptr_t CompilerStats::num_functions_compiled = 0;
+intptr_t CompilerStats::num_functions_optimized = 0;
+
+
+const char* CompilerStats::PassName(Pass pass) {
+  switch (pass) {
+#define PASS_NAME_CASE(name, msg)                                              \
+    case k##name##Pass: return msg;
+  COMPILER_PASS_LIST(PASS_NAME_CASE)
+#undef PASS_NAME_CASE
+    default:
+      UNREACHABLE();
+      return NULL;
+  }
+}
+
+
+// The slowest compilations, sorted by decreasing compilation time.
+struct CompilationRecord {
+  char* name;
+  bool optimized;
+  int64_t usecs;
+  intptr_t code_size;
+};
+
+static const intptr_t kMaxSlowestCompilations = 100;
+static CompilationRecord slowest_compilations[kMaxSlowestCompilations];
+static intptr_t num_slowest_compilations = 0;
+
+
+static intptr_t SlowestCompilationsLimit() {
+  if (FLAG_compiler_stats_top < 0) {
+    return 0;
+  }
+  return Utils::Minimum(static_cast<intptr_t>(FLAG_compiler_stats_top),
+                        kMaxSlowestCompilations);
+}
+
+
+void CompilerStats::RecordCompilation(const Function& function,
+                                      bool optimized,
+                                      int64_t usecs,
+                                      intptr_t code_size) {
+  if (optimized) {
+    num_functions_optimized++;
+  } else {
+    num_functions_compiled++;
+  }
+  const intptr_t limit = SlowestCompilationsLimit();
+  intptr_t index = num_slowest_compilations;
+  if (index == limit) {
+    if ((limit == 0) || (slowest_compilations[limit - 1].usecs >= usecs)) {
+      return;
+    }
+    // Evict the fastest entry.
+    index--;
+    free(slowest_compilations[index].name);
+  } else {
+    num_slowest_compilations++;
+  }
+  while ((index > 0) && (slowest_compilations[index - 1].usecs < usecs)) {
+    slowest_compilations[index] = slowest_compilations[index - 1];
+    index--;
+  }
+  const char* name = function.ToFullyQualifiedCString();
+  slowest_compilations[index].name = OS::StrNDup(name, strlen(name));
+  slowest_compilations[index].optimized = optimized;
+  slowest_compilations[index].usecs = usecs;
+  slowest_compilations[index].code_size = code_size;
+}
+
+
+CompilerPassScope::CompilerPassScope(CompilerStats::Pass pass,
+                                     FlowGraph* flow_graph)
+    : pass_(pass), flow_graph_(flow_graph), start_(0) {
+  if (FLAG_compiler_stats) {
+    CompilerStats::pass_il_before[pass_] += flow_graph_->InstructionCount();
+    start_ = OS::GetCurrentTimeMicros();
+  }
+}
+
+
+CompilerPassScope::~CompilerPassScope() {
+  if (FLAG_compiler_stats) {
+    CompilerStats::pass_usecs[pass_] += OS::GetCurrentTimeMicros() - start_;
+    CompilerStats::pass_count[pass_]++;
+    CompilerStats::pass_il_after[pass_] += flow_graph_->InstructionCount();
+  }
+}
+
+
 void CompilerStats::Print() {
   if (!FLAG_compiler_stats) {
     return;
   }
+  if (FLAG_compiler_stats_json) {
+    PrintJSON();
+    return;
+  }
   OS::Print("==== Compiler Stats ====\n");
   OS::Print("Number of tokens:   %"Pd"\n", num_tokens_total);
   OS::Print("  Literal tokens:   %"Pd"\n", num_literal_tokens_total);
@@ -130,6 +250,101 @@ void CompilerStats::Print() {
             code_allocated / 1024);
   OS::Print("Code density:       %"Pd" tokens per KB\n",
             num_tokens_total * 1024 / code_allocated);
+  OS::Print("Code reclaimed:     %"Pd" KB (%"Pd" functions)\n",
+            code_reclaimed / 1024, num_functions_aged_out);
+  OS::Print("Instantiations:     %"Pd" cached (%"Pd" overflows)\n",
+            num_instantiations_cached, num_instantiation_cache_overflows);
+  const intptr_t num_compilations =
+      num_functions_compiled + num_functions_optimized;
+  OS::Print("Compilations:       %"Pd" (%"Pd" optimized)\n",
+            num_compilations, num_functions_optimized);
+  if (num_compilations > 0) {
+    OS::Print("Code per function:  %"Pd" bytes\n",
+              code_allocated / num_compilations);
+  }
+
+  OS::Print("Optimization passes (time, runs, IL before -> after):\n");
+  for (intptr_t i = 0; i < kNumPasses; i++) {
+    if (pass_count[i] == 0) continue;
+    OS::Print("  %-20s %6"Pd64" msecs %6"Pd" %8"Pd" -> %"Pd"\n",
+              PassName(static_cast<Pass>(i)),
+              pass_usecs[i] / 1000,
+              pass_count[i],
+              pass_il_before[i],
+              pass_il_after[i]);
+  }
+
+  if (num_slowest_compilations > 0) {
+    OS::Print("Slowest compilations (time, code size):\n");
+    for (intptr_t i = 0; i < num_slowest_compilations; i++) {
+      const CompilationRecord& record = slowest_compilations[i];
+      OS::Print("  %6"Pd64" usecs %6"Pd" bytes %s%s\n",
+                record.usecs,
+                record.code_size,
+                record.optimized ? "optimized " : "",
+                record.name);
+    }
+  }
+}
+
+
+void CompilerStats::PrintJSON() {
+  TextBuffer buffer(1024);
+  buffer.Printf("{ \"tokens\": %"Pd", ", num_tokens_total);
+  buffer.Printf("\"source_length\": %"Pd", ", src_length);
+  buffer.Printf("\"usecs\": { ");
+  buffer.Printf("\"scanner\": %"Pd64", ", scanner_timer.TotalElapsedTime());
+  buffer.Printf("\"parser\": %"Pd64", ", parser_timer.TotalElapsedTime());
+  buffer.Printf("\"codegen\": %"Pd64", ", codegen_timer.TotalElapsedTime());
+  buffer.Printf("\"graph_builder\": %"Pd64", ",
+                graphbuilder_timer.TotalElapsedTime());
+  buffer.Printf("\"ssa\": %"Pd64", ", ssa_timer.TotalElapsedTime());
+  buffer.Printf("\"graph_inliner\": %"Pd64", ",
+                graphinliner_timer.TotalElapsedTime());
+  buffer.Printf("\"graph_optimizer\": %"Pd64", ",
+                graphoptimizer_timer.TotalElapsedTime());
+  buffer.Printf("\"graph_compiler\": %"Pd64", ",
+                graphcompiler_timer.TotalElapsedTime());
+  buffer.Printf("\"code_finalizer\": %"Pd64" }, ",
+                codefinalizer_timer.TotalElapsedTime());
+  buffer.Printf("\"code_allocated\": %"Pd", ", code_allocated);
+  buffer.Printf("\"code_reclaimed\": %"Pd", ", code_reclaimed);
+  buffer.Printf("\"instantiations_cached\": %"Pd", ",
+                num_instantiations_cached);
+  buffer.Printf("\"instantiation_cache_overflows\": %"Pd", ",
+                num_instantiation_cache_overflows);
+  buffer.Printf("\"functions_compiled\": %"Pd", ", num_functions_compiled);
+  buffer.Printf("\"functions_optimized\": %"Pd", ", num_functions_optimized);
+  buffer.Printf("\"passes\": [ ");
+  for (intptr_t i = 0; i < kNumPasses; i++) {
+    if (i > 0) {
+      buffer.Printf(", ");
+    }
+    buffer.Printf("{ \"name\": \"%s\", \"runs\": %"Pd", "
+                  "\"usecs\": %"Pd64", \"il_before\": %"Pd", "
+                  "\"il_after\": %"Pd" }",
+                  PassName(static_cast<Pass>(i)),
+                  pass_count[i],
+                  pass_usecs[i],
+                  pass_il_before[i],
+                  pass_il_after[i]);
+  }
+  buffer.Printf("], \"slowest_compilations\": [ ");
+  for (intptr_t i = 0; i < num_slowest_compilations; i++) {
+    const CompilationRecord& record = slowest_compilations[i];
+    if (i > 0) {
+      buffer.Printf(", ");
+    }
+    buffer.Printf("{ \"function\": \"");
+    buffer.AddEscapedString(record.name);
+    buffer.Printf("\", \"optimized\": %s, \"usecs\": %"Pd64", "
+                  "\"code_size\": %"Pd" }",
+                  record.optimized ? "true" : "false",
+                  record.usecs,
+                  record.code_size);
+  }
+  buffer.Printf("]}");
+  OS::Print("%s\n", buffer.buf());
 }
 
 }  // namespace dart
@@ -15,9 +15,33 @@ namespace dart {
 
 DECLARE_FLAG(bool, compiler_stats);
 
+class FlowGraph;
+class Function;
+
+// Passes of the optimizing compiler that are measured individually. Load
+// elimination runs as part of CSE and is included in its numbers.
+#define COMPILER_PASS_LIST(V)                                                  \
+  V(ApplyICData, "ApplyICData")                                                \
+  V(Inlining, "Inlining")                                                      \
+  V(TypePropagation, "TypePropagation")                                        \
+  V(ConstantPropagation, "ConstantPropagation")                                \
+  V(RangeAnalysis, "RangeAnalysis")                                            \
+  V(LICM, "LICM")                                                              \
+  V(CSE, "CSE")                                                                \
+  V(LoadElimination, "LoadElimination")                                        \
+  V(AllocationSinking, "AllocationSinking")                                    \
+  V(RegisterAllocation, "RegisterAllocation")                                  \
+
 
 class CompilerStats : AllStatic {
  public:
+  enum Pass {
+#define DEFINE_PASS_ENUM(name, msg) k##name##Pass,
+  COMPILER_PASS_LIST(DEFINE_PASS_ENUM)
+#undef DEFINE_PASS_ENUM
+    kNumPasses
+  };
+
   static intptr_t num_tokens_total;
   static intptr_t num_literal_tokens_total;
   static intptr_t num_ident_tokens_total;
@@ -28,6 +52,10 @@ class CompilerStats : AllStatic {
 
   static intptr_t src_length;        // Total number of characters in source.
   static intptr_t code_allocated;    // Bytes allocated for generated code.
+  static intptr_t code_reclaimed;    // Bytes of code dropped by code aging.
+  static intptr_t num_functions_aged_out;  // Functions whose code was dropped.
+  static intptr_t num_instantiations_cached;  // Type argument vectors cached.
+  static intptr_t num_instantiation_cache_overflows;  // Not cached, full.
   static Timer parser_timer;         // Cumulative runtime of parser.
   static Timer scanner_timer;        // Cumulative runtime of scanner.
   static Timer codegen_timer;        // Cumulative runtime of code generator.
@@ -46,7 +74,44 @@ class CompilerStats : AllStatic {
   static Timer graphcompiler_timer;   // Included in codegen_timer.
   static Timer codefinalizer_timer;   // Included in codegen_timer.
 
+  // Per pass statistics, see COMPILER_PASS_LIST.
+  static intptr_t pass_count[kNumPasses];      // Number of runs.
+  static int64_t pass_usecs[kNumPasses];       // Cumulative runtime.
+  static intptr_t pass_il_before[kNumPasses];  // IL instructions before.
+  static intptr_t pass_il_after[kNumPasses];   // IL instructions after.
+
+  static intptr_t num_functions_compiled;   // Unoptimized compilations.
+  static intptr_t num_functions_optimized;  // Optimized compilations.
+
+  static const char* PassName(Pass pass);
+
+  // Records a finished compilation of function for the report of the
+  // slowest compilations.
+  static void RecordCompilation(const Function& function,
+                                bool optimized,
+                                int64_t usecs,
+                                intptr_t code_size);
+
+  // Prints a human readable report, or JSON with --compiler_stats_json.
   static void Print();
+  static void PrintJSON();
+};
+
+
+// Measures a pass of the optimizing compiler if --compiler_stats is set:
+// accumulates its runtime and the size of the flow graph before and after
+// the pass in CompilerStats.
+class CompilerPassScope : public ValueObject {
+ public:
+  CompilerPassScope(CompilerStats::Pass pass, FlowGraph* flow_graph);
+  ~CompilerPassScope();
+
+ private:
+  const CompilerStats::Pass pass_;
+  FlowGraph* flow_graph_;
+  int64_t start_;
+
+  DISALLOW_COPY_AND_ASSIGN(CompilerPassScope);
 };
 
 
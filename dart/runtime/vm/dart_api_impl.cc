@@ -96,6 +96,7 @@ RawObject* Api::UnwrapHandle(Dart_Handle object) {
   ASSERT(state != NULL);
   ASSERT(state->IsValidLocalHandle(object) ||
          state->IsValidPersistentHandle(object) ||
+         state->IsValidPinnedHandle(object) ||
          state->IsValidWeakPersistentHandle(object) ||
          state->IsValidPrologueWeakPersistentHandle(object));
   ASSERT(FinalizablePersistentHandle::raw_offset() == 0 &&
@@ -210,6 +211,24 @@ Dart_Handle Api::AcquiredError(Isolate* isolate) {
 }
 
 
+void Api::SetupNativeArgumentError(Isolate* isolate) {
+  ASSERT(isolate != NULL);
+  ApiState* state = isolate->api_state();
+  ASSERT(state != NULL);
+  state->SetupNativeArgumentError();
+}
+
+
+Dart_Handle Api::NativeArgumentError(Isolate* isolate) {
+  ASSERT(isolate != NULL);
+  ApiState* state = isolate->api_state();
+  ASSERT(state != NULL);
+  PersistentHandle* native_argument_error_handle =
+      state->NativeArgumentError();
+  return reinterpret_cast<Dart_Handle>(native_argument_error_handle);
+}
+
+
 Dart_Handle Api::Null(Isolate* isolate) {
   ASSERT(isolate != NULL);
   ApiState* state = isolate->api_state();
@@ -865,7 +884,9 @@ DART_EXPORT void Dart_EnterIsolate(Dart_Isolate dart_isolate) {
 
 
 DART_EXPORT void Dart_ExitIsolate() {
-  CHECK_ISOLATE(Isolate::Current());
+  Isolate* isolate = Isolate::Current();
+  CHECK_ISOLATE(isolate);
+  isolate->TrimZoneSegmentCache();
   Isolate::SetCurrent(NULL);
 }
 
@@ -2481,9 +2502,10 @@ static Dart_Handle NewByteData(Isolate* isolate, intptr_t length) {
 
 static Dart_Handle NewTypedData(Isolate* isolate,
                                 intptr_t cid,
-                                intptr_t length) {
+                                intptr_t length,
+                                Heap::Space space = Heap::kNew) {
   CHECK_LENGTH(length, TypedData::MaxElements(cid));
-  return Api::NewHandle(isolate, TypedData::New(cid, length));
+  return Api::NewHandle(isolate, TypedData::New(cid, length, space));
 }
 
 
@@ -2584,6 +2606,59 @@ DART_EXPORT Dart_Handle Dart_NewTypedData(Dart_TypedData_Type type,
 }
 
 
+DART_EXPORT Dart_Handle Dart_NewTypedDataInOldSpace(Dart_TypedData_Type type,
+                                                    intptr_t length) {
+  Isolate* isolate = Isolate::Current();
+  DARTSCOPE(isolate);
+  CHECK_CALLBACK_STATE(isolate);
+  intptr_t cid = kIllegalCid;
+  switch (type) {
+    case kInt8 :
+      cid = kTypedDataInt8ArrayCid;
+      break;
+    case kUint8 :
+      cid = kTypedDataUint8ArrayCid;
+      break;
+    case kUint8Clamped :
+      cid = kTypedDataUint8ClampedArrayCid;
+      break;
+    case kInt16 :
+      cid = kTypedDataInt16ArrayCid;
+      break;
+    case kUint16 :
+      cid = kTypedDataUint16ArrayCid;
+      break;
+    case kInt32 :
+      cid = kTypedDataInt32ArrayCid;
+      break;
+    case kUint32 :
+      cid = kTypedDataUint32ArrayCid;
+      break;
+    case kInt64 :
+      cid = kTypedDataInt64ArrayCid;
+      break;
+    case kUint64 :
+      cid = kTypedDataUint64ArrayCid;
+      break;
+    case kFloat32 :
+      cid = kTypedDataFloat32ArrayCid;
+      break;
+    case kFloat64 :
+      cid = kTypedDataFloat64ArrayCid;
+      break;
+    case kFloat32x4:
+      cid = kTypedDataFloat32x4ArrayCid;
+      break;
+    default:
+      // ByteData is allocated by Dart code, which always allocates in
+      // new space.
+      return Api::NewError("%s expects argument 'type' to be of 'TypedData' "
+                           "other than kByteData.", CURRENT_FUNC);
+  }
+  return NewTypedData(isolate, cid, length, Heap::kOld);
+}
+
+
 DART_EXPORT Dart_Handle Dart_NewExternalTypedData(
     Dart_TypedData_Type type,
     void* data,
@@ -2777,6 +2852,117 @@ DART_EXPORT Dart_Handle Dart_TypedDataReleaseData(Dart_Handle object) {
 }
 
 
+// Returns false if the data of the typed data object or view may still be
+// moved by a scavenge. Old space is not compacted, so data in old space and
+// external data keep their address for as long as the object is alive.
+static bool GetPinnableData(const Instance& obj,
+                            intptr_t class_id,
+                            void** data,
+                            intptr_t* len,
+                            intptr_t* size_in_bytes) {
+  intptr_t offset_in_bytes = 0;
+  intptr_t element_size = 0;
+  Instance& data_obj = Instance::Handle();
+  if (RawObject::IsTypedDataViewClassId(class_id)) {
+    data_obj = TypedDataView::Data(obj);
+    *len = Smi::Value(TypedDataView::Length(obj));
+    offset_in_bytes = Smi::Value(TypedDataView::OffsetInBytes(obj));
+    element_size = TypedDataView::ElementSizeInBytes(obj);
+  } else {
+    data_obj = obj.raw();
+    if (RawObject::IsTypedDataClassId(class_id)) {
+      *len = TypedData::Cast(obj).Length();
+      element_size = TypedData::Cast(obj).ElementSizeInBytes();
+    } else {
+      ASSERT(RawObject::IsExternalTypedDataClassId(class_id));
+      *len = ExternalTypedData::Cast(obj).Length();
+      element_size = ExternalTypedData::Cast(obj).ElementSizeInBytes();
+    }
+  }
+  *size_in_bytes = *len * element_size;
+  if (TypedData::IsTypedData(data_obj)) {
+    if (data_obj.raw()->IsNewObject()) {
+      return false;
+    }
+    const TypedData& typed_data = TypedData::Cast(data_obj);
+    *data = (*size_in_bytes == 0) ?
+        NULL : typed_data.DataAddr(offset_in_bytes);
+  } else {
+    ASSERT(ExternalTypedData::IsExternalTypedData(data_obj));
+    const ExternalTypedData& external_data = ExternalTypedData::Cast(data_obj);
+    *data = (*size_in_bytes == 0) ?
+        NULL : external_data.DataAddr(offset_in_bytes);
+  }
+  return true;
+}
+
+
+DART_EXPORT Dart_Handle Dart_TypedDataPin(Dart_Handle object,
+                                          Dart_TypedData_Type* type,
+                                          void** data,
+                                          intptr_t* len,
+                                          Dart_Handle* pinned) {
+  Isolate* isolate = Isolate::Current();
+  DARTSCOPE(isolate);
+  intptr_t class_id = Api::ClassId(object);
+  if (!RawObject::IsExternalTypedDataClassId(class_id) &&
+      !RawObject::IsTypedDataViewClassId(class_id) &&
+      !RawObject::IsTypedDataClassId(class_id)) {
+    RETURN_TYPE_ERROR(isolate, object, 'TypedData');
+  }
+  if (type == NULL) {
+    RETURN_NULL_ERROR(type);
+  }
+  if (data == NULL) {
+    RETURN_NULL_ERROR(data);
+  }
+  if (len == NULL) {
+    RETURN_NULL_ERROR(len);
+  }
+  if (pinned == NULL) {
+    RETURN_NULL_ERROR(pinned);
+  }
+  const Instance& obj = Api::UnwrapInstanceHandle(isolate, object);
+  ASSERT(!obj.IsNull());
+  intptr_t size_in_bytes = 0;
+  if (!GetPinnableData(obj, class_id, data, len, &size_in_bytes)) {
+    return Api::NewError("%s: the data of 'object' is in new space and can "
+                         "still be moved.", CURRENT_FUNC);
+  }
+  *type = GetType(class_id);
+  PersistentHandle* pinned_ref =
+      isolate->api_state()->pinned_handles().AllocateHandle();
+  pinned_ref->set_raw(obj);
+  *pinned = reinterpret_cast<Dart_Handle>(pinned_ref);
+  isolate->heap()->AddPinnedBytes(size_in_bytes);
+  return Api::Success(isolate);
+}
+
+
+DART_EXPORT Dart_Handle Dart_TypedDataUnpin(Dart_Handle pinned) {
+  Isolate* isolate = Isolate::Current();
+  DARTSCOPE(isolate);
+  ApiState* state = isolate->api_state();
+  ASSERT(state != NULL);
+  if (!state->IsValidPinnedHandle(pinned)) {
+    return Api::NewError("%s expects argument 'pinned' to be a handle "
+                         "returned by Dart_TypedDataPin.", CURRENT_FUNC);
+  }
+  const Instance& obj = Api::UnwrapInstanceHandle(isolate, pinned);
+  void* data = NULL;
+  intptr_t len = 0;
+  intptr_t size_in_bytes = 0;
+  const bool is_pinnable =
+      GetPinnableData(obj, Api::ClassId(pinned), &data, &len, &size_in_bytes);
+  ASSERT(is_pinnable);
+  USE(is_pinnable);
+  isolate->heap()->AddPinnedBytes(-size_in_bytes);
+  state->pinned_handles().FreeHandle(
+      reinterpret_cast<PersistentHandle*>(pinned));
+  return Api::Success(isolate);
+}
+
+
 // --- Closures ---
 
 
@@ -3898,6 +4084,303 @@ DART_EXPORT Dart_Handle Dart_Invoke(Dart_Handle target,
 }
 
 
+// A prepared invocation is a persistent handle to an array with the entries
+// below. The array is not reachable from Dart code.
+enum {
+  kPreparedFunctionIndex,        // Bound function, null for noSuchMethod.
+  kPreparedReceiverCidIndex,     // Receiver class id the function was bound
+                                 // for, null for static functions.
+  kPreparedNameIndex,            // Name of the function.
+  kPreparedArgsDescriptorIndex,  // Arguments descriptor.
+  kPreparedArgumentNamesIndex,   // Names of the named arguments, or null.
+  kPreparedInvocationLength,
+};
+
+
+// Resolves the method called by a prepared invocation on a receiver of class
+// 'receiver_cid', returning null if noSuchMethod is to be invoked instead.
+static RawFunction* ResolvePreparedMethod(Isolate* isolate,
+                                          intptr_t receiver_cid,
+                                          const String& function_name,
+                                          int num_arguments,
+                                          const Array& argument_names) {
+  Class& cls = Class::Handle(isolate, isolate->class_table()->At(receiver_cid));
+  // For lookups treat null as an instance of class Object.
+  if (cls.IsNullClass()) {
+    cls = isolate->object_store()->object_class();
+  }
+  const Function& function = Function::Handle(
+      isolate, Resolver::ResolveDynamicAnyArgs(cls, function_name));
+  if (function.IsNull() ||
+      !function.AreValidArguments(num_arguments, argument_names, NULL)) {
+    return Function::null();
+  }
+  return function.raw();
+}
+
+
+DART_EXPORT Dart_Handle Dart_PrepareInvocation(
+    Dart_Handle target,
+    Dart_Handle name,
+    int number_of_arguments,
+    Dart_Handle argument_names,
+    Dart_PreparedInvocation* invocation) {
+  Isolate* isolate = Isolate::Current();
+  DARTSCOPE(isolate);
+  CHECK_CALLBACK_STATE(isolate);
+
+  if (invocation == NULL) {
+    RETURN_NULL_ERROR(invocation);
+  }
+  const String& function_name = Api::UnwrapStringHandle(isolate, name);
+  if (function_name.IsNull()) {
+    RETURN_TYPE_ERROR(isolate, name, String);
+  }
+  if (number_of_arguments < 0) {
+    return Api::NewError(
+        "%s expects argument 'number_of_arguments' to be non-negative.",
+        CURRENT_FUNC);
+  }
+
+  // Collect the names of the named arguments as symbols.
+  Array& names = Array::Handle(isolate);
+  const Object& names_obj =
+      Object::Handle(isolate, Api::UnwrapHandle(argument_names));
+  if (!names_obj.IsNull()) {
+    if (names_obj.IsError()) {
+      return argument_names;
+    }
+    Array& list = Array::Handle(isolate);
+    intptr_t num_names = 0;
+    if (names_obj.IsArray()) {
+      list ^= names_obj.raw();
+      num_names = list.Length();
+    } else if (names_obj.IsGrowableObjectArray()) {
+      const GrowableObjectArray& growable =
+          GrowableObjectArray::Cast(names_obj);
+      list = growable.data();
+      num_names = growable.Length();
+    } else {
+      RETURN_TYPE_ERROR(isolate, argument_names, List);
+    }
+    if (num_names > number_of_arguments) {
+      return Api::NewError(
+          "%s expects argument 'argument_names' to have at most %d names.",
+          CURRENT_FUNC, number_of_arguments);
+    }
+    names = Array::New(num_names);
+    Object& arg_name = Object::Handle(isolate);
+    for (intptr_t i = 0; i < num_names; i++) {
+      arg_name = list.At(i);
+      if (!arg_name.IsString()) {
+        return Api::NewError(
+            "%s expects argument 'argument_names' to contain only strings.",
+            CURRENT_FUNC);
+      }
+      names.SetAt(i, String::Handle(isolate,
+                                    Symbols::New(String::Cast(arg_name))));
+    }
+  }
+
+  const Object& obj = Object::Handle(isolate, Api::UnwrapHandle(target));
+  if (obj.IsError()) {
+    return target;
+  }
+  const Array& prepared = Array::Handle(
+      isolate, Array::New(kPreparedInvocationLength, Heap::kOld));
+  Function& function = Function::Handle(isolate);
+  intptr_t num_receiver = 0;
+  if (obj.IsNull() || obj.IsInstance()) {
+    // The method is bound to the class of the receiver.
+    num_receiver = 1;
+    const intptr_t receiver_cid = Api::ClassId(target);
+    function = ResolvePreparedMethod(isolate,
+                                     receiver_cid,
+                                     function_name,
+                                     number_of_arguments + num_receiver,
+                                     names);
+    prepared.SetAt(kPreparedReceiverCidIndex,
+                   Smi::Handle(isolate, Smi::New(receiver_cid)));
+
+  } else if (obj.IsClass()) {
+    // Finalize all classes.
+    Dart_Handle state = Api::CheckIsolateState(isolate);
+    if (::Dart_IsError(state)) {
+      return state;
+    }
+
+    const Class& cls = Class::Cast(obj);
+    function = Resolver::ResolveStatic(cls,
+                                       function_name,
+                                       number_of_arguments,
+                                       names,
+                                       Resolver::kIsQualified);
+    if (function.IsNull()) {
+      const String& cls_name = String::Handle(isolate, cls.Name());
+      return Api::NewError("%s: did not find static method '%s.%s'.",
+                           CURRENT_FUNC,
+                           cls_name.ToCString(),
+                           function_name.ToCString());
+    }
+
+  } else if (obj.IsLibrary()) {
+    const Library& lib = Library::Cast(obj);
+    // When calling functions in the dart:builtin library do not finalize as it
+    // should have been prefinalized.
+    if (lib.raw() != isolate->object_store()->builtin_library()) {
+      Dart_Handle state = Api::CheckIsolateState(isolate);
+      if (::Dart_IsError(state)) {
+        return state;
+      }
+    }
+
+    function = lib.LookupFunctionAllowPrivate(function_name);
+    if (function.IsNull()) {
+      return Api::NewError("%s: did not find top-level function '%s'.",
+                           CURRENT_FUNC,
+                           function_name.ToCString());
+    }
+    String& error_message = String::Handle(isolate);
+    if (!function.AreValidArguments(number_of_arguments,
+                                    names,
+                                    &error_message)) {
+      return Api::NewError("%s: wrong arguments for function '%s': %s.",
+                           CURRENT_FUNC,
+                           function_name.ToCString(),
+                           error_message.ToCString());
+    }
+
+  } else {
+    return Api::NewError(
+        "%s expects argument 'target' to be an object, class, or library.",
+        CURRENT_FUNC);
+  }
+
+  prepared.SetAt(kPreparedFunctionIndex, function);
+  prepared.SetAt(kPreparedNameIndex, function_name);
+  prepared.SetAt(kPreparedArgsDescriptorIndex, Array::Handle(
+      isolate,
+      ArgumentsDescriptor::New(number_of_arguments + num_receiver, names)));
+  prepared.SetAt(kPreparedArgumentNamesIndex, names);
+
+  ApiState* state = isolate->api_state();
+  ASSERT(state != NULL);
+  PersistentHandle* ref = state->persistent_handles().AllocateHandle();
+  ref->set_raw(prepared);
+  *invocation = reinterpret_cast<Dart_PreparedInvocation>(ref);
+  return Api::Success(isolate);
+}
+
+
+DART_EXPORT Dart_Handle Dart_InvokePrepared(Dart_PreparedInvocation invocation,
+                                            Dart_Handle receiver,
+                                            int number_of_arguments,
+                                            Dart_Handle* arguments) {
+  Isolate* isolate = Isolate::Current();
+  DARTSCOPE(isolate);
+  CHECK_CALLBACK_STATE(isolate);
+
+  if (invocation == NULL) {
+    RETURN_NULL_ERROR(invocation);
+  }
+  ApiState* state = isolate->api_state();
+  ASSERT(state != NULL);
+  const PersistentHandle* ref = Api::UnwrapAsPersistentHandle(
+      *state, reinterpret_cast<Dart_Handle>(invocation));
+  Array& prepared = Array::Handle(isolate);
+  prepared ^= ref->raw();
+  ASSERT(prepared.Length() == kPreparedInvocationLength);
+
+  Array& args_descriptor = Array::Handle(isolate);
+  args_descriptor ^= prepared.At(kPreparedArgsDescriptorIndex);
+  const intptr_t num_receiver =
+      (prepared.At(kPreparedReceiverCidIndex) == Object::null()) ? 0 : 1;
+  const intptr_t expected_count =
+      ArgumentsDescriptor(args_descriptor).Count() - num_receiver;
+  if (number_of_arguments != expected_count) {
+    return Api::NewError(
+        "%s expects argument 'number_of_arguments' to be %"Pd".",
+        CURRENT_FUNC, expected_count);
+  }
+
+  // Check for malformed arguments in the arguments list.
+  const Array& args =
+      Array::Handle(isolate, Array::New(number_of_arguments + num_receiver));
+  Object& arg = Object::Handle(isolate);
+  for (int i = 0; i < number_of_arguments; i++) {
+    arg = Api::UnwrapHandle(arguments[i]);
+    if (!arg.IsNull() && !arg.IsInstance()) {
+      if (arg.IsError()) {
+        return Api::NewHandle(isolate, arg.raw());
+      } else {
+        return Api::NewError(
+            "%s expects arguments[%d] to be an Instance handle.",
+            CURRENT_FUNC, i);
+      }
+    }
+    args.SetAt((i + num_receiver), arg);
+  }
+
+  Function& function = Function::Handle(isolate);
+  function ^= prepared.At(kPreparedFunctionIndex);
+  if (num_receiver == 0) {
+    return Api::NewHandle(
+        isolate, DartEntry::InvokeFunction(function, args, args_descriptor));
+  }
+
+  const Object& obj = Object::Handle(isolate, Api::UnwrapHandle(receiver));
+  if (!obj.IsNull() && !obj.IsInstance()) {
+    if (obj.IsError()) {
+      return receiver;
+    }
+    return Api::NewError(
+        "%s expects argument 'receiver' to be an Instance handle.",
+        CURRENT_FUNC);
+  }
+  Instance& instance = Instance::Handle(isolate);
+  instance ^= obj.raw();
+  args.SetAt(0, instance);
+  String& function_name = String::Handle(isolate);
+  function_name ^= prepared.At(kPreparedNameIndex);
+  const intptr_t receiver_cid = Api::ClassId(receiver);
+  if (receiver_cid != Smi::Value(
+          reinterpret_cast<RawSmi*>(prepared.At(kPreparedReceiverCidIndex)))) {
+    // Bind the method for the class of this receiver.
+    Array& argument_names = Array::Handle(isolate);
+    argument_names ^= prepared.At(kPreparedArgumentNamesIndex);
+    function = ResolvePreparedMethod(isolate,
+                                     receiver_cid,
+                                     function_name,
+                                     args.Length(),
+                                     argument_names);
+    prepared.SetAt(kPreparedFunctionIndex, function);
+    prepared.SetAt(kPreparedReceiverCidIndex,
+                   Smi::Handle(isolate, Smi::New(receiver_cid)));
+  }
+  if (function.IsNull()) {
+    return Api::NewHandle(isolate,
+                          DartEntry::InvokeNoSuchMethod(instance,
+                                                        function_name,
+                                                        args,
+                                                        args_descriptor));
+  }
+  return Api::NewHandle(
+      isolate, DartEntry::InvokeFunction(function, args, args_descriptor));
+}
+
+
+DART_EXPORT void Dart_DeletePreparedInvocation(
+    Dart_PreparedInvocation invocation) {
+  Isolate* isolate = Isolate::Current();
+  CHECK_ISOLATE(isolate);
+  ApiState* state = isolate->api_state();
+  ASSERT(state != NULL);
+  PersistentHandle* ref = Api::UnwrapAsPersistentHandle(
+      *state, reinterpret_cast<Dart_Handle>(invocation));
+  state->persistent_handles().FreeHandle(ref);
+}
+
+
 static bool FieldIsUninitialized(Isolate* isolate, const Field& fld) {
   ASSERT(!fld.IsNull());
 
@@ -4344,7 +4827,13 @@ DART_EXPORT Dart_Handle Dart_GetNativeArgument(Dart_NativeArguments args,
         "%s: argument 'index' out of range. Expected 0..%d but saw %d.",
         CURRENT_FUNC, arguments->NativeArgCount() - 1, index);
   }
-  return Api::NewHandle(arguments->isolate(), arguments->NativeArgAt(index));
+  Isolate* isolate = arguments->isolate();
+  const Object& obj = Object::Handle(isolate, arguments->NativeArgAt(index));
+  if (obj.IsString() && String::Cast(obj).IsConsString()) {
+    // Native code only ever sees flat strings.
+    return Api::NewHandle(isolate, ConsString::Flatten(String::Cast(obj)));
+  }
+  return Api::NewHandle(isolate, obj.raw());
 }
 
 
@@ -4367,6 +4856,226 @@ DART_EXPORT void Dart_SetReturnValue(Dart_NativeArguments args,
 }
 
 
+// Natives using the primitive accessors below usually do not enter an API
+// scope, so every handle created here has to be released before returning.
+static bool GetNativeArgumentValue(Isolate* isolate,
+                                   const NativeArguments& arguments,
+                                   int arg_index,
+                                   uint8_t type,
+                                   Dart_NativeArgument_Value* value) {
+  HANDLESCOPE(isolate);
+  const Object& obj =
+      Object::Handle(isolate, arguments.NativeArgAt(arg_index));
+  switch (type) {
+    case Dart_NativeArgument_kBool:
+      if (obj.raw() == Bool::True().raw()) {
+        value->as_bool = true;
+        return true;
+      }
+      if (obj.raw() == Bool::False().raw()) {
+        value->as_bool = false;
+        return true;
+      }
+      return false;
+
+    case Dart_NativeArgument_kInt32:
+    case Dart_NativeArgument_kInt64: {
+      if (!obj.IsSmi() && !obj.IsMint()) {
+        return false;
+      }
+      const int64_t int_value = Integer::Cast(obj).AsInt64Value();
+      if (type == Dart_NativeArgument_kInt64) {
+        value->as_int64 = int_value;
+        return true;
+      }
+      if ((int_value < kMinInt32) || (int_value > kMaxInt32)) {
+        return false;
+      }
+      value->as_int32 = static_cast<int32_t>(int_value);
+      return true;
+    }
+
+    case Dart_NativeArgument_kDouble:
+      if (!obj.IsDouble()) {
+        return false;
+      }
+      value->as_double = Double::Cast(obj).value();
+      return true;
+
+    case Dart_NativeArgument_kNativeFields: {
+      const int num_fields = value->as_native_fields.num_fields;
+      if (!obj.IsInstance() ||
+          (num_fields < 0) ||
+          ((num_fields > 0) &&
+           ((value->as_native_fields.values == NULL) ||
+            !Instance::Cast(obj).IsValidNativeIndex(num_fields - 1)))) {
+        return false;
+      }
+      const Instance& instance = Instance::Cast(obj);
+      for (int i = 0; i < num_fields; i++) {
+        value->as_native_fields.values[i] =
+            instance.GetNativeField(isolate, i);
+      }
+      return true;
+    }
+
+    default:
+      return false;
+  }
+}
+
+
+// Mismatches are reported with a pre-created error, since the caller may not
+// have entered a scope to allocate a new error handle in.
+static Dart_Handle GetNativeArgumentChecked(const NativeArguments& arguments,
+                                            int arg_index,
+                                            uint8_t type,
+                                            Dart_NativeArgument_Value* value) {
+  Isolate* isolate = arguments.isolate();
+  CHECK_ISOLATE(isolate);
+  if ((arg_index < 0) ||
+      (arg_index >= arguments.NativeArgCount()) ||
+      !GetNativeArgumentValue(isolate, arguments, arg_index, type, value)) {
+    return Api::NativeArgumentError(isolate);
+  }
+  return Api::Success(isolate);
+}
+
+
+DART_EXPORT Dart_Handle Dart_GetNativeArguments(
+    Dart_NativeArguments args,
+    int num_arguments,
+    const Dart_NativeArgument_Descriptor* descriptors,
+    Dart_NativeArgument_Value* values) {
+  NativeArguments* arguments = reinterpret_cast<NativeArguments*>(args);
+  Isolate* isolate = arguments->isolate();
+  CHECK_ISOLATE(isolate);
+  if ((num_arguments < 0) ||
+      ((num_arguments > 0) && ((descriptors == NULL) || (values == NULL)))) {
+    return Api::NativeArgumentError(isolate);
+  }
+  for (int i = 0; i < num_arguments; i++) {
+    Dart_Handle result = GetNativeArgumentChecked(*arguments,
+                                                  descriptors[i].index,
+                                                  descriptors[i].type,
+                                                  &values[i]);
+    if (::Dart_IsError(result)) {
+      return result;
+    }
+  }
+  return Api::Success(isolate);
+}
+
+
+DART_EXPORT Dart_Handle Dart_GetNativeIntegerArgument(Dart_NativeArguments args,
+                                                      int index,
+                                                      int64_t* value) {
+  NativeArguments* arguments = reinterpret_cast<NativeArguments*>(args);
+  if (value == NULL) {
+    return Api::NativeArgumentError(arguments->isolate());
+  }
+  Dart_NativeArgument_Value arg_value;
+  Dart_Handle result = GetNativeArgumentChecked(*arguments,
+                                                index,
+                                                Dart_NativeArgument_kInt64,
+                                                &arg_value);
+  if (!::Dart_IsError(result)) {
+    *value = arg_value.as_int64;
+  }
+  return result;
+}
+
+
+DART_EXPORT Dart_Handle Dart_GetNativeBooleanArgument(Dart_NativeArguments args,
+                                                      int index,
+                                                      bool* value) {
+  NativeArguments* arguments = reinterpret_cast<NativeArguments*>(args);
+  if (value == NULL) {
+    return Api::NativeArgumentError(arguments->isolate());
+  }
+  Dart_NativeArgument_Value arg_value;
+  Dart_Handle result = GetNativeArgumentChecked(*arguments,
+                                                index,
+                                                Dart_NativeArgument_kBool,
+                                                &arg_value);
+  if (!::Dart_IsError(result)) {
+    *value = arg_value.as_bool;
+  }
+  return result;
+}
+
+
+DART_EXPORT Dart_Handle Dart_GetNativeDoubleArgument(Dart_NativeArguments args,
+                                                     int index,
+                                                     double* value) {
+  NativeArguments* arguments = reinterpret_cast<NativeArguments*>(args);
+  if (value == NULL) {
+    return Api::NativeArgumentError(arguments->isolate());
+  }
+  Dart_NativeArgument_Value arg_value;
+  Dart_Handle result = GetNativeArgumentChecked(*arguments,
+                                                index,
+                                                Dart_NativeArgument_kDouble,
+                                                &arg_value);
+  if (!::Dart_IsError(result)) {
+    *value = arg_value.as_double;
+  }
+  return result;
+}
+
+
+DART_EXPORT Dart_Handle Dart_GetNativeFieldOfArgument(Dart_NativeArguments args,
+                                                      int arg_index,
+                                                      int fld_index,
+                                                      intptr_t* value) {
+  NativeArguments* arguments = reinterpret_cast<NativeArguments*>(args);
+  Isolate* isolate = arguments->isolate();
+  CHECK_ISOLATE(isolate);
+  if ((value == NULL) ||
+      (arg_index < 0) ||
+      (arg_index >= arguments->NativeArgCount())) {
+    return Api::NativeArgumentError(isolate);
+  }
+  {
+    HANDLESCOPE(isolate);
+    const Object& obj =
+        Object::Handle(isolate, arguments->NativeArgAt(arg_index));
+    if (obj.IsInstance() && Instance::Cast(obj).IsValidNativeIndex(fld_index)) {
+      *value = Instance::Cast(obj).GetNativeField(isolate, fld_index);
+      return Api::Success(isolate);
+    }
+  }
+  return Api::NativeArgumentError(isolate);
+}
+
+
+DART_EXPORT void Dart_SetBooleanReturnValue(Dart_NativeArguments args,
+                                            bool retval) {
+  NativeArguments* arguments = reinterpret_cast<NativeArguments*>(args);
+  arguments->SetReturn(retval ? Bool::True() : Bool::False());
+}
+
+
+DART_EXPORT void Dart_SetIntegerReturnValue(Dart_NativeArguments args,
+                                            int64_t retval) {
+  NativeArguments* arguments = reinterpret_cast<NativeArguments*>(args);
+  Isolate* isolate = arguments->isolate();
+  CHECK_ISOLATE(isolate);
+  HANDLESCOPE(isolate);
+  arguments->SetReturn(Integer::Handle(isolate, Integer::New(retval)));
+}
+
+
+DART_EXPORT void Dart_SetDoubleReturnValue(Dart_NativeArguments args,
+                                           double retval) {
+  NativeArguments* arguments = reinterpret_cast<NativeArguments*>(args);
+  Isolate* isolate = arguments->isolate();
+  CHECK_ISOLATE(isolate);
+  HANDLESCOPE(isolate);
+  arguments->SetReturn(Double::Handle(isolate, Double::New(retval)));
+}
+
+
 // --- Scripts and Libraries ---
 
 
@@ -113,6 +113,15 @@ class Api : AllStatic {
   // Gets the handle which holds the pre-created acquired error object.
   static Dart_Handle AcquiredError(Isolate* isolate);
 
+  // Sets up the error object returned by the primitive native argument
+  // accessors. It is pre-created because these accessors may be called from
+  // natives that have not entered an API scope, where no local handle can be
+  // allocated.
+  static void SetupNativeArgumentError(Isolate* isolate);
+
+  // Gets the handle which holds the pre-created native argument error object.
+  static Dart_Handle NativeArgumentError(Isolate* isolate);
+
   // Returns true if the handle holds a Smi.
   static bool IsSmi(Dart_Handle handle) {
     // TODO(turnidge): Assumes RawObject* is at offset zero.  Fix.
@@ -9,6 +9,7 @@
 #include "vm/class_finalizer.h"
 #include "vm/dart_api_impl.h"
 #include "vm/dart_api_state.h"
+#include "vm/message_handler.h"
 #include "vm/thread.h"
 #include "vm/unit_test.h"
 #include "vm/verifier.h"
@@ -1152,6 +1153,100 @@ TEST_CASE(TypedDataViewDirectAccess) {
 }
 
 
+TEST_CASE(TypedDataPin) {
+  Isolate* isolate = Isolate::Current();
+  Heap* heap = isolate->heap();
+  const intptr_t pinned_bytes = heap->PinnedInBytes();
+  Dart_TypedData_Type type;
+  void* data = NULL;
+  intptr_t len = 0;
+  Dart_Handle pinned = NULL;
+
+  // Data in new space can still move.
+  Dart_Handle new_array = Dart_NewTypedData(kUint8, 10);
+  EXPECT_VALID(new_array);
+  Dart_Handle result =
+      Dart_TypedDataPin(new_array, &type, &data, &len, &pinned);
+  EXPECT_ERROR(result, "Dart_TypedDataPin: the data of 'object' is in new "
+                       "space and can still be moved.");
+  result = Dart_TypedDataPin(Dart_Null(), &type, &data, &len, &pinned);
+  EXPECT_ERROR(result, "Dart_TypedDataPin expects argument 'object'"
+                       " to be non-null.");
+  result = Dart_TypedDataPin(new_array, &type, &data, &len, NULL);
+  EXPECT_ERROR(result, "Dart_TypedDataPin expects argument 'pinned'"
+                       " to be non-null.");
+
+  // Data in old space stays where it is while GC runs.
+  Dart_Handle old_array = Dart_NewTypedDataInOldSpace(kInt16, 100);
+  EXPECT_VALID(old_array);
+  result = Dart_TypedDataPin(old_array, &type, &data, &len, &pinned);
+  EXPECT_VALID(result);
+  EXPECT_EQ(kInt16, type);
+  EXPECT_EQ(100, len);
+  EXPECT_EQ(pinned_bytes + 200, heap->PinnedInBytes());
+  int16_t* values = reinterpret_cast<int16_t*>(data);
+  for (int i = 0; i < len; i++) {
+    values[i] = -i;
+  }
+  heap->CollectAllGarbage();
+  heap->CollectGarbage(Heap::kNew);
+  for (int i = 0; i < len; i++) {
+    values[i] -= i;
+  }
+  Dart_Handle element = Dart_ListGetAt(pinned, 99);
+  EXPECT_VALID(element);
+  int64_t value = 0;
+  EXPECT_VALID(Dart_IntegerToInt64(element, &value));
+  EXPECT_EQ(-198, value);
+  EXPECT_VALID(Dart_TypedDataUnpin(pinned));
+  EXPECT_EQ(pinned_bytes, heap->PinnedInBytes());
+  result = Dart_TypedDataUnpin(new_array);
+  EXPECT_ERROR(result, "Dart_TypedDataUnpin expects argument 'pinned' to be "
+                       "a handle returned by Dart_TypedDataPin.");
+  // Unpinning the same handle twice and unpinning a persistent handle that
+  // was never pinned are both rejected.
+  result = Dart_TypedDataUnpin(pinned);
+  EXPECT_ERROR(result, "Dart_TypedDataUnpin expects argument 'pinned' to be "
+                       "a handle returned by Dart_TypedDataPin.");
+  Dart_Handle persistent = Dart_NewPersistentHandle(old_array);
+  EXPECT_VALID(persistent);
+  result = Dart_TypedDataUnpin(persistent);
+  EXPECT_ERROR(result, "Dart_TypedDataUnpin expects argument 'pinned' to be "
+                       "a handle returned by Dart_TypedDataPin.");
+  EXPECT_EQ(pinned_bytes, heap->PinnedInBytes());
+  Dart_DeletePersistentHandle(persistent);
+  result = Dart_NewTypedDataInOldSpace(kByteData, 10);
+  EXPECT_ERROR(result, "Dart_NewTypedDataInOldSpace expects argument 'type' "
+                       "to be of 'TypedData' other than kByteData.");
+
+  // External data and views on it never move.
+  const char* kScriptChars =
+      "import 'dart:typed_data';\n"
+      "List view(var list) => new Uint8List.view(list.buffer, 3, 4);\n";
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  uint8_t external_data[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+  Dart_Handle external_array = Dart_NewExternalTypedData(
+      kUint8, external_data, ARRAY_SIZE(external_data), NULL, NULL);
+  EXPECT_VALID(external_array);
+  result = Dart_TypedDataPin(external_array, &type, &data, &len, &pinned);
+  EXPECT_VALID(result);
+  EXPECT_EQ(kUint8, type);
+  EXPECT(data == external_data);
+  EXPECT_EQ(10, len);
+  EXPECT_VALID(Dart_TypedDataUnpin(pinned));
+  Dart_Handle view = Dart_Invoke(lib, NewString("view"), 1, &external_array);
+  EXPECT_VALID(view);
+  result = Dart_TypedDataPin(view, &type, &data, &len, &pinned);
+  EXPECT_VALID(result);
+  EXPECT_EQ(kUint8, type);
+  EXPECT(data == (external_data + 3));
+  EXPECT_EQ(4, len);
+  EXPECT_EQ(pinned_bytes + 4, heap->PinnedInBytes());
+  EXPECT_VALID(Dart_TypedDataUnpin(pinned));
+  EXPECT_EQ(pinned_bytes, heap->PinnedInBytes());
+}
+
+
 TEST_CASE(ByteDataDirectAccess) {
   const char* kScriptChars =
       "import 'dart:typed_data';\n"
@@ -1476,7 +1571,7 @@ UNIT_TEST_CASE(PersistentHandles) {
     }
   }
   EXPECT(scope == state->top_scope());
-  EXPECT_EQ(2001, state->CountPersistentHandles());
+  EXPECT_EQ(2002, state->CountPersistentHandles());
   Dart_ShutdownIsolate();
 }
 
@@ -3899,6 +3994,102 @@ TEST_CASE(Invoke_Null) {
 }
 
 
+TEST_CASE(InvokePrepared) {
+  const char* kScriptChars =
+      "class A {\n"
+      "  method(arg) => 'A $arg';\n"
+      "  noSuchMethod(invocation) => 'A noSuchMethod';\n"
+      "}\n"
+      "class B extends A {\n"
+      "  method(arg) => 'B $arg';\n"
+      "}\n"
+      "class C {\n"
+      "  static staticMethod(arg, {suffix: '?'}) => 'static $arg$suffix';\n"
+      "}\n"
+      "topMethod(arg) => 'top $arg';\n"
+      "A newA() => new A();\n"
+      "A newB() => new B();\n";
+
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  Dart_Handle cls = Dart_GetClass(lib, NewString("C"));
+  EXPECT_VALID(cls);
+  Dart_Handle a = Dart_Invoke(lib, NewString("newA"), 0, NULL);
+  EXPECT_VALID(a);
+  Dart_Handle b = Dart_Invoke(lib, NewString("newB"), 0, NULL);
+  EXPECT_VALID(b);
+  Dart_Handle args[2];
+  args[0] = NewString("!!!");
+  args[1] = NewString("...");
+  Dart_PreparedInvocation invocation = NULL;
+  Dart_Handle result;
+  const char* str;
+
+  // Instance method, called on receivers of the prepared and other classes.
+  result = Dart_PrepareInvocation(a, NewString("method"), 1, Dart_Null(),
+                                  &invocation);
+  EXPECT_VALID(result);
+  const char* kExpected[] = { "A !!!", "B !!!", "A !!!", "A !!!" };
+  Dart_Handle receivers[] = { a, b, a, a };
+  for (int i = 0; i < 4; i++) {
+    result = Dart_InvokePrepared(invocation, receivers[i], 1, args);
+    EXPECT_VALID(result);
+    result = Dart_StringToCString(result, &str);
+    EXPECT_STREQ(kExpected[i], str);
+  }
+  result = Dart_InvokePrepared(invocation, Dart_Null(), 1, args);
+  EXPECT(Dart_IsError(result));
+  EXPECT(Dart_ErrorHasException(result));
+  EXPECT_ERROR(Dart_InvokePrepared(invocation, a, 2, args),
+               "Dart_InvokePrepared expects argument 'number_of_arguments' "
+               "to be 1.");
+  Dart_DeletePreparedInvocation(invocation);
+
+  // Instance method that is not found, or called with the wrong arguments.
+  result = Dart_PrepareInvocation(a, NewString("method"), 2, Dart_Null(),
+                                  &invocation);
+  EXPECT_VALID(result);
+  result = Dart_InvokePrepared(invocation, b, 2, args);
+  EXPECT_VALID(result);
+  result = Dart_StringToCString(result, &str);
+  EXPECT_STREQ("A noSuchMethod", str);
+  Dart_DeletePreparedInvocation(invocation);
+
+  // Static method with a named argument.
+  Dart_Handle names = Dart_NewList(1);
+  EXPECT_VALID(Dart_ListSetAt(names, 0, NewString("suffix")));
+  result = Dart_PrepareInvocation(cls, NewString("staticMethod"), 2, names,
+                                  &invocation);
+  EXPECT_VALID(result);
+  for (int i = 0; i < 2; i++) {
+    result = Dart_InvokePrepared(invocation, Dart_Null(), 2, args);
+    EXPECT_VALID(result);
+    result = Dart_StringToCString(result, &str);
+    EXPECT_STREQ("static !!!...", str);
+  }
+  Dart_DeletePreparedInvocation(invocation);
+  EXPECT_ERROR(Dart_PrepareInvocation(cls, NewString("staticMethod"), 2,
+                                      Dart_Null(), &invocation),
+               "did not find static method 'C.staticMethod'");
+
+  // Top-level function.
+  result = Dart_PrepareInvocation(lib, NewString("topMethod"), 1, Dart_Null(),
+                                  &invocation);
+  EXPECT_VALID(result);
+  result = Dart_InvokePrepared(invocation, Dart_Null(), 1, args);
+  EXPECT_VALID(result);
+  result = Dart_StringToCString(result, &str);
+  EXPECT_STREQ("top !!!", str);
+  Dart_DeletePreparedInvocation(invocation);
+  EXPECT_ERROR(Dart_PrepareInvocation(lib, NewString("noMethod"), 1,
+                                      Dart_Null(), &invocation),
+               "did not find top-level function 'noMethod'");
+  EXPECT_ERROR(Dart_PrepareInvocation(lib, NewString("topMethod"), 1,
+                                      NewString("arg"), &invocation),
+               "Dart_PrepareInvocation expects argument 'argument_names' "
+               "to be of type List.");
+}
+
+
 TEST_CASE(InvokeNoSuchMethod) {
   const char* kScriptChars =
       "import 'dart:_collection-dev' as _collection_dev;\n"
@@ -4324,6 +4515,216 @@ TEST_CASE(GetNativeArgumentCount) {
 }
 
 
+// These natives do not enter a scope, so the accessors must not leave any
+// handles behind.
+static void NativeArgumentsSum(Dart_NativeArguments args) {
+  int handle_count = VMHandles::ScopedHandleCount();
+  static const Dart_NativeArgument_Descriptor kDescriptors[] = {
+    { Dart_NativeArgument_kNativeFields, 0 },
+    { Dart_NativeArgument_kInt32, 1 },
+    { Dart_NativeArgument_kInt64, 2 },
+    { Dart_NativeArgument_kBool, 3 },
+  };
+  intptr_t fields[2];
+  Dart_NativeArgument_Value values[4];
+  values[0].as_native_fields.num_fields = 2;
+  values[0].as_native_fields.values = fields;
+  Dart_Handle result = Dart_GetNativeArguments(args, 4, kDescriptors, values);
+  if (Dart_IsError(result)) Dart_PropagateError(result);
+  int64_t sum = fields[0] + fields[1] + values[1].as_int32;
+  sum += values[2].as_int64;
+  Dart_SetIntegerReturnValue(args, values[3].as_bool ? sum : -sum);
+  EXPECT_EQ(handle_count, VMHandles::ScopedHandleCount());
+}
+
+
+static void NativeArgumentsHalf(Dart_NativeArguments args) {
+  int handle_count = VMHandles::ScopedHandleCount();
+  double value = 0.0;
+  Dart_Handle result = Dart_GetNativeDoubleArgument(args, 1, &value);
+  if (Dart_IsError(result)) Dart_PropagateError(result);
+  Dart_SetDoubleReturnValue(args, value / 2);
+  EXPECT_EQ(handle_count, VMHandles::ScopedHandleCount());
+}
+
+
+static void NativeArgumentsNot(Dart_NativeArguments args) {
+  bool value = false;
+  Dart_Handle result = Dart_GetNativeBooleanArgument(args, 1, &value);
+  if (Dart_IsError(result)) Dart_PropagateError(result);
+  intptr_t field = 0;
+  result = Dart_GetNativeFieldOfArgument(args, 0, 1, &field);
+  if (Dart_IsError(result)) Dart_PropagateError(result);
+  EXPECT_EQ(20, field);
+  Dart_SetBooleanReturnValue(args, !value);
+}
+
+
+static void NativeArgumentsInit(Dart_NativeArguments args) {
+  Dart_EnterScope();
+  Dart_Handle recv = Dart_GetNativeArgument(args, 0);
+  EXPECT_VALID(Dart_SetNativeInstanceField(recv, 0, 10));
+  EXPECT_VALID(Dart_SetNativeInstanceField(recv, 1, 20));
+  Dart_ExitScope();
+}
+
+
+static Dart_NativeFunction gna_lookup(Dart_Handle name, int argument_count) {
+  const char* cstr = NULL;
+  EXPECT_VALID(Dart_StringToCString(name, &cstr));
+  if (strcmp(cstr, "sum") == 0) {
+    return reinterpret_cast<Dart_NativeFunction>(&NativeArgumentsSum);
+  } else if (strcmp(cstr, "half") == 0) {
+    return reinterpret_cast<Dart_NativeFunction>(&NativeArgumentsHalf);
+  } else if (strcmp(cstr, "not") == 0) {
+    return reinterpret_cast<Dart_NativeFunction>(&NativeArgumentsNot);
+  }
+  return reinterpret_cast<Dart_NativeFunction>(&NativeArgumentsInit);
+}
+
+
+TEST_CASE(GetNativeArguments) {
+  const char* kScriptChars =
+      "import 'dart:nativewrappers';\n"
+      "class MyObject extends NativeFieldWrapperClass2 {\n"
+      "  MyObject() { init(); }\n"
+      "  void init() native 'init';\n"
+      "  int sum(int i, int j, bool positive) native 'sum';\n"
+      "  double half(double d) native 'half';\n"
+      "  bool not(bool b) native 'not';\n"
+      "}\n"
+      "testMain() {\n"
+      "  MyObject obj = new MyObject();\n"
+      "  int total = 0;\n"
+      "  for (int i = 0; i < 1000; i++) {\n"
+      "    total += obj.sum(i, 0x100000000, i.isEven);\n"
+      "  }\n"
+      "  if (obj.half(5.0) != 2.5) return -1;\n"
+      "  if (obj.not(true) || !obj.not(false)) return -2;\n"
+      "  return total;\n"
+      "}\n"
+      "testSumTypeError() => new MyObject().sum(1, 2, null);\n"
+      "testSumRangeError() => new MyObject().sum(0x100000000, 2, true);\n"
+      "testHalfTypeError() => new MyObject().half(1);\n";
+
+  Dart_Handle lib = TestCase::LoadTestScript(
+      kScriptChars,
+      reinterpret_cast<Dart_NativeEntryResolver>(gna_lookup));
+
+  Dart_Handle result = Dart_Invoke(lib, NewString("testMain"), 0, NULL);
+  EXPECT_VALID(result);
+  EXPECT(Dart_IsInteger(result));
+  int64_t value = 0;
+  EXPECT_VALID(Dart_IntegerToInt64(result, &value));
+  // Even i add 30 + i + 2^32, odd i subtract it; the 500 pairs sum to -500.
+  EXPECT_EQ(-500, value);
+
+  result = Dart_Invoke(lib, NewString("testSumTypeError"), 0, NULL);
+  EXPECT_ERROR(result, "Invalid native argument");
+  result = Dart_Invoke(lib, NewString("testSumRangeError"), 0, NULL);
+  EXPECT_ERROR(result, "Invalid native argument");
+  result = Dart_Invoke(lib, NewString("testHalfTypeError"), 0, NULL);
+  EXPECT_ERROR(result, "Invalid native argument");
+}
+
+
+// Messages are handled without an API scope, as they are in spawned
+// isolates. Reporting a mismatch must not need one.
+static void NativeArgumentsNoScopeHalf(Dart_NativeArguments args) {
+  EXPECT(Isolate::Current()->api_state()->top_scope() == NULL);
+  double value = 0.0;
+  Dart_Handle result = Dart_GetNativeDoubleArgument(args, 0, &value);
+  if (Dart_IsError(result)) {
+    Dart_SetBooleanReturnValue(args, false);
+  } else {
+    Dart_SetDoubleReturnValue(args, value / 2);
+  }
+}
+
+
+static void NativeArgumentsNoScopeThrow(Dart_NativeArguments args) {
+  EXPECT(Isolate::Current()->api_state()->top_scope() == NULL);
+  int64_t value = 0;
+  Dart_Handle result = Dart_GetNativeIntegerArgument(args, 0, &value);
+  EXPECT(Dart_IsError(result));
+  Dart_PropagateError(result);
+}
+
+
+static Dart_NativeFunction gna_no_scope_lookup(Dart_Handle name,
+                                               int argument_count) {
+  const char* cstr = NULL;
+  EXPECT_VALID(Dart_StringToCString(name, &cstr));
+  if (strcmp(cstr, "half") == 0) {
+    return reinterpret_cast<Dart_NativeFunction>(&NativeArgumentsNoScopeHalf);
+  }
+  return reinterpret_cast<Dart_NativeFunction>(&NativeArgumentsNoScopeThrow);
+}
+
+
+UNIT_TEST_CASE(GetNativeArguments_NoScope) {
+  const char* kScriptChars =
+      "import 'dart:isolate';\n"
+      "class Natives {\n"
+      "  static half(d) native 'half';\n"
+      "  static throwOnMismatch(i) native 'throw';\n"
+      "}\n"
+      "var results = [];\n"
+      "main() {\n"
+      "  var port = new ReceivePort();\n"
+      "  port.receive((message, replyTo) {\n"
+      "    if (message == 'half') {\n"
+      "      results.add(Natives.half(5.0));\n"
+      "      results.add(Natives.half(5));\n"
+      "      results.add(Natives.half(null));\n"
+      "    } else {\n"
+      "      Natives.throwOnMismatch('not an int');\n"
+      "    }\n"
+      "  });\n"
+      "  return port.toSendPort();\n"
+      "}\n";
+  Dart_Isolate isolate = TestCase::CreateTestIsolate();
+  ASSERT(isolate != NULL);
+  Dart_EnterScope();
+  Dart_Handle lib = TestCase::LoadTestScript(
+      kScriptChars,
+      reinterpret_cast<Dart_NativeEntryResolver>(gna_no_scope_lookup));
+  Dart_Handle send_port = Dart_Invoke(lib, NewString("main"), 0, NULL);
+  EXPECT_VALID(send_port);
+  Dart_Handle result = Dart_GetField(send_port, NewString("_id"));
+  EXPECT_VALID(result);
+  int64_t send_port_id = 0;
+  EXPECT_VALID(Dart_IntegerToInt64(result, &send_port_id));
+  Dart_ExitScope();
+
+  Isolate* vm_isolate = Isolate::Current();
+  EXPECT(vm_isolate->api_state()->top_scope() == NULL);
+  Dart_CObject message;
+  message.type = Dart_CObject::kString;
+  message.value.as_string = const_cast<char*>("half");
+  EXPECT(Dart_PostCObject(send_port_id, &message));
+  EXPECT(vm_isolate->message_handler()->HandleNextMessage());
+
+  message.value.as_string = const_cast<char*>("throw");
+  EXPECT(Dart_PostCObject(send_port_id, &message));
+  EXPECT(!vm_isolate->message_handler()->HandleNextMessage());
+  EXPECT(vm_isolate->api_state()->top_scope() == NULL);
+
+  Dart_EnterScope();
+  result = Dart_GetField(lib, NewString("results"));
+  EXPECT_VALID(result);
+  const char* results = NULL;
+  EXPECT_VALID(Dart_StringToCString(Dart_ToString(result), &results));
+  EXPECT_STREQ("[2.5, false, false]", results);
+  Dart_Handle error = Api::NewHandle(
+      vm_isolate, vm_isolate->object_store()->sticky_error());
+  EXPECT_ERROR(error, "Invalid native argument");
+  vm_isolate->object_store()->clear_sticky_error();
+  Dart_ExitScope();
+  Dart_ShutdownIsolate();
+}
+
+
 TEST_CASE(GetClass) {
   const char* kScriptChars =
       "class Class {\n"
@@ -31,7 +31,7 @@ DECLARE_DEBUG_FLAG(bool, trace_handles);
 class ApiZone {
  public:
   // Create an empty zone.
-  ApiZone() : zone_() {
+  ApiZone() : zone_(Zone::kApiScope) {
     Isolate* isolate = Isolate::Current();
     Zone* current_zone = isolate != NULL ? isolate->current_zone() : NULL;
     zone_.Link(current_zone);
@@ -527,7 +527,7 @@ class ApiState {
  public:
   ApiState() : top_scope_(NULL), delayed_weak_reference_sets_(NULL),
                null_(NULL), true_(NULL), false_(NULL),
-               acquired_error_(NULL) {}
+               acquired_error_(NULL), native_argument_error_(NULL) {}
   ~ApiState() {
     while (top_scope_ != NULL) {
       ApiLocalScope* scope = top_scope_;
@@ -550,6 +550,10 @@ class ApiState {
       persistent_handles().FreeHandle(acquired_error_);
       acquired_error_ = NULL;
     }
+    if (native_argument_error_ != NULL) {
+      persistent_handles().FreeHandle(native_argument_error_);
+      native_argument_error_ = NULL;
+    }
   }
 
   // Accessors.
@@ -558,6 +562,9 @@ class ApiState {
 
   PersistentHandles& persistent_handles() { return persistent_handles_; }
 
+  // Handles returned by Dart_TypedDataPin.
+  PersistentHandles& pinned_handles() { return pinned_handles_; }
+
   FinalizablePersistentHandles& weak_persistent_handles() {
     return weak_persistent_handles_;
   }
@@ -593,6 +600,7 @@ class ApiState {
       scope = scope->previous();
     }
     persistent_handles().VisitObjectPointers(visitor);
+    pinned_handles().VisitObjectPointers(visitor);
     if (visit_prologue_weak_handles) {
       prologue_weak_persistent_handles().VisitObjectPointers(visitor);
     }
@@ -621,6 +629,15 @@ class ApiState {
     return persistent_handles_.IsValidHandle(object);
   }
 
+  bool IsValidPinnedHandle(Dart_Handle object) const {
+    if (!pinned_handles_.IsValidHandle(object)) {
+      return false;
+    }
+    // A freed handle holds the next pointer of the free list instead of an
+    // object.
+    return reinterpret_cast<PersistentHandle*>(object)->raw()->IsHeapObject();
+  }
+
   bool IsValidWeakPersistentHandle(Dart_Handle object) const {
     return weak_persistent_handles_.IsValidHandle(object);
   }
@@ -631,7 +648,8 @@ class ApiState {
 
   bool IsProtectedHandle(PersistentHandle* object) const {
     if (object == NULL) return false;
-    return object == null_ || object == true_ || object == false_;
+    return object == null_ || object == true_ || object == false_ ||
+        object == native_argument_error_;
   }
 
   int CountLocalHandles() const {
@@ -690,12 +708,28 @@ class ApiState {
     return acquired_error_;
   }
 
+  void SetupNativeArgumentError() {
+    ASSERT(native_argument_error_ == NULL);
+    native_argument_error_ = persistent_handles().AllocateHandle();
+    const String& message = String::Handle(
+        String::New("Invalid native argument: the index is out of range or "
+                    "the argument does not have the expected type.",
+                    Heap::kOld));
+    native_argument_error_->set_raw(ApiError::New(message, Heap::kOld));
+  }
+
+  PersistentHandle* NativeArgumentError() const {
+    ASSERT(native_argument_error_ != NULL);
+    return native_argument_error_;
+  }
+
   void DelayWeakReferenceSet(WeakReferenceSet* reference_set) {
     WeakReferenceSet::Push(reference_set, &delayed_weak_reference_sets_);
   }
 
  private:
   PersistentHandles persistent_handles_;
+  PersistentHandles pinned_handles_;
   FinalizablePersistentHandles weak_persistent_handles_;
   FinalizablePersistentHandles prologue_weak_persistent_handles_;
   ApiLocalScope* top_scope_;
@@ -706,6 +740,7 @@ class ApiState {
   PersistentHandle* true_;
   PersistentHandle* false_;
   PersistentHandle* acquired_error_;
+  PersistentHandle* native_argument_error_;
 
   DISALLOW_COPY_AND_ASSIGN(ApiState);
 };
@@ -175,6 +175,16 @@ bool ArgumentsDescriptor::MatchesNameAt(intptr_t index,
 }
 
 
+RawString* ArgumentsDescriptor::NameAt(intptr_t index) const {
+  const intptr_t offset = kFirstNamedEntryIndex +
+                          (index * kNamedEntrySize) +
+                          kNameOffset;
+  String& result = String::Handle();
+  result ^= array_.At(offset);
+  return result.raw();
+}
+
+
 intptr_t ArgumentsDescriptor::count_offset() {
   return Array::data_offset() + (kCountIndex * kWordSize);
 }
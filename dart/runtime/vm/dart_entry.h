@@ -38,6 +38,7 @@ class ArgumentsDescriptor : public ValueObject {
   intptr_t PositionalCount() const;
   intptr_t NamedCount() const { return Count() - PositionalCount(); }
   bool MatchesNameAt(intptr_t i, const String& other) const;
+  RawString* NameAt(intptr_t i) const;
 
   // Generated code support.
   static intptr_t count_offset();
@@ -281,6 +281,9 @@ class Debugger {
   // Checks for both user-defined and internal temporary breakpoints.
   bool HasBreakpoint(const Function& func);
 
+  // Returns true if any user-defined or internal breakpoint is set in code.
+  bool HasCodeBreakpoints() const { return code_breakpoints_ != NULL; }
+
   DebuggerStackTrace* StackTrace() const { return stack_trace_; }
 
   RawArray* GetInstanceFields(const Instance& obj);
@@ -57,6 +57,22 @@ void DeoptimizationContext::SetCallerFp(intptr_t caller_fp) {
   caller_fp_ = caller_fp;
 }
 
+
+// Stores an unboxed unsigned 32-bit value into the unoptimized frame slot,
+// as a Smi if it fits and as a deferred Mint otherwise.
+static void MaterializeUint32(uint32_t value, intptr_t* to_addr) {
+  const int64_t value64 = static_cast<int64_t>(value);
+  if (Smi::IsValid64(value64)) {
+    *to_addr = reinterpret_cast<intptr_t>(
+        Smi::New(static_cast<intptr_t>(value64)));
+  } else {
+    *reinterpret_cast<RawSmi**>(to_addr) = Smi::New(0);
+    Isolate::Current()->DeferMintMaterialization(
+        value64, reinterpret_cast<RawMint**>(to_addr));
+  }
+}
+
+
 // Deoptimization instruction moving value from optimized frame at
 // 'from_index' to specified slots in the unoptimized frame.
 // 'from_index' represents the slot index of the frame (0 being first argument)
@@ -90,6 +106,38 @@ class DeoptStackSlotInstr : public DeoptInstr {
 };
 
 
+// Materializes an unboxed unsigned 32-bit integer kept in a stack slot as
+// Smi or Mint.
+class DeoptUint32StackSlotInstr : public DeoptInstr {
+ public:
+  explicit DeoptUint32StackSlotInstr(intptr_t from_index)
+      : stack_slot_index_(from_index) {
+    ASSERT(stack_slot_index_ >= 0);
+  }
+
+  virtual intptr_t from_index() const { return stack_slot_index_; }
+  virtual DeoptInstr::Kind kind() const { return kUint32StackSlot; }
+
+  virtual const char* ToCString() const {
+    return Isolate::Current()->current_zone()->PrintToString(
+        "us%"Pd"", stack_slot_index_);
+  }
+
+  void Execute(DeoptimizationContext* deopt_context, intptr_t* to_addr) {
+    intptr_t from_index =
+       deopt_context->from_frame_size() - stack_slot_index_ - 1;
+    uint32_t* from_addr = reinterpret_cast<uint32_t*>(
+        deopt_context->GetFromFrameAddressAt(from_index));
+    MaterializeUint32(*from_addr, to_addr);
+  }
+
+ private:
+  const intptr_t stack_slot_index_;  // First argument is 0, always >= 0.
+
+  DISALLOW_COPY_AND_ASSIGN(DeoptUint32StackSlotInstr);
+};
+
+
 class DeoptDoubleStackSlotInstr : public DeoptInstr {
  public:
   explicit DeoptDoubleStackSlotInstr(intptr_t from_index)
@@ -341,6 +389,34 @@ class DeoptRegisterInstr: public DeoptInstr {
 };
 
 
+// Deoptimization instruction moving a CPU register that holds an unboxed
+// unsigned 32-bit integer.
+class DeoptUint32RegisterInstr: public DeoptInstr {
+ public:
+  explicit DeoptUint32RegisterInstr(intptr_t reg_as_int)
+      : reg_(static_cast<Register>(reg_as_int)) {}
+
+  virtual intptr_t from_index() const { return static_cast<intptr_t>(reg_); }
+  virtual DeoptInstr::Kind kind() const { return kUint32Register; }
+
+  virtual const char* ToCString() const {
+    return Isolate::Current()->current_zone()->PrintToString(
+        "%s(u)", Assembler::RegisterName(reg_));
+  }
+
+  void Execute(DeoptimizationContext* deopt_context, intptr_t* to_addr) {
+    const uint32_t value =
+        static_cast<uint32_t>(deopt_context->RegisterValue(reg_));
+    MaterializeUint32(value, to_addr);
+  }
+
+ private:
+  const Register reg_;
+
+  DISALLOW_COPY_AND_ASSIGN(DeoptUint32RegisterInstr);
+};
+
+
 // Deoptimization instruction moving an XMM register.
 class DeoptFpuRegisterInstr: public DeoptInstr {
  public:
@@ -628,8 +704,8 @@ class DeoptMaterializedObjectRefInstr : public DeoptInstr {
 
 
 // Materialize object with the given number of fields.
-// Arguments for materialization (class and field-value pairs) are pushed
-// to the expression stack of the bottom-most frame.
+// Arguments for materialization (class, length and slot-value pairs) are
+// pushed to the expression stack of the bottom-most frame.
 class DeoptMaterializeObjectInstr : public DeoptInstr {
  public:
   explicit DeoptMaterializeObjectInstr(intptr_t field_count)
@@ -686,6 +762,7 @@ DeoptInstr* DeoptInstr::Create(intptr_t kind_as_int, intptr_t from_index) {
   Kind kind = static_cast<Kind>(kind_as_int);
   switch (kind) {
     case kStackSlot: return new DeoptStackSlotInstr(from_index);
+    case kUint32StackSlot: return new DeoptUint32StackSlotInstr(from_index);
     case kDoubleStackSlot: return new DeoptDoubleStackSlotInstr(from_index);
     case kInt64StackSlot: return new DeoptInt64StackSlotInstr(from_index);
     case kFloat32x4StackSlot:
@@ -695,6 +772,7 @@ DeoptInstr* DeoptInstr::Create(intptr_t kind_as_int, intptr_t from_index) {
     case kRetAddress: return new DeoptRetAddressInstr(from_index);
     case kConstant: return new DeoptConstantInstr(from_index);
     case kRegister: return new DeoptRegisterInstr(from_index);
+    case kUint32Register: return new DeoptUint32RegisterInstr(from_index);
     case kFpuRegister: return new DeoptFpuRegisterInstr(from_index);
     case kInt64FpuRegister: return new DeoptInt64FpuRegisterInstr(from_index);
     case kFloat32x4FpuRegister:
@@ -810,8 +888,12 @@ void DeoptInfoBuilder::AddCopy(Value* value,
     intptr_t object_table_index = FindOrAddObjectInTable(from_loc.constant());
     deopt_instr = new DeoptConstantInstr(object_table_index);
   } else if (from_loc.IsRegister()) {
-    ASSERT(value->definition()->representation() == kTagged);
-    deopt_instr = new DeoptRegisterInstr(from_loc.reg());
+    if (value->definition()->representation() == kUnboxedUint32) {
+      deopt_instr = new DeoptUint32RegisterInstr(from_loc.reg());
+    } else {
+      ASSERT(value->definition()->representation() == kTagged);
+      deopt_instr = new DeoptRegisterInstr(from_loc.reg());
+    }
   } else if (from_loc.IsFpuRegister()) {
     if (value->definition()->representation() == kUnboxedDouble) {
       deopt_instr = new DeoptFpuRegisterInstr(from_loc.fpu_reg());
@@ -824,9 +906,13 @@ void DeoptInfoBuilder::AddCopy(Value* value,
       deopt_instr = new DeoptUint32x4FpuRegisterInstr(from_loc.fpu_reg());
     }
   } else if (from_loc.IsStackSlot()) {
-    ASSERT(value->definition()->representation() == kTagged);
     intptr_t from_index = CalculateStackIndex(from_loc);
-    deopt_instr = new DeoptStackSlotInstr(from_index);
+    if (value->definition()->representation() == kUnboxedUint32) {
+      deopt_instr = new DeoptUint32StackSlotInstr(from_index);
+    } else {
+      ASSERT(value->definition()->representation() == kTagged);
+      deopt_instr = new DeoptStackSlotInstr(from_index);
+    }
   } else if (from_loc.IsDoubleStackSlot()) {
     intptr_t from_index = CalculateStackIndex(from_loc);
     if (value->definition()->representation() == kUnboxedDouble) {
@@ -903,10 +989,12 @@ intptr_t DeoptInfoBuilder::EmitMaterializationArguments() {
   for (intptr_t i = 0; i < materializations_.length(); i++) {
     MaterializeObjectInstr* mat = materializations_[i];
     AddConstant(mat->cls(), slot_idx++);  // Class of the instance to allocate.
+    // Length of the array to allocate (ignored for other objects).
+    AddConstant(Smi::ZoneHandle(Smi::New(mat->num_elements())), slot_idx++);
     for (intptr_t i = 0; i < mat->InputCount(); i++) {
       if (!mat->InputAt(i)->BindsToConstantNull()) {
-        // Emit field-value pair.
-        AddConstant(mat->FieldAt(i), slot_idx++);
+        // Emit slot-value pair. Slot is either a Field or a Smi offset.
+        AddConstant(mat->SlotAt(i), slot_idx++);
         AddCopy(mat->InputAt(i), mat->LocationAt(i), slot_idx++);
       }
     }
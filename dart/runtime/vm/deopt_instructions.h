@@ -99,11 +99,13 @@ class DeoptInstr : public ZoneAllocated {
     kRetAddress,
     kConstant,
     kRegister,
+    kUint32Register,
     kFpuRegister,
     kInt64FpuRegister,
     kFloat32x4FpuRegister,
     kUint32x4FpuRegister,
     kStackSlot,
+    kUint32StackSlot,
     kDoubleStackSlot,
     kInt64StackSlot,
     kFloat32x4StackSlot,
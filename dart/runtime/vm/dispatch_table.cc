@@ -0,0 +1,233 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/dispatch_table.h"
+
+#include <stdlib.h>
+#include "vm/dart_entry.h"
+#include "vm/object.h"
+
+namespace dart {
+
+DispatchTable::DispatchTable()
+    : capacity_(0),
+      length_(0),
+      selectors_(NULL),
+      num_targets_(0),
+      table_(Array::null()) {
+}
+
+
+DispatchTable::~DispatchTable() {
+  free(selectors_);
+}
+
+
+// Only instances of finalized, concrete classes can be receivers. Calls on
+// null are left to the megamorphic cache.
+static bool HasRow(const Class& cls) {
+  const intptr_t cid = cls.id();
+  if ((cid < kInstanceCid) ||
+      ((cid >= kNullCid) && (cid < kNumPredefinedCids))) {
+    return false;
+  }
+  return cls.is_finalized() && !cls.is_abstract();
+}
+
+
+// Looks the target up like Resolver::ResolveDynamicForReceiverClass, except
+// that no method extractor is created: filling the table must not add
+// functions to every class with a method of a getter selector's name. Such
+// a class is left to the megamorphic cache until a call has created the
+// extractor.
+static RawFunction* ResolveTarget(const Class& cls,
+                                  const String& name,
+                                  const String& field_name,
+                                  const Array& descriptor) {
+  Class& owner = Class::Handle(cls.raw());
+  Function& function = Function::Handle();
+  while (!owner.IsNull()) {
+    function = owner.LookupDynamicFunction(name);
+    if (!function.IsNull()) {
+      break;
+    }
+    if (!field_name.IsNull() &&
+        (owner.LookupDynamicFunction(field_name) != Function::null())) {
+      // The resolver would extract this method.
+      return Function::null();
+    }
+    owner = owner.SuperClass();
+  }
+  ArgumentsDescriptor args_desc(descriptor);
+  if (function.IsNull() ||
+      !function.AreValidArguments(args_desc, NULL)) {
+    return Function::null();
+  }
+  return function.raw();
+}
+
+
+// Returns the name of the method a getter selector may extract, or null.
+static RawString* ExtractedMethodName(const String& name) {
+  if (!Field::IsGetterName(name)) {
+    return String::null();
+  }
+  return Field::NameFromGetter(name);
+}
+
+
+bool DispatchTable::IsFree(const Array& table, intptr_t row) const {
+  const intptr_t index = row * kEntryLength + kSelectorIdIndex;
+  return table.IsNull() ||
+      (index >= table.Length()) ||
+      (table.At(index) == Object::null());
+}
+
+
+void DispatchTable::EnsureLength(intptr_t row) {
+  const Array& table = Array::Handle(table_);
+  const intptr_t needed = (row + 1) * kEntryLength;
+  const intptr_t length = table.IsNull() ? 0 : table.Length();
+  if (needed <= length) {
+    return;
+  }
+  intptr_t new_length = (length == 0) ? kInitialTableLength : 2 * length;
+  if (new_length < needed) {
+    new_length = needed;
+  }
+  table_ = Array::Grow(table, new_length, Heap::kOld);
+}
+
+
+intptr_t DispatchTable::SelectorId(const String& name,
+                                   const Array& descriptor,
+                                   intptr_t* offset) {
+  for (intptr_t i = 0; i < length_; ++i) {
+    if ((selectors_[i].name == name.raw()) &&
+        (selectors_[i].descriptor == descriptor.raw())) {
+      *offset = selectors_[i].offset;
+      return i + 1;
+    }
+  }
+
+  // Collect the targets of all classes finalized so far.
+  ClassTable* class_table = Isolate::Current()->class_table();
+  GrowableArray<intptr_t> cids;
+  const GrowableObjectArray& targets =
+      GrowableObjectArray::Handle(GrowableObjectArray::New());
+  Class& cls = Class::Handle();
+  Function& target = Function::Handle();
+  const String& field_name = String::Handle(ExtractedMethodName(name));
+  for (intptr_t cid = kInstanceCid; cid < class_table->NumCids(); cid++) {
+    if (!class_table->HasValidClassAt(cid)) {
+      continue;
+    }
+    cls = class_table->At(cid);
+    if (!HasRow(cls)) {
+      continue;
+    }
+    target = ResolveTarget(cls, name, field_name, descriptor);
+    if (!target.IsNull()) {
+      cids.Add(cid);
+      targets.Add(target);
+    }
+  }
+
+  // Find the lowest offset at which all entries are free.
+  Array& table = Array::Handle(table_);
+  intptr_t selector_offset = 0;
+  bool fits = false;
+  while (!fits) {
+    fits = true;
+    for (intptr_t i = 0; i < cids.length(); i++) {
+      if (!IsFree(table, cids[i] + selector_offset)) {
+        fits = false;
+        selector_offset++;
+        break;
+      }
+    }
+  }
+
+  if (length_ == capacity_) {
+    capacity_ += kCapacityIncrement;
+    selectors_ = reinterpret_cast<Entry*>(
+        realloc(selectors_, capacity_ * sizeof(*selectors_)));
+  }
+  ASSERT(length_ < capacity_);
+  Entry entry = { name.raw(), descriptor.raw(), selector_offset };
+  selectors_[length_++] = entry;
+  const intptr_t id = length_;
+
+  // Generated code expects a table once a selector has been assigned.
+  EnsureLength(cids.is_empty() ? 0 : cids.Last() + selector_offset);
+  table = table_;
+  if (!cids.is_empty()) {
+    const Smi& selector_id = Smi::Handle(Smi::New(id));
+    for (intptr_t i = 0; i < cids.length(); i++) {
+      const intptr_t row = cids[i] + selector_offset;
+      target ^= targets.At(i);
+      table.SetAt(row * kEntryLength + kSelectorIdIndex, selector_id);
+      table.SetAt(row * kEntryLength + kTargetIndex, target);
+    }
+    num_targets_ += cids.length();
+  }
+  *offset = selector_offset;
+  return id;
+}
+
+
+void DispatchTable::AddClass(const Class& cls) {
+  if ((length_ == 0) || !HasRow(cls)) {
+    return;
+  }
+  const intptr_t cid = cls.id();
+  String& name = String::Handle();
+  String& field_name = String::Handle();
+  Array& descriptor = Array::Handle();
+  Array& table = Array::Handle();
+  Function& target = Function::Handle();
+  Smi& selector_id = Smi::Handle();
+  for (intptr_t i = 0; i < length_; ++i) {
+    name = selectors_[i].name;
+    descriptor = selectors_[i].descriptor;
+    field_name = ExtractedMethodName(name);
+    target = ResolveTarget(cls, name, field_name, descriptor);
+    const intptr_t row = cid + selectors_[i].offset;
+    table = table_;
+    if (target.IsNull() || !IsFree(table, row)) {
+      // An entry taken by another selector leaves this class to the
+      // megamorphic cache.
+      continue;
+    }
+    EnsureLength(row);
+    table = table_;
+    selector_id = Smi::New(i + 1);
+    table.SetAt(row * kEntryLength + kSelectorIdIndex, selector_id);
+    table.SetAt(row * kEntryLength + kTargetIndex, target);
+    num_targets_++;
+  }
+}
+
+
+void DispatchTable::VisitObjectPointers(ObjectPointerVisitor* v) {
+  ASSERT(v != NULL);
+  v->VisitPointer(reinterpret_cast<RawObject**>(&table_));
+  for (intptr_t i = 0; i < length_; ++i) {
+    v->VisitPointer(reinterpret_cast<RawObject**>(&selectors_[i].name));
+    v->VisitPointer(reinterpret_cast<RawObject**>(&selectors_[i].descriptor));
+  }
+}
+
+
+void DispatchTable::PrintSizes() {
+  StackZone zone(Isolate::Current());
+  const Array& table = Array::Handle(table_);
+  const intptr_t length = table.IsNull() ? 0 : table.Length();
+  const intptr_t size = table.IsNull() ? 0 : Array::InstanceSize(length);
+  OS::Print("%"Pd" dispatch table selectors with %"Pd" targets in %"Pd" "
+            "entries using %"Pd"KB.\n",
+            length_, num_targets_, length / kEntryLength, size / 1024);
+}
+
+}  // namespace dart
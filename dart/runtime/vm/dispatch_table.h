@@ -0,0 +1,81 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef VM_DISPATCH_TABLE_H_
+#define VM_DISPATCH_TABLE_H_
+
+#include "vm/allocation.h"
+
+namespace dart {
+
+class Array;
+class Class;
+class ObjectPointerVisitor;
+class RawArray;
+class RawString;
+class String;
+
+// A global row-displacement dispatch table used by megamorphic instance calls
+// in optimized code. Every selector (a name and an arguments descriptor) used
+// at a megamorphic call site gets an id and an offset; the target for a
+// receiver with class id 'cid' is found in the row starting at
+// 'cid + offset'. Rows of different selectors are interleaved, so an entry
+// holds the selector id it belongs to and the target function:
+//   [2 * (cid + offset)]:     selector id (smi), or null if the row is free.
+//   [2 * (cid + offset) + 1]: target function.
+// A missing or mismatching entry (e.g., noSuchMethod, conflicting rows of
+// classes finalized after the selector was assigned) or a target without code
+// is handled by the megamorphic cache of the call site.
+class DispatchTable {
+ public:
+  static const intptr_t kEntryLength = 2;
+  static const intptr_t kSelectorIdIndex = 0;
+  static const intptr_t kTargetIndex = 1;
+
+  DispatchTable();
+  ~DispatchTable();
+
+  // Returns the id of the selector and sets 'offset' to its row offset.
+  // A new selector is assigned the lowest offset at which the targets of all
+  // finalized classes fit into free entries.
+  intptr_t SelectorId(const String& name,
+                      const Array& descriptor,
+                      intptr_t* offset);
+
+  // Adds the targets of the assigned selectors for a newly finalized class.
+  void AddClass(const Class& cls);
+
+  // Address of the table array; generated code loads the table through it
+  // since the array is replaced when it grows.
+  uword table_address() const { return reinterpret_cast<uword>(&table_); }
+
+  void VisitObjectPointers(ObjectPointerVisitor* visitor);
+
+  void PrintSizes();
+
+ private:
+  struct Entry {
+    RawString* name;
+    RawArray* descriptor;
+    intptr_t offset;
+  };
+
+  static const int kCapacityIncrement = 128;
+  static const intptr_t kInitialTableLength = 1024;
+
+  bool IsFree(const Array& table, intptr_t row) const;
+  void EnsureLength(intptr_t row);
+
+  intptr_t capacity_;
+  intptr_t length_;
+  Entry* selectors_;
+  intptr_t num_targets_;
+  RawArray* table_;
+
+  DISALLOW_COPY_AND_ASSIGN(DispatchTable);
+};
+
+}  // namespace dart
+
+#endif  // VM_DISPATCH_TABLE_H_
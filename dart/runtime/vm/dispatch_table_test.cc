@@ -0,0 +1,104 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "platform/assert.h"
+#include "vm/class_finalizer.h"
+#include "vm/dart_entry.h"
+#include "vm/dispatch_table.h"
+#include "vm/globals.h"
+#include "vm/symbols.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+// Returns the target the table holds for the selector and receiver class,
+// or null if the entry belongs to no or to another selector.
+static RawFunction* LookupTarget(DispatchTable* dispatch_table,
+                                 intptr_t selector_id,
+                                 intptr_t offset,
+                                 const Class& cls) {
+  const Array& table = Array::Handle(
+      *reinterpret_cast<RawArray**>(dispatch_table->table_address()));
+  const intptr_t index = (cls.id() + offset) * DispatchTable::kEntryLength;
+  if (table.IsNull() ||
+      (index >= table.Length()) ||
+      (table.At(index + DispatchTable::kSelectorIdIndex) !=
+       Smi::New(selector_id))) {
+    return Function::null();
+  }
+  return reinterpret_cast<RawFunction*>(
+      table.At(index + DispatchTable::kTargetIndex));
+}
+
+
+static RawClass* LookupClass(const char* library_url, const char* name) {
+  const Library& lib = Library::Handle(
+      Library::LookupLibrary(String::Handle(String::New(library_url))));
+  EXPECT(!lib.IsNull());
+  const Class& cls = Class::Handle(
+      lib.LookupClass(String::Handle(Symbols::New(name))));
+  EXPECT(!cls.IsNull());
+  return cls.raw();
+}
+
+
+TEST_CASE(DispatchTable) {
+  const char* kScriptChars =
+      "class A {\n"
+      "  foo(x) => 1;\n"
+      "  bar() => 2;\n"
+      "}\n"
+      "class B extends A {\n"
+      "  foo(x) => 3;\n"
+      "}\n";
+  TestCase::LoadTestScript(kScriptChars, NULL);
+  EXPECT(ClassFinalizer::FinalizePendingClasses());
+  const Class& class_a = Class::Handle(LookupClass(TestCase::url(), "A"));
+  const Class& class_b = Class::Handle(LookupClass(TestCase::url(), "B"));
+
+  DispatchTable* dispatch_table = Isolate::Current()->dispatch_table();
+  const String& foo = String::Handle(Symbols::New("foo"));
+  const Array& two_args = Array::Handle(ArgumentsDescriptor::New(2));
+  intptr_t foo_offset = -1;
+  const intptr_t foo_id =
+      dispatch_table->SelectorId(foo, two_args, &foo_offset);
+  EXPECT(foo_offset >= 0);
+  EXPECT_EQ(foo_id, dispatch_table->SelectorId(foo, two_args, &foo_offset));
+  EXPECT(LookupTarget(dispatch_table, foo_id, foo_offset, class_a) ==
+         class_a.LookupDynamicFunction(foo));
+  EXPECT(LookupTarget(dispatch_table, foo_id, foo_offset, class_b) ==
+         class_b.LookupDynamicFunction(foo));
+
+  // Assigning a getter selector does not create method extractors.
+  const String& get_bar = String::Handle(Symbols::New("get:bar"));
+  const Array& one_arg = Array::Handle(ArgumentsDescriptor::New(1));
+  intptr_t get_bar_offset = -1;
+  const intptr_t get_bar_id =
+      dispatch_table->SelectorId(get_bar, one_arg, &get_bar_offset);
+  EXPECT(get_bar_id != foo_id);
+  EXPECT(class_a.LookupDynamicFunction(get_bar) == Function::null());
+  EXPECT(LookupTarget(dispatch_table, get_bar_id, get_bar_offset, class_a) ==
+         Function::null());
+
+  // A class loaded after the selector was assigned gets its targets when it
+  // is finalized.
+  const char* kLateLibraryChars =
+      "library late_library;\n"
+      "class Late {\n"
+      "  foo(x) => 4;\n"
+      "}\n";
+  Dart_Handle lib = Dart_LoadLibrary(NewString("late_library_url"),
+                                     NewString(kLateLibraryChars));
+  EXPECT_VALID(lib);
+  EXPECT(ClassFinalizer::FinalizePendingClasses());
+  const Class& late = Class::Handle(LookupClass("late_library_url", "Late"));
+  EXPECT(late.is_finalized());
+  EXPECT(late.id() > class_b.id());
+  EXPECT(LookupTarget(dispatch_table, foo_id, foo_offset, late) ==
+         late.LookupDynamicFunction(foo));
+  EXPECT(LookupTarget(dispatch_table, foo_id, foo_offset, class_b) ==
+         class_b.LookupDynamicFunction(foo));
+}
+
+}  // namespace dart
@@ -136,11 +136,36 @@ static bool ShouldShowFunction(const Function& function) {
 
 // Iterate through the stack frames and try to find a frame with an
 // exception handler. Once found, set the pc, sp and fp so that execution
-// can continue in that frame.
+// can continue in that frame, and whether the handler uses the stack trace.
 static bool FindExceptionHandler(uword* handler_pc,
                                  uword* handler_sp,
                                  uword* handler_fp,
-                                 StacktraceBuilder* builder) {
+                                 bool* needs_stacktrace) {
+  StackFrameIterator frames(StackFrameIterator::kDontValidateFrames);
+  StackFrame* frame = frames.NextFrame();
+  ASSERT(frame != NULL);  // We expect to find a dart invocation frame.
+  while (!frame->IsEntryFrame()) {
+    if (frame->IsDartFrame()) {
+      if (frame->FindExceptionHandler(handler_pc, needs_stacktrace)) {
+        *handler_sp = frame->sp();
+        *handler_fp = frame->fp();
+        return true;
+      }
+    }
+    frame = frames.NextFrame();
+    ASSERT(frame != NULL);
+  }
+  ASSERT(frame->IsEntryFrame());
+  *handler_pc = frame->pc();
+  *handler_sp = frame->sp();
+  *handler_fp = frame->fp();
+  return false;
+}
+
+
+// Add the frames from the top of the stack down to the handler frame with
+// the given frame pointer (or down to the entry frame) to the stack trace.
+static void BuildStacktrace(StacktraceBuilder* builder, uword handler_fp) {
   StackFrameIterator frames(StackFrameIterator::kDontValidateFrames);
   StackFrame* frame = frames.NextFrame();
   ASSERT(frame != NULL);  // We expect to find a dart invocation frame.
@@ -172,20 +197,13 @@ static bool FindExceptionHandler(uword* handler_pc,
           builder->AddFrame(func, code, offset);
         }
       }
-      if (frame->FindExceptionHandler(handler_pc)) {
-        *handler_sp = frame->sp();
-        *handler_fp = frame->fp();
-        return true;
+      if (frame->fp() == handler_fp) {
+        return;
       }
     }
     frame = frames.NextFrame();
     ASSERT(frame != NULL);
   }
-  ASSERT(frame->IsEntryFrame());
-  *handler_pc = frame->pc();
-  *handler_sp = frame->sp();
-  *handler_fp = frame->fp();
-  return false;
 }
 
 
@@ -265,24 +283,25 @@ static void ThrowExceptionHelper(const Instance& incoming_exception,
   uword handler_pc = 0;
   uword handler_sp = 0;
   uword handler_fp = 0;
+  bool needs_stacktrace = false;
+  bool handler_exists = FindExceptionHandler(&handler_pc,
+                                             &handler_sp,
+                                             &handler_fp,
+                                             &needs_stacktrace);
+  // Exceptions are mostly caught by handlers that neither bind the stack
+  // trace nor rethrow, so the stack trace is only built if it is observable.
+  // Unhandled exceptions are reported with their stack trace.
+  if (!handler_exists || FLAG_print_stacktrace_at_throw) {
+    needs_stacktrace = true;
+  }
   Stacktrace& stacktrace = Stacktrace::Handle(isolate);
-  bool handler_exists = false;
-  if (use_preallocated_stacktrace) {
+  if (needs_stacktrace && use_preallocated_stacktrace) {
     stacktrace ^= isolate->object_store()->preallocated_stack_trace();
     PreallocatedStacktraceBuilder frame_builder(stacktrace);
-    handler_exists = FindExceptionHandler(&handler_pc,
-                                          &handler_sp,
-                                          &handler_fp,
-                                          &frame_builder);
-  } else {
+    BuildStacktrace(&frame_builder, handler_fp);
+  } else if (needs_stacktrace) {
     RegularStacktraceBuilder frame_builder;
-    handler_exists = FindExceptionHandler(&handler_pc,
-                                          &handler_sp,
-                                          &handler_fp,
-                                          &frame_builder);
-    // TODO(5411263): At some point we can optimize by figuring out if a
-    // stack trace is needed based on whether the catch code specifies a
-    // stack trace object or there is a rethrow in the catch clause.
+    BuildStacktrace(&frame_builder, handler_fp);
     if (frame_builder.pc_offset_list().Length() != 0) {
       // Create arrays for function, code and pc_offset triplet for each frame.
       const Array& func_array =
@@ -304,7 +323,7 @@ static void ThrowExceptionHelper(const Instance& incoming_exception,
                                       Object::empty_array(),
                                       Object::empty_array());
       }
-    } else {
+    } else if (!existing_stacktrace.IsNull()) {
       stacktrace ^= existing_stacktrace.raw();
       // Since we are re throwing and appending to the existing stack trace
       // we clear out the catch trace collected in the existing stack trace
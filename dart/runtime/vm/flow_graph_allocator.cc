@@ -73,7 +73,11 @@ FlowGraphAllocator::FlowGraphAllocator(const FlowGraph& flow_graph)
     fpu_regs_(),
     blocked_cpu_registers_(),
     blocked_fpu_registers_(),
-    cpu_spill_slot_count_(0) {
+    cpu_spill_slot_count_(0),
+    spill_count_(0),
+    reload_count_(0),
+    rematerialization_count_(0),
+    moves_in_loops_count_(0) {
   for (intptr_t i = 0; i < vreg_count_; i++) live_ranges_.Add(NULL);
   for (intptr_t i = 0; i < vreg_count_; i++) {
     value_representations_.Add(kNoRepresentation);
@@ -827,6 +831,11 @@ void FlowGraphAllocator::ProcessOneInstruction(BlockEntryInstr* block,
       locs->set_out(Location::NoLocation());
       return;
     }
+
+    // Otherwise the constant is kept in a register but never stored to
+    // the stack: spilled parts of its range use the constant directly and
+    // reloads rematerialize it.
+    range->set_spill_slot(Location::Constant(def->AsConstant()->value()));
   }
 
   const intptr_t pos = current->lifetime_position();
@@ -1222,6 +1231,16 @@ void FlowGraphAllocator::DiscoverLoops() {
       }
     }
   }
+
+  // Compute loop depths in reverse postorder so that headers of enclosing
+  // loops are visited first.
+  for (intptr_t i = block_count - 1; i >= 0; i--) {
+    BlockInfo* info = BlockInfoAt(postorder_[i]->lifetime_position());
+    BlockInfo* loop = info->loop();
+    intptr_t depth = (loop != NULL) ? loop->loop_depth() : 0;
+    if (info->is_loop_header()) depth++;
+    info->set_loop_depth(depth);
+  }
 }
 
 
@@ -1494,6 +1513,10 @@ void FlowGraphAllocator::SpillBetween(LiveRange* range,
   TRACE_ALLOC(OS::Print("spill v%"Pd" [%"Pd", %"Pd") "
                         "between [%"Pd", %"Pd")\n",
                         range->vreg(), range->Start(), range->End(), from, to));
+  // Values that are not needed in a register until after the loop are
+  // spilled at the loop header instead of inside the loop body.
+  from = HoistSpillPosition(range, from, to);
+
   LiveRange* tail = range->SplitAt(from);
 
   if (tail->Start() < to) {
@@ -1514,25 +1537,31 @@ void FlowGraphAllocator::SpillAfter(LiveRange* range, intptr_t from) {
 
   // When spilling the value inside the loop check if this spill can
   // be moved outside.
-  BlockInfo* block_info = BlockInfoAt(from);
-  if (block_info->is_loop_header() || (block_info->loop() != NULL)) {
-    BlockInfo* loop_header =
-        block_info->is_loop_header() ? block_info : block_info->loop();
-
-    if ((range->Start() <= loop_header->entry()->start_pos()) &&
-        RangeHasOnlyUnconstrainedUsesInLoop(range, loop_header->loop_id())) {
-      ASSERT(loop_header->entry()->start_pos() <= from);
-      from = loop_header->entry()->start_pos();
-      TRACE_ALLOC(OS::Print("  moved spill position to loop header %"Pd"\n",
-                            from));
-    }
-  }
+  from = HoistSpillPosition(range, from, kMaxPosition);
 
   LiveRange* tail = range->SplitAt(from);
   Spill(tail);
 }
 
 
+intptr_t FlowGraphAllocator::HoistSpillPosition(LiveRange* range,
+                                                intptr_t from,
+                                                intptr_t to) {
+  BlockInfo* loop_header = BlockInfoAt(from)->loop_header();
+  while ((loop_header != NULL) &&
+         (range->Start() <= loop_header->entry()->start_pos()) &&
+         (loop_header->last_block()->end_pos() <= to) &&
+         RangeHasOnlyUnconstrainedUsesInLoop(range, loop_header->loop_id())) {
+    ASSERT(loop_header->entry()->start_pos() <= from);
+    from = loop_header->entry()->start_pos();
+    TRACE_ALLOC(OS::Print("  moved spill position to loop header %"Pd"\n",
+                          from));
+    loop_header = loop_header->loop();
+  }
+  return from;
+}
+
+
 void FlowGraphAllocator::AllocateSpillSlotFor(LiveRange* range) {
   ASSERT(range->spill_slot().IsInvalid());
 
@@ -1913,20 +1942,44 @@ void FlowGraphAllocator::AllocateAnyRegister(LiveRange* unallocated) {
     return;
   }
 
+  const intptr_t register_use_pos =
+      (register_use != NULL) ? register_use->pos()
+                             : unallocated->Start();
+
   intptr_t candidate = kNoRegister;
   intptr_t free_until = 0;
   intptr_t blocked_at = kMaxPosition;
+  intptr_t candidate_cost = 0;
 
+  // Among the registers that stay free until the first register use prefer
+  // the one whose values are cheapest to evict, so that values used in inner
+  // loops are not spilled in favor of values used outside of them.
   for (int reg = 0; reg < NumberOfRegisters(); ++reg) {
     if (blocked_registers_[reg]) continue;
-    if (UpdateFreeUntil(reg, unallocated, &free_until, &blocked_at)) {
+    intptr_t reg_free_until = 0;
+    intptr_t reg_blocked_at = kMaxPosition;
+    if (!UpdateFreeUntil(reg, unallocated, &reg_free_until, &reg_blocked_at)) {
+      continue;
+    }
+
+    bool is_better = (reg_free_until > free_until);
+    intptr_t cost = 0;
+    if (reg_free_until >= register_use_pos) {
+      cost = EvictionCost(reg, unallocated);
+      if ((candidate != kNoRegister) && (free_until >= register_use_pos)) {
+        is_better = (cost < candidate_cost) ||
+            ((cost == candidate_cost) && (reg_free_until > free_until));
+      }
+    }
+
+    if (is_better || (candidate == kNoRegister)) {
       candidate = reg;
+      free_until = reg_free_until;
+      blocked_at = reg_blocked_at;
+      candidate_cost = cost;
     }
   }
 
-  const intptr_t register_use_pos =
-      (register_use != NULL) ? register_use->pos()
-                             : unallocated->Start();
   if (free_until < register_use_pos) {
     // Can't acquire free register. Spill until we really need one.
     ASSERT(unallocated->Start() < ToInstructionStart(register_use_pos));
@@ -1952,6 +2005,44 @@ void FlowGraphAllocator::AllocateAnyRegister(LiveRange* unallocated) {
 }
 
 
+// Weight of a use at the given loop depth: assume every loop iterates
+// kLoopWeight times, but do not let deep nests overflow the cost.
+static intptr_t LoopWeight(intptr_t loop_depth) {
+  static const intptr_t kLoopWeight = 8;
+  static const intptr_t kMaxWeightedLoopDepth = 6;
+  intptr_t weight = 1;
+  for (intptr_t i = 0; (i < loop_depth) && (i < kMaxWeightedLoopDepth); i++) {
+    weight *= kLoopWeight;
+  }
+  return weight;
+}
+
+
+intptr_t FlowGraphAllocator::EvictionCost(intptr_t reg,
+                                          LiveRange* unallocated) {
+  const intptr_t start = unallocated->Start();
+  const intptr_t end = unallocated->End();
+
+  intptr_t cost = 0;
+  for (intptr_t i = 0; i < registers_[reg].length(); i++) {
+    LiveRange* allocated = registers_[reg][i];
+    if (allocated->vreg() < 0) continue;
+
+    for (UsePosition* use = allocated->finger()->FirstRegisterBeneficialUse(
+             start);
+         (use != NULL) && (use->pos() < end);
+         use = use->next()) {
+      Location* loc = use->location_slot();
+      if (loc->IsUnallocated() && loc->IsRegisterBeneficial()) {
+        cost += LoopWeight(BlockInfoAt(use->pos())->loop_depth());
+      }
+    }
+  }
+
+  return cost;
+}
+
+
 bool FlowGraphAllocator::UpdateFreeUntil(intptr_t reg,
                                          LiveRange* unallocated,
                                          intptr_t* cur_free_until,
@@ -2124,7 +2215,8 @@ void FlowGraphAllocator::ConvertAllUses(LiveRange* range) {
          safepoint = safepoint->next()) {
       if (!safepoint->locs()->always_calls()) {
         ASSERT(safepoint->locs()->can_call());
-        safepoint->locs()->live_registers()->Add(loc);
+        safepoint->locs()->live_registers()->Add(loc,
+                                                 range->representation());
       }
     }
   }
@@ -2374,8 +2466,10 @@ void FlowGraphAllocator::ConnectSplitSiblings(LiveRange* parent,
   if ((last->SuccessorCount() == 1) && !source_block->IsGraphEntry()) {
     ASSERT(last->IsGoto());
     last->AsGoto()->GetParallelMove()->AddMove(target, source);
+    CountMove(source_pos, target, source);
   } else {
     target_block->GetParallelMove()->AddMove(target, source);
+    CountMove(target_pos, target, source);
   }
 }
 
@@ -2403,6 +2497,9 @@ void FlowGraphAllocator::ResolveControlFlow() {
         AddMoveAt(sibling->Start(),
                   sibling->assigned_location(),
                   range->assigned_location());
+        CountMove(sibling->Start(),
+                  sibling->assigned_location(),
+                  range->assigned_location());
       }
       range = sibling;
     }
@@ -2433,11 +2530,47 @@ void FlowGraphAllocator::ResolveControlFlow() {
       AddMoveAt(range->Start() + 1,
                 range->spill_slot(),
                 range->assigned_location());
+      CountMove(range->Start() + 1,
+                range->spill_slot(),
+                range->assigned_location());
     }
   }
 }
 
 
+static bool IsSpillSlot(Location loc) {
+  return loc.IsStackSlot() || loc.IsDoubleStackSlot() || loc.IsQuadStackSlot();
+}
+
+
+void FlowGraphAllocator::CountMove(intptr_t pos, Location to, Location from) {
+  if (from.IsConstant()) {
+    rematerialization_count_++;
+  } else if (IsSpillSlot(from)) {
+    reload_count_++;
+  } else if (IsSpillSlot(to)) {
+    spill_count_++;
+  } else {
+    return;
+  }
+  if (BlockInfoAt(pos)->loop_depth() > 0) {
+    moves_in_loops_count_++;
+  }
+}
+
+
+void FlowGraphAllocator::PrintMoveCounts() {
+  const Function& function = flow_graph_.parsed_function().function();
+  OS::Print("ssa allocator [%s]: %"Pd" spills, %"Pd" reloads, "
+            "%"Pd" rematerialized constants, %"Pd" of them in loops\n",
+            function.ToFullyQualifiedCString(),
+            spill_count_,
+            reload_count_,
+            rematerialization_count_,
+            moves_in_loops_count_);
+}
+
+
 void FlowGraphAllocator::CollectRepresentations() {
   // Parameters.
   GraphEntryInstr* graph_entry = flow_graph_.graph_entry();
@@ -2528,6 +2661,10 @@ void FlowGraphAllocator::AllocateRegisters() {
   intptr_t double_spill_slot_count = spill_slots_.length() * kDoubleSpillFactor;
   entry->set_spill_slot_count(cpu_spill_slot_count_ + double_spill_slot_count);
 
+  if (FLAG_trace_ssa_allocator) {
+    PrintMoveCounts();
+  }
+
   if (FLAG_print_ssa_liveranges) {
     const Function& function = flow_graph_.parsed_function().function();
 
@@ -163,10 +163,16 @@ class FlowGraphAllocator : public ValueObject {
 
   // Try to find a register that can be used by a given live range.
   // If all registers are occupied consider evicting interference for
-  // a register that is going to be used as far from the start of
-  // the unallocated live range as possible.
+  // a register whose values are cheapest to evict, preferring the one that
+  // is going to be used as far from the start of the unallocated live range
+  // as possible.
   void AllocateAnyRegister(LiveRange* unallocated);
 
+  // Returns the cost of evicting values allocated to the given register
+  // for the duration of the unallocated live range: their register
+  // beneficial uses inside it weighted by the loop depth of each use.
+  intptr_t EvictionCost(intptr_t reg, LiveRange* unallocated);
+
   // Returns true if the given range has only unconstrained uses in
   // the given loop.
   bool RangeHasOnlyUnconstrainedUsesInLoop(LiveRange* range, intptr_t loop_id);
@@ -214,12 +220,23 @@ class FlowGraphAllocator : public ValueObject {
   // position preceding the to position.
   void SpillBetween(LiveRange* range, intptr_t from, intptr_t to);
 
+  // Returns the position where the range spilled at the from position and
+  // reloaded not earlier than the to position can be spilled instead: the
+  // header of the outermost loop containing from that ends before to and has
+  // only unconstrained uses of the range.
+  intptr_t HoistSpillPosition(LiveRange* range, intptr_t from, intptr_t to);
+
   // Mark the live range as a live object pointer at all safepoints
   // contained in the range.
   void MarkAsObjectAtSafepoints(LiveRange* range);
 
   MoveOperands* AddMoveAt(intptr_t pos, Location to, Location from);
 
+  // Update spill, reload and rematerialization statistics for a move
+  // inserted at the given position.
+  void CountMove(intptr_t pos, Location to, Location from);
+  void PrintMoveCounts();
+
   Location MakeRegisterLocation(intptr_t reg) {
     return Location::MachineRegisterLocation(register_kind_, reg);
   }
@@ -298,6 +315,13 @@ class FlowGraphAllocator : public ValueObject {
 
   intptr_t cpu_spill_slot_count_;
 
+  // Number of moves to spill slots, from spill slots and of constants into
+  // registers inserted by the allocator, and how many of them are in loops.
+  intptr_t spill_count_;
+  intptr_t reload_count_;
+  intptr_t rematerialization_count_;
+  intptr_t moves_in_loops_count_;
+
   DISALLOW_COPY_AND_ASSIGN(FlowGraphAllocator);
 };
 
@@ -310,6 +334,7 @@ class BlockInfo : public ZoneAllocated {
     : entry_(entry),
       loop_(NULL),
       is_loop_header_(false),
+      loop_depth_(0),
       backedge_interference_(NULL) {
   }
 
@@ -348,6 +373,11 @@ class BlockInfo : public ZoneAllocated {
   intptr_t loop_id() const { return loop_id_; }
   void set_loop_id(intptr_t loop_id) { loop_id_ = loop_id; }
 
+  // Number of loops containing this block including the loop it is
+  // a header of.
+  intptr_t loop_depth() const { return loop_depth_; }
+  void set_loop_depth(intptr_t loop_depth) { loop_depth_ = loop_depth; }
+
   BitVector* backedge_interference() const {
     return backedge_interference_;
   }
@@ -363,6 +393,7 @@ class BlockInfo : public ZoneAllocated {
 
   BlockEntryInstr* last_block_;
   intptr_t loop_id_;
+  intptr_t loop_depth_;
 
   BitVector* backedge_interference_;
 
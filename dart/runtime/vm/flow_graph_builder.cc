@@ -2648,6 +2648,8 @@ void EffectGraphVisitor::VisitLoadInstanceFieldNode(
       node->field().Offset(),
       AbstractType::ZoneHandle(node->field().type()));
   load->set_field(&node->field());
+  load->set_copies_mutable_box(
+      LoadFieldInstr::IsPotentialUnboxedField(node->field()));
   ReturnDefinition(load);
 }
 
@@ -3131,7 +3133,8 @@ void EffectGraphVisitor::VisitTryCatchNode(TryCatchNode* node) {
         new CatchBlockEntryInstr(owner()->AllocateBlockId(),
                                  old_try_index,
                                  catch_block->handler_types(),
-                                 try_index);
+                                 try_index,
+                                 catch_block->needs_stacktrace());
     owner()->AddCatchEntry(catch_entry);
     ASSERT(!for_catch_block.is_open());
     AppendFragment(catch_entry, for_catch_block);
@@ -23,6 +23,8 @@
 namespace dart {
 
 DEFINE_FLAG(bool, print_scopes, false, "Print scopes of local variables.");
+DEFINE_FLAG(bool, use_dispatch_table, true,
+    "Use the global dispatch table for megamorphic calls.");
 DECLARE_FLAG(bool, code_comments);
 DECLARE_FLAG(bool, enable_type_checks);
 DECLARE_FLAG(bool, intrinsify);
@@ -388,11 +390,13 @@ void FlowGraphCompiler::GenerateDeferredCode() {
 void FlowGraphCompiler::AddExceptionHandler(intptr_t try_index,
                                             intptr_t outer_try_index,
                                             intptr_t pc_offset,
-                                            const Array& handler_types) {
+                                            const Array& handler_types,
+                                            bool needs_stacktrace) {
   exception_handlers_list_->AddHandler(try_index,
                                        outer_try_index,
                                        pc_offset,
-                                       handler_types);
+                                       handler_types,
+                                       needs_stacktrace);
 }
 
 
@@ -468,8 +472,8 @@ void FlowGraphCompiler::RecordSafepoint(LocationSummary* locs) {
       // highest address (i.e., first in the stackmap).
       for (intptr_t i = 0; i < kNumberOfCpuRegisters; ++i) {
         Register reg = static_cast<Register>(i);
-        if (locs->live_registers()->ContainsRegister(reg)) {
-          bitmap->Set(bitmap->Length(), true);
+        if (regs->ContainsRegister(reg)) {
+          bitmap->Set(bitmap->Length(), regs->IsTagged(reg));
         }
       }
     }
@@ -588,6 +592,10 @@ bool FlowGraphCompiler::TryIntrinsify() {
       ASSERT(return_node.value()->IsLoadInstanceFieldNode());
       const LoadInstanceFieldNode& load_node =
           *return_node.value()->AsLoadInstanceFieldNode();
+      if (LoadFieldInstr::IsPotentialUnboxedField(load_node.field())) {
+        GenerateInlinedMutableBoxGetter(load_node.field().Offset());
+        return false;
+      }
       GenerateInlinedGetter(load_node.field().Offset());
       return true;
     }
@@ -727,6 +735,7 @@ void FlowGraphCompiler::GenerateStringTypeCheck(Register kClassIdReg,
   args.Add(kTwoByteStringCid);
   args.Add(kExternalOneByteStringCid);
   args.Add(kExternalTwoByteStringCid);
+  args.Add(kConsStringCid);
   CheckClassIds(kClassIdReg, args, is_instance_lbl, is_not_instance_lbl);
 }
 
@@ -237,6 +237,8 @@ class FlowGraphCompiler : public ValueObject {
   ~FlowGraphCompiler();
 
   static bool SupportsUnboxedMints();
+  static bool SupportsUnboxedFields();
+  static bool SupportsUnboxedUint32();
 
   // Accessors.
   Assembler* assembler() const { return assembler_; }
@@ -393,7 +395,8 @@ class FlowGraphCompiler : public ValueObject {
   void AddExceptionHandler(intptr_t try_index,
                            intptr_t outer_try_index,
                            intptr_t pc_offset,
-                           const Array& handler_types);
+                           const Array& handler_types,
+                           bool needs_stacktrace);
   void AddCurrentDescriptor(PcDescriptors::Kind kind,
                             intptr_t deopt_id,
                             intptr_t token_pos);
@@ -463,6 +466,7 @@ class FlowGraphCompiler : public ValueObject {
   friend class CheckStackOverflowSlowPath;  // For pending_deoptimization_env_.
 
   void EmitFrameEntry();
+  void EmitMonomorphicEntry(Label* normal_entry);
 
   void AddStaticCallTarget(const Function& function);
 
@@ -536,6 +540,9 @@ class FlowGraphCompiler : public ValueObject {
   void CopyParameters();
 
   void GenerateInlinedGetter(intptr_t offset);
+  // Falls through to the regular getter body if the field contains a
+  // mutable box that has to be copied.
+  void GenerateInlinedMutableBoxGetter(intptr_t offset);
   void GenerateInlinedSetter(intptr_t offset);
 
   // Perform a greedy local register allocation.  Consider all registers free.
@@ -42,6 +42,16 @@ bool FlowGraphCompiler::SupportsUnboxedMints() {
 }
 
 
+bool FlowGraphCompiler::SupportsUnboxedFields() {
+  return false;
+}
+
+
+bool FlowGraphCompiler::SupportsUnboxedUint32() {
+  return false;
+}
+
+
 void CompilerDeoptInfoWithStub::GenerateCode(FlowGraphCompiler* compiler,
                                              intptr_t stub_ix) {
   // Calls do not need stubs, they share a deoptimization trampoline.
@@ -801,6 +811,12 @@ void FlowGraphCompiler::GenerateInlinedGetter(intptr_t offset) {
 }
 
 
+void FlowGraphCompiler::GenerateInlinedMutableBoxGetter(intptr_t offset) {
+  // Unboxed fields are not supported on this architecture.
+  UNREACHABLE();
+}
+
+
 void FlowGraphCompiler::GenerateInlinedSetter(intptr_t offset) {
   // LR: return address.
   // SP+1: receiver.
@@ -847,6 +863,8 @@ void FlowGraphCompiler::EmitFrameEntry() {
         __ add(R7, R7, ShifterOperand(1));
         __ str(R7, FieldAddress(function_reg,
                                 Function::usage_counter_offset()));
+        __ mov(IP, ShifterOperand(0));
+        __ str(IP, FieldAddress(function_reg, Function::code_age_offset()));
       } else {
         __ ldr(R7, FieldAddress(function_reg,
                                 Function::usage_counter_offset()));
@@ -27,6 +27,8 @@ DECLARE_FLAG(bool, print_ast);
 DECLARE_FLAG(bool, print_scopes);
 DECLARE_FLAG(bool, enable_type_checks);
 DECLARE_FLAG(bool, eliminate_type_checks);
+DECLARE_FLAG(bool, monomorphic_calls);
+DECLARE_FLAG(bool, use_dispatch_table);
 
 
 FlowGraphCompiler::~FlowGraphCompiler() {
@@ -45,6 +47,16 @@ bool FlowGraphCompiler::SupportsUnboxedMints() {
 }
 
 
+bool FlowGraphCompiler::SupportsUnboxedFields() {
+  return true;
+}
+
+
+bool FlowGraphCompiler::SupportsUnboxedUint32() {
+  return true;
+}
+
+
 void CompilerDeoptInfoWithStub::GenerateCode(FlowGraphCompiler* compiler,
                                              intptr_t stub_ix) {
   // Calls do not need stubs, they share a deoptimization trampoline.
@@ -895,6 +907,22 @@ void FlowGraphCompiler::GenerateInlinedGetter(intptr_t offset) {
 }
 
 
+void FlowGraphCompiler::GenerateInlinedMutableBoxGetter(intptr_t offset) {
+  // TOS: return address.
+  // +1 : receiver.
+  Label fall_through;
+  __ movl(EAX, Address(ESP, 1 * kWordSize));
+  __ movl(EAX, FieldAddress(EAX, offset));
+  __ testl(EAX, Immediate(kSmiTagMask));
+  __ j(ZERO, &fall_through, Assembler::kNearJump);
+  __ movl(EBX, FieldAddress(EAX, Object::tags_offset()));
+  __ testl(EBX, Immediate(1 << RawObject::kMutableBoxBit));
+  __ j(NOT_ZERO, &fall_through, Assembler::kNearJump);
+  __ ret();
+  __ Bind(&fall_through);
+}
+
+
 void FlowGraphCompiler::GenerateInlinedSetter(intptr_t offset) {
   // TOS: return address.
   // +1 : value
@@ -927,6 +955,8 @@ void FlowGraphCompiler::EmitFrameEntry() {
       // IC stubs, but not at the entry of the function.
       if (!is_optimizing()) {
         __ incl(FieldAddress(function_reg, Function::usage_counter_offset()));
+        __ movl(FieldAddress(function_reg, Function::code_age_offset()),
+                Immediate(0));
       }
       __ cmpl(FieldAddress(function_reg, Function::usage_counter_offset()),
           Immediate(FLAG_optimization_counter_threshold));
@@ -945,6 +975,8 @@ void FlowGraphCompiler::EmitFrameEntry() {
 
 void FlowGraphCompiler::CompileGraph() {
   InitCompiler();
+  Label normal_entry;
+  __ Bind(&normal_entry);
   if (TryIntrinsify()) {
     // Although this intrinsified code will never be patched, it must satisfy
     // CodePatcher::CodeIsPatchable, which verifies that this code has a minimum
@@ -1084,6 +1116,66 @@ void FlowGraphCompiler::CompileGraph() {
                        Isolate::kNoDeoptId,
                        0);  // No token position.
   __ jmp(&StubCode::DeoptimizeLazyLabel());
+
+  if (FLAG_monomorphic_calls && function.IsDynamicFunction()) {
+    EmitMonomorphicEntry(&normal_entry);
+  }
+}
+
+
+// Emits the entry used by unoptimized instance call sites that have seen a
+// single receiver class. Such call sites are patched to call this entry
+// directly instead of the inline cache stub. The entry verifies the receiver
+// class and target of the only check in the caller's IC data, updates the
+// counters like the stub would and continues at the normal entry. Any other
+// receiver is handled by the inline cache stub.
+void FlowGraphCompiler::EmitMonomorphicEntry(Label* normal_entry) {
+  __ Comment("Monomorphic entry");
+  AddCurrentDescriptor(PcDescriptors::kMonomorphicEntry,
+                       Isolate::kNoDeoptId,
+                       0);  // No token position.
+  // ECX: IC data object.
+  // EDX: Arguments descriptor array.
+  // TOS(0): Return address.
+  Label miss, not_smi, check_class_id, counted;
+  __ movl(EAX, FieldAddress(EDX, ArgumentsDescriptor::count_offset()));
+  __ movl(EAX, Address(ESP, EAX, TIMES_2, 0));  // EAX (argument count) is smi.
+  __ testl(EAX, Immediate(kSmiTagMask));
+  __ j(NOT_ZERO, &not_smi, Assembler::kNearJump);
+  __ movl(EAX, Immediate(Smi::RawValue(kSmiCid)));
+  __ jmp(&check_class_id, Assembler::kNearJump);
+  __ Bind(&not_smi);
+  __ LoadClassId(EAX, EAX);
+  __ SmiTag(EAX);
+  __ Bind(&check_class_id);
+  // EAX: receiver's class ID as smi.
+  __ movl(EBX, FieldAddress(ECX, ICData::ic_data_offset()));
+  __ leal(EBX, FieldAddress(EBX, Array::data_offset()));
+  // EBX: points directly to the first ic data array element.
+  __ cmpl(EAX, Address(EBX, 0));
+  __ j(NOT_EQUAL, &miss);
+  const intptr_t target_offset = ICData::TargetIndexFor(1) * kWordSize;
+  const intptr_t count_offset = ICData::CountIndexFor(1) * kWordSize;
+  __ movl(EAX, Address(EBX, target_offset));
+  __ CompareObject(EAX, parsed_function().function());
+  __ j(NOT_EQUAL, &miss);
+  __ addl(Address(EBX, count_offset), Immediate(Smi::RawValue(1)));
+  __ j(NO_OVERFLOW, &counted, Assembler::kNearJump);
+  __ movl(Address(EBX, count_offset),
+          Immediate(Smi::RawValue(Smi::kMaxValue)));
+  __ Bind(&counted);
+  // Increment the usage counter of the caller.
+  __ movl(EAX, FieldAddress(ECX, ICData::function_offset()));
+  if (CanOptimize()) {
+    __ cmpl(FieldAddress(EAX, Function::usage_counter_offset()),
+        Immediate(FLAG_optimization_counter_threshold));
+    __ j(EQUAL, normal_entry);
+  }
+  __ incl(FieldAddress(EAX, Function::usage_counter_offset()));
+  __ jmp(normal_entry);
+
+  __ Bind(&miss);
+  __ jmp(&StubCode::OneArgCheckInlineCacheLabel());
 }
 
 
@@ -1208,6 +1300,31 @@ void FlowGraphCompiler::EmitMegamorphicInstanceCall(
 
   // EAX: class ID of the receiver (smi).
   __ Bind(&load_cache);
+  const intptr_t base = Array::data_offset();
+  Label call_target_function;
+  if (FLAG_use_dispatch_table) {
+    DispatchTable* dispatch_table = Isolate::Current()->dispatch_table();
+    intptr_t offset = 0;
+    const intptr_t selector_id =
+        dispatch_table->SelectorId(name, arguments_descriptor, &offset);
+    Label probe_cache;
+    __ movl(EDI, Address::Absolute(dispatch_table->table_address()));
+    // ECX: row of the receiver class in the dispatch table (smi). Rows are
+    // two words, so the smi is the index of the selector id entry.
+    __ leal(ECX, Address(EAX, Smi::RawValue(offset)));
+    __ leal(EDX, Address(ECX, ECX, TIMES_1, 0));
+    __ cmpl(EDX, FieldAddress(EDI, Array::length_offset()));
+    __ j(ABOVE_EQUAL, &probe_cache, Assembler::kNearJump);
+    __ cmpl(FieldAddress(EDI, ECX, TIMES_4, base),
+            Immediate(Smi::RawValue(selector_id)));
+    __ j(NOT_EQUAL, &probe_cache, Assembler::kNearJump);
+    // Targets that are not compiled yet go through the cache miss handler.
+    __ movl(EDX, FieldAddress(EDI, ECX, TIMES_4, base + kWordSize));
+    __ movl(EDX, FieldAddress(EDX, Function::code_offset()));
+    __ CompareObject(EDX, Object::Handle());
+    __ j(NOT_EQUAL, &call_target_function);
+    __ Bind(&probe_cache);
+  }
   __ LoadObject(EBX, cache);
   __ movl(EDI, FieldAddress(EBX, MegamorphicCache::buckets_offset()));
   __ movl(EBX, FieldAddress(EBX, MegamorphicCache::mask_offset()));
@@ -1215,14 +1332,13 @@ void FlowGraphCompiler::EmitMegamorphicInstanceCall(
   // EBX: mask.
   __ movl(ECX, EAX);
 
-  Label loop, update, call_target_function;
+  Label loop, update;
   __ jmp(&loop);
 
   __ Bind(&update);
   __ addl(ECX, Immediate(Smi::RawValue(1)));
   __ Bind(&loop);
   __ andl(ECX, EBX);
-  const intptr_t base = Array::data_offset();
   // ECX is smi tagged, but table entries are two words, so TIMES_4.
   __ movl(EDX, FieldAddress(EDI, ECX, TIMES_4, base));
 
@@ -1233,10 +1349,10 @@ void FlowGraphCompiler::EmitMegamorphicInstanceCall(
   __ j(NOT_EQUAL, &update, Assembler::kNearJump);
 
   __ Bind(&call_target_function);
-  // Call the target found in the cache.  For a class id match, this is a
-  // proper target for the given name and arguments descriptor.  If the
-  // illegal class id was found, the target is a cache miss handler that can
-  // be invoked as a normal Dart function.
+  // Call the target found in the dispatch table or in the cache.  For a
+  // selector or class id match, this is a proper target for the given name
+  // and arguments descriptor.  If the illegal class id was found, the target
+  // is a cache miss handler that can be invoked as a normal Dart function.
   __ movl(EAX, FieldAddress(EDI, ECX, TIMES_4, base + kWordSize));
   __ movl(EAX, FieldAddress(EAX, Function::code_offset()));
   __ movl(EAX, FieldAddress(EAX, Code::instructions_offset()));
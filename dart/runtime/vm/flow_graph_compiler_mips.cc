@@ -42,6 +42,16 @@ bool FlowGraphCompiler::SupportsUnboxedMints() {
 }
 
 
+bool FlowGraphCompiler::SupportsUnboxedFields() {
+  return false;
+}
+
+
+bool FlowGraphCompiler::SupportsUnboxedUint32() {
+  return false;
+}
+
+
 void CompilerDeoptInfoWithStub::GenerateCode(FlowGraphCompiler* compiler,
                                              intptr_t stub_ix) {
   // Calls do not need stubs, they share a deoptimization trampoline.
@@ -824,6 +834,12 @@ void FlowGraphCompiler::GenerateInlinedGetter(intptr_t offset) {
 }
 
 
+void FlowGraphCompiler::GenerateInlinedMutableBoxGetter(intptr_t offset) {
+  // Unboxed fields are not supported on this architecture.
+  UNREACHABLE();
+}
+
+
 void FlowGraphCompiler::GenerateInlinedSetter(intptr_t offset) {
   // RA: return address.
   // SP+1: receiver.
@@ -888,6 +904,7 @@ void FlowGraphCompiler::EmitFrameEntry() {
         __ addiu(T1, T1, Immediate(1));
         __ sw(T1, FieldAddress(function_reg,
                                Function::usage_counter_offset()));
+        __ sw(ZR, FieldAddress(function_reg, Function::code_age_offset()));
       } else {
         __ lw(T1, FieldAddress(function_reg,
                                Function::usage_counter_offset()));
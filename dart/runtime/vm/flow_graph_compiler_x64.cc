@@ -26,6 +26,8 @@ DECLARE_FLAG(bool, print_ast);
 DECLARE_FLAG(bool, print_scopes);
 DECLARE_FLAG(bool, enable_type_checks);
 DECLARE_FLAG(bool, eliminate_type_checks);
+DECLARE_FLAG(bool, monomorphic_calls);
+DECLARE_FLAG(bool, use_dispatch_table);
 
 
 FlowGraphCompiler::~FlowGraphCompiler() {
@@ -43,6 +45,16 @@ bool FlowGraphCompiler::SupportsUnboxedMints() {
 }
 
 
+bool FlowGraphCompiler::SupportsUnboxedFields() {
+  return true;
+}
+
+
+bool FlowGraphCompiler::SupportsUnboxedUint32() {
+  return true;
+}
+
+
 void CompilerDeoptInfoWithStub::GenerateCode(FlowGraphCompiler* compiler,
                                              intptr_t stub_ix) {
   // Calls do not need stubs, they share a deoptimization trampoline.
@@ -893,6 +905,22 @@ void FlowGraphCompiler::GenerateInlinedGetter(intptr_t offset) {
 }
 
 
+void FlowGraphCompiler::GenerateInlinedMutableBoxGetter(intptr_t offset) {
+  // TOS: return address.
+  // +1 : receiver.
+  Label fall_through;
+  __ movq(RAX, Address(RSP, 1 * kWordSize));
+  __ movq(RAX, FieldAddress(RAX, offset));
+  __ testq(RAX, Immediate(kSmiTagMask));
+  __ j(ZERO, &fall_through, Assembler::kNearJump);
+  __ movq(RCX, FieldAddress(RAX, Object::tags_offset()));
+  __ testq(RCX, Immediate(1 << RawObject::kMutableBoxBit));
+  __ j(NOT_ZERO, &fall_through, Assembler::kNearJump);
+  __ ret();
+  __ Bind(&fall_through);
+}
+
+
 void FlowGraphCompiler::GenerateInlinedSetter(intptr_t offset) {
   // TOS: return address.
   // +1 : value
@@ -925,6 +953,8 @@ void FlowGraphCompiler::EmitFrameEntry() {
       // IC stubs, but not at the entry of the function.
       if (!is_optimizing()) {
         __ incq(FieldAddress(function_reg, Function::usage_counter_offset()));
+        __ movq(FieldAddress(function_reg, Function::code_age_offset()),
+                Immediate(0));
       }
       __ cmpq(FieldAddress(function_reg, Function::usage_counter_offset()),
           Immediate(FLAG_optimization_counter_threshold));
@@ -943,6 +973,8 @@ void FlowGraphCompiler::EmitFrameEntry() {
 
 void FlowGraphCompiler::CompileGraph() {
   InitCompiler();
+  Label normal_entry;
+  __ Bind(&normal_entry);
   if (TryIntrinsify()) {
     // Although this intrinsified code will never be patched, it must satisfy
     // CodePatcher::CodeIsPatchable, which verifies that this code has a minimum
@@ -1084,6 +1116,66 @@ void FlowGraphCompiler::CompileGraph() {
                        Isolate::kNoDeoptId,
                        0);  // No token position.
   __ jmp(&StubCode::DeoptimizeLazyLabel());
+
+  if (FLAG_monomorphic_calls && function.IsDynamicFunction()) {
+    EmitMonomorphicEntry(&normal_entry);
+  }
+}
+
+
+// Emits the entry used by unoptimized instance call sites that have seen a
+// single receiver class. Such call sites are patched to call this entry
+// directly instead of the inline cache stub. The entry verifies the receiver
+// class and target of the only check in the caller's IC data, updates the
+// counters like the stub would and continues at the normal entry. Any other
+// receiver is handled by the inline cache stub.
+void FlowGraphCompiler::EmitMonomorphicEntry(Label* normal_entry) {
+  __ Comment("Monomorphic entry");
+  AddCurrentDescriptor(PcDescriptors::kMonomorphicEntry,
+                       Isolate::kNoDeoptId,
+                       0);  // No token position.
+  // RBX: IC data object.
+  // R10: Arguments descriptor array.
+  // TOS(0): Return address.
+  Label miss, not_smi, check_class_id, counted;
+  __ movq(RAX, FieldAddress(R10, ArgumentsDescriptor::count_offset()));
+  __ movq(RAX, Address(RSP, RAX, TIMES_4, 0));  // RAX (argument count) is Smi.
+  __ testq(RAX, Immediate(kSmiTagMask));
+  __ j(NOT_ZERO, &not_smi, Assembler::kNearJump);
+  __ movq(RAX, Immediate(Smi::RawValue(kSmiCid)));
+  __ jmp(&check_class_id, Assembler::kNearJump);
+  __ Bind(&not_smi);
+  __ LoadClassId(RAX, RAX);
+  __ SmiTag(RAX);
+  __ Bind(&check_class_id);
+  // RAX: receiver's class ID as smi.
+  __ movq(R12, FieldAddress(RBX, ICData::ic_data_offset()));
+  __ leaq(R12, FieldAddress(R12, Array::data_offset()));
+  // R12: points directly to the first ic data array element.
+  __ cmpq(RAX, Address(R12, 0));
+  __ j(NOT_EQUAL, &miss);
+  const intptr_t target_offset = ICData::TargetIndexFor(1) * kWordSize;
+  const intptr_t count_offset = ICData::CountIndexFor(1) * kWordSize;
+  __ movq(RAX, Address(R12, target_offset));
+  __ CompareObject(RAX, parsed_function().function());
+  __ j(NOT_EQUAL, &miss);
+  __ addq(Address(R12, count_offset), Immediate(Smi::RawValue(1)));
+  __ j(NO_OVERFLOW, &counted, Assembler::kNearJump);
+  __ movq(Address(R12, count_offset),
+          Immediate(Smi::RawValue(Smi::kMaxValue)));
+  __ Bind(&counted);
+  // Increment the usage counter of the caller.
+  __ movq(RAX, FieldAddress(RBX, ICData::function_offset()));
+  if (CanOptimize()) {
+    __ cmpq(FieldAddress(RAX, Function::usage_counter_offset()),
+        Immediate(FLAG_optimization_counter_threshold));
+    __ j(EQUAL, normal_entry);
+  }
+  __ incq(FieldAddress(RAX, Function::usage_counter_offset()));
+  __ jmp(normal_entry);
+
+  __ Bind(&miss);
+  __ jmp(&StubCode::OneArgCheckInlineCacheLabel());
 }
 
 
@@ -1208,6 +1300,32 @@ void FlowGraphCompiler::EmitMegamorphicInstanceCall(
 
   // RAX: class ID of the receiver (smi).
   __ Bind(&load_cache);
+  const intptr_t base = Array::data_offset();
+  Label call_target_function;
+  if (FLAG_use_dispatch_table) {
+    DispatchTable* dispatch_table = Isolate::Current()->dispatch_table();
+    intptr_t offset = 0;
+    const intptr_t selector_id =
+        dispatch_table->SelectorId(name, arguments_descriptor, &offset);
+    Label probe_cache;
+    __ movq(RDI, Immediate(dispatch_table->table_address()));
+    __ movq(RDI, Address(RDI, 0));
+    // RCX: row of the receiver class in the dispatch table (smi). Rows are
+    // two words, so the smi is the index of the selector id entry.
+    __ leaq(RCX, Address(RAX, Smi::RawValue(offset)));
+    __ leaq(RDX, Address(RCX, RCX, TIMES_1, 0));
+    __ cmpq(RDX, FieldAddress(RDI, Array::length_offset()));
+    __ j(ABOVE_EQUAL, &probe_cache, Assembler::kNearJump);
+    __ cmpq(FieldAddress(RDI, RCX, TIMES_8, base),
+            Immediate(Smi::RawValue(selector_id)));
+    __ j(NOT_EQUAL, &probe_cache, Assembler::kNearJump);
+    // Targets that are not compiled yet go through the cache miss handler.
+    __ movq(RDX, FieldAddress(RDI, RCX, TIMES_8, base + kWordSize));
+    __ movq(RDX, FieldAddress(RDX, Function::code_offset()));
+    __ CompareObject(RDX, Object::Handle());
+    __ j(NOT_EQUAL, &call_target_function);
+    __ Bind(&probe_cache);
+  }
   __ LoadObject(RBX, cache);
   __ movq(RDI, FieldAddress(RBX, MegamorphicCache::buckets_offset()));
   __ movq(RBX, FieldAddress(RBX, MegamorphicCache::mask_offset()));
@@ -1215,14 +1333,13 @@ void FlowGraphCompiler::EmitMegamorphicInstanceCall(
   // RBX: mask.
   __ movq(RCX, RAX);
 
-  Label loop, update, call_target_function;
+  Label loop, update;
   __ jmp(&loop);
 
   __ Bind(&update);
   __ addq(RCX, Immediate(Smi::RawValue(1)));
   __ Bind(&loop);
   __ andq(RCX, RBX);
-  const intptr_t base = Array::data_offset();
   // RCX is smi tagged, but table entries are two words, so TIMES_8.
   __ movq(RDX, FieldAddress(RDI, RCX, TIMES_8, base));
 
@@ -1233,10 +1350,10 @@ void FlowGraphCompiler::EmitMegamorphicInstanceCall(
   __ j(NOT_EQUAL, &update, Assembler::kNearJump);
 
   __ Bind(&call_target_function);
-  // Call the target found in the cache.  For a class id match, this is a
-  // proper target for the given name and arguments descriptor.  If the
-  // illegal class id was found, the target is a cache miss handler that can
-  // be invoked as a normal Dart function.
+  // Call the target found in the dispatch table or in the cache.  For a
+  // selector or class id match, this is a proper target for the given name
+  // and arguments descriptor.  If the illegal class id was found, the target
+  // is a cache miss handler that can be invoked as a normal Dart function.
   __ movq(RAX, FieldAddress(RDI, RCX, TIMES_8, base + kWordSize));
   __ movq(RAX, FieldAddress(RAX, Function::code_offset()));
   __ movq(RAX, FieldAddress(RAX, Code::instructions_offset()));
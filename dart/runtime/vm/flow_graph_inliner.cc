@@ -40,6 +40,13 @@ DEFINE_FLAG(int, inlining_hotness, 10,
     "default 10%: calls above-equal 10% of max-count are inlined.");
 DEFINE_FLAG(bool, inline_recursive, true,
     "Inline recursive calls.");
+DEFINE_FLAG(int, inlining_variant_hotness, 10,
+    "Inline only polymorphic variants that receive at least this percentage "
+    "(0 .. 100) of the call site's count; colder variants use the fallback "
+    "call.");
+DEFINE_FLAG(int, inlining_caller_size_threshold, 50000,
+    "Stop inlining once a caller reaches the threshold on instructions; "
+    "hotter instance call sites are considered first.");
 
 DECLARE_FLAG(bool, print_flow_graph);
 DECLARE_FLAG(bool, print_flow_graph_optimized);
@@ -199,11 +206,36 @@ class CallSites : public FlowGraphVisitor {
 
   struct InstanceCallInfo {
     PolymorphicInstanceCallInstr* call;
+    intptr_t count;
     double ratio;
     explicit InstanceCallInfo(PolymorphicInstanceCallInstr* call_arg)
-        : call(call_arg), ratio(0.0) {}
+        : call(call_arg),
+          count(call_arg->ic_data().AggregateCount()),
+          ratio(0.0) {}
   };
 
+  intptr_t MaxInstanceCallCount() const {
+    intptr_t max_count = 0;
+    for (intptr_t i = 0; i < instance_calls_.length(); ++i) {
+      if (instance_calls_[i].count > max_count) {
+        max_count = instance_calls_[i].count;
+      }
+    }
+    return max_count;
+  }
+
+  // Compute the instance call site ratios relative to 'max_count' and sort
+  // the calls by them so that the hottest call sites are inlined first and
+  // get the largest share of the caller's inlining budget.
+  void SortInstanceCallsByHotness(intptr_t max_count) {
+    ASSERT(max_count >= MaxInstanceCallCount());
+    for (intptr_t i = 0; i < instance_calls_.length(); ++i) {
+      instance_calls_[i].ratio = (max_count == 0) ?
+          0.0 : static_cast<double>(instance_calls_[i].count) / max_count;
+    }
+    instance_calls_.Sort(HighestRatioFirst);
+  }
+
   const GrowableArray<InstanceCallInfo>& instance_calls() const {
     return instance_calls_;
   }
@@ -230,7 +262,6 @@ class CallSites : public FlowGraphVisitor {
     skip_static_call_deopt_ids_.Clear();
     code.ExtractUncalledStaticCallDeoptIds(&skip_static_call_deopt_ids_);
 
-    const intptr_t instance_call_start_ix = instance_calls_.length();
     for (BlockIterator block_it = graph->postorder_iterator();
          !block_it.Done();
          block_it.Advance()) {
@@ -240,30 +271,19 @@ class CallSites : public FlowGraphVisitor {
         it.Current()->Accept(this);
       }
     }
-    // Compute instance call site ratio.
-    const intptr_t num_instance_calls =
-        instance_calls_.length() - instance_call_start_ix;
-    intptr_t max_count = 0;
-    GrowableArray<intptr_t> call_counts(num_instance_calls);
-    for (intptr_t i = 0; i < num_instance_calls; ++i) {
-      const intptr_t aggregate_count =
-          instance_calls_[i + instance_call_start_ix].
-              call->ic_data().AggregateCount();
-      call_counts.Add(aggregate_count);
-      if (aggregate_count > max_count) max_count = aggregate_count;
-    }
-
-
-    for (intptr_t i = 0; i < num_instance_calls; ++i) {
-      const double ratio = static_cast<double>(call_counts[i]) / max_count;
-      instance_calls_[i + instance_call_start_ix].ratio = ratio;
-    }
   }
 
   void VisitClosureCall(ClosureCallInstr* call) {
     closure_calls_.Add(call);
   }
 
+  static int HighestRatioFirst(const InstanceCallInfo* a,
+                               const InstanceCallInfo* b) {
+    if (a->ratio > b->ratio) return -1;
+    if (a->ratio < b->ratio) return 1;
+    return 0;
+  }
+
   void VisitPolymorphicInstanceCall(PolymorphicInstanceCallInstr* call) {
     instance_calls_.Add(InstanceCallInfo(call));
   }
@@ -344,6 +364,7 @@ class CallSiteInliner : public ValueObject {
         initial_size_(flow_graph->InstructionCount()),
         inlined_size_(0),
         inlining_depth_(1),
+        max_instance_call_count_(0),
         collected_call_sites_(NULL),
         inlining_call_sites_(NULL),
         function_cache_(),
@@ -381,6 +402,7 @@ class CallSiteInliner : public ValueObject {
     inlining_call_sites_ = &sites2;
     // Collect initial call sites.
     collected_call_sites_->FindCallSites(caller_graph_);
+    max_instance_call_count_ = collected_call_sites_->MaxInstanceCallCount();
     while (collected_call_sites_->HasCalls()) {
       TRACE_INLINING(OS::Print("  Depth %"Pd" ----------\n", inlining_depth_));
       // Swap collected and inlining arrays and clear the new collecting array.
@@ -406,6 +428,13 @@ class CallSiteInliner : public ValueObject {
         static_cast<double>(initial_size_);
   }
 
+  // Returns true if inlining a callee of the given size keeps the caller
+  // within its per-compilation size budget.
+  bool IsWithinBudget(intptr_t instr_count) const {
+    return (initial_size_ + inlined_size_ + instr_count) <=
+        FLAG_inlining_caller_size_threshold;
+  }
+
   bool TryInlining(const Function& function,
                    const Array& argument_names,
                    InlinedCallData* call_data) {
@@ -442,6 +471,15 @@ class CallSiteInliner : public ValueObject {
       return false;
     }
 
+    // Abort if the caller has already exhausted its inlining budget.
+    if (!IsWithinBudget(function.optimized_instruction_count())) {
+      TRACE_INLINING(OS::Print("     Bailout: caller size budget exhausted "
+                               "(%"Pd" + %"Pd")\n",
+                               initial_size_ + inlined_size_,
+                               function.optimized_instruction_count()));
+      return false;
+    }
+
     // Abort if this is a recursive occurrence.
     Definition* call = call_data->call;
     if (!FLAG_inline_recursive && IsCallRecursive(function, call)) {
@@ -457,6 +495,13 @@ class CallSiteInliner : public ValueObject {
       return false;
     }
 
+    // Abort if the unoptimized code of the callee was dropped by code aging:
+    // it has not run recently and there is no type feedback for it.
+    if (!function.HasCode()) {
+      TRACE_INLINING(OS::Print("     Bailout: no unoptimized code\n"));
+      return false;
+    }
+
     Isolate* isolate = Isolate::Current();
     // Save and clear IC data.
     const Array& prev_ic_data = Array::Handle(isolate->ic_data_array());
@@ -601,6 +646,19 @@ class CallSiteInliner : public ValueObject {
         return false;
       }
 
+      // The early budget check above uses a possibly stale estimate of the
+      // callee size. Check again with the actual size of the callee graph.
+      if (!IsWithinBudget(size)) {
+        isolate->set_long_jump_base(base);
+        isolate->set_deopt_id(prev_deopt_id);
+        isolate->set_ic_data_array(prev_ic_data.raw());
+        TRACE_INLINING(OS::Print("     Bailout: caller size budget exhausted "
+                                 "(%"Pd" + %"Pd")\n",
+                                 initial_size_ + inlined_size_,
+                                 size));
+        return false;
+      }
+
       // If depth is less or equal to threshold recursively add call sites.
       if (inlining_depth_ < FLAG_inlining_depth_threshold) {
         collected_call_sites_->FindCallSites(callee_graph);
@@ -743,20 +801,29 @@ class CallSiteInliner : public ValueObject {
     TRACE_INLINING(OS::Print("  Closure Calls (%d)\n", calls.length()));
     for (intptr_t i = 0; i < calls.length(); ++i) {
       ClosureCallInstr* call = calls[i];
-      // Find the closure of the callee.
+      // Find the function of the callee.
       ASSERT(call->ArgumentCount() > 0);
-      const CreateClosureInstr* closure =
-          call->ArgumentAt(0)->AsCreateClosure();
-      if (closure == NULL) {
+      const Function& target =
+          Function::ZoneHandle(ClosureFunction(call->ArgumentAt(0)));
+      if (target.IsNull()) {
         TRACE_INLINING(OS::Print("     Bailout: non-closure operator\n"));
         continue;
       }
+      // The closure call stub checks the arguments against the closure
+      // function and calls noSuchMethod on mismatch. Leave such calls alone.
+      if (!target.AreValidArguments(call->ArgumentCount(),
+                                    call->argument_names(),
+                                    NULL)) {
+        TRACE_INLINING(OS::Print("  => %s\n     Bailout: argument mismatch\n",
+                                 target.ToCString()));
+        continue;
+      }
       GrowableArray<Value*> arguments(call->ArgumentCount());
       for (int i = 0; i < call->ArgumentCount(); ++i) {
         arguments.Add(call->PushArgumentAt(i)->value());
       }
       InlinedCallData call_data(call, &arguments);
-      if (TryInlining(closure->function(),
+      if (TryInlining(target,
                       call->argument_names(),
                       &call_data)) {
         InlineCall(&call_data);
@@ -764,19 +831,35 @@ class CallSiteInliner : public ValueObject {
     }
   }
 
+  // Returns the function of the closure if it is known from the allocation
+  // site of the closure or from a constant closure (e.g. an implicit static
+  // closure), otherwise returns null.
+  static RawFunction* ClosureFunction(Definition* closure) {
+    CreateClosureInstr* create_closure = closure->AsCreateClosure();
+    if (create_closure != NULL) {
+      return create_closure->function().raw();
+    }
+    ConstantInstr* constant = closure->AsConstant();
+    if ((constant != NULL) &&
+        constant->value().IsInstance() &&
+        Instance::Cast(constant->value()).IsClosure()) {
+      return Closure::function(Instance::Cast(constant->value()));
+    }
+    return Function::null();
+  }
+
   void InlineInstanceCalls() {
+    // Inlined bodies may contain calls hotter than any call of the caller,
+    // e.g. when the caller has no instance calls of its own.
+    max_instance_call_count_ = Utils::Maximum(
+        max_instance_call_count_, inlining_call_sites_->MaxInstanceCallCount());
+    inlining_call_sites_->SortInstanceCallsByHotness(max_instance_call_count_);
     const GrowableArray<CallSites::InstanceCallInfo>& call_info =
         inlining_call_sites_->instance_calls();
     TRACE_INLINING(OS::Print("  Polymorphic Instance Calls (%d)\n",
                              call_info.length()));
     for (intptr_t call_idx = 0; call_idx < call_info.length(); ++call_idx) {
       PolymorphicInstanceCallInstr* call = call_info[call_idx].call;
-      if (call->with_checks()) {
-        PolymorphicInliner inliner(this, call);
-        inliner.Inline();
-        continue;
-      }
-
       const ICData& ic_data = call->ic_data();
       const Function& target = Function::ZoneHandle(ic_data.GetTargetAt(0));
       if ((call_info[call_idx].ratio * 100) < FLAG_inlining_hotness) {
@@ -787,6 +870,13 @@ class CallSiteInliner : public ValueObject {
             call_info[call_idx].ratio));
         continue;
       }
+
+      if (call->with_checks()) {
+        PolymorphicInliner inliner(this, call);
+        inliner.Inline();
+        continue;
+      }
+
       GrowableArray<Value*> arguments(call->ArgumentCount());
       for (int arg_i = 0; arg_i < call->ArgumentCount(); ++arg_i) {
         arguments.Add(call->PushArgumentAt(arg_i)->value());
@@ -895,6 +985,10 @@ class CallSiteInliner : public ValueObject {
   intptr_t initial_size_;
   intptr_t inlined_size_;
   intptr_t inlining_depth_;
+  // The highest ICData count of the instance calls seen in the caller graph
+  // and the bodies inlined into it. All call site ratios are computed against
+  // it, so that they are comparable across inlining depths.
+  intptr_t max_instance_call_count_;
   CallSites* collected_call_sites_;
   CallSites* inlining_call_sites_;
   GrowableArray<ParsedFunction*> function_cache_;
@@ -1246,9 +1340,21 @@ TargetEntryInstr* PolymorphicInliner::BuildDecisionGraph() {
 void PolymorphicInliner::Inline() {
   // Consider the polymorphic variants in order by frequency.
   FlowGraphCompiler::SortICDataByCount(call_->ic_data(), &variants_);
+  const intptr_t total_count = call_->ic_data().AggregateCount();
   for (intptr_t var_idx = 0; var_idx < variants_.length(); ++var_idx) {
     const Function& target = *variants_[var_idx].target;
 
+    // Only the most frequent receivers are inlined. Rare receiver classes
+    // are left to the fallback polymorphic call.
+    if ((variants_[var_idx].count * 100) <
+        (FLAG_inlining_variant_hotness * total_count)) {
+      TRACE_INLINING(OS::Print("  => %s\n     Bailout: cold variant %"Pd"\n",
+                               target.ToCString(),
+                               variants_[var_idx].count));
+      non_inlined_variants_.Add(variants_[var_idx]);
+      continue;
+    }
+
     // First check if this is the same target as an earlier inlined variant.
     if (CheckInlinedDuplicate(target)) {
       inlined_variants_.Add(variants_[var_idx]);
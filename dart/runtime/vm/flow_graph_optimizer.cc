@@ -6,6 +6,7 @@
 
 #include "vm/bit_vector.h"
 #include "vm/cha.h"
+#include "vm/compiler_stats.h"
 #include "vm/flow_graph_builder.h"
 #include "vm/flow_graph_compiler.h"
 #include "vm/hash_map.h"
@@ -31,6 +32,8 @@ DEFINE_FLAG(bool, trace_optimization, false, "Print optimization details.");
 DEFINE_FLAG(bool, trace_range_analysis, false, "Trace range analysis progress");
 DEFINE_FLAG(bool, truncating_left_shift, true,
     "Optimize left shift to truncate if possible");
+DEFINE_FLAG(bool, unbox_uint32, true,
+    "Compute bit manipulation on unboxed 32-bit values where possible.");
 DEFINE_FLAG(bool, use_cha, true, "Use class hierarchy analysis.");
 DECLARE_FLAG(bool, eliminate_type_checks);
 DECLARE_FLAG(bool, enable_type_checks);
@@ -64,6 +67,8 @@ void FlowGraphOptimizer::ApplyClassIds() {
         }
       } else if (instr->IsPolymorphicInstanceCall()) {
         SpecializePolymorphicInstanceCall(instr->AsPolymorphicInstanceCall());
+      } else if (instr->IsStaticCall()) {
+        VisitStaticCall(instr->AsStaticCall());
       } else if (instr->IsStrictCompare()) {
         VisitStrictCompare(instr->AsStrictCompare());
       } else if (instr->IsBranch()) {
@@ -382,6 +387,19 @@ void FlowGraphOptimizer::InsertConversion(Representation from,
     converted = new UnboxUint32x4Instr(use->CopyWithType(), deopt_id);
   } else if ((from == kUnboxedUint32x4) && (to == kTagged)) {
     converted = new BoxUint32x4Instr(use->CopyWithType());
+  } else if ((from == kTagged) && (to == kUnboxedUint32)) {
+    const intptr_t deopt_id = (deopt_target != NULL) ?
+        deopt_target->DeoptimizationTarget() : Isolate::kNoDeoptId;
+    converted = new UnboxUint32Instr(use->CopyWithType(), deopt_id);
+  } else if ((from == kUnboxedUint32) && (to == kTagged)) {
+    converted = new BoxUint32Instr(use->CopyWithType());
+  } else if (from == kUnboxedUint32) {
+    // Convert by boxing/unboxing.
+    BoxUint32Instr* boxed = new BoxUint32Instr(use->CopyWithType());
+    use->BindTo(boxed);
+    InsertBefore(insert_before, boxed, NULL, Definition::kValue);
+    InsertConversion(kTagged, to, use, insert_before, deopt_target);
+    return;
   }
   ASSERT(converted != NULL);
   use->BindTo(converted);
@@ -421,7 +439,413 @@ void FlowGraphOptimizer::InsertConversionsFor(Definition* def) {
 }
 
 
+// Loads and stores of fields that are known to contain only non-null doubles
+// (or Float32x4 values) operate on unboxed values. The value lives in a
+// mutable box owned by the field which is allocated by the first unboxed
+// store into an object and updated in place afterwards.
+// Code relying on this is registered as dependent on the field and will be
+// deoptimized when the field guard changes. The same applies to loads of
+// fields that were never assigned yet: the first assignment might make
+// them unboxed.
+void FlowGraphOptimizer::SelectUnboxedFieldAccesses() {
+  for (intptr_t i = 0; i < block_order_.length(); ++i) {
+    BlockEntryInstr* entry = block_order_[i];
+    for (ForwardInstructionIterator it(entry); !it.Done(); it.Advance()) {
+      Instruction* current = it.Current();
+      LoadFieldInstr* load = current->AsLoadField();
+      if ((load != NULL) && (load->field() != NULL)) {
+        const Field& field = *load->field();
+        load->set_copies_mutable_box(false);
+        if (LoadFieldInstr::IsUnboxedField(field)) {
+          load->set_is_unboxed_load(true);
+          AddToGuardedFields(field);
+        } else if (LoadFieldInstr::IsPotentialUnboxedField(field) &&
+                   (field.guarded_cid() == kIllegalCid)) {
+          AddToGuardedFields(field);
+        }
+        continue;
+      }
+
+      StoreInstanceFieldInstr* store = current->AsStoreInstanceField();
+      if ((store != NULL) && LoadFieldInstr::IsUnboxedField(store->field())) {
+        store->set_is_unboxed_store(true);
+        AddToGuardedFields(store->field());
+      }
+    }
+  }
+}
+
+
+static bool IsUint32ArrayCid(intptr_t cid) {
+  return (cid == kTypedDataInt32ArrayCid) || (cid == kTypedDataUint32ArrayCid);
+}
+
+
+// Returns the shift count if the value is a smi constant that can be used as
+// an operand of ShiftUint32OpInstr, and -1 otherwise.
+static intptr_t Uint32ShiftCount(Value* value) {
+  if (!value->BindsToConstant() || !value->BoundConstant().IsSmi()) {
+    return -1;
+  }
+  const intptr_t count = Smi::Cast(value->BoundConstant()).Value();
+  return ((count >= 0) && (count < 32)) ? count : -1;
+}
+
+
+// Decomposes a smi or mint operation that has an unboxed 32-bit counterpart.
+// Returns false for all other definitions.
+static bool GetUint32Operation(Definition* def,
+                               Token::Kind* op_kind,
+                               Value** left,
+                               Value** right) {
+  if (def->IsBinarySmiOp()) {
+    BinarySmiOpInstr* op = def->AsBinarySmiOp();
+    *op_kind = op->op_kind();
+    *left = op->left();
+    *right = op->right();
+  } else if (def->IsBinaryMintOp()) {
+    BinaryMintOpInstr* op = def->AsBinaryMintOp();
+    *op_kind = op->op_kind();
+    *left = op->left();
+    *right = op->right();
+  } else if (def->IsShiftMintOp()) {
+    ShiftMintOpInstr* op = def->AsShiftMintOp();
+    *op_kind = op->op_kind();
+    *left = op->left();
+    *right = op->right();
+  } else {
+    return false;
+  }
+
+  switch (*op_kind) {
+    case Token::kBIT_AND:
+    case Token::kBIT_OR:
+    case Token::kBIT_XOR:
+    case Token::kADD:
+    case Token::kSUB:
+    case Token::kMUL:
+      return true;
+    case Token::kSHL:
+    case Token::kSHR:
+      return Uint32ShiftCount(*right) >= 0;
+    default:
+      return false;
+  }
+}
+
+
+static bool IsUint32Candidate(Definition* def) {
+  if (!def->HasSSATemp()) {
+    return false;
+  }
+  if (def->IsPhi()) {
+    return def->representation() == kTagged;
+  }
+  LoadIndexedInstr* load = def->AsLoadIndexed();
+  if (load != NULL) {
+    return IsUint32ArrayCid(load->class_id());
+  }
+  Token::Kind op_kind;
+  Value* left;
+  Value* right;
+  return GetUint32Operation(def, &op_kind, &left, &right);
+}
+
+
+// Returns true if the value is known to be in the range [0, 2^32), so that
+// truncating it to 32 bits does not lose information.
+static bool IsExactUint32Value(Value* value, BitVector* exact) {
+  Definition* def = value->definition();
+  if (def->IsConstant()) {
+    const Object& constant = def->AsConstant()->value();
+    if (!constant.IsSmi() && !constant.IsMint()) {
+      return false;
+    }
+    const int64_t v = Integer::Cast(constant).AsInt64Value();
+    return (v >= 0) && (v <= static_cast<int64_t>(kMaxUint32));
+  }
+  return def->HasSSATemp() && exact->Contains(def->ssa_temp_index());
+}
+
+
+// A candidate is exact if its value is always in the range [0, 2^32). This
+// is a local form of range analysis: the range analysis pass runs after
+// representation selection, and the patterns that matter (masks, shifts and
+// loads from Uint32 arrays) are decidable from the operations themselves.
+static bool IsExactUint32(Definition* def, BitVector* exact) {
+  PhiInstr* phi = def->AsPhi();
+  if (phi != NULL) {
+    for (intptr_t i = 0; i < phi->InputCount(); i++) {
+      if (!IsExactUint32Value(phi->InputAt(i), exact)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  LoadIndexedInstr* load = def->AsLoadIndexed();
+  if (load != NULL) {
+    return load->class_id() == kTypedDataUint32ArrayCid;
+  }
+
+  Token::Kind op_kind;
+  Value* left;
+  Value* right;
+  if (!GetUint32Operation(def, &op_kind, &left, &right)) {
+    return false;
+  }
+  switch (op_kind) {
+    case Token::kBIT_AND:
+      return IsExactUint32Value(left, exact) ||
+             IsExactUint32Value(right, exact);
+    case Token::kBIT_OR:
+    case Token::kBIT_XOR:
+      return IsExactUint32Value(left, exact) &&
+             IsExactUint32Value(right, exact);
+    case Token::kSHR:
+      return IsExactUint32Value(left, exact);
+    default:
+      return false;
+  }
+}
+
+
+// Returns true if the value can be fed into an unboxed 32-bit operation
+// without an unboxing instruction that might deoptimize.
+static bool IsUint32Input(Value* value, BitVector* selected) {
+  Definition* def = value->definition();
+  if (def->HasSSATemp() && selected->Contains(def->ssa_temp_index())) {
+    return true;
+  }
+  const intptr_t cid = value->Type()->ToCid();
+  return (cid == kSmiCid) || (cid == kMintCid);
+}
+
+
+// Returns true if the use only depends on the low 32 bits of the value.
+static bool IsTruncatingUint32Use(Value* use, BitVector* selected) {
+  Instruction* instr = use->instruction();
+  StoreIndexedInstr* store = instr->AsStoreIndexed();
+  if (store != NULL) {
+    return (use->use_index() == 2) && IsUint32ArrayCid(store->class_id());
+  }
+
+  Definition* def = instr->AsDefinition();
+  if ((def == NULL) ||
+      !def->HasSSATemp() ||
+      !selected->Contains(def->ssa_temp_index())) {
+    return false;
+  }
+  if (def->IsPhi()) {
+    return true;
+  }
+
+  Token::Kind op_kind;
+  Value* left;
+  Value* right;
+  if (!GetUint32Operation(def, &op_kind, &left, &right)) {
+    return false;
+  }
+  switch (op_kind) {
+    case Token::kBIT_AND:
+    case Token::kBIT_OR:
+    case Token::kBIT_XOR:
+    case Token::kADD:
+    case Token::kSUB:
+    case Token::kMUL:
+      return true;
+    case Token::kSHL:
+      return use->use_index() == 0;
+    default:
+      return false;
+  }
+}
+
+
+static bool CanSelectUint32(Definition* def,
+                            BitVector* selected,
+                            BitVector* exact) {
+  const bool is_exact = exact->Contains(def->ssa_temp_index());
+
+  PhiInstr* phi = def->AsPhi();
+  if (phi != NULL) {
+    for (intptr_t i = 0; i < phi->InputCount(); i++) {
+      if (!IsUint32Input(phi->InputAt(i), selected)) {
+        return false;
+      }
+    }
+  } else if (!def->IsLoadIndexed()) {
+    Token::Kind op_kind;
+    Value* left;
+    Value* right;
+    GetUint32Operation(def, &op_kind, &left, &right);
+    if (!IsUint32Input(left, selected)) {
+      return false;
+    }
+    if ((op_kind == Token::kSHL) || (op_kind == Token::kSHR)) {
+      // Right shift moves the high bits into the result: the operand has to
+      // be exact.
+      if ((op_kind == Token::kSHR) && !is_exact) {
+        return false;
+      }
+    } else if (!IsUint32Input(right, selected)) {
+      return false;
+    }
+  }
+
+  if (is_exact) {
+    // Exact values can be boxed and materialized on deoptimization.
+    return true;
+  }
+
+  // Truncated values must not escape: all uses have to ignore the high bits
+  // and no deoptimization can observe the value.
+  for (Value* use = def->env_use_list(); use != NULL; use = use->next_use()) {
+    Definition* env_owner = use->instruction()->AsDefinition();
+    const bool env_is_dropped = (env_owner != NULL) &&
+        env_owner->HasSSATemp() &&
+        selected->Contains(env_owner->ssa_temp_index()) &&
+        !env_owner->IsLoadIndexed();
+    if (!env_is_dropped && use->instruction()->CanDeoptimize()) {
+      return false;
+    }
+  }
+  for (Value* use = def->input_use_list();
+       use != NULL;
+       use = use->next_use()) {
+    if (!IsTruncatingUint32Use(use, selected)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+void FlowGraphOptimizer::SelectUint32Representations() {
+  if (!FLAG_unbox_uint32 || !FlowGraphCompiler::SupportsUnboxedUint32()) {
+    return;
+  }
+
+  GrowableArray<Definition*> candidates;
+  for (intptr_t i = 0; i < block_order_.length(); ++i) {
+    BlockEntryInstr* entry = block_order_[i];
+    JoinEntryInstr* join_entry = entry->AsJoinEntry();
+    if (join_entry != NULL) {
+      for (PhiIterator it(join_entry); !it.Done(); it.Advance()) {
+        if (IsUint32Candidate(it.Current())) {
+          candidates.Add(it.Current());
+        }
+      }
+    }
+    for (ForwardInstructionIterator it(entry); !it.Done(); it.Advance()) {
+      Definition* def = it.Current()->AsDefinition();
+      if ((def != NULL) && IsUint32Candidate(def)) {
+        candidates.Add(def);
+      }
+    }
+  }
+  if (candidates.is_empty()) {
+    return;
+  }
+
+  // Both properties are computed optimistically: start from all candidates
+  // and remove those that do not qualify until a fixed point is reached.
+  const intptr_t num_vregs = flow_graph_->max_virtual_register_number();
+  BitVector* exact = new BitVector(num_vregs);
+  BitVector* selected = new BitVector(num_vregs);
+  for (intptr_t i = 0; i < candidates.length(); i++) {
+    exact->Add(candidates[i]->ssa_temp_index());
+    selected->Add(candidates[i]->ssa_temp_index());
+  }
+
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (intptr_t i = 0; i < candidates.length(); i++) {
+      Definition* def = candidates[i];
+      if (exact->Contains(def->ssa_temp_index()) &&
+          !IsExactUint32(def, exact)) {
+        exact->Remove(def->ssa_temp_index());
+        changed = true;
+      }
+    }
+  }
+
+  changed = true;
+  while (changed) {
+    changed = false;
+    for (intptr_t i = 0; i < candidates.length(); i++) {
+      Definition* def = candidates[i];
+      if (selected->Contains(def->ssa_temp_index()) &&
+          !CanSelectUint32(def, selected, exact)) {
+        selected->Remove(def->ssa_temp_index());
+        changed = true;
+      }
+    }
+  }
+
+  for (intptr_t i = 0; i < candidates.length(); i++) {
+    Definition* def = candidates[i];
+    if (!selected->Contains(def->ssa_temp_index())) {
+      continue;
+    }
+
+    if (def->IsPhi()) {
+      def->AsPhi()->set_representation(kUnboxedUint32);
+      continue;
+    }
+
+    if (def->IsLoadIndexed()) {
+      def->AsLoadIndexed()->set_is_unboxed_uint32();
+      continue;
+    }
+
+    Token::Kind op_kind;
+    Value* left;
+    Value* right;
+    GetUint32Operation(def, &op_kind, &left, &right);
+    Definition* replacement = NULL;
+    if ((op_kind == Token::kSHL) || (op_kind == Token::kSHR)) {
+      replacement = new ShiftUint32OpInstr(op_kind,
+                                           new Value(left->definition()),
+                                           Uint32ShiftCount(right),
+                                           def->GetDeoptId());
+    } else {
+      replacement = new BinaryUint32OpInstr(op_kind,
+                                            new Value(left->definition()),
+                                            new Value(right->definition()),
+                                            def->GetDeoptId());
+    }
+    if (FLAG_trace_optimization) {
+      OS::Print("Using unboxed 32-bit operation for v%"Pd"\n",
+                def->ssa_temp_index());
+    }
+    def->ReplaceWith(replacement, NULL);
+    // The unboxed operation cannot deoptimize.
+    replacement->RemoveEnvironment();
+  }
+
+  for (intptr_t i = 0; i < block_order_.length(); ++i) {
+    for (ForwardInstructionIterator it(block_order_[i]);
+         !it.Done();
+         it.Advance()) {
+      StoreIndexedInstr* store = it.Current()->AsStoreIndexed();
+      if ((store != NULL) && IsUint32ArrayCid(store->class_id())) {
+        Definition* value = store->value()->definition();
+        if (value->HasSSATemp() &&
+            selected->Contains(value->ssa_temp_index())) {
+          store->set_is_unboxed_uint32();
+        }
+      }
+    }
+  }
+}
+
+
 void FlowGraphOptimizer::SelectRepresentations() {
+  SelectUnboxedFieldAccesses();
+  SelectUint32Representations();
+
   // Convervatively unbox all phis that were proven to be of type Double.
   for (intptr_t i = 0; i < block_order_.length(); ++i) {
     JoinEntryInstr* join_entry = block_order_[i]->AsJoinEntry();
@@ -1240,8 +1664,7 @@ bool FlowGraphOptimizer::MethodExtractorNeedsClassCheck(
 
 
 void FlowGraphOptimizer::AddToGuardedFields(const Field& field) {
-  if ((field.guarded_cid() == kDynamicCid) ||
-      (field.guarded_cid() == kIllegalCid)) {
+  if (field.guarded_cid() == kDynamicCid) {
     return;
   }
   for (intptr_t j = 0; j < guarded_fields_->length(); j++) {
@@ -1249,7 +1672,7 @@ void FlowGraphOptimizer::AddToGuardedFields(const Field& field) {
       return;
     }
   }
-  guarded_fields_->Add(&field);
+  guarded_fields_->Add(&Field::ZoneHandle(field.raw()));
 }
 
 
@@ -1653,9 +2076,9 @@ bool FlowGraphOptimizer::TryInlineInstanceMethod(InstanceCallInstr* call) {
       }
       case MethodRecognizer::kDoubleMod:
       case MethodRecognizer::kDoublePow:
-      case MethodRecognizer::kDoubleRound:
         ReplaceWithMathCFunction(call, recognized_kind);
         return true;
+      case MethodRecognizer::kDoubleRound:
       case MethodRecognizer::kDoubleTruncate:
       case MethodRecognizer::kDoubleFloor:
       case MethodRecognizer::kDoubleCeil:
@@ -2280,13 +2703,58 @@ void FlowGraphOptimizer::VisitInstanceCall(InstanceCallInstr* instr) {
 }
 
 
+// Returns true if the function is the factory of fixed-length arrays
+// (new _ObjectArray<E>(length)).
+static bool IsObjectArrayFactory(const Function& function) {
+  return function.IsFactory() &&
+         (Class::Handle(function.Owner()).id() == kArrayCid);
+}
+
+
 void FlowGraphOptimizer::VisitStaticCall(StaticCallInstr* call) {
+  if (IsObjectArrayFactory(call->function())) {
+    // An array of constant length is allocated inline. The allocation is
+    // then visible to the load optimizer and to allocation sinking, e.g.
+    // for new List(n) after the List factory was inlined.
+    Value* length = call->PushArgumentAt(1)->value();
+    if (length->BindsToConstant() && length->BoundConstant().IsSmi()) {
+      const intptr_t num_elements = Smi::Cast(length->BoundConstant()).Value();
+      if ((0 <= num_elements) && (num_elements <= Array::kMaxElements)) {
+        CreateArrayInstr* create_array =
+            new CreateArrayInstr(call->token_pos(),
+                                 num_elements,
+                                 Type::ZoneHandle(Type::ArrayType()),
+                                 new Value(call->ArgumentAt(0)));
+        ReplaceCall(call, create_array);
+      }
+    }
+    return;
+  }
+
   MethodRecognizer::Kind recognized_kind =
       MethodRecognizer::RecognizeKind(call->function());
   if (recognized_kind == MethodRecognizer::kMathSqrt) {
     MathSqrtInstr* sqrt =
         new MathSqrtInstr(new Value(call->ArgumentAt(0)), call);
     ReplaceCall(call, sqrt);
+  } else if ((recognized_kind == MethodRecognizer::kMathMin) ||
+             (recognized_kind == MethodRecognizer::kMathMax)) {
+    // Only calls on two smis or two doubles are inlined; mixed arguments
+    // need the conversions of the library code.
+    const intptr_t left_cid =
+        call->PushArgumentAt(0)->value()->Type()->ToCid();
+    const intptr_t right_cid =
+        call->PushArgumentAt(1)->value()->Type()->ToCid();
+    if ((left_cid == right_cid) &&
+        ((left_cid == kSmiCid) || (left_cid == kDoubleCid))) {
+      MathMinMaxInstr* min_max =
+          new MathMinMaxInstr(recognized_kind,
+                              new Value(call->ArgumentAt(0)),
+                              new Value(call->ArgumentAt(1)),
+                              call,
+                              left_cid);
+      ReplaceCall(call, min_max);
+    }
   } else if (recognized_kind == MethodRecognizer::kFloat32x4Zero) {
     Float32x4ZeroInstr* zero = new Float32x4ZeroInstr(call);
     ReplaceCall(call, zero);
@@ -3391,7 +3859,16 @@ class AliasedSet : public ZoneAllocated {
         field_ids_() { }
 
   Alias ComputeAliasForLoad(Definition* defn) {
-    if (defn->IsLoadIndexed()) {
+    LoadIndexedInstr* load_indexed = defn->AsLoadIndexed();
+    if (load_indexed != NULL) {
+      // Elements of a non-aliased array accessed through constant indices
+      // are disambiguated the same way as fields of non-aliased instances.
+      const intptr_t element_id =
+          GetArrayElementId(load_indexed->array()->definition(),
+                            load_indexed->index());
+      if (element_id != kNoElementId) {
+        return Alias::Field(element_id);
+      }
       // We are assuming that LoadField is never used to load the first word.
       return Alias::Indexes();
     }
@@ -3420,7 +3897,14 @@ class AliasedSet : public ZoneAllocated {
   }
 
   Alias ComputeAliasForStore(Instruction* instr) {
-    if (instr->IsStoreIndexed()) {
+    StoreIndexedInstr* store_indexed = instr->AsStoreIndexed();
+    if (store_indexed != NULL) {
+      const intptr_t element_id =
+          GetArrayElementId(store_indexed->array()->definition(),
+                            store_indexed->index());
+      if (element_id != kNoElementId) {
+        return Alias::Field(element_id);
+      }
       return Alias::Indexes();
     }
 
@@ -3485,6 +3969,47 @@ class AliasedSet : public ZoneAllocated {
 
   BitVector* aliased_by_effects() const { return aliased_by_effects_; }
 
+  // Returns true if the result of CreateArray can be aliased by some other
+  // SSA variable or if its elements are accessed through non-constant
+  // indices. Otherwise every element of the array can be treated as a
+  // separate field of a non-aliased instance.
+  static bool CanBeAliased(CreateArrayInstr* alloc) {
+    if (alloc->identity() == AllocateObjectInstr::kUnknown) {
+      bool escapes = false;
+      for (Value* use = alloc->input_use_list();
+           use != NULL;
+           use = use->next_use()) {
+        Instruction* instr = use->instruction();
+        if (instr->IsLoadField() ||
+            (instr->IsLoadIndexed() &&
+             (use->use_index() == 0) &&
+             IsConstantIndex(alloc, instr->AsLoadIndexed()->index())) ||
+            (instr->IsStoreIndexed() &&
+             (use->use_index() == 0) &&
+             IsConstantIndex(alloc, instr->AsStoreIndexed()->index()))) {
+          continue;
+        }
+        escapes = true;
+        break;
+      }
+
+      alloc->set_identity(escapes ? AllocateObjectInstr::kAliased
+                                  : AllocateObjectInstr::kNotAliased);
+    }
+
+    return alloc->identity() != AllocateObjectInstr::kNotAliased;
+  }
+
+  // Returns true if the given index is a constant within bounds of the array
+  // allocated by the given CreateArray.
+  static bool IsConstantIndex(CreateArrayInstr* alloc, Value* index) {
+    if (!index->BindsToConstant() || !index->BoundConstant().IsSmi()) {
+      return false;
+    }
+    const intptr_t value = Smi::Cast(index->BoundConstant()).Value();
+    return (0 <= value) && (value < alloc->num_elements());
+  }
+
  private:
   // Get id assigned to the given field. Assign a new id if the field is seen
   // for the first time.
@@ -3498,9 +4023,37 @@ class AliasedSet : public ZoneAllocated {
   }
 
   enum {
-    kAnyInstance = -1
+    kAnyInstance = -1,
+    kNoElementId = -1
   };
 
+  // Get or create an identifier for an element of the array accessed at
+  // the given index. Returns kNoElementId if array can be aliased or
+  // index is not a constant: such accesses alias all other indexed accesses.
+  intptr_t GetArrayElementId(Definition* defn, Value* index) {
+    CreateArrayInstr* alloc = defn->AsCreateArray();
+    if ((alloc == NULL) || CanBeAliased(alloc)) {
+      return kNoElementId;
+    }
+    ASSERT(IsConstantIndex(alloc, index));
+
+    const intptr_t instance_id = alloc->ssa_temp_index();
+    const intptr_t element = Smi::Cast(index->BoundConstant()).Value();
+    for (intptr_t i = 0; i < element_ids_.length(); i++) {
+      const ElementId& id = element_ids_[i];
+      if ((id.instance_id == instance_id) && (id.element == element)) {
+        return id.id;
+      }
+    }
+
+    ElementId id;
+    id.instance_id = instance_id;
+    id.element = element;
+    id.id = ++max_field_id_;
+    element_ids_.Add(id);
+    return id.id;
+  }
+
   // Get or create an identifier for an instance field belonging to the
   // given instance.
   // The space of identifiers assigned to instance fields is split into
@@ -3544,6 +4097,7 @@ class AliasedSet : public ZoneAllocated {
         if (instr->IsPushArgument() ||
             (instr->IsStoreVMField() && (use->use_index() != 0)) ||
             (instr->IsStoreInstanceField() && (use->use_index() != 0)) ||
+            (instr->IsStoreIndexed() && (use->use_index() == 2)) ||
             (instr->IsStoreStaticField()) ||
             (instr->IsPhi())) {
           escapes = true;
@@ -3562,6 +4116,13 @@ class AliasedSet : public ZoneAllocated {
   // This essentially means that no stores to the same location can
   // occur in other functions.
   bool IsIndependentFromEffects(Definition* defn) {
+    LoadIndexedInstr* load_indexed = defn->AsLoadIndexed();
+    if (load_indexed != NULL) {
+      CreateArrayInstr* alloc =
+          load_indexed->array()->definition()->AsCreateArray();
+      return (alloc != NULL) && !CanBeAliased(alloc);
+    }
+
     LoadFieldInstr* load_field = defn->AsLoadField();
     if (load_field != NULL) {
       // Note that we can't use LoadField's is_immutable attribute here because
@@ -3639,9 +4200,20 @@ class AliasedSet : public ZoneAllocated {
 
   BitVector* aliased_by_effects_;
 
+  // Identifier assigned to an element of a non-aliased array.
+  struct ElementId {
+    intptr_t instance_id;
+    intptr_t element;
+    intptr_t id;
+  };
+
   // Table mapping static field to their id used during optimization pass.
   intptr_t max_field_id_;
   DirectChainedHashMap<FieldIdPair> field_ids_;
+
+  // Ids assigned to elements of non-aliased arrays. Share the id space with
+  // fields. Such arrays are rare and small so a linear list is sufficient.
+  GrowableArray<ElementId> element_ids_;
 };
 
 
@@ -3957,6 +4529,23 @@ class LoadOptimizer : public ValueObject {
         // TODO(vegorov): record null-values at least for not final fields of
         // escaping object.
         // TODO(vegorov): enable forwarding of type arguments.
+        // Similarly all elements of a non-aliased array are initially null.
+        CreateArrayInstr* array_alloc = instr->AsCreateArray();
+        if ((array_alloc != NULL) &&
+            !AliasedSet::CanBeAliased(array_alloc)) {
+          for (Value* use = array_alloc->input_use_list();
+               use != NULL;
+               use = use->next_use()) {
+            LoadIndexedInstr* load = use->instruction()->AsLoadIndexed();
+            if ((load != NULL) && (use->use_index() == 0)) {
+              gen->Add(load->expr_id());
+              if (out_values == NULL) out_values = CreateBlockOutValues();
+              (*out_values)[load->expr_id()] = graph_->constant_null();
+            }
+          }
+          continue;
+        }
+
         AllocateObjectInstr* alloc = instr->AsAllocateObject();
         if ((alloc != NULL) &&
             (alloc->identity() == AllocateObjectInstr::kNotAliased) &&
@@ -3970,8 +4559,10 @@ class LoadOptimizer : public ValueObject {
             }
 
             LoadFieldInstr* load = use->instruction()->AsLoadField();
-            if (load != NULL) {
+            if ((load != NULL) && !load->IsUnboxedLoad()) {
               // Found a load. Initialize current value of the field to null.
+              // Unboxed loads can't produce null: fields are always
+              // initialized before their unboxed value is read.
               gen->Add(load->expr_id());
               if (out_values == NULL) out_values = CreateBlockOutValues();
               (*out_values)[load->expr_id()] = graph_->constant_null();
@@ -4146,6 +4737,11 @@ class LoadOptimizer : public ValueObject {
     // Incoming values are different. Phi is required to merge.
     PhiInstr* phi = new PhiInstr(
         block->AsJoinEntry(), block->PredecessorCount());
+    // Values forwarded to the same load have the same representation (e.g.
+    // unboxed loads from Float64 arrays or from unboxed fields).
+    phi->set_representation(
+        (*out_values_[block->PredecessorAt(0)->preorder_number()])[expr_id]->
+            Replacement()->representation());
 
     for (intptr_t i = 0; i < block->PredecessorCount(); i++) {
       BlockEntryInstr* pred = block->PredecessorAt(i);
@@ -4384,6 +4980,7 @@ class CSEInstructionMap : public ValueObject {
 bool DominatorBasedCSE::Optimize(FlowGraph* graph) {
   bool changed = false;
   if (FLAG_load_cse) {
+    CompilerPassScope pass(CompilerStats::kLoadEliminationPass, graph);
     changed = LoadOptimizer::OptimizeGraph(graph) || changed;
   }
 
@@ -5116,6 +5713,27 @@ void ConstantPropagator::VisitUnaryMintOp(
 }
 
 
+void ConstantPropagator::VisitBoxUint32(BoxUint32Instr* instr) {
+  // Unboxed 32-bit operations are introduced after constant folding.
+  SetValue(instr, non_constant_);
+}
+
+
+void ConstantPropagator::VisitUnboxUint32(UnboxUint32Instr* instr) {
+  SetValue(instr, non_constant_);
+}
+
+
+void ConstantPropagator::VisitBinaryUint32Op(BinaryUint32OpInstr* instr) {
+  SetValue(instr, non_constant_);
+}
+
+
+void ConstantPropagator::VisitShiftUint32Op(ShiftUint32OpInstr* instr) {
+  SetValue(instr, non_constant_);
+}
+
+
 void ConstantPropagator::VisitUnarySmiOp(UnarySmiOpInstr* instr) {
   const Object& value = instr->value()->definition()->constant_value();
   if (IsNonConstant(value)) {
@@ -5279,6 +5897,41 @@ void ConstantPropagator::VisitMathSqrt(MathSqrtInstr* instr) {
 }
 
 
+void ConstantPropagator::VisitMathMinMax(MathMinMaxInstr* instr) {
+  const Object& left = instr->left()->definition()->constant_value();
+  const Object& right = instr->right()->definition()->constant_value();
+  if (IsNonConstant(left) || IsNonConstant(right)) {
+    SetValue(instr, non_constant_);
+  } else if (IsConstant(left) && IsConstant(right)) {
+    // The result is one of the operands, picked as in the generated code.
+    const bool is_min = (instr->op_kind() == MethodRecognizer::kMathMin);
+    if (left.IsSmi() && right.IsSmi()) {
+      const intptr_t left_value = Smi::Cast(left).Value();
+      const intptr_t right_value = Smi::Cast(right).Value();
+      const bool is_left = is_min ? (left_value <= right_value)
+                                  : (left_value >= right_value);
+      SetValue(instr, is_left ? left : right);
+    } else if (left.IsDouble() && right.IsDouble()) {
+      const double left_value = Double::Cast(left).value();
+      const double right_value = Double::Cast(right).value();
+      bool is_left;
+      if (isnan(left_value) || isnan(right_value)) {
+        is_left = isnan(left_value);
+      } else if (left_value == right_value) {
+        // min(0.0, -0.0) is -0.0 and max(0.0, -0.0) is 0.0.
+        is_left = ((signbit(left_value) != 0) == is_min);
+      } else {
+        is_left = is_min ? (left_value < right_value)
+                         : (left_value > right_value);
+      }
+      SetValue(instr, is_left ? left : right);
+    } else {
+      SetValue(instr, non_constant_);
+    }
+  }
+}
+
+
 void ConstantPropagator::VisitUnboxDouble(UnboxDoubleInstr* instr) {
   const Object& value = instr->value()->definition()->constant_value();
   if (IsNonConstant(value)) {
@@ -5963,9 +6616,62 @@ static bool IsAllocationSinkingCandidate(AllocateObjectInstr* alloc) {
 }
 
 
+// Array is a candidate if it is only used in StoreIndexed instructions
+// that write into its elements through constant indices. Type arguments
+// of the array are known at the allocation site.
+static bool IsAllocationSinkingCandidate(CreateArrayInstr* alloc) {
+  for (Value* use = alloc->input_use_list();
+       use != NULL;
+       use = use->next_use()) {
+    StoreIndexedInstr* store = use->instruction()->AsStoreIndexed();
+    if ((store == NULL) ||
+        (use->use_index() != 0) ||
+        !AliasedSet::IsConstantIndex(alloc, store->index())) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+
+// Closure is a candidate if it is not used anywhere except environments
+// (e.g. a closure stored into a local variable whose invocations were all
+// inlined). Closures of implicit instance functions allocate a new context
+// to capture the receiver and are not supported.
+static bool IsAllocationSinkingCandidate(CreateClosureInstr* alloc) {
+  if (!alloc->function().IsNonImplicitClosureFunction() ||
+      (alloc->input_use_list() != NULL)) {
+    return false;
+  }
+
+  // Arguments of the closure allocation are removed together with it.
+  for (intptr_t i = 0; i < alloc->ArgumentCount(); i++) {
+    PushArgumentInstr* push = alloc->PushArgumentAt(i);
+    if ((push->input_use_list() != NULL) || (push->env_use_list() != NULL)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+
+static bool IsAllocationSinkingCandidate(Definition* alloc) {
+  if (alloc->IsAllocateObject()) {
+    return IsAllocationSinkingCandidate(alloc->AsAllocateObject());
+  } else if (alloc->IsCreateArray()) {
+    return IsAllocationSinkingCandidate(alloc->AsCreateArray());
+  } else if (alloc->IsCreateClosure()) {
+    return IsAllocationSinkingCandidate(alloc->AsCreateClosure());
+  }
+  return false;
+}
+
+
 // Remove the given allocation from the graph. It is not observable.
 // If deoptimization occurs the object will be materialized.
-static void EliminateAllocation(AllocateObjectInstr* alloc) {
+static void EliminateAllocation(Definition* alloc) {
   ASSERT(IsAllocationSinkingCandidate(alloc));
 
   if (FLAG_trace_optimization) {
@@ -5981,6 +6687,11 @@ static void EliminateAllocation(AllocateObjectInstr* alloc) {
     use->instruction()->RemoveFromGraph();
   }
 
+  // Remove arguments pushed for the allocation stub.
+  for (intptr_t i = 0; i < alloc->ArgumentCount(); i++) {
+    alloc->PushArgumentAt(i)->RemoveFromGraph();
+  }
+
   // There should be no environment uses. The pass replaced them with
   // MaterializeObject instructions.
   ASSERT(alloc->env_use_list() == NULL);
@@ -5990,7 +6701,7 @@ static void EliminateAllocation(AllocateObjectInstr* alloc) {
 
 
 void AllocationSinking::Optimize() {
-  GrowableArray<AllocateObjectInstr*> candidates(5);
+  GrowableArray<Definition*> candidates(5);
 
   // Collect sinking candidates.
   const GrowableArray<BlockEntryInstr*>& postorder = flow_graph_->postorder();
@@ -5999,7 +6710,7 @@ void AllocationSinking::Optimize() {
        block_it.Advance()) {
     BlockEntryInstr* block = block_it.Current();
     for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
-      AllocateObjectInstr* alloc = it.Current()->AsAllocateObject();
+      Definition* alloc = it.Current()->AsDefinition();
       if ((alloc != NULL) && IsAllocationSinkingCandidate(alloc)) {
         if (FLAG_trace_optimization) {
           OS::Print("discovered allocation sinking candidate: v%"Pd"\n",
@@ -6017,14 +6728,18 @@ void AllocationSinking::Optimize() {
   //           ...
   //   v_N     <- LoadField(v_0, field_N)
   //   v_{N+1} <- MaterializeObject(field_1 = v_1, ..., field_N = v_{N})
+  // For arrays LoadIndexed(v_0, i) with constant index is used instead of
+  // LoadField. Slots that are known at the allocation site (type arguments
+  // of arrays, function and context of closures) do not require loads.
   for (intptr_t i = 0; i < candidates.length(); i++) {
     InsertMaterializations(candidates[i]);
   }
 
-  // Run load forwarding to eliminate LoadField instructions inserted above.
+  // Run load forwarding to eliminate LoadField/LoadIndexed instructions
+  // inserted above.
   // All loads will be successfully eliminated because:
-  //   a) they use fields (not offsets) and thus provide precise aliasing
-  //      information
+  //   a) they use fields (not offsets) or constant indices and thus provide
+  //      precise aliasing information
   //   b) candidate does not escape and thus its fields is not affected by
   //      external effects from calls.
   LoadOptimizer::OptimizeGraph(flow_graph_);
@@ -6062,15 +6777,16 @@ void AllocationSinking::DetachMaterializations() {
 }
 
 
-// Add the given field to the list of fields if it is not yet present there.
-static void AddField(ZoneGrowableArray<const Field*>* fields,
-                     const Field& field) {
-  for (intptr_t i = 0; i < fields->length(); i++) {
-    if ((*fields)[i]->raw() == field.raw()) {
+// Add the given slot to the list of slots if it is not yet present there.
+// Slot is either a Field or a Smi offset.
+static void AddSlot(ZoneGrowableArray<const Object*>* slots,
+                    const Object& slot) {
+  for (intptr_t i = 0; i < slots->length(); i++) {
+    if ((*slots)[i]->raw() == slot.raw()) {
       return;
     }
   }
-  fields->Add(&field);
+  slots->Add(&slot);
 }
 
 
@@ -6087,29 +6803,81 @@ static void AddInstruction(GrowableArray<Instruction*>* exits,
 }
 
 
+// Returns the value of the given slot that is known at the allocation site
+// or NULL if the value has to be loaded from the object.
+static Definition* KnownSlotValue(FlowGraph* flow_graph,
+                                  Definition* alloc,
+                                  Definition* context,
+                                  const Object& slot) {
+  if (slot.IsField()) {
+    return NULL;
+  }
+
+  const intptr_t offset = Smi::Cast(slot).Value();
+  CreateArrayInstr* array_alloc = alloc->AsCreateArray();
+  if (array_alloc != NULL) {
+    return (offset == Array::type_arguments_offset())
+        ? array_alloc->element_type()->definition()
+        : NULL;
+  }
+
+  CreateClosureInstr* closure_alloc = alloc->AsCreateClosure();
+  ASSERT(closure_alloc != NULL);
+  if (offset == Closure::function_offset()) {
+    return flow_graph->GetConstant(closure_alloc->function());
+  } else if (offset == Closure::context_offset()) {
+    ASSERT(context != NULL);
+    return context;
+  }
+  ASSERT(offset == Closure::type_arguments_offset());
+  // Second argument of the closure allocation stub are type arguments.
+  return closure_alloc->PushArgumentAt(1)->value()->definition();
+}
+
+
 // Insert MaterializeObject instruction for the given allocation before
 // the given instruction that can deoptimize.
 void AllocationSinking::CreateMaterializationAt(
     Instruction* exit,
-    AllocateObjectInstr* alloc,
+    Definition* alloc,
+    Definition* context,
     const Class& cls,
-    const ZoneGrowableArray<const Field*>& fields) {
+    intptr_t num_elements,
+    const ZoneGrowableArray<const Object*>& slots) {
   ZoneGrowableArray<Value*>* values =
-      new ZoneGrowableArray<Value*>(fields.length());
-
-  // Insert load instruction for every field.
-  for (intptr_t i = 0; i < fields.length(); i++) {
-    const Field* field = fields[i];
-    LoadFieldInstr* load = new LoadFieldInstr(new Value(alloc),
-                                              field->Offset(),
-                                              AbstractType::ZoneHandle());
-    load->set_field(field);
-    flow_graph_->InsertBefore(
-        exit, load, NULL, Definition::kValue);
-    values->Add(new Value(load));
+      new ZoneGrowableArray<Value*>(slots.length());
+
+  // Insert load instruction for every slot whose value is not known.
+  for (intptr_t i = 0; i < slots.length(); i++) {
+    const Object& slot = *slots[i];
+    Definition* value = KnownSlotValue(flow_graph_, alloc, context, slot);
+    if (value == NULL) {
+      if (slot.IsField()) {
+        const Field& field = Field::Cast(slot);
+        LoadFieldInstr* load = new LoadFieldInstr(new Value(alloc),
+                                                  field.Offset(),
+                                                  AbstractType::ZoneHandle());
+        load->set_field(&field);
+        value = load;
+      } else {
+        const intptr_t index =
+            (Smi::Cast(slot).Value() - Array::data_offset()) / kWordSize;
+        value = new LoadIndexedInstr(
+            new Value(alloc),
+            new Value(flow_graph_->GetConstant(
+                Smi::ZoneHandle(Smi::New(index)))),
+            FlowGraphCompiler::ElementSizeFor(kArrayCid),
+            kArrayCid,
+            Isolate::kNoDeoptId);
+      }
+      flow_graph_->InsertBefore(
+          exit, value, NULL, Definition::kValue);
+    }
+    values->Add(new Value(value));
   }
 
-  MaterializeObjectInstr* mat = new MaterializeObjectInstr(cls, fields, values);
+  MaterializeObjectInstr* mat =
+      new MaterializeObjectInstr(cls, num_elements, slots, values);
   flow_graph_->InsertBefore(exit, mat, NULL, Definition::kValue);
 
   // Replace all mentions of this allocation with a newly inserted
@@ -6132,16 +6900,26 @@ void AllocationSinking::CreateMaterializationAt(
 }
 
 
-void AllocationSinking::InsertMaterializations(AllocateObjectInstr* alloc) {
-  // Collect all fields that are written for this instance.
-  ZoneGrowableArray<const Field*>* fields =
-      new ZoneGrowableArray<const Field*>(5);
+void AllocationSinking::InsertMaterializations(Definition* alloc) {
+  // Collect all slots that are written for this object.
+  ZoneGrowableArray<const Object*>* slots =
+      new ZoneGrowableArray<const Object*>(5);
 
   for (Value* use = alloc->input_use_list();
        use != NULL;
        use = use->next_use()) {
-    ASSERT(use->instruction()->IsStoreInstanceField());
-    AddField(fields, use->instruction()->AsStoreInstanceField()->field());
+    StoreInstanceFieldInstr* store_field =
+        use->instruction()->AsStoreInstanceField();
+    if (store_field != NULL) {
+      AddSlot(slots, store_field->field());
+    } else {
+      StoreIndexedInstr* store_indexed = use->instruction()->AsStoreIndexed();
+      ASSERT(store_indexed != NULL);
+      const intptr_t index =
+          Smi::Cast(store_indexed->index()->BoundConstant()).Value();
+      AddSlot(slots,
+              Smi::ZoneHandle(Smi::New(Array::element_offset(index))));
+    }
   }
 
   // Collect all instructions that mention this object in the environment.
@@ -6152,10 +6930,37 @@ void AllocationSinking::InsertMaterializations(AllocateObjectInstr* alloc) {
     AddInstruction(&exits, use->instruction());
   }
 
+  if (exits.is_empty()) {
+    return;
+  }
+
+  const Class* cls = NULL;
+  intptr_t num_elements = 0;
+  Definition* context = NULL;
+  if (alloc->IsAllocateObject()) {
+    cls = &Class::ZoneHandle(alloc->AsAllocateObject()->constructor().Owner());
+  } else if (alloc->IsCreateArray()) {
+    cls = &Class::ZoneHandle(
+        Isolate::Current()->object_store()->array_class());
+    num_elements = alloc->AsCreateArray()->num_elements();
+    slots->Add(&Smi::ZoneHandle(Smi::New(Array::type_arguments_offset())));
+  } else {
+    CreateClosureInstr* closure_alloc = alloc->AsCreateClosure();
+    ASSERT(closure_alloc != NULL);
+    cls = &Class::ZoneHandle(closure_alloc->function().signature_class());
+    slots->Add(&Smi::ZoneHandle(Smi::New(Closure::function_offset())));
+    slots->Add(&Smi::ZoneHandle(Smi::New(Closure::context_offset())));
+    slots->Add(&Smi::ZoneHandle(Smi::New(Closure::type_arguments_offset())));
+
+    // Closure captures the current context at the moment of its allocation.
+    context = new CurrentContextInstr();
+    flow_graph_->InsertBefore(alloc, context, NULL, Definition::kValue);
+  }
+
   // Insert materializations at environment uses.
-  const Class& cls = Class::Handle(alloc->constructor().Owner());
   for (intptr_t i = 0; i < exits.length(); i++) {
-    CreateMaterializationAt(exits[i], alloc, cls, *fields);
+    CreateMaterializationAt(
+        exits[i], alloc, context, *cls, num_elements, *slots);
   }
 }
 
@@ -176,6 +176,12 @@ class FlowGraphOptimizer : public FlowGraphVisitor {
 
   void AddToGuardedFields(const Field& field);
 
+  void SelectUnboxedFieldAccesses();
+
+  // Select unboxed 32-bit representation for bit manipulation operations and
+  // accesses to Int32 and Uint32 arrays.
+  void SelectUint32Representations();
+
   FlowGraph* flow_graph_;
   GrowableArray<const Field*>* guarded_fields_;
 
@@ -321,6 +327,9 @@ class IfConverter : public AllStatic {
 };
 
 
+// Removes allocations of objects (instances, fixed-length arrays and
+// closures) that do not escape and are only mentioned in deoptimization
+// environments. Such objects are materialized on deoptimization.
 class AllocationSinking : public ZoneAllocated {
  public:
   explicit AllocationSinking(FlowGraph* flow_graph)
@@ -332,13 +341,15 @@ class AllocationSinking : public ZoneAllocated {
   void DetachMaterializations();
 
  private:
-  void InsertMaterializations(AllocateObjectInstr* alloc);
+  void InsertMaterializations(Definition* alloc);
 
   void CreateMaterializationAt(
       Instruction* exit,
-      AllocateObjectInstr* alloc,
+      Definition* alloc,
+      Definition* context,
       const Class& cls,
-      const ZoneGrowableArray<const Field*>& fields);
+      intptr_t num_elements,
+      const ZoneGrowableArray<const Object*>& slots);
 
   FlowGraph* flow_graph_;
 
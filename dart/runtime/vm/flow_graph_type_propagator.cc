@@ -965,6 +965,26 @@ CompileType UnboxIntegerInstr::ComputeType() const {
 }
 
 
+CompileType BoxUint32Instr::ComputeType() const {
+  return (kSmiBits >= 32) ? CompileType::FromCid(kSmiCid) : CompileType::Int();
+}
+
+
+CompileType UnboxUint32Instr::ComputeType() const {
+  return CompileType::Int();
+}
+
+
+CompileType BinaryUint32OpInstr::ComputeType() const {
+  return CompileType::Int();
+}
+
+
+CompileType ShiftUint32OpInstr::ComputeType() const {
+  return CompileType::Int();
+}
+
+
 CompileType DoubleToIntegerInstr::ComputeType() const {
   return CompileType::Int();
 }
@@ -1051,6 +1071,11 @@ CompileType MathSqrtInstr::ComputeType() const {
 }
 
 
+CompileType MathMinMaxInstr::ComputeType() const {
+  return CompileType::FromCid(result_cid());
+}
+
+
 CompileType UnboxDoubleInstr::ComputeType() const {
   return CompileType::FromCid(kDoubleCid);
 }
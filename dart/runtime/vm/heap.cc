@@ -6,6 +6,7 @@
 
 #include "platform/assert.h"
 #include "platform/utils.h"
+#include "vm/compiler.h"
 #include "vm/flags.h"
 #include "vm/heap_profiler.h"
 #include "vm/isolate.h"
@@ -34,7 +35,8 @@ DEFINE_FLAG(int, old_gen_heap_size, Heap::kHeapSizeInMB,
             "old gen heap size in MB,"
             "e.g: --old_gen_heap_size=1024 allocates a 1024MB old gen heap");
 
-Heap::Heap() : read_only_(false), gc_in_progress_(false) {
+Heap::Heap()
+    : pinned_in_bytes_(0), read_only_(false), gc_in_progress_(false) {
   new_space_ = new Scavenger(this,
                              (FLAG_new_gen_heap_size * MB),
                              kNewObjectAlignmentOffset);
@@ -158,6 +160,9 @@ void Heap::CollectGarbage(Space space, ApiCallbacks api_callbacks) {
     case kOld:
     case kCode: {
       bool promotion_failure = new_space_->HadPromotionFailure();
+      // Drop cold code before marking so that it is reclaimed by this
+      // collection.
+      Compiler::AgeCode(Isolate::Current());
       RecordBeforeGC(kOld, promotion_failure ? kPromotionFailure : kOldSpace);
       old_space_->MarkSweep(invoke_api_callbacks);
       RecordAfterGC();
@@ -186,6 +191,7 @@ void Heap::CollectAllGarbage() {
   new_space_->Scavenge(kInvokeApiCallbacks);
   RecordAfterGC();
   PrintStats();
+  Compiler::AgeCode(Isolate::Current());
   RecordBeforeGC(kOld, kFull);
   old_space_->MarkSweep(kInvokeApiCallbacks);
   RecordAfterGC();
@@ -274,9 +280,11 @@ bool Heap::Verify() const {
 
 void Heap::PrintSizes() const {
   OS::PrintErr("New space (%"Pd"k of %"Pd"k) "
-               "Old space (%"Pd"k of %"Pd"k)\n",
+               "Old space (%"Pd"k of %"Pd"k) "
+               "Pinned (%"Pd"k)\n",
                (Used(kNew) / KB), (Capacity(kNew) / KB),
-               (Used(kOld) / KB), (Capacity(kOld) / KB));
+               (Used(kOld) / KB), (Capacity(kOld) / KB),
+               (PinnedInBytes() / KB));
 }
 
 
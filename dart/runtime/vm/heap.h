@@ -179,6 +179,14 @@ class Heap {
   // Returns the number of objects with a peer.
   int64_t PeerCount() const;
 
+  // Bytes of typed data currently pinned through Dart_TypedDataPin. Pinned
+  // data is neither moved nor freed until it is unpinned.
+  void AddPinnedBytes(intptr_t size) {
+    pinned_in_bytes_ += size;
+    ASSERT(pinned_in_bytes_ >= 0);
+  }
+  intptr_t PinnedInBytes() const { return pinned_in_bytes_; }
+
   // Stats collection.
   void RecordTime(int id, int64_t micros) {
     ASSERT((id >= 0) && (id < GCStats::kDataEntries));
@@ -247,6 +255,9 @@ class Heap {
   // GC stats collection.
   GCStats stats_;
 
+  // Size of the typed data pinned by the embedder.
+  intptr_t pinned_in_bytes_;
+
   // This heap is in read-only mode: No allocation is allowed.
   bool read_only_;
 
@@ -496,9 +496,17 @@ void AllocateObjectWithBoundsCheckInstr::PrintOperandsTo(
 
 void MaterializeObjectInstr::PrintOperandsTo(BufferFormatter* f) const {
   f->Print("%s", String::Handle(cls_.Name()).ToCString());
+  if (cls_.id() == kArrayCid) {
+    f->Print("[%"Pd"]", num_elements_);
+  }
   for (intptr_t i = 0; i < InputCount(); i++) {
     f->Print(", ");
-    f->Print("%s: ", String::Handle(fields_[i]->name()).ToCString());
+    if (slots_[i]->IsField()) {
+      f->Print("%s: ",
+               String::Handle(Field::Cast(*slots_[i]).name()).ToCString());
+    } else {
+      f->Print("[%"Pd"]: ", Smi::Cast(*slots_[i]).Value());
+    }
     InputAt(i)->PrintTo(f);
   }
 }
@@ -605,6 +613,14 @@ void BinaryDoubleOpInstr::PrintOperandsTo(BufferFormatter* f) const {
 }
 
 
+void MathMinMaxInstr::PrintOperandsTo(BufferFormatter* f) const {
+  f->Print("%s, ", MethodRecognizer::KindToCString(op_kind()));
+  left()->PrintTo(f);
+  f->Print(", ");
+  right()->PrintTo(f);
+}
+
+
 void BinaryFloat32x4OpInstr::PrintOperandsTo(BufferFormatter* f) const {
   f->Print("%s, ", Token::Str(op_kind()));
   left()->PrintTo(f);
@@ -716,6 +732,21 @@ void ShiftMintOpInstr::PrintOperandsTo(BufferFormatter* f) const {
 }
 
 
+void BinaryUint32OpInstr::PrintOperandsTo(BufferFormatter* f) const {
+  f->Print("%s, ", Token::Str(op_kind()));
+  left()->PrintTo(f);
+  f->Print(", ");
+  right()->PrintTo(f);
+}
+
+
+void ShiftUint32OpInstr::PrintOperandsTo(BufferFormatter* f) const {
+  f->Print("%s, ", Token::Str(op_kind()));
+  value()->PrintTo(f);
+  f->Print(", %"Pd"", shift_count());
+}
+
+
 void UnaryMintOpInstr::PrintOperandsTo(BufferFormatter* f) const {
   f->Print("%s, ", Token::Str(op_kind()));
   value()->PrintTo(f);
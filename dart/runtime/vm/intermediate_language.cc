@@ -24,6 +24,8 @@ DEFINE_FLAG(bool, new_identity_spec, true,
     "Use new identity check rules for numbers.");
 DEFINE_FLAG(bool, propagate_ic_data, true,
     "Propagate IC data from unoptimized to optimized IC calls.");
+DEFINE_FLAG(bool, unbox_double_fields, true,
+    "Keep double and Float32x4 fields in mutable boxes updated in place.");
 DECLARE_FLAG(bool, enable_type_checks);
 DECLARE_FLAG(bool, eliminate_type_checks);
 DECLARE_FLAG(int, max_polymorphic_checks);
@@ -107,7 +109,8 @@ EffectSet CheckClassInstr::Dependencies() const {
   // Externalization of strings via the API can change the class-id.
   const bool externalizable =
       unary_checks().HasReceiverClassId(kOneByteStringCid) ||
-      unary_checks().HasReceiverClassId(kTwoByteStringCid);
+      unary_checks().HasReceiverClassId(kTwoByteStringCid) ||
+      unary_checks().HasReceiverClassId(kConsStringCid);
   return externalizable ? EffectSet::Externalization() : EffectSet::None();
 }
 
@@ -166,6 +169,45 @@ bool LoadFieldInstr::AttributesEqual(Instruction* other) const {
 }
 
 
+bool LoadFieldInstr::IsPotentialUnboxedField(const Field& field) {
+  return FLAG_unbox_double_fields &&
+      FlowGraphCompiler::SupportsUnboxedFields() &&
+      !field.is_final() &&
+      !field.is_static();
+}
+
+
+bool LoadFieldInstr::IsUnboxedField(const Field& field) {
+  // Nullable fields would need a box even when the value is null. Fields
+  // of other classes are left tagged. Constructors that leave the field
+  // uninitialized record its implicit null in the guard when they are
+  // compiled (see Parser::CheckConstFieldsInitialized), and the unboxed
+  // accesses are deoptimized then.
+  return IsPotentialUnboxedField(field) &&
+      !field.is_nullable() &&
+      ((field.guarded_cid() == kDoubleCid) ||
+       (field.guarded_cid() == kFloat32x4Cid));
+}
+
+
+Representation LoadFieldInstr::UnboxedFieldRepresentation(
+    const Field& field) {
+  ASSERT(IsUnboxedField(field));
+  return (field.guarded_cid() == kDoubleCid) ? kUnboxedDouble
+                                             : kUnboxedFloat32x4;
+}
+
+
+Representation StoreInstanceFieldInstr::RequiredInputRepresentation(
+    intptr_t idx) const {
+  ASSERT((idx == 0) || (idx == 1));
+  if ((idx == 1) && IsUnboxedStore()) {
+    return LoadFieldInstr::UnboxedFieldRepresentation(field());
+  }
+  return kTagged;
+}
+
+
 EffectSet LoadStaticFieldInstr::Dependencies() const {
   return field().is_final() ? EffectSet::None() : EffectSet::All();
 }
@@ -189,7 +231,8 @@ EffectSet LoadIndexedInstr::Dependencies() const {
 bool LoadIndexedInstr::AttributesEqual(Instruction* other) const {
   LoadIndexedInstr* other_load = other->AsLoadIndexed();
   ASSERT(other_load != NULL);
-  return class_id() == other_load->class_id();
+  return (class_id() == other_load->class_id()) &&
+      (representation() == other_load->representation());
 }
 
 
@@ -1265,6 +1308,13 @@ Definition* UnboxDoubleInstr::Canonicalize(FlowGraph* flow_graph) {
 }
 
 
+Definition* UnboxUint32Instr::Canonicalize(FlowGraph* flow_graph) {
+  // Fold away UnboxUint32(BoxUint32(v)).
+  BoxUint32Instr* defn = value()->definition()->AsBoxUint32();
+  return (defn != NULL) ? defn->value()->definition() : this;
+}
+
+
 Instruction* BranchInstr::Canonicalize(FlowGraph* flow_graph) {
   // Only handle strict-compares.
   if (comparison()->IsStrictCompare()) {
@@ -1428,7 +1478,8 @@ void CatchBlockEntryInstr::PrepareEntry(FlowGraphCompiler* compiler) {
   compiler->AddExceptionHandler(catch_try_index(),
                                 try_index(),
                                 compiler->assembler()->CodeSize(),
-                                catch_handler_types_);
+                                catch_handler_types_,
+                                needs_stacktrace_);
   if (HasParallelMove()) {
     compiler->parallel_move_resolver()->EmitNativeCode(parallel_move());
   }
@@ -2373,12 +2424,11 @@ intptr_t InvokeMathCFunctionInstr::ArgumentCountFor(
   switch (kind) {
     case MethodRecognizer::kDoubleTruncate:
     case MethodRecognizer::kDoubleFloor:
-    case MethodRecognizer::kDoubleCeil: {
+    case MethodRecognizer::kDoubleCeil:
+    case MethodRecognizer::kDoubleRound: {
       ASSERT(!CPUFeatures::double_truncate_round_supported());
       return 1;
     }
-    case MethodRecognizer::kDoubleRound:
-      return 1;
     case MethodRecognizer::kDoubleMod:
     case MethodRecognizer::kDoublePow:
       return 2;
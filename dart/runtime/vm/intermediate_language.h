@@ -72,6 +72,8 @@ class Range;
   V(_Double, pow, DoublePow, 631903778)                                        \
   V(_Double, _modulo, DoubleMod, 437099337)                                    \
   V(::, sqrt, MathSqrt, 1662640002)                                            \
+  V(::, min, MathMin, 502022729)                                               \
+  V(::, max, MathMax, 1448471548)                                              \
   V(Float32x4, Float32x4., Float32x4Constructor, 1327837070)                   \
   V(Float32x4, Float32x4.zero, Float32x4Zero, 927169529)                       \
   V(Float32x4, Float32x4.splat, Float32x4Splat, 1778587275)                    \
@@ -557,6 +559,7 @@ class EmbeddedArray<T, 0> {
   M(CheckEitherNonSmi)                                                         \
   M(BinaryDoubleOp)                                                            \
   M(MathSqrt)                                                                  \
+  M(MathMinMax)                                                                \
   M(UnboxDouble)                                                               \
   M(BoxDouble)                                                                 \
   M(BoxFloat32x4)                                                              \
@@ -568,6 +571,10 @@ class EmbeddedArray<T, 0> {
   M(BinaryMintOp)                                                              \
   M(ShiftMintOp)                                                               \
   M(UnaryMintOp)                                                               \
+  M(BoxUint32)                                                                 \
+  M(UnboxUint32)                                                               \
+  M(BinaryUint32Op)                                                            \
+  M(ShiftUint32Op)                                                             \
   M(CheckArrayBound)                                                           \
   M(Constraint)                                                                \
   M(StringFromCharCode)                                                        \
@@ -860,7 +867,11 @@ FOR_EACH_INSTRUCTION(INSTRUCTION_TYPE_CHECK)
   friend class UnarySmiOpInstr;
   friend class ShiftMintOpInstr;
   friend class UnaryMintOpInstr;
+  friend class UnboxUint32Instr;
+  friend class BinaryUint32OpInstr;
+  friend class ShiftUint32OpInstr;
   friend class MathSqrtInstr;
+  friend class MathMinMaxInstr;
   friend class CheckClassInstr;
   friend class GuardFieldInstr;
   friend class CheckSmiInstr;
@@ -1396,11 +1407,13 @@ class CatchBlockEntryInstr : public BlockEntryInstr {
   CatchBlockEntryInstr(intptr_t block_id,
                        intptr_t try_index,
                        const Array& handler_types,
-                       intptr_t catch_try_index)
+                       intptr_t catch_try_index,
+                       bool needs_stacktrace)
       : BlockEntryInstr(block_id, try_index),
         predecessor_(NULL),
         catch_handler_types_(Array::ZoneHandle(handler_types.raw())),
-        catch_try_index_(catch_try_index) { }
+        catch_try_index_(catch_try_index),
+        needs_stacktrace_(needs_stacktrace) { }
 
   DECLARE_INSTRUCTION(CatchBlockEntry)
 
@@ -1418,6 +1431,10 @@ class CatchBlockEntryInstr : public BlockEntryInstr {
     return catch_try_index_;
   }
 
+  // Returns false if the handler reads neither the stack trace nor rethrows,
+  // so that throwing does not need to build one.
+  bool needs_stacktrace() const { return needs_stacktrace_; }
+
   virtual void PrepareEntry(FlowGraphCompiler* compiler);
 
   virtual void PrintTo(BufferFormatter* f) const;
@@ -1434,6 +1451,7 @@ class CatchBlockEntryInstr : public BlockEntryInstr {
   BlockEntryInstr* predecessor_;
   const Array& catch_handler_types_;
   const intptr_t catch_try_index_;
+  const bool needs_stacktrace_;
 
   DISALLOW_COPY_AND_ASSIGN(CatchBlockEntryInstr);
 };
@@ -3104,7 +3122,8 @@ class StoreInstanceFieldInstr : public TemplateDefinition<2> {
                           Value* value,
                           StoreBarrierType emit_store_barrier)
       : field_(field),
-        emit_store_barrier_(emit_store_barrier) {
+        emit_store_barrier_(emit_store_barrier),
+        is_unboxed_store_(false) {
     SetInputAt(0, instance);
     SetInputAt(1, value);
   }
@@ -3121,6 +3140,13 @@ class StoreInstanceFieldInstr : public TemplateDefinition<2> {
         && (emit_store_barrier_ == kEmitStoreBarrier);
   }
 
+  // An unboxed store writes the unboxed value into the mutable box owned by
+  // the field, allocating the box on the first store into an object.
+  bool IsUnboxedStore() const { return is_unboxed_store_; }
+  void set_is_unboxed_store(bool value) { is_unboxed_store_ = value; }
+
+  virtual Representation RequiredInputRepresentation(intptr_t idx) const;
+
   virtual void PrintOperandsTo(BufferFormatter* f) const;
 
   virtual bool CanDeoptimize() const { return false; }
@@ -3140,6 +3166,7 @@ class StoreInstanceFieldInstr : public TemplateDefinition<2> {
 
   const Field& field_;
   const StoreBarrierType emit_store_barrier_;
+  bool is_unboxed_store_;
 
   DISALLOW_COPY_AND_ASSIGN(StoreInstanceFieldInstr);
 };
@@ -3250,7 +3277,9 @@ class LoadIndexedInstr : public TemplateDefinition<2> {
                    intptr_t index_scale,
                    intptr_t class_id,
                    intptr_t deopt_id)
-      : index_scale_(index_scale), class_id_(class_id) {
+      : index_scale_(index_scale),
+        class_id_(class_id),
+        is_unboxed_uint32_(false) {
     SetInputAt(0, array);
     SetInputAt(1, index);
     deopt_id_ = deopt_id;
@@ -3279,6 +3308,16 @@ class LoadIndexedInstr : public TemplateDefinition<2> {
     return deopt_id_ != Isolate::kNoDeoptId;
   }
 
+  // Loads from Int32 and Uint32 arrays can produce the raw 32 bits of the
+  // element in a CPU register instead of a Smi or Mint. Such a load never
+  // deoptimizes.
+  bool is_unboxed_uint32() const { return is_unboxed_uint32_; }
+  void set_is_unboxed_uint32() {
+    ASSERT((class_id() == kTypedDataInt32ArrayCid) ||
+           (class_id() == kTypedDataUint32ArrayCid));
+    is_unboxed_uint32_ = true;
+    deopt_id_ = Isolate::kNoDeoptId;
+  }
 
   virtual Representation representation() const;
   virtual void InferRange();
@@ -3291,6 +3330,7 @@ class LoadIndexedInstr : public TemplateDefinition<2> {
  private:
   const intptr_t index_scale_;
   const intptr_t class_id_;
+  bool is_unboxed_uint32_;
 
   DISALLOW_COPY_AND_ASSIGN(LoadIndexedInstr);
 };
@@ -3338,7 +3378,8 @@ class StoreIndexedInstr : public TemplateDefinition<3> {
                     intptr_t deopt_id)
       : emit_store_barrier_(emit_store_barrier),
         index_scale_(index_scale),
-        class_id_(class_id) {
+        class_id_(class_id),
+        is_unboxed_uint32_(false) {
     SetInputAt(0, array);
     SetInputAt(1, index);
     SetInputAt(2, value);
@@ -3362,6 +3403,15 @@ class StoreIndexedInstr : public TemplateDefinition<3> {
 
   virtual Representation RequiredInputRepresentation(intptr_t idx) const;
 
+  // Stores into Int32 and Uint32 arrays can take the low 32 bits of the value
+  // from a CPU register instead of a Smi or Mint.
+  bool is_unboxed_uint32() const { return is_unboxed_uint32_; }
+  void set_is_unboxed_uint32() {
+    ASSERT((class_id() == kTypedDataInt32ArrayCid) ||
+           (class_id() == kTypedDataUint32ArrayCid));
+    is_unboxed_uint32_ = true;
+  }
+
   bool IsExternal() const {
     return array()->definition()->representation() == kUntagged;
   }
@@ -3378,6 +3428,7 @@ class StoreIndexedInstr : public TemplateDefinition<3> {
   const StoreBarrierType emit_store_barrier_;
   const intptr_t index_scale_;
   const intptr_t class_id_;
+  bool is_unboxed_uint32_;
 
   DISALLOW_COPY_AND_ASSIGN(StoreIndexedInstr);
 };
@@ -3506,13 +3557,22 @@ class AllocateObjectInstr : public TemplateDefinition<0> {
 // This instruction captures the state of the object which had its allocation
 // removed during the AllocationSinking pass.
 // It does not produce any real code only deoptimization information.
+// Each slot of the materialized object is described either by a Field (for
+// instance fields) or by a Smi containing the offset of the slot in bytes
+// (for array elements, closure fields and type arguments).
+// For arrays num_elements is the length of the array to allocate.
 class MaterializeObjectInstr : public Definition {
  public:
   MaterializeObjectInstr(const Class& cls,
-                         const ZoneGrowableArray<const Field*>& fields,
+                         intptr_t num_elements,
+                         const ZoneGrowableArray<const Object*>& slots,
                          ZoneGrowableArray<Value*>* values)
-      : cls_(cls), fields_(fields), values_(values), locations_(NULL) {
-    ASSERT(fields_.length() == values_->length());
+      : cls_(cls),
+        num_elements_(num_elements),
+        slots_(slots),
+        values_(values),
+        locations_(NULL) {
+    ASSERT(slots_.length() == values_->length());
     for (intptr_t i = 0; i < InputCount(); i++) {
       InputAt(i)->set_instruction(this);
       InputAt(i)->set_use_index(i);
@@ -3520,8 +3580,9 @@ class MaterializeObjectInstr : public Definition {
   }
 
   const Class& cls() const { return cls_; }
-  const Field& FieldAt(intptr_t i) const {
-    return *fields_[i];
+  intptr_t num_elements() const { return num_elements_; }
+  const Object& SlotAt(intptr_t i) const {
+    return *slots_[i];
   }
   const Location& LocationAt(intptr_t i) {
     return locations_[i];
@@ -3555,7 +3616,8 @@ class MaterializeObjectInstr : public Definition {
   }
 
   const Class& cls_;
-  const ZoneGrowableArray<const Field*>& fields_;
+  const intptr_t num_elements_;
+  const ZoneGrowableArray<const Object*>& slots_;
   ZoneGrowableArray<Value*>* values_;
   Location* locations_;
 
@@ -3599,7 +3661,8 @@ class CreateArrayInstr : public TemplateDefinition<1> {
                    Value* element_type)
       : token_pos_(token_pos),
         num_elements_(num_elements),
-        type_(type) {
+        type_(type),
+        identity_(AllocateObjectInstr::kUnknown) {
     ASSERT(type_.IsZoneHandle());
     ASSERT(!type_.IsNull());
     ASSERT(type_.IsFinalized());
@@ -3621,10 +3684,17 @@ class CreateArrayInstr : public TemplateDefinition<1> {
 
   virtual EffectSet Effects() const { return EffectSet::None(); }
 
+  // See AllocateObjectInstr::identity().
+  AllocateObjectInstr::Identity identity() const { return identity_; }
+  void set_identity(AllocateObjectInstr::Identity identity) {
+    identity_ = identity;
+  }
+
  private:
   const intptr_t token_pos_;
   const intptr_t num_elements_;
   const AbstractType& type_;
+  AllocateObjectInstr::Identity identity_;
 
   DISALLOW_COPY_AND_ASSIGN(CreateArrayInstr);
 };
@@ -3737,7 +3807,9 @@ class LoadFieldInstr : public TemplateDefinition<1> {
         immutable_(immutable),
         recognized_kind_(MethodRecognizer::kUnknown),
         field_name_(NULL),
-        field_(NULL) {
+        field_(NULL),
+        is_unboxed_load_(false),
+        copies_mutable_box_(false) {
     ASSERT(type.IsZoneHandle());  // May be null if field is not an instance.
     SetInputAt(0, instance);
   }
@@ -3754,6 +3826,29 @@ class LoadFieldInstr : public TemplateDefinition<1> {
   const Field* field() const { return field_; }
   void set_field(const Field* field) { field_ = field; }
 
+  // An unboxed load reads the value directly out of the mutable box owned
+  // by the field. Only optimized code marks loads as unboxed.
+  bool IsUnboxedLoad() const { return is_unboxed_load_; }
+  void set_is_unboxed_load(bool value) { is_unboxed_load_ = value; }
+
+  // A load in unoptimized code that may observe a mutable box and has to
+  // copy it before the box escapes. Optimized code never copies: it is
+  // deoptimized before a field it loads from becomes unboxed.
+  bool CopiesMutableBox() const { return copies_mutable_box_; }
+  void set_copies_mutable_box(bool value) { copies_mutable_box_ = value; }
+
+  // Returns true if values of the field are currently kept unboxed.
+  static bool IsUnboxedField(const Field& field);
+
+  // Returns true if the field may become unboxed in the future.
+  static bool IsPotentialUnboxedField(const Field& field);
+
+  static Representation UnboxedFieldRepresentation(const Field& field);
+
+  virtual Representation representation() const {
+    return IsUnboxedLoad() ? UnboxedFieldRepresentation(*field_) : kTagged;
+  }
+
   void set_recognized_kind(MethodRecognizer::Kind kind) {
     recognized_kind_ = kind;
   }
@@ -3794,6 +3889,8 @@ class LoadFieldInstr : public TemplateDefinition<1> {
 
   const char* field_name_;
   const Field* field_;
+  bool is_unboxed_load_;
+  bool copies_mutable_box_;
 
   DISALLOW_COPY_AND_ASSIGN(LoadFieldInstr);
 };
@@ -4346,6 +4443,69 @@ class MathSqrtInstr : public TemplateDefinition<1> {
 };
 
 
+// Inlined dart:math min and max of two smis or two doubles.
+class MathMinMaxInstr : public TemplateDefinition<2> {
+ public:
+  MathMinMaxInstr(MethodRecognizer::Kind op_kind,
+                  Value* left_value,
+                  Value* right_value,
+                  StaticCallInstr* call,
+                  intptr_t result_cid)
+      : op_kind_(op_kind), result_cid_(result_cid) {
+    ASSERT((op_kind == MethodRecognizer::kMathMin) ||
+           (op_kind == MethodRecognizer::kMathMax));
+    ASSERT((result_cid == kSmiCid) || (result_cid == kDoubleCid));
+    SetInputAt(0, left_value);
+    SetInputAt(1, right_value);
+    deopt_id_ = call->deopt_id();
+  }
+
+  MethodRecognizer::Kind op_kind() const { return op_kind_; }
+
+  Value* left() const { return inputs_[0]; }
+  Value* right() const { return inputs_[1]; }
+
+  intptr_t result_cid() const { return result_cid_; }
+
+  virtual void PrintOperandsTo(BufferFormatter* f) const;
+
+  virtual bool CanDeoptimize() const { return false; }
+
+  virtual Representation representation() const {
+    return (result_cid() == kDoubleCid) ? kUnboxedDouble : kTagged;
+  }
+
+  virtual Representation RequiredInputRepresentation(intptr_t idx) const {
+    ASSERT((idx == 0) || (idx == 1));
+    return (result_cid() == kDoubleCid) ? kUnboxedDouble : kTagged;
+  }
+
+  virtual intptr_t DeoptimizationTarget() const {
+    // Direct access since this instruction cannot deoptimize, and the deopt-id
+    // was inherited from another instruction that could deoptimize.
+    return deopt_id_;
+  }
+
+  DECLARE_INSTRUCTION(MathMinMax)
+  virtual CompileType ComputeType() const;
+
+  virtual bool AllowsCSE() const { return true; }
+  virtual EffectSet Effects() const { return EffectSet::None(); }
+  virtual EffectSet Dependencies() const { return EffectSet::None(); }
+  virtual bool AttributesEqual(Instruction* other) const {
+    MathMinMaxInstr* other_op = other->AsMathMinMax();
+    return (op_kind() == other_op->op_kind()) &&
+        (result_cid() == other_op->result_cid());
+  }
+
+ private:
+  const MethodRecognizer::Kind op_kind_;
+  const intptr_t result_cid_;
+
+  DISALLOW_COPY_AND_ASSIGN(MathMinMaxInstr);
+};
+
+
 class BinaryDoubleOpInstr : public TemplateDefinition<2> {
  public:
   BinaryDoubleOpInstr(Token::Kind op_kind,
@@ -5199,6 +5359,190 @@ class UnaryMintOpInstr : public TemplateDefinition<1> {
 };
 
 
+// Boxes an unsigned 32-bit value as a Smi or, if it does not fit, as a Mint.
+class BoxUint32Instr : public TemplateDefinition<1> {
+ public:
+  explicit BoxUint32Instr(Value* value) {
+    SetInputAt(0, value);
+  }
+
+  Value* value() const { return inputs_[0]; }
+
+  virtual bool CanDeoptimize() const { return false; }
+
+  virtual Representation RequiredInputRepresentation(intptr_t idx) const {
+    ASSERT(idx == 0);
+    return kUnboxedUint32;
+  }
+
+  DECLARE_INSTRUCTION(BoxUint32)
+  virtual CompileType ComputeType() const;
+
+  virtual bool AllowsCSE() const { return true; }
+  virtual EffectSet Effects() const { return EffectSet::None(); }
+  virtual EffectSet Dependencies() const { return EffectSet::None(); }
+  virtual bool AttributesEqual(Instruction* other) const { return true; }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(BoxUint32Instr);
+};
+
+
+// Extracts the low 32 bits of a Smi or Mint. Deoptimizes if the value is not
+// an integer.
+class UnboxUint32Instr : public TemplateDefinition<1> {
+ public:
+  UnboxUint32Instr(Value* value, intptr_t deopt_id) {
+    SetInputAt(0, value);
+    deopt_id_ = deopt_id;
+  }
+
+  Value* value() const { return inputs_[0]; }
+
+  virtual bool CanDeoptimize() const {
+    return (value()->Type()->ToCid() != kSmiCid)
+        && (value()->Type()->ToCid() != kMintCid);
+  }
+
+  virtual Representation representation() const {
+    return kUnboxedUint32;
+  }
+
+  DECLARE_INSTRUCTION(UnboxUint32)
+  virtual CompileType ComputeType() const;
+
+  virtual bool AllowsCSE() const { return true; }
+  virtual EffectSet Effects() const { return EffectSet::None(); }
+  virtual EffectSet Dependencies() const { return EffectSet::None(); }
+  virtual bool AttributesEqual(Instruction* other) const { return true; }
+
+  virtual Definition* Canonicalize(FlowGraph* flow_graph);
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(UnboxUint32Instr);
+};
+
+
+// Bitwise and arithmetic operations on unboxed 32-bit values. Arithmetic
+// operations wrap around, so the result is only valid modulo 2^32.
+class BinaryUint32OpInstr : public TemplateDefinition<2> {
+ public:
+  BinaryUint32OpInstr(Token::Kind op_kind,
+                      Value* left,
+                      Value* right,
+                      intptr_t deopt_id)
+      : op_kind_(op_kind) {
+    ASSERT((op_kind == Token::kBIT_AND) ||
+           (op_kind == Token::kBIT_OR) ||
+           (op_kind == Token::kBIT_XOR) ||
+           (op_kind == Token::kADD) ||
+           (op_kind == Token::kSUB) ||
+           (op_kind == Token::kMUL));
+    SetInputAt(0, left);
+    SetInputAt(1, right);
+    deopt_id_ = deopt_id;
+  }
+
+  Value* left() const { return inputs_[0]; }
+  Value* right() const { return inputs_[1]; }
+
+  Token::Kind op_kind() const { return op_kind_; }
+
+  virtual void PrintOperandsTo(BufferFormatter* f) const;
+
+  virtual bool CanDeoptimize() const { return false; }
+
+  virtual Representation representation() const {
+    return kUnboxedUint32;
+  }
+
+  virtual Representation RequiredInputRepresentation(intptr_t idx) const {
+    ASSERT((idx == 0) || (idx == 1));
+    return kUnboxedUint32;
+  }
+
+  virtual intptr_t DeoptimizationTarget() const {
+    // Direct access since this instruction cannot deoptimize, and the deopt-id
+    // was inherited from another instruction that could deoptimize.
+    return deopt_id_;
+  }
+
+  DECLARE_INSTRUCTION(BinaryUint32Op)
+  virtual CompileType ComputeType() const;
+
+  virtual bool AllowsCSE() const { return true; }
+  virtual EffectSet Effects() const { return EffectSet::None(); }
+  virtual EffectSet Dependencies() const { return EffectSet::None(); }
+  virtual bool AttributesEqual(Instruction* other) const {
+    return op_kind() == other->AsBinaryUint32Op()->op_kind();
+  }
+
+ private:
+  const Token::Kind op_kind_;
+
+  DISALLOW_COPY_AND_ASSIGN(BinaryUint32OpInstr);
+};
+
+
+// Shifts an unboxed 32-bit value by a constant count in the range [0, 31].
+// Left shifts discard the bits shifted out of the low 32 bits.
+class ShiftUint32OpInstr : public TemplateDefinition<1> {
+ public:
+  ShiftUint32OpInstr(Token::Kind op_kind,
+                     Value* value,
+                     intptr_t shift_count,
+                     intptr_t deopt_id)
+      : op_kind_(op_kind), shift_count_(shift_count) {
+    ASSERT((op_kind == Token::kSHL) || (op_kind == Token::kSHR));
+    ASSERT((shift_count >= 0) && (shift_count < 32));
+    SetInputAt(0, value);
+    deopt_id_ = deopt_id;
+  }
+
+  Value* value() const { return inputs_[0]; }
+
+  Token::Kind op_kind() const { return op_kind_; }
+  intptr_t shift_count() const { return shift_count_; }
+
+  virtual void PrintOperandsTo(BufferFormatter* f) const;
+
+  virtual bool CanDeoptimize() const { return false; }
+
+  virtual Representation representation() const {
+    return kUnboxedUint32;
+  }
+
+  virtual Representation RequiredInputRepresentation(intptr_t idx) const {
+    ASSERT(idx == 0);
+    return kUnboxedUint32;
+  }
+
+  virtual intptr_t DeoptimizationTarget() const {
+    // Direct access since this instruction cannot deoptimize, and the deopt-id
+    // was inherited from another instruction that could deoptimize.
+    return deopt_id_;
+  }
+
+  DECLARE_INSTRUCTION(ShiftUint32Op)
+  virtual CompileType ComputeType() const;
+
+  virtual bool AllowsCSE() const { return true; }
+  virtual EffectSet Effects() const { return EffectSet::None(); }
+  virtual EffectSet Dependencies() const { return EffectSet::None(); }
+  virtual bool AttributesEqual(Instruction* other) const {
+    ShiftUint32OpInstr* other_shift = other->AsShiftUint32Op();
+    return (op_kind() == other_shift->op_kind()) &&
+        (shift_count() == other_shift->shift_count());
+  }
+
+ private:
+  const Token::Kind op_kind_;
+  const intptr_t shift_count_;
+
+  DISALLOW_COPY_AND_ASSIGN(ShiftUint32OpInstr);
+};
+
+
 class BinarySmiOpInstr : public TemplateDefinition<2> {
  public:
   BinarySmiOpInstr(Token::Kind op_kind,
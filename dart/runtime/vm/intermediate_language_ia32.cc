@@ -1173,6 +1173,9 @@ CompileType LoadIndexedInstr::ComputeType() const {
 
 
 Representation LoadIndexedInstr::representation() const {
+  if (is_unboxed_uint32()) {
+    return kUnboxedUint32;
+  }
   switch (class_id_) {
     case kArrayCid:
     case kImmutableArrayCid:
@@ -1287,6 +1290,11 @@ void LoadIndexedInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
   if ((index_scale() == 1) && index.IsRegister()) {
     __ SmiUntag(index.reg());
   }
+  if (representation() == kUnboxedUint32) {
+    // Raw element bits.
+    __ movl(result, element_address);
+    return;
+  }
   switch (class_id()) {
     case kTypedDataInt8ArrayCid:
       ASSERT(index_scale() == 1);
@@ -1343,6 +1351,9 @@ Representation StoreIndexedInstr::RequiredInputRepresentation(
   if (idx == 0)  return kNoRepresentation;  // Flexible input representation.
   if (idx == 1) return kTagged;  // Index is a smi.
   ASSERT(idx == 2);
+  if (is_unboxed_uint32()) {
+    return kUnboxedUint32;
+  }
   switch (class_id_) {
     case kArrayCid:
     case kOneByteStringCid:
@@ -1412,10 +1423,15 @@ LocationSummary* StoreIndexedInstr::MakeLocationSummary() const {
     case kTypedDataInt32ArrayCid:
     case kTypedDataUint32ArrayCid:
       // Mints are stored in XMM registers. For smis, use a writable register
-      // because the value must be untagged before storing.
-      locs->set_in(2, value()->IsSmiValue()
-                      ? Location::WritableRegister()
-                      : Location::RequiresFpuRegister());
+      // because the value must be untagged before storing. Unboxed values
+      // are stored as is.
+      if (is_unboxed_uint32()) {
+        locs->set_in(2, Location::RequiresRegister());
+      } else {
+        locs->set_in(2, value()->IsSmiValue()
+                        ? Location::WritableRegister()
+                        : Location::RequiresFpuRegister());
+      }
       break;
     case kTypedDataFloat32ArrayCid:
       // Need temp register for float-to-double conversion.
@@ -1526,7 +1542,9 @@ void StoreIndexedInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
     }
     case kTypedDataInt32ArrayCid:
     case kTypedDataUint32ArrayCid:
-      if (value()->IsSmiValue()) {
+      if (is_unboxed_uint32()) {
+        __ movl(element_address, locs()->in(2).reg());
+      } else if (value()->IsSmiValue()) {
         ASSERT(RequiredInputRepresentation(2) == kTagged);
         Register value = locs()->in(2).reg();
         __ SmiUntag(value);
@@ -1702,9 +1720,60 @@ void GuardFieldInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
 }
 
 
+// Allocates the mutable box of an unboxed field on the slow path of
+// StoreInstanceField.
+class BoxAllocationSlowPath : public SlowPathCode {
+ public:
+  BoxAllocationSlowPath(Instruction* instruction,
+                        const Class& cls,
+                        Register result)
+      : instruction_(instruction),
+        cls_(cls),
+        result_(result) { }
+
+  virtual void EmitNativeCode(FlowGraphCompiler* compiler) {
+    __ Comment("BoxAllocationSlowPath");
+    __ Bind(entry_label());
+    const Code& stub =
+        Code::Handle(StubCode::GetAllocationStubForClass(cls_));
+    const ExternalLabel label(cls_.ToCString(), stub.EntryPoint());
+
+    LocationSummary* locs = instruction_->locs();
+    locs->live_registers()->Remove(Location::RegisterLocation(result_));
+
+    compiler->SaveLiveRegisters(locs);
+    compiler->GenerateCall(Scanner::kDummyTokenIndex,  // No token position.
+                           &label,
+                           PcDescriptors::kOther,
+                           locs);
+    __ MoveRegister(result_, EAX);
+    compiler->RestoreLiveRegisters(locs);
+
+    __ jmp(exit_label());
+  }
+
+ private:
+  Instruction* instruction_;
+  const Class& cls_;
+  const Register result_;
+};
+
+
 LocationSummary* StoreInstanceFieldInstr::MakeLocationSummary() const {
   const intptr_t kNumInputs = 2;
-  const intptr_t num_temps =  0;
+  if (IsUnboxedStore()) {
+    const intptr_t kNumTemps = 2;
+    LocationSummary* summary =
+        new LocationSummary(kNumInputs,
+                            kNumTemps,
+                            LocationSummary::kCallOnSlowPath);
+    summary->set_in(0, Location::RequiresRegister());
+    summary->set_in(1, Location::RequiresFpuRegister());
+    summary->set_temp(0, Location::RequiresRegister());
+    summary->set_temp(1, Location::RequiresRegister());
+    return summary;
+  }
+  const intptr_t num_temps = 0;
   LocationSummary* summary =
       new LocationSummary(kNumInputs, num_temps, LocationSummary::kNoCall);
   summary->set_in(0, Location::RequiresRegister());
@@ -1717,6 +1786,50 @@ LocationSummary* StoreInstanceFieldInstr::MakeLocationSummary() const {
 
 void StoreInstanceFieldInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
   Register instance_reg = locs()->in(0).reg();
+  if (IsUnboxedStore()) {
+    ASSERT(compiler->is_optimizing());
+    XmmRegister value = locs()->in(1).fpu_reg();
+    Register box_reg = locs()->temp(0).reg();
+    Register temp = locs()->temp(1).reg();
+    const bool is_double = (field().guarded_cid() == kDoubleCid);
+
+    // The field contains either null or a box. Reuse the box if it is owned
+    // by the field, otherwise allocate a new one.
+    Label store_value;
+    __ movl(box_reg, FieldAddress(instance_reg, field().Offset()));
+    __ movl(temp, FieldAddress(box_reg, Object::tags_offset()));
+    __ testl(temp, Immediate(1 << RawObject::kMutableBoxBit));
+    __ j(NOT_ZERO, &store_value);
+
+    const Class& cls =
+        is_double ? compiler->double_class() : compiler->float32x4_class();
+    BoxAllocationSlowPath* slow_path =
+        new BoxAllocationSlowPath(this, cls, box_reg);
+    compiler->AddSlowPathCode(slow_path);
+    __ TryAllocate(cls,
+                   slow_path->entry_label(),
+                   Assembler::kFarJump,
+                   box_reg);
+    __ Bind(slow_path->exit_label());
+    __ movl(temp, FieldAddress(box_reg, Object::tags_offset()));
+    __ orl(temp, Immediate(1 << RawObject::kMutableBoxBit));
+    __ movl(FieldAddress(box_reg, Object::tags_offset()), temp);
+    // The write barrier clobbers the stored register.
+    __ movl(temp, box_reg);
+    __ StoreIntoObject(instance_reg,
+                       FieldAddress(instance_reg, field().Offset()),
+                       temp,
+                       false);  // The box is never a Smi.
+
+    __ Bind(&store_value);
+    if (is_double) {
+      __ movsd(FieldAddress(box_reg, Double::value_offset()), value);
+    } else {
+      __ movups(FieldAddress(box_reg, Float32x4::value_offset()), value);
+    }
+    return;
+  }
+
   if (ShouldEmitStoreBarrier()) {
     Register value_reg = locs()->in(1).reg();
     __ StoreIntoObject(instance_reg,
@@ -1863,6 +1976,26 @@ void AllocateObjectWithBoundsCheckInstr::EmitNativeCode(
 
 
 LocationSummary* LoadFieldInstr::MakeLocationSummary() const {
+  if (IsUnboxedLoad()) {
+    const intptr_t kNumInputs = 1;
+    const intptr_t kNumTemps = 1;
+    LocationSummary* locs =
+        new LocationSummary(kNumInputs, kNumTemps, LocationSummary::kNoCall);
+    locs->set_in(0, Location::RequiresRegister());
+    locs->set_temp(0, Location::RequiresRegister());
+    locs->set_out(Location::RequiresFpuRegister());
+    return locs;
+  }
+  if (CopiesMutableBox()) {
+    const intptr_t kNumInputs = 1;
+    const intptr_t kNumTemps = 1;
+    LocationSummary* locs =
+        new LocationSummary(kNumInputs, kNumTemps, LocationSummary::kCall);
+    locs->set_in(0, Location::RegisterLocation(EAX));
+    locs->set_temp(0, Location::RegisterLocation(ECX));
+    locs->set_out(Location::RegisterLocation(EAX));
+    return locs;
+  }
   return LocationSummary::Make(1,
                                Location::RequiresRegister(),
                                LocationSummary::kNoCall);
@@ -1871,18 +2004,96 @@ LocationSummary* LoadFieldInstr::MakeLocationSummary() const {
 
 void LoadFieldInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
   Register instance_reg = locs()->in(0).reg();
-  Register result_reg = locs()->out().reg();
+  if (IsUnboxedLoad()) {
+    ASSERT(compiler->is_optimizing());
+    XmmRegister result = locs()->out().fpu_reg();
+    Register box_reg = locs()->temp(0).reg();
+    __ movl(box_reg, FieldAddress(instance_reg, offset_in_bytes()));
+    if (field()->guarded_cid() == kDoubleCid) {
+      __ movsd(result, FieldAddress(box_reg, Double::value_offset()));
+    } else {
+      __ movups(result, FieldAddress(box_reg, Float32x4::value_offset()));
+    }
+    return;
+  }
 
+  Register result_reg = locs()->out().reg();
   __ movl(result_reg, FieldAddress(instance_reg, offset_in_bytes()));
+
+  if (CopiesMutableBox()) {
+    ASSERT(!compiler->is_optimizing());
+    Register temp = locs()->temp(0).reg();
+    Label done;
+    __ testl(result_reg, Immediate(kSmiTagMask));
+    __ j(ZERO, &done, Assembler::kNearJump);
+    __ movl(temp, FieldAddress(result_reg, Object::tags_offset()));
+    __ testl(temp, Immediate(1 << RawObject::kMutableBoxBit));
+    __ j(ZERO, &done, Assembler::kNearJump);
+    __ PushObject(Object::ZoneHandle());  // Make room for the result.
+    __ pushl(result_reg);
+    compiler->GenerateCallRuntime(Scanner::kDummyTokenIndex,
+                                  deopt_id(),
+                                  kCloneMutableBoxRuntimeEntry,
+                                  locs());
+    __ Drop(1);
+    __ popl(result_reg);
+    __ Bind(&done);
+  }
+}
+
+
+// Probes the instantiations cache of the uninstantiated 'type_arguments' for
+// 'instantiator_reg'. On a hit, loads the cached instantiated type arguments
+// into 'result_reg' (unless it is kNoRegister) and jumps to 'found'. Falls
+// through on a miss.
+static void EmitInstantiationsCacheLookup(
+    FlowGraphCompiler* compiler,
+    const AbstractTypeArguments& type_arguments,
+    Register instantiator_reg,
+    Register result_reg,
+    Register cache_reg,
+    Register temp_reg,
+    Label* found) {
+  ASSERT(type_arguments.IsTypeArguments());
+  const Immediate& raw_null =
+      Immediate(reinterpret_cast<intptr_t>(Object::null()));
+  const intptr_t kInstantiatorOffset =
+      TypeArguments::kInstantiatorIndex * kWordSize;
+  const intptr_t kInstantiatedOffset =
+      TypeArguments::kInstantiatedIndex * kWordSize;
+  Label loop, next, not_cached;
+  __ LoadObject(cache_reg, type_arguments);
+  __ movl(cache_reg,
+          FieldAddress(cache_reg, TypeArguments::instantiations_offset()));
+  __ cmpl(cache_reg, raw_null);
+  __ j(EQUAL, &not_cached, Assembler::kNearJump);
+  __ leal(cache_reg, FieldAddress(cache_reg, Array::data_offset()));
+  __ Bind(&loop);
+  __ movl(temp_reg, Address(cache_reg, kInstantiatorOffset));
+  __ cmpl(temp_reg, instantiator_reg);
+  __ j(NOT_EQUAL, &next, Assembler::kNearJump);
+  if (result_reg != kNoRegister) {
+    __ movl(result_reg, Address(cache_reg, kInstantiatedOffset));
+  }
+  __ jmp(found);
+  __ Bind(&next);
+  __ cmpl(temp_reg, Immediate(Smi::RawValue(TypeArguments::kNoInstantiator)));
+  __ j(EQUAL, &not_cached, Assembler::kNearJump);
+  __ addl(cache_reg,
+          Immediate(TypeArguments::kInstantiationSizeInWords * kWordSize));
+  __ jmp(&loop, Assembler::kNearJump);
+  __ Bind(&not_cached);
 }
 
 
 LocationSummary* InstantiateTypeArgumentsInstr::MakeLocationSummary() const {
   const intptr_t kNumInputs = 1;
-  const intptr_t kNumTemps = 0;
+  const intptr_t kNumTemps = 2;
   LocationSummary* locs =
       new LocationSummary(kNumInputs, kNumTemps, LocationSummary::kCall);
   locs->set_in(0, Location::RegisterLocation(EAX));
+  locs->set_temp(0, Location::RegisterLocation(EDI));
+  locs->set_temp(1, Location::RegisterLocation(EBX));
   locs->set_out(Location::RegisterLocation(EAX));
   return locs;
 }
@@ -1902,12 +2113,22 @@ void InstantiateTypeArgumentsInstr::EmitNativeCode(
     // instantiated from null becomes a vector of dynamic, then use null as
     // the type arguments.
     Label type_arguments_instantiated;
+    const Immediate& raw_null =
+        Immediate(reinterpret_cast<intptr_t>(Object::null()));
     const intptr_t len = type_arguments().Length();
     if (type_arguments().IsRawInstantiatedRaw(len)) {
-      const Immediate& raw_null =
-          Immediate(reinterpret_cast<intptr_t>(Object::null()));
       __ cmpl(instantiator_reg, raw_null);
-      __ j(EQUAL, &type_arguments_instantiated, Assembler::kNearJump);
+      __ j(EQUAL, &type_arguments_instantiated);
+    }
+    if (compiler->is_optimizing() && type_arguments().IsTypeArguments()) {
+      // Probe the instantiations cache before calling the runtime.
+      EmitInstantiationsCacheLookup(compiler,
+                                    type_arguments(),
+                                    instantiator_reg,
+                                    result_reg,
+                                    locs()->temp(0).reg(),
+                                    locs()->temp(1).reg(),
+                                    &type_arguments_instantiated);
     }
     // Instantiate non-null type arguments.
     // A runtime call to instantiate the type arguments is required.
@@ -1930,10 +2151,12 @@ void InstantiateTypeArgumentsInstr::EmitNativeCode(
 LocationSummary*
 ExtractConstructorTypeArgumentsInstr::MakeLocationSummary() const {
   const intptr_t kNumInputs = 1;
-  const intptr_t kNumTemps = 0;
+  const intptr_t kNumTemps = 2;
   LocationSummary* locs =
       new LocationSummary(kNumInputs, kNumTemps, LocationSummary::kNoCall);
   locs->set_in(0, Location::RequiresRegister());
+  locs->set_temp(0, Location::RequiresRegister());
+  locs->set_temp(1, Location::RequiresRegister());
   locs->set_out(Location::SameAsFirstInput());
   return locs;
 }
@@ -1954,12 +2177,23 @@ void ExtractConstructorTypeArgumentsInstr::EmitNativeCode(
     // instantiated from null becomes a vector of dynamic, then use null as
     // the type arguments.
     Label type_arguments_instantiated;
+    const Immediate& raw_null =
+        Immediate(reinterpret_cast<intptr_t>(Object::null()));
     const intptr_t len = type_arguments().Length();
     if (type_arguments().IsRawInstantiatedRaw(len)) {
-      const Immediate& raw_null =
-          Immediate(reinterpret_cast<intptr_t>(Object::null()));
       __ cmpl(instantiator_reg, raw_null);
-      __ j(EQUAL, &type_arguments_instantiated, Assembler::kNearJump);
+      __ j(EQUAL, &type_arguments_instantiated);
+    }
+    if (compiler->is_optimizing() && type_arguments().IsTypeArguments()) {
+      // Use the cached instantiation if there is one. The allocation stub
+      // then gets no instantiator, see ExtractConstructorInstantiatorInstr.
+      EmitInstantiationsCacheLookup(compiler,
+                                    type_arguments(),
+                                    instantiator_reg,
+                                    result_reg,
+                                    locs()->temp(0).reg(),
+                                    locs()->temp(1).reg(),
+                                    &type_arguments_instantiated);
     }
     // Instantiate non-null type arguments.
     // In the non-factory case, we rely on the allocation stub to
@@ -1976,10 +2210,12 @@ void ExtractConstructorTypeArgumentsInstr::EmitNativeCode(
 LocationSummary*
 ExtractConstructorInstantiatorInstr::MakeLocationSummary() const {
   const intptr_t kNumInputs = 1;
-  const intptr_t kNumTemps = 0;
+  const intptr_t kNumTemps = 2;
   LocationSummary* locs =
       new LocationSummary(kNumInputs, kNumTemps, LocationSummary::kNoCall);
   locs->set_in(0, Location::RequiresRegister());
+  locs->set_temp(0, Location::RequiresRegister());
+  locs->set_temp(1, Location::RequiresRegister());
   locs->set_out(Location::SameAsFirstInput());
   return locs;
 }
@@ -2003,19 +2239,33 @@ void ExtractConstructorInstantiatorInstr::EmitNativeCode(
     // If the instantiator is null and if the type argument vector
     // instantiated from null becomes a vector of dynamic, then use null as
     // the type arguments and do not pass the instantiator.
+    Label no_instantiator, done;
     const intptr_t len = type_arguments().Length();
     if (type_arguments().IsRawInstantiatedRaw(len)) {
       const Immediate& raw_null =
           Immediate(reinterpret_cast<intptr_t>(Object::null()));
-      Label instantiator_not_null;
-      __ cmpl(instantiator_reg, raw_null);
-      __ j(NOT_EQUAL, &instantiator_not_null, Assembler::kNearJump);
       // Null was used in VisitExtractConstructorTypeArguments as the
       // instantiated type arguments, no proper instantiator needed.
-      __ movl(instantiator_reg,
-              Immediate(Smi::RawValue(StubCode::kNoInstantiator)));
-      __ Bind(&instantiator_not_null);
+      __ cmpl(instantiator_reg, raw_null);
+      __ j(EQUAL, &no_instantiator, Assembler::kNearJump);
+    }
+    if (compiler->is_optimizing() && type_arguments().IsTypeArguments()) {
+      // ExtractConstructorTypeArgumentsInstr immediately precedes this
+      // instruction and probed the same cache, so a hit there produced
+      // the instantiated type arguments, no proper instantiator needed.
+      EmitInstantiationsCacheLookup(compiler,
+                                    type_arguments(),
+                                    instantiator_reg,
+                                    kNoRegister,
+                                    locs()->temp(0).reg(),
+                                    locs()->temp(1).reg(),
+                                    &no_instantiator);
     }
+    __ jmp(&done, Assembler::kNearJump);
+    __ Bind(&no_instantiator);
+    __ movl(instantiator_reg,
+            Immediate(Smi::RawValue(StubCode::kNoInstantiator)));
+    __ Bind(&done);
   }
   // instantiator_reg: instantiator or kNoInstantiator.
 }
@@ -3335,6 +3585,69 @@ void MathSqrtInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
 }
 
 
+LocationSummary* MathMinMaxInstr::MakeLocationSummary() const {
+  const intptr_t kNumInputs = 2;
+  const intptr_t kNumTemps = 0;
+  LocationSummary* summary =
+      new LocationSummary(kNumInputs, kNumTemps, LocationSummary::kNoCall);
+  if (result_cid() == kDoubleCid) {
+    summary->set_in(0, Location::RequiresFpuRegister());
+    summary->set_in(1, Location::RequiresFpuRegister());
+  } else {
+    ASSERT(result_cid() == kSmiCid);
+    summary->set_in(0, Location::RequiresRegister());
+    summary->set_in(1, Location::RequiresRegister());
+  }
+  summary->set_out(Location::SameAsFirstInput());
+  return summary;
+}
+
+
+void MathMinMaxInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
+  const bool is_min = (op_kind() == MethodRecognizer::kMathMin);
+  if (result_cid() == kDoubleCid) {
+    XmmRegister left = locs()->in(0).fpu_reg();
+    XmmRegister right = locs()->in(1).fpu_reg();
+    XmmRegister result = locs()->out().fpu_reg();
+    ASSERT(left == result);
+    Label done, returns_nan, are_equal;
+    __ comisd(left, right);
+    __ j(PARITY_EVEN, &returns_nan, Assembler::kNearJump);
+    __ j(EQUAL, &are_equal, Assembler::kNearJump);
+    __ j(is_min ? BELOW : ABOVE, &done, Assembler::kNearJump);
+    __ movsd(result, right);
+    __ jmp(&done, Assembler::kNearJump);
+
+    __ Bind(&returns_nan);
+    // One of the operands is NaN, so is their sum.
+    __ addsd(result, right);
+    __ jmp(&done, Assembler::kNearJump);
+
+    __ Bind(&are_equal);
+    // Equal values only differ in the sign of zeros: min(0.0, -0.0) is -0.0
+    // and max(0.0, -0.0) is 0.0.
+    if (is_min) {
+      __ orpd(result, right);
+    } else {
+      __ andpd(result, right);
+    }
+    __ Bind(&done);
+    return;
+  }
+
+  ASSERT(result_cid() == kSmiCid);
+  Register left = locs()->in(0).reg();
+  Register right = locs()->in(1).reg();
+  Register result = locs()->out().reg();
+  ASSERT(left == result);
+  Label done;
+  __ cmpl(left, right);
+  __ j(is_min ? LESS_EQUAL : GREATER_EQUAL, &done, Assembler::kNearJump);
+  __ movl(result, right);
+  __ Bind(&done);
+}
+
+
 LocationSummary* UnarySmiOpInstr::MakeLocationSummary() const {
   const intptr_t kNumInputs = 1;
   return LocationSummary::Make(kNumInputs,
@@ -3452,10 +3765,14 @@ void DoubleToSmiInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
 
 LocationSummary* DoubleToDoubleInstr::MakeLocationSummary() const {
   const intptr_t kNumInputs = 1;
-  const intptr_t kNumTemps = 0;
+  const intptr_t kNumTemps =
+      (recognized_kind() == MethodRecognizer::kDoubleRound) ? 1 : 0;
   LocationSummary* result =
       new LocationSummary(kNumInputs, kNumTemps, LocationSummary::kNoCall);
   result->set_in(0, Location::RequiresFpuRegister());
+  if (kNumTemps > 0) {
+    result->set_temp(0, Location::RequiresFpuRegister());
+  }
   result->set_out(Location::RequiresFpuRegister());
   return result;
 }
@@ -3474,6 +3791,24 @@ void DoubleToDoubleInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
     case MethodRecognizer::kDoubleCeil:
       __ roundsd(result, value,  Assembler::kRoundUp);
       break;
+    case MethodRecognizer::kDoubleRound: {
+      // Round half away from zero: add the truncation of twice the fraction
+      // (-1.0, -0.0, 0.0 or 1.0) to the truncated value. Integral values,
+      // infinities and NaN are returned unchanged, which also preserves the
+      // sign of -0.0.
+      XmmRegister temp = locs()->temp(0).fpu_reg();
+      Label done;
+      __ movsd(temp, value);
+      __ roundsd(result, temp, Assembler::kRoundToZero);
+      __ comisd(temp, result);
+      __ j(EQUAL, &done, Assembler::kNearJump);
+      __ subsd(temp, result);
+      __ addsd(temp, temp);
+      __ roundsd(temp, temp, Assembler::kRoundToZero);
+      __ addsd(result, temp);
+      __ Bind(&done);
+      break;
+    }
     default:
       UNREACHABLE();
   }
@@ -3986,6 +4321,165 @@ void UnaryMintOpInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
 }
 
 
+LocationSummary* BoxUint32Instr::MakeLocationSummary() const {
+  const intptr_t kNumInputs = 1;
+  const intptr_t kNumTemps = 0;
+  LocationSummary* summary =
+      new LocationSummary(kNumInputs,
+                          kNumTemps,
+                          LocationSummary::kCallOnSlowPath);
+  summary->set_in(0, Location::RequiresRegister());
+  summary->set_out(Location::RequiresRegister());
+  return summary;
+}
+
+
+void BoxUint32Instr::EmitNativeCode(FlowGraphCompiler* compiler) {
+  Register value = locs()->in(0).reg();
+  Register out = locs()->out().reg();
+  ASSERT(value != out);
+
+  Label not_smi, done;
+  __ movl(out, value);
+  // The value fits into a smi if the two topmost bits are clear.
+  __ testl(out, Immediate(0xC0000000));
+  __ j(NOT_ZERO, &not_smi);
+  __ SmiTag(out);
+  __ jmp(&done);
+
+  __ Bind(&not_smi);
+  const Class& mint_class =
+      Class::ZoneHandle(Isolate::Current()->object_store()->mint_class());
+  BoxAllocationSlowPath* slow_path =
+      new BoxAllocationSlowPath(this, mint_class, out);
+  compiler->AddSlowPathCode(slow_path);
+  __ TryAllocate(mint_class,
+                 slow_path->entry_label(),
+                 Assembler::kFarJump,
+                 out);
+  __ Bind(slow_path->exit_label());
+  __ movl(FieldAddress(out, Mint::value_offset()), value);
+  __ movl(FieldAddress(out, Mint::value_offset() + kWordSize), Immediate(0));
+  __ Bind(&done);
+}
+
+
+LocationSummary* UnboxUint32Instr::MakeLocationSummary() const {
+  const intptr_t kNumInputs = 1;
+  const intptr_t value_cid = value()->Type()->ToCid();
+  if (value()->BindsToConstant()) {
+    LocationSummary* summary =
+        new LocationSummary(kNumInputs, 0, LocationSummary::kNoCall);
+    summary->set_in(0, Location::Constant(value()->BoundConstant()));
+    summary->set_out(Location::RequiresRegister());
+    return summary;
+  }
+  const bool needs_temp = (value_cid != kSmiCid) && (value_cid != kMintCid);
+  const intptr_t kNumTemps = needs_temp ? 1 : 0;
+  LocationSummary* summary =
+      new LocationSummary(kNumInputs, kNumTemps, LocationSummary::kNoCall);
+  summary->set_in(0, Location::RequiresRegister());
+  if (needs_temp) summary->set_temp(0, Location::RequiresRegister());
+  summary->set_out((value_cid == kSmiCid) ? Location::SameAsFirstInput()
+                                          : Location::RequiresRegister());
+  return summary;
+}
+
+
+void UnboxUint32Instr::EmitNativeCode(FlowGraphCompiler* compiler) {
+  Register out = locs()->out().reg();
+  Label* deopt = CanDeoptimize() ?
+      compiler->AddDeoptStub(deopt_id_, kDeoptUnboxInteger) : NULL;
+
+  if (locs()->in(0).IsConstant()) {
+    const Object& constant = locs()->in(0).constant();
+    if (constant.IsSmi() || constant.IsMint()) {
+      const int64_t value = Integer::Cast(constant).AsInt64Value();
+      __ movl(out, Immediate(static_cast<int32_t>(value)));
+    } else {
+      ASSERT(deopt != NULL);
+      __ jmp(deopt);
+    }
+    return;
+  }
+
+  Register value = locs()->in(0).reg();
+  const intptr_t value_cid = this->value()->Type()->ToCid();
+  if (value_cid == kSmiCid) {
+    ASSERT(value == out);
+    __ SmiUntag(out);
+  } else if (value_cid == kMintCid) {
+    // Low half of the 64-bit value.
+    __ movl(out, FieldAddress(value, Mint::value_offset()));
+  } else {
+    Register temp = locs()->temp(0).reg();
+    Label is_smi, done;
+    __ testl(value, Immediate(kSmiTagMask));
+    __ j(ZERO, &is_smi, Assembler::kNearJump);
+    __ CompareClassId(value, kMintCid, temp);
+    __ j(NOT_EQUAL, deopt);
+    __ movl(out, FieldAddress(value, Mint::value_offset()));
+    __ jmp(&done, Assembler::kNearJump);
+    __ Bind(&is_smi);
+    __ movl(out, value);
+    __ SmiUntag(out);
+    __ Bind(&done);
+  }
+}
+
+
+LocationSummary* BinaryUint32OpInstr::MakeLocationSummary() const {
+  const intptr_t kNumInputs = 2;
+  const intptr_t kNumTemps = 0;
+  LocationSummary* summary =
+      new LocationSummary(kNumInputs, kNumTemps, LocationSummary::kNoCall);
+  summary->set_in(0, Location::RequiresRegister());
+  summary->set_in(1, Location::RequiresRegister());
+  summary->set_out(Location::SameAsFirstInput());
+  return summary;
+}
+
+
+void BinaryUint32OpInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
+  Register left = locs()->in(0).reg();
+  Register right = locs()->in(1).reg();
+  ASSERT(locs()->out().reg() == left);
+  switch (op_kind()) {
+    case Token::kBIT_AND: __ andl(left, right); break;
+    case Token::kBIT_OR:  __ orl(left, right); break;
+    case Token::kBIT_XOR: __ xorl(left, right); break;
+    case Token::kADD:     __ addl(left, right); break;
+    case Token::kSUB:     __ subl(left, right); break;
+    case Token::kMUL:     __ imull(left, right); break;
+    default: UNREACHABLE();
+  }
+}
+
+
+LocationSummary* ShiftUint32OpInstr::MakeLocationSummary() const {
+  const intptr_t kNumInputs = 1;
+  const intptr_t kNumTemps = 0;
+  LocationSummary* summary =
+      new LocationSummary(kNumInputs, kNumTemps, LocationSummary::kNoCall);
+  summary->set_in(0, Location::RequiresRegister());
+  summary->set_out(Location::SameAsFirstInput());
+  return summary;
+}
+
+
+void ShiftUint32OpInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
+  Register value = locs()->in(0).reg();
+  ASSERT(locs()->out().reg() == value);
+  const Immediate count = Immediate(shift_count());
+  if (op_kind() == Token::kSHL) {
+    __ shll(value, count);
+  } else {
+    ASSERT(op_kind() == Token::kSHR);
+    __ shrl(value, count);
+  }
+}
+
+
 LocationSummary* ThrowInstr::MakeLocationSummary() const {
   return new LocationSummary(0, 0, LocationSummary::kCall);
 }
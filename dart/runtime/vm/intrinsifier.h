@@ -80,6 +80,10 @@ namespace dart {
   V(_StringBase, get:isEmpty, String_getIsEmpty, 1026765313)                   \
   V(_StringBase, get:length, String_getLength, 320803993)                      \
   V(_StringBase, codeUnitAt, String_codeUnitAt, 984449525)                     \
+  V(_StringBase, ==, String_equality, 1265127843)                              \
+  V(_StringBase, compareTo, String_compareTo, 1896938637)                      \
+  V(_StringBase, _substringMatches, String_substringMatches, 479829948)        \
+  V(_StringBase, _indexOf, String_indexOf, 373194570)                          \
   V(_OneByteString, get:hashCode, OneByteString_getHashCode, 682660413)        \
   V(_OneByteString, _substringUncheckedNative,                                 \
       OneByteString_substringUnchecked, 713121438)                             \
@@ -336,6 +336,26 @@ bool Intrinsifier::String_getIsEmpty(Assembler* assembler) {
 }
 
 
+bool Intrinsifier::String_equality(Assembler* assembler) {
+  return false;
+}
+
+
+bool Intrinsifier::String_compareTo(Assembler* assembler) {
+  return false;
+}
+
+
+bool Intrinsifier::String_substringMatches(Assembler* assembler) {
+  return false;
+}
+
+
+bool Intrinsifier::String_indexOf(Assembler* assembler) {
+  return false;
+}
+
+
 bool Intrinsifier::OneByteString_getHashCode(Assembler* assembler) {
   return false;
 }
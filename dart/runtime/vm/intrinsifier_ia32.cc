@@ -1501,6 +1501,369 @@ bool Intrinsifier::String_getIsEmpty(Assembler* assembler) {
 }
 
 
+// Advances 'left' and 'right' over the leading bytes they have in common,
+// looking at no more than 'length' bytes. Blocks of 16 bytes are compared
+// with SSE2, the remaining bytes one at a time. On exit 'length' holds the
+// number of bytes from the first mismatch to the end, i.e., zero if all
+// bytes are equal. Destroys 'temp1', 'temp2', XMM0 and XMM1.
+static void GenerateSkipEqualBytes(Assembler* assembler,
+                                   Register left,
+                                   Register right,
+                                   Register length,
+                                   Register temp1,
+                                   Register temp2) {
+  Label block_loop, block_mismatch, byte_loop, done;
+  __ Bind(&block_loop);
+  __ cmpl(length, Immediate(16));
+  __ j(LESS, &byte_loop, Assembler::kNearJump);
+  __ movups(XMM0, Address(left, 0));
+  __ movups(XMM1, Address(right, 0));
+  __ pcmpeqb(XMM0, XMM1);
+  __ pmovmskb(temp1, XMM0);
+  __ cmpl(temp1, Immediate(0xFFFF));
+  __ j(NOT_EQUAL, &block_mismatch, Assembler::kNearJump);
+  __ addl(left, Immediate(16));
+  __ addl(right, Immediate(16));
+  __ subl(length, Immediate(16));
+  __ jmp(&block_loop, Assembler::kNearJump);
+
+  __ Bind(&block_mismatch);
+  // Bits of the mismatching bytes are clear in the mask.
+  __ notl(temp1);
+  __ bsfl(temp1, temp1);
+  __ addl(left, temp1);
+  __ addl(right, temp1);
+  __ subl(length, temp1);
+  __ jmp(&done, Assembler::kNearJump);
+
+  __ Bind(&byte_loop);
+  __ testl(length, length);
+  __ j(ZERO, &done, Assembler::kNearJump);
+  __ movzxb(temp1, Address(left, 0));
+  __ movzxb(temp2, Address(right, 0));
+  __ cmpl(temp1, temp2);
+  __ j(NOT_EQUAL, &done, Assembler::kNearJump);
+  __ incl(left);
+  __ incl(right);
+  __ decl(length);
+  __ jmp(&byte_loop, Assembler::kNearJump);
+  __ Bind(&done);
+}
+
+
+// EAX: receiver string with class id 'cid'.
+// EBX: argument, not a smi.
+// Returns the result of == if the argument has class id 'cid' as well,
+// otherwise jumps to 'fall_through'.
+static void GenerateStringEquality(Assembler* assembler,
+                                   intptr_t cid,
+                                   Label* fall_through) {
+  ASSERT(OneByteString::data_offset() == TwoByteString::data_offset());
+  Label is_false, compare;
+  __ CompareClassId(EBX, cid, EDI);
+  __ j(NOT_EQUAL, fall_through);
+  // The intrinsic cannot fall through anymore, ECX and EDX are free.
+  __ movl(ECX, EBX);
+  __ movl(EDX, FieldAddress(EAX, String::length_offset()));
+  __ cmpl(EDX, FieldAddress(ECX, String::length_offset()));
+  __ j(NOT_EQUAL, &is_false);
+  // Strings with different hash codes cannot be equal.
+  __ movl(EBX, FieldAddress(EAX, String::hash_offset()));
+  __ testl(EBX, EBX);
+  __ j(ZERO, &compare, Assembler::kNearJump);
+  __ cmpl(FieldAddress(ECX, String::hash_offset()), Immediate(0));
+  __ j(EQUAL, &compare, Assembler::kNearJump);
+  __ cmpl(EBX, FieldAddress(ECX, String::hash_offset()));
+  __ j(NOT_EQUAL, &is_false);
+  __ Bind(&compare);
+  // EDX: length in bytes. The tagged length of a two-byte string is its
+  // length in bytes.
+  if (cid == kOneByteStringCid) {
+    __ SmiUntag(EDX);
+  }
+  __ leal(EAX, FieldAddress(EAX, OneByteString::data_offset()));
+  __ leal(ECX, FieldAddress(ECX, OneByteString::data_offset()));
+  GenerateSkipEqualBytes(assembler, EAX, ECX, EDX, EBX, EDI);
+  __ testl(EDX, EDX);
+  __ j(NOT_ZERO, &is_false, Assembler::kNearJump);
+  __ LoadObject(EAX, Bool::True());
+  __ ret();
+  __ Bind(&is_false);
+  __ LoadObject(EAX, Bool::False());
+  __ ret();
+}
+
+
+bool Intrinsifier::String_equality(Assembler* assembler) {
+  Label fall_through, is_true, is_false, two_byte;
+  __ movl(EAX, Address(ESP, + 2 * kWordSize));  // This.
+  __ movl(EBX, Address(ESP, + 1 * kWordSize));  // Other.
+  __ cmpl(EAX, EBX);
+  __ j(EQUAL, &is_true);
+  __ testl(EBX, Immediate(kSmiTagMask));
+  __ j(ZERO, &is_false);
+  // Strings of different representations are compared by the Dart code.
+  __ CompareClassId(EAX, kOneByteStringCid, EDI);
+  __ j(NOT_EQUAL, &two_byte);
+  GenerateStringEquality(assembler, kOneByteStringCid, &fall_through);
+  __ Bind(&two_byte);
+  __ CompareClassId(EAX, kTwoByteStringCid, EDI);
+  __ j(NOT_EQUAL, &fall_through);
+  GenerateStringEquality(assembler, kTwoByteStringCid, &fall_through);
+  __ Bind(&is_true);
+  __ LoadObject(EAX, Bool::True());
+  __ ret();
+  __ Bind(&is_false);
+  __ LoadObject(EAX, Bool::False());
+  __ ret();
+  __ Bind(&fall_through);
+  return false;
+}
+
+
+// EAX: receiver string with class id 'cid'.
+// EBX: argument, not a smi.
+// Returns the result of compareTo if the argument has class id 'cid' as
+// well, otherwise jumps to 'fall_through'.
+static void GenerateStringCompareTo(Assembler* assembler,
+                                    intptr_t cid,
+                                    Label* fall_through) {
+  ASSERT(OneByteString::data_offset() == TwoByteString::data_offset());
+  Label compare_lengths, is_less, is_greater, min_length;
+  __ CompareClassId(EBX, cid, EDI);
+  __ j(NOT_EQUAL, fall_through);
+  // The intrinsic cannot fall through anymore, ECX and EDX are free.
+  __ movl(ECX, EBX);
+  // EDX: tagged length of the shorter string.
+  __ movl(EDX, FieldAddress(EAX, String::length_offset()));
+  __ cmpl(EDX, FieldAddress(ECX, String::length_offset()));
+  __ j(LESS_EQUAL, &min_length, Assembler::kNearJump);
+  __ movl(EDX, FieldAddress(ECX, String::length_offset()));
+  __ Bind(&min_length);
+  if (cid == kOneByteStringCid) {
+    __ SmiUntag(EDX);
+  }
+  __ leal(EAX, FieldAddress(EAX, OneByteString::data_offset()));
+  __ leal(ECX, FieldAddress(ECX, OneByteString::data_offset()));
+  GenerateSkipEqualBytes(assembler, EAX, ECX, EDX, EBX, EDI);
+  __ testl(EDX, EDX);
+  __ j(ZERO, &compare_lengths, Assembler::kNearJump);
+  // Compare the first code units that differ.
+  if (cid == kOneByteStringCid) {
+    __ movzxb(EBX, Address(EAX, 0));
+    __ movzxb(EDI, Address(ECX, 0));
+  } else {
+    // The mismatch may be in the upper byte of a code unit. The characters
+    // of a string start at an even address.
+    __ movl(EBX, EAX);
+    __ andl(EBX, Immediate(1));
+    __ subl(EAX, EBX);
+    __ subl(ECX, EBX);
+    __ movzxw(EBX, Address(EAX, 0));
+    __ movzxw(EDI, Address(ECX, 0));
+  }
+  __ cmpl(EBX, EDI);
+  __ j(LESS, &is_less, Assembler::kNearJump);
+  __ jmp(&is_greater, Assembler::kNearJump);
+
+  __ Bind(&compare_lengths);
+  __ movl(EAX, Address(ESP, + 2 * kWordSize));  // This.
+  __ movl(ECX, Address(ESP, + 1 * kWordSize));  // Other.
+  __ movl(EAX, FieldAddress(EAX, String::length_offset()));
+  __ cmpl(EAX, FieldAddress(ECX, String::length_offset()));
+  __ j(LESS, &is_less, Assembler::kNearJump);
+  __ j(GREATER, &is_greater, Assembler::kNearJump);
+  __ movl(EAX, Immediate(Smi::RawValue(0)));
+  __ ret();
+  __ Bind(&is_less);
+  __ movl(EAX, Immediate(Smi::RawValue(-1)));
+  __ ret();
+  __ Bind(&is_greater);
+  __ movl(EAX, Immediate(Smi::RawValue(1)));
+  __ ret();
+}
+
+
+bool Intrinsifier::String_compareTo(Assembler* assembler) {
+  Label fall_through, two_byte;
+  __ movl(EAX, Address(ESP, + 2 * kWordSize));  // This.
+  __ movl(EBX, Address(ESP, + 1 * kWordSize));  // Other.
+  __ testl(EBX, Immediate(kSmiTagMask));
+  __ j(ZERO, &fall_through);
+  // Strings of different representations are compared by the Dart code.
+  __ CompareClassId(EAX, kOneByteStringCid, EDI);
+  __ j(NOT_EQUAL, &two_byte);
+  GenerateStringCompareTo(assembler, kOneByteStringCid, &fall_through);
+  __ Bind(&two_byte);
+  __ CompareClassId(EAX, kTwoByteStringCid, EDI);
+  __ j(NOT_EQUAL, &fall_through);
+  GenerateStringCompareTo(assembler, kTwoByteStringCid, &fall_through);
+  __ Bind(&fall_through);
+  return false;
+}
+
+
+// EAX: receiver string with class id 'cid'.
+// EBX: start index, a smi.
+// Returns the result of _substringMatches if the argument has class id 'cid'
+// as well and is not empty and the start index is not negative, otherwise
+// jumps to 'fall_through'.
+static void GenerateSubstringMatches(Assembler* assembler,
+                                     intptr_t cid,
+                                     Label* fall_through) {
+  ASSERT(OneByteString::data_offset() == TwoByteString::data_offset());
+  Label is_false;
+  // Only EDI is free until the intrinsic cannot fall through anymore.
+  __ movl(EDI, Address(ESP, + 1 * kWordSize));  // Other.
+  __ testl(EDI, Immediate(kSmiTagMask));
+  __ j(ZERO, fall_through);
+  __ CompareClassId(EDI, cid, EDI);
+  __ j(NOT_EQUAL, fall_through);
+  __ movl(EDI, Address(ESP, + 1 * kWordSize));  // Other.
+  __ movl(EDI, FieldAddress(EDI, String::length_offset()));
+  __ testl(EDI, EDI);
+  __ j(ZERO, fall_through);
+  __ cmpl(EBX, Immediate(0));
+  __ j(LESS, fall_through);
+  __ movl(ECX, Address(ESP, + 1 * kWordSize));  // Other.
+  __ movl(EDX, EBX);
+  __ addl(EDX, EDI);
+  __ cmpl(EDX, FieldAddress(EAX, String::length_offset()));
+  __ j(GREATER, &is_false);
+  // EBX: start offset in bytes, EDI: length of the argument in bytes.
+  if (cid == kOneByteStringCid) {
+    __ SmiUntag(EBX);
+    __ SmiUntag(EDI);
+  }
+  __ leal(EAX, FieldAddress(EAX, EBX, TIMES_1, OneByteString::data_offset()));
+  __ leal(ECX, FieldAddress(ECX, OneByteString::data_offset()));
+  GenerateSkipEqualBytes(assembler, EAX, ECX, EDI, EBX, EDX);
+  __ testl(EDI, EDI);
+  __ j(NOT_ZERO, &is_false, Assembler::kNearJump);
+  __ LoadObject(EAX, Bool::True());
+  __ ret();
+  __ Bind(&is_false);
+  __ LoadObject(EAX, Bool::False());
+  __ ret();
+}
+
+
+bool Intrinsifier::String_substringMatches(Assembler* assembler) {
+  Label fall_through, two_byte;
+  __ movl(EAX, Address(ESP, + 3 * kWordSize));  // This.
+  __ movl(EBX, Address(ESP, + 2 * kWordSize));  // Start.
+  __ testl(EBX, Immediate(kSmiTagMask));
+  __ j(NOT_ZERO, &fall_through);
+  __ CompareClassId(EAX, kOneByteStringCid, EDI);
+  __ j(NOT_EQUAL, &two_byte);
+  GenerateSubstringMatches(assembler, kOneByteStringCid, &fall_through);
+  __ Bind(&two_byte);
+  __ CompareClassId(EAX, kTwoByteStringCid, EDI);
+  __ j(NOT_EQUAL, &fall_through);
+  GenerateSubstringMatches(assembler, kTwoByteStringCid, &fall_through);
+  __ Bind(&fall_through);
+  return false;
+}
+
+
+// Searches one-byte strings for the first character of 'other' 16 characters
+// at a time and compares the rest at the candidate positions.
+bool Intrinsifier::String_indexOf(Assembler* assembler) {
+  Label fall_through, scan, scan_tail, candidate, verify, next, not_found;
+  __ movl(EAX, Address(ESP, + 3 * kWordSize));  // This.
+  __ movl(EBX, Address(ESP, + 1 * kWordSize));  // Start.
+  __ testl(EBX, Immediate(kSmiTagMask));
+  __ j(NOT_ZERO, &fall_through);
+  __ CompareClassId(EAX, kOneByteStringCid, EDI);
+  __ j(NOT_EQUAL, &fall_through);
+  // Only EDI is free until the intrinsic cannot fall through anymore.
+  __ movl(EDI, Address(ESP, + 2 * kWordSize));  // Other.
+  __ testl(EDI, Immediate(kSmiTagMask));
+  __ j(ZERO, &fall_through);
+  __ CompareClassId(EDI, kOneByteStringCid, EDI);
+  __ j(NOT_EQUAL, &fall_through);
+  __ movl(EDI, Address(ESP, + 2 * kWordSize));  // Other.
+  __ movl(EDI, FieldAddress(EDI, String::length_offset()));
+  __ testl(EDI, EDI);
+  __ j(ZERO, &fall_through);
+  __ cmpl(EBX, Immediate(0));
+  __ j(LESS, &fall_through);
+  __ movl(ECX, Address(ESP, + 2 * kWordSize));  // Other.
+  __ movl(EDX, EBX);
+  __ SmiUntag(EDX);
+  // EBX: one past the last index at which 'other' fits into this string.
+  __ movl(EBX, FieldAddress(EAX, String::length_offset()));
+  __ subl(EBX, EDI);
+  __ SmiUntag(EBX);
+  __ incl(EBX);
+  // XMM2: first character of 'other' in every byte.
+  __ movzxb(EDI, FieldAddress(ECX, OneByteString::data_offset()));
+  __ imull(EDI, Immediate(0x01010101));
+  __ movd(XMM2, EDI);
+  __ shufps(XMM2, XMM2, Immediate(0));
+  __ leal(EAX, FieldAddress(EAX, OneByteString::data_offset()));
+  __ leal(ECX, FieldAddress(ECX, OneByteString::data_offset()));
+  // EAX: characters of this string.
+  // ECX: characters of 'other'.
+  // EDX: next index to look at.
+  // EBX: end of the indices to look at.
+  __ Bind(&scan);
+  __ movl(EDI, EBX);
+  __ subl(EDI, EDX);
+  __ cmpl(EDI, Immediate(16));
+  __ j(LESS, &scan_tail, Assembler::kNearJump);
+  // All 16 indices are candidates inside this string.
+  __ movups(XMM0, Address(EAX, EDX, TIMES_1, 0));
+  __ pcmpeqb(XMM0, XMM2);
+  __ pmovmskb(EDI, XMM0);
+  __ testl(EDI, EDI);
+  __ j(NOT_ZERO, &candidate, Assembler::kNearJump);
+  __ addl(EDX, Immediate(16));
+  __ jmp(&scan, Assembler::kNearJump);
+
+  __ Bind(&candidate);
+  __ bsfl(EDI, EDI);
+  __ addl(EDX, EDI);
+  __ jmp(&verify, Assembler::kNearJump);
+
+  // Fewer than 16 indices are left, verify each of them.
+  __ Bind(&scan_tail);
+  __ cmpl(EDX, EBX);
+  __ j(GREATER_EQUAL, &not_found);
+
+  __ Bind(&verify);
+  // Not enough registers, preserve the scan state on the stack.
+  __ pushl(EAX);
+  __ pushl(EBX);
+  __ pushl(ECX);
+  __ pushl(EDX);
+  __ addl(EAX, EDX);
+  __ movl(EBX, Address(ESP, + (4 + 2) * kWordSize));  // Other.
+  __ movl(EBX, FieldAddress(EBX, String::length_offset()));
+  __ SmiUntag(EBX);
+  GenerateSkipEqualBytes(assembler, EAX, ECX, EBX, EDX, EDI);
+  __ movl(EDI, EBX);
+  __ popl(EDX);
+  __ popl(ECX);
+  __ popl(EBX);
+  __ popl(EAX);
+  __ testl(EDI, EDI);
+  __ j(NOT_ZERO, &next);
+  __ movl(EAX, EDX);
+  __ SmiTag(EAX);
+  __ ret();
+  __ Bind(&next);
+  __ incl(EDX);
+  __ jmp(&scan);
+
+  __ Bind(&not_found);
+  __ movl(EAX, Immediate(Smi::RawValue(-1)));
+  __ ret();
+  __ Bind(&fall_through);
+  return false;
+}
+
+
 bool Intrinsifier::OneByteString_getHashCode(Assembler* assembler) {
   Label compute_hash;
   __ movl(EBX, Address(ESP, + 1 * kWordSize));  // OneByteString object.
@@ -1417,6 +1417,352 @@ bool Intrinsifier::String_getIsEmpty(Assembler* assembler) {
 }
 
 
+// Advances 'left' and 'right' over the leading bytes they have in common,
+// looking at no more than 'length' bytes. Blocks of 16 bytes are compared
+// with SSE2, the remaining bytes one at a time. On exit 'length' holds the
+// number of bytes from the first mismatch to the end, i.e., zero if all
+// bytes are equal. Destroys 'temp1', 'temp2', XMM0 and XMM1.
+static void GenerateSkipEqualBytes(Assembler* assembler,
+                                   Register left,
+                                   Register right,
+                                   Register length,
+                                   Register temp1,
+                                   Register temp2) {
+  Label block_loop, block_mismatch, byte_loop, done;
+  __ Bind(&block_loop);
+  __ cmpq(length, Immediate(16));
+  __ j(LESS, &byte_loop, Assembler::kNearJump);
+  __ movups(XMM0, Address(left, 0));
+  __ movups(XMM1, Address(right, 0));
+  __ pcmpeqb(XMM0, XMM1);
+  __ pmovmskb(temp1, XMM0);
+  __ cmpq(temp1, Immediate(0xFFFF));
+  __ j(NOT_EQUAL, &block_mismatch, Assembler::kNearJump);
+  __ addq(left, Immediate(16));
+  __ addq(right, Immediate(16));
+  __ subq(length, Immediate(16));
+  __ jmp(&block_loop, Assembler::kNearJump);
+
+  __ Bind(&block_mismatch);
+  // Bits of the mismatching bytes are clear in the mask.
+  __ notl(temp1);
+  __ bsfl(temp1, temp1);
+  __ addq(left, temp1);
+  __ addq(right, temp1);
+  __ subq(length, temp1);
+  __ jmp(&done, Assembler::kNearJump);
+
+  __ Bind(&byte_loop);
+  __ testq(length, length);
+  __ j(ZERO, &done, Assembler::kNearJump);
+  __ movzxb(temp1, Address(left, 0));
+  __ movzxb(temp2, Address(right, 0));
+  __ cmpq(temp1, temp2);
+  __ j(NOT_EQUAL, &done, Assembler::kNearJump);
+  __ incq(left);
+  __ incq(right);
+  __ decq(length);
+  __ jmp(&byte_loop, Assembler::kNearJump);
+  __ Bind(&done);
+}
+
+
+// RAX: receiver string with class id 'cid'.
+// RCX: argument, not a smi.
+// Returns the result of == if the argument has class id 'cid' as well,
+// otherwise jumps to 'fall_through'.
+static void GenerateStringEquality(Assembler* assembler,
+                                   intptr_t cid,
+                                   Label* fall_through) {
+  ASSERT(OneByteString::data_offset() == TwoByteString::data_offset());
+  Label is_false, compare;
+  __ CompareClassId(RCX, cid);
+  __ j(NOT_EQUAL, fall_through);
+  __ movq(RDX, FieldAddress(RAX, String::length_offset()));
+  __ cmpq(RDX, FieldAddress(RCX, String::length_offset()));
+  __ j(NOT_EQUAL, &is_false);
+  // Strings with different hash codes cannot be equal.
+  __ movq(RBX, FieldAddress(RAX, String::hash_offset()));
+  __ testq(RBX, RBX);
+  __ j(ZERO, &compare, Assembler::kNearJump);
+  __ cmpq(FieldAddress(RCX, String::hash_offset()), Immediate(0));
+  __ j(EQUAL, &compare, Assembler::kNearJump);
+  __ cmpq(RBX, FieldAddress(RCX, String::hash_offset()));
+  __ j(NOT_EQUAL, &is_false);
+  __ Bind(&compare);
+  // RDX: length in bytes. The tagged length of a two-byte string is its
+  // length in bytes.
+  if (cid == kOneByteStringCid) {
+    __ SmiUntag(RDX);
+  }
+  __ leaq(RSI, FieldAddress(RAX, OneByteString::data_offset()));
+  __ leaq(RDI, FieldAddress(RCX, OneByteString::data_offset()));
+  GenerateSkipEqualBytes(assembler, RSI, RDI, RDX, RAX, RBX);
+  __ testq(RDX, RDX);
+  __ j(NOT_ZERO, &is_false, Assembler::kNearJump);
+  __ LoadObject(RAX, Bool::True());
+  __ ret();
+  __ Bind(&is_false);
+  __ LoadObject(RAX, Bool::False());
+  __ ret();
+}
+
+
+bool Intrinsifier::String_equality(Assembler* assembler) {
+  Label fall_through, is_true, is_false, two_byte;
+  __ movq(RAX, Address(RSP, + 2 * kWordSize));  // This.
+  __ movq(RCX, Address(RSP, + 1 * kWordSize));  // Other.
+  __ cmpq(RAX, RCX);
+  __ j(EQUAL, &is_true);
+  __ testq(RCX, Immediate(kSmiTagMask));
+  __ j(ZERO, &is_false);
+  // Strings of different representations are compared by the Dart code.
+  __ CompareClassId(RAX, kOneByteStringCid);
+  __ j(NOT_EQUAL, &two_byte);
+  GenerateStringEquality(assembler, kOneByteStringCid, &fall_through);
+  __ Bind(&two_byte);
+  __ CompareClassId(RAX, kTwoByteStringCid);
+  __ j(NOT_EQUAL, &fall_through);
+  GenerateStringEquality(assembler, kTwoByteStringCid, &fall_through);
+  __ Bind(&is_true);
+  __ LoadObject(RAX, Bool::True());
+  __ ret();
+  __ Bind(&is_false);
+  __ LoadObject(RAX, Bool::False());
+  __ ret();
+  __ Bind(&fall_through);
+  return false;
+}
+
+
+// RAX: receiver string with class id 'cid'.
+// RCX: argument, not a smi.
+// Returns the result of compareTo if the argument has class id 'cid' as
+// well, otherwise jumps to 'fall_through'.
+static void GenerateStringCompareTo(Assembler* assembler,
+                                    intptr_t cid,
+                                    Label* fall_through) {
+  ASSERT(OneByteString::data_offset() == TwoByteString::data_offset());
+  Label compare_lengths, is_less, is_greater, min_length;
+  __ CompareClassId(RCX, cid);
+  __ j(NOT_EQUAL, fall_through);
+  // RDX: tagged length of the shorter string.
+  __ movq(RDX, FieldAddress(RAX, String::length_offset()));
+  __ cmpq(RDX, FieldAddress(RCX, String::length_offset()));
+  __ j(LESS_EQUAL, &min_length, Assembler::kNearJump);
+  __ movq(RDX, FieldAddress(RCX, String::length_offset()));
+  __ Bind(&min_length);
+  if (cid == kOneByteStringCid) {
+    __ SmiUntag(RDX);
+  }
+  __ leaq(RSI, FieldAddress(RAX, OneByteString::data_offset()));
+  __ leaq(RDI, FieldAddress(RCX, OneByteString::data_offset()));
+  GenerateSkipEqualBytes(assembler, RSI, RDI, RDX, RAX, RBX);
+  __ testq(RDX, RDX);
+  __ j(ZERO, &compare_lengths, Assembler::kNearJump);
+  // Compare the first code units that differ.
+  if (cid == kOneByteStringCid) {
+    __ movzxb(RAX, Address(RSI, 0));
+    __ movzxb(RBX, Address(RDI, 0));
+  } else {
+    // The mismatch may be in the upper byte of a code unit. The characters
+    // of a string start at an even address.
+    __ movq(RAX, RSI);
+    __ andq(RAX, Immediate(1));
+    __ subq(RSI, RAX);
+    __ subq(RDI, RAX);
+    __ movzxw(RAX, Address(RSI, 0));
+    __ movzxw(RBX, Address(RDI, 0));
+  }
+  __ cmpq(RAX, RBX);
+  __ j(LESS, &is_less, Assembler::kNearJump);
+  __ jmp(&is_greater, Assembler::kNearJump);
+
+  __ Bind(&compare_lengths);
+  __ movq(RAX, Address(RSP, + 2 * kWordSize));  // This.
+  __ movq(RCX, Address(RSP, + 1 * kWordSize));  // Other.
+  __ movq(RAX, FieldAddress(RAX, String::length_offset()));
+  __ cmpq(RAX, FieldAddress(RCX, String::length_offset()));
+  __ j(LESS, &is_less, Assembler::kNearJump);
+  __ j(GREATER, &is_greater, Assembler::kNearJump);
+  __ movq(RAX, Immediate(Smi::RawValue(0)));
+  __ ret();
+  __ Bind(&is_less);
+  __ movq(RAX, Immediate(Smi::RawValue(-1)));
+  __ ret();
+  __ Bind(&is_greater);
+  __ movq(RAX, Immediate(Smi::RawValue(1)));
+  __ ret();
+}
+
+
+bool Intrinsifier::String_compareTo(Assembler* assembler) {
+  Label fall_through, two_byte;
+  __ movq(RAX, Address(RSP, + 2 * kWordSize));  // This.
+  __ movq(RCX, Address(RSP, + 1 * kWordSize));  // Other.
+  __ testq(RCX, Immediate(kSmiTagMask));
+  __ j(ZERO, &fall_through);
+  // Strings of different representations are compared by the Dart code.
+  __ CompareClassId(RAX, kOneByteStringCid);
+  __ j(NOT_EQUAL, &two_byte);
+  GenerateStringCompareTo(assembler, kOneByteStringCid, &fall_through);
+  __ Bind(&two_byte);
+  __ CompareClassId(RAX, kTwoByteStringCid);
+  __ j(NOT_EQUAL, &fall_through);
+  GenerateStringCompareTo(assembler, kTwoByteStringCid, &fall_through);
+  __ Bind(&fall_through);
+  return false;
+}
+
+
+// RAX: receiver string with class id 'cid'.
+// RCX: argument, not a smi.
+// RDX: start index, a smi.
+// Returns the result of _substringMatches if the argument has class id 'cid'
+// as well and is not empty and the start index is not negative, otherwise
+// jumps to 'fall_through'.
+static void GenerateSubstringMatches(Assembler* assembler,
+                                     intptr_t cid,
+                                     Label* fall_through) {
+  ASSERT(OneByteString::data_offset() == TwoByteString::data_offset());
+  Label is_false;
+  __ CompareClassId(RCX, cid);
+  __ j(NOT_EQUAL, fall_through);
+  // RBX may only be destroyed once the intrinsic cannot fall through.
+  __ movq(RDI, FieldAddress(RCX, String::length_offset()));
+  __ testq(RDI, RDI);
+  __ j(ZERO, fall_through);
+  __ cmpq(RDX, Immediate(0));
+  __ j(LESS, fall_through);
+  __ movq(RBX, RDI);
+  __ movq(RSI, RDX);
+  __ addq(RSI, RBX);
+  __ cmpq(RSI, FieldAddress(RAX, String::length_offset()));
+  __ j(GREATER, &is_false);
+  // RDX: start offset in bytes, RBX: length of the argument in bytes.
+  if (cid == kOneByteStringCid) {
+    __ SmiUntag(RDX);
+    __ SmiUntag(RBX);
+  }
+  __ leaq(RSI, FieldAddress(RAX, RDX, TIMES_1, OneByteString::data_offset()));
+  __ leaq(RDI, FieldAddress(RCX, OneByteString::data_offset()));
+  GenerateSkipEqualBytes(assembler, RSI, RDI, RBX, RAX, RDX);
+  __ testq(RBX, RBX);
+  __ j(NOT_ZERO, &is_false, Assembler::kNearJump);
+  __ LoadObject(RAX, Bool::True());
+  __ ret();
+  __ Bind(&is_false);
+  __ LoadObject(RAX, Bool::False());
+  __ ret();
+}
+
+
+bool Intrinsifier::String_substringMatches(Assembler* assembler) {
+  Label fall_through, two_byte;
+  __ movq(RAX, Address(RSP, + 3 * kWordSize));  // This.
+  __ movq(RDX, Address(RSP, + 2 * kWordSize));  // Start.
+  __ movq(RCX, Address(RSP, + 1 * kWordSize));  // Other.
+  __ testq(RDX, Immediate(kSmiTagMask));
+  __ j(NOT_ZERO, &fall_through);
+  __ testq(RCX, Immediate(kSmiTagMask));
+  __ j(ZERO, &fall_through);
+  __ CompareClassId(RAX, kOneByteStringCid);
+  __ j(NOT_EQUAL, &two_byte);
+  GenerateSubstringMatches(assembler, kOneByteStringCid, &fall_through);
+  __ Bind(&two_byte);
+  __ CompareClassId(RAX, kTwoByteStringCid);
+  __ j(NOT_EQUAL, &fall_through);
+  GenerateSubstringMatches(assembler, kTwoByteStringCid, &fall_through);
+  __ Bind(&fall_through);
+  return false;
+}
+
+
+// Searches one-byte strings for the first character of 'other' 16 characters
+// at a time and compares the rest at the candidate positions.
+bool Intrinsifier::String_indexOf(Assembler* assembler) {
+  Label fall_through, scan, scan_tail, candidate, verify, next, not_found;
+  __ movq(RAX, Address(RSP, + 3 * kWordSize));  // This.
+  __ movq(RCX, Address(RSP, + 2 * kWordSize));  // Other.
+  __ movq(RDX, Address(RSP, + 1 * kWordSize));  // Start.
+  __ testq(RDX, Immediate(kSmiTagMask));
+  __ j(NOT_ZERO, &fall_through);
+  __ testq(RCX, Immediate(kSmiTagMask));
+  __ j(ZERO, &fall_through);
+  __ CompareClassId(RAX, kOneByteStringCid);
+  __ j(NOT_EQUAL, &fall_through);
+  __ CompareClassId(RCX, kOneByteStringCid);
+  __ j(NOT_EQUAL, &fall_through);
+  __ movq(RSI, FieldAddress(RCX, String::length_offset()));
+  __ testq(RSI, RSI);
+  __ j(ZERO, &fall_through);
+  __ cmpq(RDX, Immediate(0));
+  __ j(LESS, &fall_through);
+  // RBX: one past the last index at which 'other' fits into this string.
+  __ movq(RBX, FieldAddress(RAX, String::length_offset()));
+  __ subq(RBX, RSI);
+  __ SmiUntag(RBX);
+  __ incq(RBX);
+  __ SmiUntag(RDX);
+  __ SmiUntag(RSI);
+  // XMM2: first character of 'other' in every byte.
+  __ movzxb(RDI, FieldAddress(RCX, OneByteString::data_offset()));
+  __ imull(RDI, Immediate(0x01010101));
+  __ movd(XMM2, RDI);
+  __ shufps(XMM2, XMM2, Immediate(0));
+  __ leaq(RAX, FieldAddress(RAX, OneByteString::data_offset()));
+  __ leaq(RCX, FieldAddress(RCX, OneByteString::data_offset()));
+  // RAX: characters of this string.
+  // RCX: characters of 'other'.
+  // RSI: length of 'other'.
+  // RDX: next index to look at.
+  // RBX: end of the indices to look at.
+  __ Bind(&scan);
+  __ movq(RDI, RBX);
+  __ subq(RDI, RDX);
+  __ cmpq(RDI, Immediate(16));
+  __ j(LESS, &scan_tail, Assembler::kNearJump);
+  // All 16 indices are candidates inside this string.
+  __ movups(XMM0, Address(RAX, RDX, TIMES_1, 0));
+  __ pcmpeqb(XMM0, XMM2);
+  __ pmovmskb(RDI, XMM0);
+  __ testq(RDI, RDI);
+  __ j(NOT_ZERO, &candidate, Assembler::kNearJump);
+  __ addq(RDX, Immediate(16));
+  __ jmp(&scan, Assembler::kNearJump);
+
+  __ Bind(&candidate);
+  __ bsfl(RDI, RDI);
+  __ addq(RDX, RDI);
+  __ jmp(&verify, Assembler::kNearJump);
+
+  // Fewer than 16 indices are left, verify each of them.
+  __ Bind(&scan_tail);
+  __ cmpq(RDX, RBX);
+  __ j(GREATER_EQUAL, &not_found);
+
+  __ Bind(&verify);
+  __ leaq(R8, Address(RAX, RDX, TIMES_1, 0));
+  __ movq(R9, RCX);
+  __ movq(R12, RSI);
+  GenerateSkipEqualBytes(assembler, R8, R9, R12, RDI, R13);
+  __ testq(R12, R12);
+  __ j(NOT_ZERO, &next);
+  __ movq(RAX, RDX);
+  __ SmiTag(RAX);
+  __ ret();
+  __ Bind(&next);
+  __ incq(RDX);
+  __ jmp(&scan);
+
+  __ Bind(&not_found);
+  __ movq(RAX, Immediate(Smi::RawValue(-1)));
+  __ ret();
+  __ Bind(&fall_through);
+  return false;
+}
+
+
 bool Intrinsifier::OneByteString_getHashCode(Assembler* assembler) {
   Label compute_hash;
   __ movq(RBX, Address(RSP, + 1 * kWordSize));  // OneByteString object.
@@ -25,6 +25,7 @@
 #include "vm/thread.h"
 #include "vm/timer.h"
 #include "vm/visitor.h"
+#include "vm/zone.h"
 
 namespace dart {
 
@@ -87,7 +88,7 @@ void IsolateMessageHandler::MessageNotify(Message::Priority priority) {
 
 bool IsolateMessageHandler::HandleMessage(Message* message) {
   StartIsolateScope start_scope(isolate_);
-  StackZone zone(isolate_);
+  StackZone zone(isolate_, Zone::kMessage);
   HandleScope handle_scope(isolate_);
 
   // If the message is in band we lookup the receive port to dispatch to.  If
@@ -341,6 +342,16 @@ void DeferredObject::Materialize() {
                  field_count_);
   }
 
+  if (cls.id() == kArrayCid) {
+    object_ = &Instance::ZoneHandle(MaterializeArray(cls));
+    return;
+  }
+
+  if (cls.IsSignatureClass()) {
+    object_ = &Instance::ZoneHandle(MaterializeClosure(cls));
+    return;
+  }
+
   const Instance& obj = Instance::ZoneHandle(Instance::New(cls));
 
   Field& field = Field::Handle();
@@ -361,6 +372,66 @@ void DeferredObject::Materialize() {
 }
 
 
+RawInstance* DeferredObject::MaterializeArray(const Class& cls) {
+  Smi& length = Smi::Handle();
+  length ^= GetLength();
+  const Array& array = Array::Handle(Array::New(length.Value()));
+
+  Smi& offset = Smi::Handle();
+  Object& value = Object::Handle();
+  AbstractTypeArguments& type_arguments = AbstractTypeArguments::Handle();
+  for (intptr_t i = 0; i < field_count_; i++) {
+    offset ^= GetField(i);
+    value = GetValue(i);
+    if (offset.Value() == Array::type_arguments_offset()) {
+      type_arguments ^= value.raw();
+      array.SetTypeArguments(type_arguments);
+    } else {
+      const intptr_t index =
+          (offset.Value() - Array::data_offset()) / kWordSize;
+      array.SetAt(index, value);
+    }
+
+    if (FLAG_trace_deoptimization_verbose) {
+      OS::PrintErr("    [%"Pd"] <- %s\n", offset.Value(), value.ToCString());
+    }
+  }
+
+  return array.raw();
+}
+
+
+RawInstance* DeferredObject::MaterializeClosure(const Class& cls) {
+  Smi& offset = Smi::Handle();
+  Object& value = Object::Handle();
+  Function& function = Function::Handle();
+  Context& context = Context::Handle();
+  AbstractTypeArguments& type_arguments = AbstractTypeArguments::Handle();
+  for (intptr_t i = 0; i < field_count_; i++) {
+    offset ^= GetField(i);
+    value = GetValue(i);
+    if (offset.Value() == Closure::function_offset()) {
+      function ^= value.raw();
+    } else if (offset.Value() == Closure::context_offset()) {
+      context ^= value.raw();
+    } else {
+      ASSERT(offset.Value() == Closure::type_arguments_offset());
+      type_arguments ^= value.raw();
+    }
+
+    if (FLAG_trace_deoptimization_verbose) {
+      OS::PrintErr("    [%"Pd"] <- %s\n", offset.Value(), value.ToCString());
+    }
+  }
+
+  ASSERT(!function.IsNull());
+  ASSERT(function.signature_class() == cls.raw());
+  const Instance& closure = Instance::Handle(Closure::New(function, context));
+  Closure::SetTypeArguments(closure, type_arguments);
+  return closure.raw();
+}
+
+
 Isolate::Isolate()
     : store_buffer_(),
       message_notify_callback_(NULL),
@@ -381,6 +452,7 @@ Isolate::Isolate()
       timer_list_(),
       deopt_id_(0),
       ic_data_array_(Array::null()),
+      compilation_depth_(0),
       mutex_(new Mutex()),
       stack_limit_(0),
       saved_stack_limit_(0),
@@ -399,7 +471,8 @@ Isolate::Isolate()
       deferred_objects_count_(0),
       deferred_objects_(NULL),
       stacktrace_(NULL),
-      stack_frame_index_(-1) {
+      stack_frame_index_(-1),
+      zone_segment_cache_(new ZoneSegmentCache()) {
 }
 
 
@@ -417,8 +490,16 @@ Isolate::~Isolate() {
   mutex_ = NULL;  // Fail fast if interrupts are scheduled on a dead isolate.
   delete message_handler_;
   message_handler_ = NULL;  // Fail fast if we send messages to a dead isolate.
+  // Zones released above may still have returned segments to the cache.
+  delete zone_segment_cache_;
+  zone_segment_cache_ = NULL;
 }
 
+void Isolate::TrimZoneSegmentCache() {
+  zone_segment_cache_->Trim();
+}
+
+
 void Isolate::SetCurrent(Isolate* current) {
   Thread::SetThreadLocal(isolate_key, reinterpret_cast<uword>(current));
 }
@@ -777,6 +858,8 @@ void Isolate::Shutdown() {
     HandleScope handle_scope(this);
     heap()->PrintSizes();
     megamorphic_cache_table()->PrintSizes();
+    dispatch_table()->PrintSizes();
+    zone_segment_cache()->PrintStats();
     Symbols::DumpStats();
     OS::Print("[-] Stopping isolate:\n"
               "\tisolate:    %s\n", name());
@@ -813,6 +896,9 @@ void Isolate::VisitObjectPointers(ObjectPointerVisitor* visitor,
   // Visit objects in the megamorphic cache.
   megamorphic_cache_table()->VisitObjectPointers(visitor);
 
+  // Visit objects in the dispatch table.
+  dispatch_table()->VisitObjectPointers(visitor);
+
   // Visit objects in per isolate stubs.
   StubCode::VisitObjectPointers(visitor);
 
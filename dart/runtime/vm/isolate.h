@@ -10,6 +10,7 @@
 #include "platform/thread.h"
 #include "vm/base_isolate.h"
 #include "vm/class_table.h"
+#include "vm/dispatch_table.h"
 #include "vm/gc_callbacks.h"
 #include "vm/megamorphic_cache_table.h"
 #include "vm/store_buffer.h"
@@ -45,6 +46,7 @@ class StackResource;
 class StackZone;
 class StubCode;
 class RawFloat32x4;
+class ZoneSegmentCache;
 class RawUint32x4;
 
 
@@ -176,7 +178,8 @@ class DeferredObject {
  private:
   enum {
     kClassIndex = 0,
-    kFieldsStartIndex = kClassIndex + 1
+    kLengthIndex,  // Number of elements for arrays.
+    kFieldsStartIndex
   };
 
   enum {
@@ -190,10 +193,20 @@ class DeferredObject {
   // deoptimization.
   void Materialize();
 
+  // Helpers for Materialize: fill an array or a closure whose slots are
+  // described by Smi offsets instead of Fields.
+  RawInstance* MaterializeArray(const Class& cls);
+  RawInstance* MaterializeClosure(const Class& cls);
+
   RawObject* GetClass() const {
     return args_[kClassIndex];
   }
 
+  RawObject* GetLength() const {
+    return args_[kLengthIndex];
+  }
+
+  // Returns either a Field or a Smi containing the offset of the slot.
   RawObject* GetField(intptr_t index) const {
     return args_[kFieldsStartIndex + kFieldEntrySize * index + kFieldIndex];
   }
@@ -207,7 +220,7 @@ class DeferredObject {
 
   // Pointer to the first materialization argument on the stack.
   // The first argument is Class of the instance to materialize followed by
-  // Field, value pairs.
+  // the length of the array (Smi) and slot, value pairs.
   RawObject** args_;
 
   // Object materialized from this description.
@@ -253,6 +266,7 @@ class Isolate : public BaseIsolate {
   MegamorphicCacheTable* megamorphic_cache_table() {
     return &megamorphic_cache_table_;
   }
+  DispatchTable* dispatch_table() { return &dispatch_table_; }
 
   Dart_MessageNotifyCallback message_notify_callback() const {
     return message_notify_callback_;
@@ -299,6 +313,12 @@ class Isolate : public BaseIsolate {
   StubCode* stub_code() const { return stub_code_; }
   void set_stub_code(StubCode* value) { stub_code_ = value; }
 
+  ZoneSegmentCache* zone_segment_cache() const { return zone_segment_cache_; }
+
+  // Releases the zone segments that were not reused since the last call.
+  // Called whenever the isolate is exited.
+  void TrimZoneSegmentCache();
+
   LongJump* long_jump_base() const { return long_jump_base_; }
   void set_long_jump_base(LongJump* value) { long_jump_base_ = value; }
 
@@ -409,6 +429,14 @@ class Isolate : public BaseIsolate {
   void set_ic_data_array(RawArray* value) { ic_data_array_ = value; }
   ICData* GetICDataForDeoptId(intptr_t deopt_id) const;
 
+  // Number of function compilations in progress. Code aging does not drop
+  // code while the compiler may refer to it.
+  intptr_t compilation_depth() const { return compilation_depth_; }
+  void set_compilation_depth(intptr_t value) {
+    ASSERT(value >= 0);
+    compilation_depth_ = value;
+  }
+
   Mutex* mutex() const { return mutex_; }
 
   Debugger* debugger() const { return debugger_; }
@@ -598,6 +626,7 @@ class Isolate : public BaseIsolate {
   StoreBuffer store_buffer_;
   ClassTable class_table_;
   MegamorphicCacheTable megamorphic_cache_table_;
+  DispatchTable dispatch_table_;
   Dart_MessageNotifyCallback message_notify_callback_;
   char* name_;
   int64_t start_time_;
@@ -616,6 +645,7 @@ class Isolate : public BaseIsolate {
   TimerList timer_list_;
   intptr_t deopt_id_;
   RawArray* ic_data_array_;
+  intptr_t compilation_depth_;
   Mutex* mutex_;  // protects stack_limit_ and saved_stack_limit_.
   uword stack_limit_;
   uword saved_stack_limit_;
@@ -641,6 +671,8 @@ class Isolate : public BaseIsolate {
   char* stacktrace_;
   intptr_t stack_frame_index_;
 
+  ZoneSegmentCache* zone_segment_cache_;
+
   static Dart_IsolateCreateCallback create_callback_;
   static Dart_IsolateInterruptCallback interrupt_callback_;
   static Dart_IsolateUnhandledExceptionCallback unhandled_exception_callback_;
@@ -671,6 +703,7 @@ class StartIsolateScope {
   ~StartIsolateScope() {
     if (saved_isolate_ != new_isolate_) {
       new_isolate_->SetStackLimit(~static_cast<uword>(0));
+      new_isolate_->TrimZoneSegmentCache();
       Isolate::SetCurrent(saved_isolate_);
     }
   }
@@ -23,6 +23,7 @@ enum Representation {
   kUnboxedMint,
   kUnboxedFloat32x4,
   kUnboxedUint32x4,
+  kUnboxedUint32,
   kNumRepresentations
 };
 
@@ -335,15 +336,20 @@ class Location : public ValueObject {
 
 class RegisterSet : public ValueObject {
  public:
-  RegisterSet() : cpu_registers_(0), fpu_registers_(0) {
+  RegisterSet()
+      : cpu_registers_(0), untagged_cpu_registers_(0), fpu_registers_(0) {
     ASSERT(kNumberOfCpuRegisters <= (kWordSize * kBitsPerByte));
     ASSERT(kNumberOfFpuRegisters <= (kWordSize * kBitsPerByte));
   }
 
 
-  void Add(Location loc) {
+  void Add(Location loc, Representation rep = kTagged) {
     if (loc.IsRegister()) {
       cpu_registers_ |= (1 << loc.reg());
+      if (rep != kTagged) {
+        // CPU register holds an untagged value.
+        untagged_cpu_registers_ |= (1 << loc.reg());
+      }
     } else if (loc.IsFpuRegister()) {
       fpu_registers_ |= (1 << loc.fpu_reg());
     }
@@ -352,6 +358,7 @@ class RegisterSet : public ValueObject {
   void Remove(Location loc) {
     if (loc.IsRegister()) {
       cpu_registers_ &= ~(1 << loc.reg());
+      untagged_cpu_registers_ &= ~(1 << loc.reg());
     } else if (loc.IsFpuRegister()) {
       fpu_registers_ &= ~(1 << loc.fpu_reg());
     }
@@ -361,6 +368,13 @@ class RegisterSet : public ValueObject {
     return (cpu_registers_ & (1 << reg)) != 0;
   }
 
+  // Returns true if the register holds a tagged value that the GC has to
+  // visit when the registers are saved on the stack at a safepoint.
+  bool IsTagged(Register reg) const {
+    ASSERT(ContainsRegister(reg));
+    return (untagged_cpu_registers_ & (1 << reg)) == 0;
+  }
+
   bool ContainsFpuRegister(FpuRegister fpu_reg) const {
     return (fpu_registers_ & (1 << fpu_reg)) != 0;
   }
@@ -380,6 +394,7 @@ class RegisterSet : public ValueObject {
 
  private:
   intptr_t cpu_registers_;
+  intptr_t untagged_cpu_registers_;
   intptr_t fpu_registers_;
 
   DISALLOW_COPY_AND_ASSIGN(RegisterSet);
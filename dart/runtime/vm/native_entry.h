@@ -48,7 +48,7 @@ typedef void (*NativeFunction)(NativeArguments* arguments);
     ASSERT(arguments->NativeArgCount() == argument_count);                     \
     if (FLAG_trace_natives) OS::Print("Calling native: %s\n", ""#name);        \
     {                                                                          \
-      StackZone zone(arguments->isolate());                                    \
+      StackZone zone(arguments->isolate(), Zone::kNativeCall);                 \
       HANDLESCOPE(arguments->isolate());                                       \
       SET_NATIVE_RETVAL(arguments,                                             \
                         DN_Helper##name(arguments->isolate(), arguments));     \
@@ -49,6 +49,15 @@ DEFINE_FLAG(int, huge_method_cutoff_in_tokens, 20000,
     "Huge method cutoff in tokens: Disables optimizations for huge methods.");
 DEFINE_FLAG(int, huge_method_cutoff_in_code_size, 200000,
     "Huge method cutoff in unoptimized code size (in bytes).");
+DEFINE_FLAG(int, ic_data_hash_threshold, 8,
+    "Number of receiver classes at which an inline cache is looked up through "
+    "a hash index of its checks.");
+DEFINE_FLAG(int, class_member_index_threshold, 16,
+    "Number of functions and fields at which the members of a class are "
+    "looked up by name through a hash index.");
+DEFINE_FLAG(int, max_cached_instantiations, 8,
+    "Maximum number of instantiations cached per uninstantiated type argument "
+    "vector.");
 DECLARE_FLAG(bool, trace_compiler);
 DECLARE_FLAG(bool, eliminate_type_checks);
 DECLARE_FLAG(bool, enable_type_checks);
@@ -819,6 +828,11 @@ RawError* Object::Init(Isolate* isolate) {
   RegisterPrivateClass(cls, Symbols::ExternalTwoByteString(), core_lib);
   pending_classes.Add(cls, Heap::kOld);
 
+  cls = Class::NewStringClass(kConsStringCid);
+  object_store->set_cons_string_class(cls);
+  RegisterPrivateClass(cls, Symbols::ConsString(), core_lib);
+  pending_classes.Add(cls, Heap::kOld);
+
   cls = Class::New<Stacktrace>();
   object_store->set_stacktrace_class(cls);
   RegisterClass(cls, Symbols::StackTrace(), core_lib);
@@ -1132,6 +1146,9 @@ void Object::InitFromSnapshot(Isolate* isolate) {
   cls = Class::NewStringClass(kExternalTwoByteStringCid);
   object_store->set_external_two_byte_string_class(cls);
 
+  cls = Class::NewStringClass(kConsStringCid);
+  object_store->set_cons_string_class(cls);
+
   cls = Class::New<Bool>();
   object_store->set_bool_class(cls);
 
@@ -1302,6 +1319,7 @@ RawString* Class::UserVisibleName() const {
     case kTwoByteStringCid:
     case kExternalOneByteStringCid:
     case kExternalTwoByteStringCid:
+    case kConsStringCid:
       return Symbols::New("String");
     case kArrayCid:
     case kImmutableArrayCid:
@@ -1470,14 +1488,28 @@ void Class::SetFunctions(const Array& value) const {
   }
 #endif
   StorePointer(&raw_ptr()->functions_, value.raw());
+  if (member_index() != Array::null()) {
+    set_member_index(Array::Handle());
+  }
 }
 
 
 void Class::AddFunction(const Function& function) const {
+  const Array& index = Array::Handle(member_index());
   const Array& arr = Array::Handle(functions());
   const Array& new_arr = Array::Handle(Array::Grow(arr, arr.Length() + 1));
   new_arr.SetAt(arr.Length(), function);
   SetFunctions(new_arr);
+  // Keep the member index if the new function fits, see MemberIndex.
+  if (!index.IsNull()) {
+    const Array& flds = Array::Handle(fields());
+    const intptr_t num_members =
+        new_arr.Length() + (flds.IsNull() ? 0 : flds.Length());
+    if ((4 * num_members) <= index.Length()) {
+      AddToMemberIndex(index, function, String::Handle(function.name()));
+      set_member_index(index);
+    }
+  }
 }
 
 
@@ -1790,6 +1822,9 @@ void Class::SetFields(const Array& value) const {
 #endif
   // The value of static fields is already initialized to null.
   StorePointer(&raw_ptr()->fields_, value.raw());
+  if (member_index() != Array::null()) {
+    set_member_index(Array::Handle());
+  }
 }
 
 
@@ -1918,9 +1953,11 @@ RawClass* Class::NewStringClass(intptr_t class_id) {
     instance_size = TwoByteString::InstanceSize();
   } else if (class_id == kExternalOneByteStringCid) {
     instance_size = ExternalOneByteString::InstanceSize();
-  } else {
-    ASSERT(class_id == kExternalTwoByteStringCid);
+  } else if (class_id == kExternalTwoByteStringCid) {
     instance_size = ExternalTwoByteString::InstanceSize();
+  } else {
+    ASSERT(class_id == kConsStringCid);
+    instance_size = ConsString::InstanceSize();
   }
   Class& result = Class::Handle(New<String>(class_id));
   result.set_instance_size(instance_size);
@@ -1997,6 +2034,9 @@ void Class::set_is_finalized() const {
   ASSERT(!is_finalized());
   set_state_bits(StateBits::update(RawClass::kFinalized,
                                    raw_ptr()->state_bits_));
+  if (member_index() != Array::null()) {
+    set_member_index(Array::Handle());
+  }
 }
 
 
@@ -2062,6 +2102,11 @@ void Class::set_canonical_types(const Array& value) const {
 }
 
 
+void Class::set_member_index(const Array& value) const {
+  StorePointer(&raw_ptr()->member_index_, value.raw());
+}
+
+
 void Class::set_allocation_stub(const Code& value) const {
   ASSERT(!value.IsNull());
   ASSERT(raw_ptr()->allocation_stub_ == Code::null());
@@ -2309,6 +2354,30 @@ RawFunction* Class::LookupFactory(const String& name) const {
 }
 
 
+// Synchronize with implementation in compiler (intrinsifier).
+class StringHasher : ValueObject {
+ public:
+  StringHasher() : hash_(0) {}
+  void Add(int32_t ch) {
+    hash_ += ch;
+    hash_ += hash_ << 10;
+    hash_ ^= hash_ >> 6;
+  }
+  // Return a non-zero hash of at most 'bits' bits.
+  intptr_t Finalize(int bits) {
+    ASSERT(1 <= bits && bits <= (kBitsPerWord - 1));
+    hash_ += hash_ << 3;
+    hash_ ^= hash_ >> 11;
+    hash_ += hash_ << 15;
+    hash_ = hash_ & ((static_cast<intptr_t>(1) << bits) - 1);
+    ASSERT(hash_ <= static_cast<uint32_t>(kMaxInt32));
+    return hash_ == 0 ? 1 : hash_;
+  }
+ private:
+  uint32_t hash_;
+};
+
+
 // Returns true if 'prefix' and 'accessor_name' match 'name'.
 static bool MatchesAccessorName(const String& name,
                                 const char* prefix,
@@ -2334,14 +2403,163 @@ static bool MatchesAccessorName(const String& name,
 }
 
 
+// Returns the hash of 'prefix' followed by 'name', leaving out the private
+// keys in 'name' if 'ignore_private_key' is true, so that it equals the hash
+// of the corresponding string (see EqualsIgnoringPrivateKey).
+static intptr_t MemberNameHash(const char* prefix,
+                               intptr_t prefix_length,
+                               const String& name,
+                               bool ignore_private_key) {
+  StringHasher hasher;
+  for (intptr_t i = 0; i < prefix_length; i++) {
+    hasher.Add(prefix[i]);
+  }
+  bool in_private_key = false;
+  String::CodePointIterator it(name);
+  while (it.Next()) {
+    const int32_t ch = it.Current();
+    if (ignore_private_key) {
+      if (ch == Scanner::kPrivateKeySeparator) {
+        in_private_key = true;
+        continue;
+      }
+      if (in_private_key && (ch != '.')) {
+        continue;
+      }
+      in_private_key = false;
+    }
+    hasher.Add(ch);
+  }
+  return hasher.Finalize(String::kHashBits);
+}
+
+
+void Class::AddToMemberIndex(const Array& index,
+                             const Object& member,
+                             const String& name) {
+  const intptr_t mask = index.Length() - 1;
+  const intptr_t hash = name.Hash();
+  intptr_t i = hash & mask;
+  while (index.At(i) != Object::null()) {
+    i = (i + 1) & mask;
+  }
+  index.SetAt(i, member);
+  // Lookups ignoring private keys probe with the hash of the unmangled name.
+  const intptr_t unmangled_hash = MemberNameHash(NULL, 0, name, true);
+  if (unmangled_hash != hash) {
+    i = unmangled_hash & mask;
+    while (index.At(i) != Object::null()) {
+      i = (i + 1) & mask;
+    }
+    index.SetAt(i, member);
+  }
+}
+
+
+RawArray* Class::MemberIndex() const {
+  if (member_index() != Array::null()) {
+    return member_index();
+  }
+  Isolate* isolate = Isolate::Current();
+  const Array& funcs = Array::Handle(isolate, functions());
+  const Array& flds = Array::Handle(isolate, fields());
+  const intptr_t num_functions = funcs.IsNull() ? 0 : funcs.Length();
+  const intptr_t num_fields = flds.IsNull() ? 0 : flds.Length();
+  const intptr_t num_members = num_functions + num_fields;
+  if ((num_members == 0) ||
+      (num_members < FLAG_class_member_index_threshold)) {
+    return Array::null();
+  }
+  // Every member may be entered twice.
+  const intptr_t size = Utils::RoundUpToPowerOfTwo(4 * num_members);
+  const Array& index = Array::Handle(isolate, Array::New(size, Heap::kOld));
+  Function& function = Function::Handle(isolate);
+  Field& field = Field::Handle(isolate);
+  String& name = String::Handle(isolate);
+  for (intptr_t i = 0; i < num_functions; i++) {
+    function ^= funcs.At(i);
+    name = function.name();
+    AddToMemberIndex(index, function, name);
+  }
+  for (intptr_t i = 0; i < num_fields; i++) {
+    field ^= flds.At(i);
+    name = field.name();
+    AddToMemberIndex(index, field, name);
+  }
+  set_member_index(index);
+  return index.raw();
+}
+
+
+// The ways in which name based lookups match the members of a class.
+enum MemberLookupKind {
+  kFunctionNamed,                    // Function named 'name'.
+  kFunctionNamedIgnoringPrivateKey,  // Function named 'name' once unmangled.
+  kFieldNamedIgnoringPrivateKey,     // Field named 'name' once unmangled.
+  kAccessorNamed,                    // Function named 'prefix' + 'name'.
+};
+
+
+// Probes the member index of a class, starting at 'hash', for the member
+// matching 'name' (and 'prefix') as specified by 'kind'.
+static RawObject* LookupInMemberIndex(const Array& index,
+                                      intptr_t hash,
+                                      MemberLookupKind kind,
+                                      const char* prefix,
+                                      intptr_t prefix_length,
+                                      const String& name) {
+  Isolate* isolate = Isolate::Current();
+  Object& member = Object::Handle(isolate);
+  String& member_name = String::Handle(isolate);
+  const bool is_field_lookup = (kind == kFieldNamedIgnoringPrivateKey);
+  const intptr_t mask = index.Length() - 1;
+  for (intptr_t i = hash & mask; ; i = (i + 1) & mask) {
+    member = index.At(i);
+    if (member.IsNull()) {
+      return Object::null();
+    }
+    if (member.IsField() != is_field_lookup) {
+      continue;
+    }
+    member_name = is_field_lookup ? Field::Cast(member).name()
+                                  : Function::Cast(member).name();
+    bool matches = false;
+    switch (kind) {
+      case kFunctionNamed:
+        matches = (member_name.raw() == name.raw()) ||
+                  (!name.IsSymbol() && member_name.Equals(name));
+        break;
+      case kFunctionNamedIgnoringPrivateKey:
+      case kFieldNamedIgnoringPrivateKey:
+        matches = String::EqualsIgnoringPrivateKey(member_name, name);
+        break;
+      case kAccessorNamed:
+        matches = MatchesAccessorName(member_name, prefix, prefix_length, name);
+        break;
+    }
+    if (matches) {
+      return member.raw();
+    }
+  }
+  UNREACHABLE();
+  return Object::null();
+}
+
+
 RawFunction* Class::LookupFunction(const String& name) const {
   Isolate* isolate = Isolate::Current();
+  Function& function = Function::Handle(isolate, Function::null());
+  const Array& index = Array::Handle(isolate, MemberIndex());
+  if (!index.IsNull()) {
+    function ^= LookupInMemberIndex(index, name.Hash(), kFunctionNamed,
+                                    NULL, 0, name);
+    return function.raw();
+  }
   Array& funcs = Array::Handle(isolate, functions());
   if (funcs.IsNull()) {
     // This can occur, e.g., for Null classes.
     return Function::null();
   }
-  Function& function = Function::Handle(isolate, Function::null());
   const intptr_t len = funcs.Length();
   if (name.IsSymbol()) {
     // Quick Symbol compare.
@@ -2369,12 +2587,21 @@ RawFunction* Class::LookupFunction(const String& name) const {
 
 RawFunction* Class::LookupFunctionAllowPrivate(const String& name) const {
   Isolate* isolate = Isolate::Current();
+  Function& function = Function::Handle(isolate, Function::null());
+  const Array& index = Array::Handle(isolate, MemberIndex());
+  if (!index.IsNull()) {
+    // A name with a private key only matches itself, and the unmangled name
+    // of a member with private keys is entered into the index as well.
+    function ^= LookupInMemberIndex(index, name.Hash(),
+                                    kFunctionNamedIgnoringPrivateKey,
+                                    NULL, 0, name);
+    return function.raw();
+  }
   Array& funcs = Array::Handle(isolate, functions());
   if (funcs.IsNull()) {
     // This can occur, e.g., for Null classes.
     return Function::null();
   }
-  Function& function = Function::Handle(isolate, Function::null());
   String& function_name = String::Handle(isolate, String::null());
   intptr_t len = funcs.Length();
   for (intptr_t i = 0; i < len; i++) {
@@ -2403,8 +2630,15 @@ RawFunction* Class::LookupAccessorFunction(const char* prefix,
                                            intptr_t prefix_length,
                                            const String& name) const {
   Isolate* isolate = Isolate::Current();
-  Array& funcs = Array::Handle(isolate, functions());
   Function& function = Function::Handle(isolate, Function::null());
+  const Array& index = Array::Handle(isolate, MemberIndex());
+  if (!index.IsNull()) {
+    function ^= LookupInMemberIndex(
+        index, MemberNameHash(prefix, prefix_length, name, false),
+        kAccessorNamed, prefix, prefix_length, name);
+    return function.raw();
+  }
+  Array& funcs = Array::Handle(isolate, functions());
   String& function_name = String::Handle(isolate, String::null());
   intptr_t len = funcs.Length();
   for (intptr_t i = 0; i < len; i++) {
@@ -2474,8 +2708,15 @@ RawField* Class::LookupStaticField(const String& name) const {
 
 RawField* Class::LookupField(const String& name) const {
   Isolate* isolate = Isolate::Current();
-  const Array& flds = Array::Handle(isolate, fields());
   Field& field = Field::Handle(isolate, Field::null());
+  const Array& index = Array::Handle(isolate, MemberIndex());
+  if (!index.IsNull()) {
+    field ^= LookupInMemberIndex(index, name.Hash(),
+                                 kFieldNamedIgnoringPrivateKey,
+                                 NULL, 0, name);
+    return field.raw();
+  }
+  const Array& flds = Array::Handle(isolate, fields());
   String& field_name = String::Handle(isolate, String::null());
   intptr_t len = flds.Length();
   for (intptr_t i = 0; i < len; i++) {
@@ -3038,6 +3279,79 @@ void TypeArguments::SetLength(intptr_t value) const {
 }
 
 
+void TypeArguments::set_instantiations(const Array& value) const {
+  StorePointer(&raw_ptr()->instantiations_, value.raw());
+}
+
+
+intptr_t TypeArguments::NumInstantiations() const {
+  const Array& cache = Array::Handle(instantiations());
+  if (cache.IsNull()) {
+    return 0;
+  }
+  intptr_t num = 0;
+  for (intptr_t i = kInstantiatorIndex;
+       cache.At(i) != Smi::New(kNoInstantiator);
+       i += kInstantiationSizeInWords) {
+    num++;
+  }
+  return num;
+}
+
+
+RawAbstractTypeArguments* TypeArguments::LookupInstantiation(
+    const AbstractTypeArguments& instantiator) const {
+  const Array& cache = Array::Handle(instantiations());
+  if (cache.IsNull()) {
+    return AbstractTypeArguments::null();
+  }
+  for (intptr_t i = 0;
+       cache.At(i + kInstantiatorIndex) != Smi::New(kNoInstantiator);
+       i += kInstantiationSizeInWords) {
+    if (cache.At(i + kInstantiatorIndex) == instantiator.raw()) {
+      return reinterpret_cast<RawAbstractTypeArguments*>(
+          cache.At(i + kInstantiatedIndex));
+    }
+  }
+  return AbstractTypeArguments::null();
+}
+
+
+bool TypeArguments::AddInstantiation(
+    const AbstractTypeArguments& instantiator,
+    const AbstractTypeArguments& instantiated) const {
+  ASSERT(!IsInstantiated());
+  ASSERT(instantiated.IsNull() || instantiated.IsInstantiated());
+  const intptr_t num = NumInstantiations();
+  if (num >= FLAG_max_cached_instantiations) {
+    return false;
+  }
+  Array& cache = Array::Handle(instantiations());
+  // Keep room for the kNoInstantiator terminator.
+  const intptr_t used = num * kInstantiationSizeInWords;
+  if (cache.IsNull() ||
+      (used + kInstantiationSizeInWords >= cache.Length())) {
+    intptr_t capacity = (num == 0) ? 2 : 2 * num;
+    if (capacity > FLAG_max_cached_instantiations) {
+      capacity = FLAG_max_cached_instantiations;
+    }
+    const Array& new_cache = Array::Handle(
+        Array::New(capacity * kInstantiationSizeInWords + 1, Heap::kOld));
+    const Smi& no_instantiator = Smi::Handle(Smi::New(kNoInstantiator));
+    Object& entry = Object::Handle();
+    for (intptr_t i = 0; i < new_cache.Length(); i++) {
+      entry = (i < used) ? cache.At(i) : no_instantiator.raw();
+      new_cache.SetAt(i, entry);
+    }
+    cache = new_cache.raw();
+  }
+  cache.SetAt(used + kInstantiatorIndex, instantiator);
+  cache.SetAt(used + kInstantiatedIndex, instantiated);
+  set_instantiations(cache);
+  return true;
+}
+
+
 static void GrowCanonicalTypeArguments(Isolate* isolate, const Array& table) {
   // Last element of the array is the number of used elements.
   intptr_t table_size = table.Length() - 1;
@@ -3299,6 +3613,15 @@ void Function::SetCode(const Code& value) const {
   ASSERT(Function::Handle(value.function()).IsNull() ||
     (value.function() == this->raw()));
   value.set_function(*this);
+  set_code_age(0);
+}
+
+
+void Function::ClearCode() const {
+  ASSERT(!HasOptimizedCode());
+  StorePointer(&raw_ptr()->code_, Code::null());
+  StorePointer(&raw_ptr()->unoptimized_code_, Code::null());
+  set_code_age(0);
 }
 
 
@@ -3867,6 +4190,48 @@ bool Function::AreValidArguments(int num_arguments,
 }
 
 
+bool Function::AreValidArguments(const ArgumentsDescriptor& args_desc,
+                                 String* error_message) const {
+  const int num_arguments = args_desc.Count();
+  const int num_named_arguments = args_desc.NamedCount();
+  if (!AreValidArgumentCounts(num_arguments,
+                              num_named_arguments,
+                              error_message)) {
+    return false;
+  }
+  // Verify that all argument names are valid parameter names.
+  String& argument_name = String::Handle();
+  String& parameter_name = String::Handle();
+  for (int i = 0; i < num_named_arguments; i++) {
+    argument_name ^= args_desc.NameAt(i);
+    ASSERT(argument_name.IsSymbol());
+    bool found = false;
+    const int num_positional_args = num_arguments - num_named_arguments;
+    const int num_parameters = NumParameters();
+    for (int j = num_positional_args; !found && (j < num_parameters); j++) {
+      parameter_name = ParameterNameAt(j);
+      ASSERT(argument_name.IsSymbol());
+      if (argument_name.Equals(parameter_name)) {
+        found = true;
+      }
+    }
+    if (!found) {
+      if (error_message != NULL) {
+        const intptr_t kMessageBufferSize = 64;
+        char message_buffer[kMessageBufferSize];
+        OS::SNPrint(message_buffer,
+                    kMessageBufferSize,
+                    "no optional formal parameter named '%s'",
+                    argument_name.ToCString());
+        *error_message = String::New(message_buffer);
+      }
+      return false;
+    }
+  }
+  return true;
+}
+
+
 // Helper allocating a C string buffer in the zone, printing the fully qualified
 // name of a function in it, and replacing ':' by '_' to make sure the
 // constructed name is a valid C++ identifier for debugging purpose.
@@ -4175,6 +4540,7 @@ RawFunction* Function::New(const String& name,
   result.set_num_fixed_parameters(0);
   result.set_num_optional_parameters(0);
   result.set_usage_counter(0);
+  result.set_code_age(0);
   result.set_deoptimization_counter(0);
   result.set_optimized_instruction_count(0);
   result.set_optimized_call_site_count(0);
@@ -4201,6 +4567,7 @@ RawFunction* Function::Clone(const Class& new_owner) const {
   clone.StorePointer(&clone.raw_ptr()->code_, Code::null());
   clone.StorePointer(&clone.raw_ptr()->unoptimized_code_, Code::null());
   clone.set_usage_counter(0);
+  clone.set_code_age(0);
   clone.set_deoptimization_counter(0);
   clone.set_optimized_instruction_count(0);
   clone.set_optimized_call_site_count(0);
@@ -4938,6 +5305,9 @@ void Field::UpdateCid(intptr_t cid) const {
     // Field is assigned first time.
     set_guarded_cid(cid);
     set_is_nullable(cid == kNullCid);
+    // Optimized code that loads the field before its first assignment does
+    // not expect the field to be unboxed.
+    DeoptimizeDependentCode();
     return;
   }
 
@@ -7095,6 +7465,7 @@ const char* PcDescriptors::KindAsStr(intptr_t index) const {
     case PcDescriptors::kEntryPatch:    return "entry-patch  ";
     case PcDescriptors::kPatchCode:     return "patch        ";
     case PcDescriptors::kLazyDeoptJump: return "lazy-deopt   ";
+    case PcDescriptors::kMonomorphicEntry: return "mono-entry   ";
     case PcDescriptors::kIcCall:        return "ic-call      ";
     case PcDescriptors::kFuncCall:      return "fn-call      ";
     case PcDescriptors::kClosureCall:   return "closure-call ";
@@ -7402,11 +7773,13 @@ intptr_t ExceptionHandlers::Length() const {
 
 void ExceptionHandlers::SetHandlerInfo(intptr_t try_index,
                                        intptr_t outer_try_index,
-                                       intptr_t handler_pc) const {
+                                       intptr_t handler_pc,
+                                       bool needs_stacktrace) const {
   ASSERT((try_index >= 0) && (try_index < Length()));
   RawExceptionHandlers::HandlerInfo* info = &raw_ptr()->data_[try_index];
   info->outer_try_index = outer_try_index;
   info->handler_pc = handler_pc;
+  info->needs_stacktrace = needs_stacktrace;
 }
 
 void ExceptionHandlers::GetHandlerInfo(
@@ -7417,6 +7790,7 @@ void ExceptionHandlers::GetHandlerInfo(
   RawExceptionHandlers::HandlerInfo* data = &raw_ptr()->data_[try_index];
   info->outer_try_index = data->outer_try_index;
   info->handler_pc = data->handler_pc;
+  info->needs_stacktrace = data->needs_stacktrace;
 }
 
 
@@ -7432,6 +7806,12 @@ intptr_t ExceptionHandlers::OuterTryIndex(intptr_t try_index) const {
 }
 
 
+bool ExceptionHandlers::NeedsStacktrace(intptr_t try_index) const {
+  ASSERT((try_index >= 0) && (try_index < Length()));
+  return raw_ptr()->data_[try_index].needs_stacktrace != 0;
+}
+
+
 void ExceptionHandlers::SetHandledTypes(intptr_t try_index,
                                         const Array& handled_types) const {
   ASSERT((try_index >= 0) && (try_index < Length()));
@@ -7958,6 +8338,12 @@ uword Code::GetLazyDeoptPc() const {
 }
 
 
+uword Code::GetMonomorphicEntryPc() const {
+  const PcDescriptors& descriptors = PcDescriptors::Handle(pc_descriptors());
+  return descriptors.GetPcForKind(PcDescriptors::kMonomorphicEntry);
+}
+
+
 bool Code::ObjectExistsInArea(intptr_t start_offset,
                               intptr_t end_offset) const {
   for (intptr_t i = 0; i < this->pointer_offsets_length(); i++) {
@@ -8236,6 +8622,16 @@ void ICData::set_ic_data(const Array& value) const {
 }
 
 
+void ICData::set_ic_data_hash(const Array& value) const {
+  StorePointer(&raw_ptr()->ic_data_hash_, value.raw());
+}
+
+
+void ICData::set_num_checks(intptr_t value) const {
+  raw_ptr()->num_checks_ = value;
+}
+
+
 void ICData::set_deopt_reason(intptr_t deopt_reason) const {
   raw_ptr()->deopt_reason_ = deopt_reason;
 }
@@ -8256,17 +8652,90 @@ intptr_t ICData::TestEntryLength() const {
 
 
 intptr_t ICData::NumberOfChecks() const {
-  // Do not count the sentinel;
-  return (Array::Handle(ic_data()).Length() / TestEntryLength()) - 1;
+  return raw_ptr()->num_checks_;
 }
 
 
+// Fills the IC data array with sentinel entries from the first unused entry.
 void ICData::WriteSentinel() const {
   const Smi& sentinel_value = Smi::Handle(Smi::New(kIllegalCid));
   const Array& data = Array::Handle(ic_data());
-  for (intptr_t i = 1; i <= TestEntryLength(); i++) {
-    data.SetAt(data.Length() - i, sentinel_value);
+  for (intptr_t i = NumberOfChecks() * TestEntryLength();
+       i < data.Length();
+       i++) {
+    data.SetAt(i, sentinel_value);
+  }
+}
+
+
+intptr_t ICData::AddEntry() const {
+  const intptr_t old_num = NumberOfChecks();
+  const intptr_t entry_length = TestEntryLength();
+  Array& data = Array::Handle(ic_data());
+  // Keep at least one sentinel entry after the checks.
+  if ((old_num + 2) * entry_length > data.Length()) {
+    const intptr_t new_len = 2 * data.Length();
+    data = Array::Grow(data, new_len, Heap::kOld);
+    set_ic_data(data);
+    WriteSentinel();
   }
+  set_num_checks(old_num + 1);
+  return old_num * entry_length;
+}
+
+
+intptr_t ICData::FindReceiverCheck(intptr_t class_id) const {
+  ASSERT(num_args_tested() == 1);
+  const Array& hash = Array::Handle(ic_data_hash());
+  if (hash.IsNull()) {
+    const intptr_t len = NumberOfChecks();
+    for (intptr_t i = 0; i < len; i++) {
+      if (GetReceiverClassIdAt(i) == class_id) {
+        return i;
+      }
+    }
+    return -1;
+  }
+  const intptr_t mask = hash.Length() - 1;
+  Smi& slot = Smi::Handle();
+  for (intptr_t i = (class_id & mask); ; i = (i + 1) & mask) {
+    slot ^= hash.At(i);
+    if (slot.Value() == kEmptyHashSlot) {
+      return -1;
+    }
+    const intptr_t index = slot.Value() / TestEntryLength();
+    if (GetReceiverClassIdAt(index) == class_id) {
+      return index;
+    }
+  }
+  UNREACHABLE();
+  return -1;
+}
+
+
+void ICData::AddToHash(const Array& hash, intptr_t index) const {
+  const intptr_t mask = hash.Length() - 1;
+  intptr_t i = GetReceiverClassIdAt(index) & mask;
+  while (Smi::Value(reinterpret_cast<RawSmi*>(hash.At(i))) != kEmptyHashSlot) {
+    i = (i + 1) & mask;
+  }
+  hash.SetAt(i, Smi::Handle(Smi::New(index * TestEntryLength())));
+}
+
+
+void ICData::RehashReceiverChecks() const {
+  ASSERT(num_args_tested() == 1);
+  const intptr_t len = NumberOfChecks();
+  const intptr_t size = Utils::RoundUpToPowerOfTwo(2 * len);
+  const Array& hash = Array::Handle(Array::New(size, Heap::kOld));
+  const Smi& empty = Smi::Handle(Smi::New(kEmptyHashSlot));
+  for (intptr_t i = 0; i < size; i++) {
+    hash.SetAt(i, empty);
+  }
+  for (intptr_t i = 0; i < len; i++) {
+    AddToHash(hash, i);
+  }
+  set_ic_data_hash(hash);
 }
 
 
@@ -8299,13 +8768,8 @@ void ICData::AddCheck(const GrowableArray<intptr_t>& class_ids,
   DEBUG_ASSERT(!HasCheck(class_ids));
   ASSERT(num_args_tested() > 1);  // Otherwise use 'AddReceiverCheck'.
   ASSERT(class_ids.length() == num_args_tested());
-  const intptr_t old_num = NumberOfChecks();
-  Array& data = Array::Handle(ic_data());
-  const intptr_t new_len = data.Length() + TestEntryLength();
-  data = Array::Grow(data, new_len, Heap::kOld);
-  set_ic_data(data);
-  WriteSentinel();
-  intptr_t data_pos = old_num * TestEntryLength();
+  intptr_t data_pos = AddEntry();
+  const Array& data = Array::Handle(ic_data());
   for (intptr_t i = 0; i < class_ids.length(); i++) {
     // kIllegalCid is used as terminating value, do not add it.
     ASSERT(class_ids[i] != kIllegalCid);
@@ -8328,13 +8792,10 @@ void ICData::AddReceiverCheck(intptr_t receiver_class_id,
   ASSERT(num_args_tested() == 1);  // Otherwise use 'AddCheck'.
   ASSERT(receiver_class_id != kIllegalCid);
 
-  const intptr_t old_num = NumberOfChecks();
-  Array& data = Array::Handle(ic_data());
-  const intptr_t new_len = data.Length() + TestEntryLength();
-  data = Array::Grow(data, new_len, Heap::kOld);
-  set_ic_data(data);
-  WriteSentinel();
-  intptr_t data_pos = old_num * TestEntryLength();
+  intptr_t data_pos = AddEntry();
+  const Array& data = Array::Handle(ic_data());
+  const intptr_t new_num = NumberOfChecks();
+  bool moved_check = false;
   if ((receiver_class_id == kSmiCid) && (data_pos > 0)) {
     ASSERT(GetReceiverClassIdAt(0) != kSmiCid);
     // Move class occupying position 0 to the data_pos.
@@ -8343,10 +8804,20 @@ void ICData::AddReceiverCheck(intptr_t receiver_class_id,
     }
     // Insert kSmiCid in position 0.
     data_pos = 0;
+    moved_check = true;
   }
   data.SetAt(data_pos, Smi::Handle(Smi::New(receiver_class_id)));
   data.SetAt(data_pos + 1, target);
   data.SetAt(data_pos + 2, Smi::Handle(Smi::New(count)));
+  if (new_num < FLAG_ic_data_hash_threshold) {
+    return;
+  }
+  const Array& hash = Array::Handle(ic_data_hash());
+  if (hash.IsNull() || moved_check || (2 * new_num > hash.Length())) {
+    RehashReceiverChecks();
+  } else {
+    AddToHash(hash, new_num - 1);
+  }
 }
 
 
@@ -8448,6 +8919,10 @@ intptr_t ICData::AggregateCount() const {
 
 
 RawFunction* ICData::GetTargetForReceiverClassId(intptr_t class_id) const {
+  if (num_args_tested() == 1) {
+    const intptr_t index = FindReceiverCheck(class_id);
+    return (index < 0) ? Function::null() : GetTargetAt(index);
+  }
   const intptr_t len = NumberOfChecks();
   for (intptr_t i = 0; i < len; i++) {
     if (GetReceiverClassIdAt(i) == class_id) {
@@ -8475,14 +8950,7 @@ RawICData* ICData::AsUnaryClassChecksForArgNr(intptr_t arg_nr) const {
   for (intptr_t i = 0; i < len; i++) {
     const intptr_t class_id = GetClassIdAt(i, arg_nr);
     const intptr_t count = GetCountAt(i);
-    intptr_t duplicate_class_id = -1;
-    const intptr_t result_len = result.NumberOfChecks();
-    for (intptr_t k = 0; k < result_len; k++) {
-      if (class_id == result.GetReceiverClassIdAt(k)) {
-        duplicate_class_id = k;
-        break;
-      }
-    }
+    const intptr_t duplicate_class_id = result.FindReceiverCheck(class_id);
     if (duplicate_class_id >= 0) {
       // This check is valid only when checking the receiver.
       ASSERT((arg_nr != 0) ||
@@ -8533,6 +9001,9 @@ bool ICData::AllReceiversAreNumbers() const {
 
 bool ICData::HasReceiverClassId(intptr_t class_id) const {
   ASSERT(num_args_tested() > 0);
+  if (num_args_tested() == 1) {
+    return FindReceiverCheck(class_id) >= 0;
+  }
   const intptr_t len = NumberOfChecks();
   for (intptr_t i = 0; i < len; i++) {
     const intptr_t test_class_id = GetReceiverClassIdAt(i);
@@ -8580,6 +9051,7 @@ RawICData* ICData::New(const Function& function,
   result.set_num_args_tested(num_args_tested);
   result.set_deopt_reason(kDeoptUnknown);
   result.set_is_closure_call(false);
+  result.set_num_checks(0);
   // Number of array elements in one test entry.
   intptr_t len = result.TestEntryLength();
   // IC data array must be null terminated (sentinel entry).
@@ -8716,7 +9188,7 @@ RawSubtypeTestCache* SubtypeTestCache::New() {
     NoGCScope no_gc;
     result ^= raw;
   }
-  const Array& cache = Array::Handle(Array::New(kTestEntryLength));
+  const Array& cache = Array::Handle(NewTable(1));
   result.set_cache(cache);
   return result.raw();
 }
@@ -8727,9 +9199,46 @@ void SubtypeTestCache::set_cache(const Array& value) const {
 }
 
 
+RawArray* SubtypeTestCache::NewTable(intptr_t num_home_entries) {
+  ASSERT(Utils::IsPowerOfTwo(num_home_entries));
+  const intptr_t num_entries = 2 * num_home_entries;
+  const Array& table =
+      Array::Handle(Array::New(num_entries * kTestEntryLength + 1, Heap::kOld));
+  table.SetAt(table.Length() - 1, Smi::Handle(Smi::New(0)));
+  return table.raw();
+}
+
+
+intptr_t SubtypeTestCache::ProbeEmpty(const Array& table, intptr_t class_id) {
+  const intptr_t num_entries = (table.Length() - 1) / kTestEntryLength;
+  const intptr_t mask = (num_entries / 2) - 1;
+  for (intptr_t i = (class_id & mask); i < (num_entries - 1); i++) {
+    const intptr_t data_pos = i * kTestEntryLength;
+    if (table.At(data_pos + kInstanceClassId) == Object::null()) {
+      return data_pos;
+    }
+  }
+  return -1;
+}
+
+
+void SubtypeTestCache::SetEntry(const Array& table,
+                                intptr_t data_pos,
+                                intptr_t class_id,
+                                const Object& instance_type_arguments,
+                                const Object& instantiator_type_arguments,
+                                const Object& test_result) {
+  table.SetAt(data_pos + kInstanceClassId, Smi::Handle(Smi::New(class_id)));
+  table.SetAt(data_pos + kInstanceTypeArguments, instance_type_arguments);
+  table.SetAt(data_pos + kInstantiatorTypeArguments,
+      instantiator_type_arguments);
+  table.SetAt(data_pos + kTestResult, test_result);
+}
+
+
 intptr_t SubtypeTestCache::NumberOfChecks() const {
-  // Do not count the sentinel;
-  return (Array::Handle(cache()).Length() / kTestEntryLength) - 1;
+  const Array& data = Array::Handle(cache());
+  return Smi::Value(reinterpret_cast<RawSmi*>(data.At(data.Length() - 1)));
 }
 
 
@@ -8738,18 +9247,72 @@ void SubtypeTestCache::AddCheck(
     const AbstractTypeArguments& instance_type_arguments,
     const AbstractTypeArguments& instantiator_type_arguments,
     const Bool& test_result) const {
-  intptr_t old_num = NumberOfChecks();
+  const intptr_t old_num = NumberOfChecks();
   Array& data = Array::Handle(cache());
-  intptr_t new_len = data.Length() + kTestEntryLength;
-  data = Array::Grow(data, new_len);
+  intptr_t num_home_entries = (data.Length() - 1) / (2 * kTestEntryLength);
+  intptr_t data_pos = -1;
+  if (old_num < num_home_entries) {
+    data_pos = ProbeEmpty(data, instance_class_id);
+  }
+  // Grow the table until the check fits, keeping at most one check per home
+  // position.
+  Smi& class_id = Smi::Handle();
+  Object& key = Object::Handle();
+  while (data_pos < 0) {
+    num_home_entries *= 2;
+    const Array& new_data = Array::Handle(NewTable(num_home_entries));
+    bool rehashed = true;
+    for (intptr_t i = 0; i < data.Length() - 1; i += kTestEntryLength) {
+      key = data.At(i + kInstanceClassId);
+      if (key.IsNull()) {
+        continue;
+      }
+      class_id ^= key.raw();
+      const intptr_t pos = ProbeEmpty(new_data, class_id.Value());
+      if (pos < 0) {
+        rehashed = false;
+        break;
+      }
+      for (intptr_t j = 0; j < kTestEntryLength; j++) {
+        key = data.At(i + j);
+        new_data.SetAt(pos + j, key);
+      }
+    }
+    if (rehashed) {
+      data = new_data.raw();
+      data_pos = ProbeEmpty(data, instance_class_id);
+    }
+  }
+  SetEntry(data, data_pos, instance_class_id,
+           instance_type_arguments, instantiator_type_arguments, test_result);
+  data.SetAt(data.Length() - 1, Smi::Handle(Smi::New(old_num + 1)));
   set_cache(data);
-  intptr_t data_pos = old_num * kTestEntryLength;
-  data.SetAt(data_pos + kInstanceClassId,
-      Smi::Handle(Smi::New(instance_class_id)));
-  data.SetAt(data_pos + kInstanceTypeArguments, instance_type_arguments);
-  data.SetAt(data_pos + kInstantiatorTypeArguments,
-      instantiator_type_arguments);
-  data.SetAt(data_pos + kTestResult, test_result);
+}
+
+
+bool SubtypeTestCache::HasCheck(
+    intptr_t instance_class_id,
+    const AbstractTypeArguments& instance_type_arguments,
+    const AbstractTypeArguments& instantiator_type_arguments) const {
+  const Array& data = Array::Handle(cache());
+  const intptr_t num_entries = (data.Length() - 1) / kTestEntryLength;
+  const intptr_t mask = (num_entries / 2) - 1;
+  const RawSmi* class_id = Smi::New(instance_class_id);
+  for (intptr_t i = (instance_class_id & mask); i < num_entries; i++) {
+    const intptr_t data_pos = i * kTestEntryLength;
+    const RawObject* key = data.At(data_pos + kInstanceClassId);
+    if (key == Object::null()) {
+      return false;
+    }
+    if ((key == class_id) &&
+        (data.At(data_pos + kInstanceTypeArguments) ==
+         instance_type_arguments.raw()) &&
+        (data.At(data_pos + kInstantiatorTypeArguments) ==
+         instantiator_type_arguments.raw())) {
+      return true;
+    }
+  }
+  return false;
 }
 
 
@@ -8759,8 +9322,18 @@ void SubtypeTestCache::GetCheck(
     AbstractTypeArguments* instance_type_arguments,
     AbstractTypeArguments* instantiator_type_arguments,
     Bool* test_result) const {
+  ASSERT((0 <= ix) && (ix < NumberOfChecks()));
   Array& data = Array::Handle(cache());
-  intptr_t data_pos = ix * kTestEntryLength;
+  // Checks are numbered in table order, skipping empty entries.
+  intptr_t data_pos = 0;
+  intptr_t num_skipped = 0;
+  while (true) {
+    if (data.At(data_pos + kInstanceClassId) != Object::null()) {
+      if (num_skipped == ix) break;
+      num_skipped++;
+    }
+    data_pos += kTestEntryLength;
+  }
   Smi& instance_class_id_handle = Smi::Handle();
   instance_class_id_handle ^= data.At(data_pos + kInstanceClassId);
   *instance_class_id = instance_class_id_handle.Value();
@@ -11062,30 +11635,6 @@ const char* Bigint::ToCString() const {
 }
 
 
-// Synchronize with implementation in compiler (intrinsifier).
-class StringHasher : ValueObject {
- public:
-  StringHasher() : hash_(0) {}
-  void Add(int32_t ch) {
-    hash_ += ch;
-    hash_ += hash_ << 10;
-    hash_ ^= hash_ >> 6;
-  }
-  // Return a non-zero hash of at most 'bits' bits.
-  intptr_t Finalize(int bits) {
-    ASSERT(1 <= bits && bits <= (kBitsPerWord - 1));
-    hash_ += hash_ << 3;
-    hash_ ^= hash_ >> 11;
-    hash_ += hash_ << 15;
-    hash_ = hash_ & ((static_cast<intptr_t>(1) << bits) - 1);
-    ASSERT(hash_ <= static_cast<uint32_t>(kMaxInt32));
-    return hash_ == 0 ? 1 : hash_;
-  }
- private:
-  uint32_t hash_;
-};
-
-
 intptr_t String::Hash(const String& str, intptr_t begin_index, intptr_t len) {
   ASSERT(begin_index >= 0);
   ASSERT(len >= 0);
@@ -11149,6 +11698,9 @@ int32_t String::CharAt(intptr_t index) const {
   if (class_id == kExternalOneByteStringCid) {
     return *ExternalOneByteString::CharAddr(*this, index);
   }
+  if (class_id == kConsStringCid) {
+    return ConsString::CharAt(*this, index);
+  }
   ASSERT(class_id == kExternalTwoByteStringCid);
   return *ExternalTwoByteString::CharAddr(*this, index);
 }
@@ -11159,6 +11711,9 @@ intptr_t String::CharSize() const {
   if (class_id == kOneByteStringCid || class_id == kExternalOneByteStringCid) {
     return kOneByteChar;
   }
+  if (class_id == kConsStringCid) {
+    return ConsString::CharSize(*this);
+  }
   ASSERT(class_id == kTwoByteStringCid ||
          class_id == kExternalTwoByteStringCid);
   return kTwoByteChar;
@@ -11472,6 +12027,22 @@ void String::Copy(const String& dst, intptr_t dst_offset,
   ASSERT(len <= (dst.Length() - dst_offset));
   ASSERT(len <= (src.Length() - src_offset));
   if (len > 0) {
+    if (src.IsConsString()) {
+      NoGCScope no_gc;
+      if (dst.IsOneByteString()) {
+        ConsString::CopyCharacters(OneByteString::CharAddr(dst, dst_offset),
+                                   src.raw(),
+                                   src_offset,
+                                   len);
+      } else {
+        ASSERT(dst.IsTwoByteString());
+        ConsString::CopyCharacters(TwoByteString::CharAddr(dst, dst_offset),
+                                   src.raw(),
+                                   src_offset,
+                                   len);
+      }
+      return;
+    }
     intptr_t char_size = src.CharSize();
     if (char_size == kOneByteChar) {
       if (src.IsOneByteString()) {
@@ -11689,14 +12260,29 @@ RawString* String::MakeExternal(void* array,
   uword tags = raw_ptr()->tags_;
 
   ASSERT(!InVMHeap());
-  if (class_id == kOneByteStringCid) {
+  if (class_id == kConsStringCid) {
+    // A cons string is morphed into an external string of the same character
+    // size, its characters are copied out of the parts below.
+    original_size = ConsString::InstanceSize();
+  }
+  if ((class_id == kOneByteStringCid) ||
+      ((class_id == kConsStringCid) && (CharSize() == kOneByteChar))) {
     used_size = ExternalOneByteString::InstanceSize();
-    original_size = OneByteString::InstanceSize(str_length);
+    if (class_id == kOneByteStringCid) {
+      original_size = OneByteString::InstanceSize(str_length);
+    }
     ASSERT(original_size >= used_size);
 
     // Copy the data into the external array.
     if (str_length > 0) {
-      memmove(array, OneByteString::CharAddr(*this, 0), str_length);
+      if (class_id == kConsStringCid) {
+        ConsString::CopyCharacters(reinterpret_cast<uint8_t*>(array),
+                                   raw(),
+                                   0,
+                                   str_length);
+      } else {
+        memmove(array, OneByteString::CharAddr(*this, 0), str_length);
+      }
     }
 
     // Update the class information of the object.
@@ -11712,16 +12298,25 @@ RawString* String::MakeExternal(void* array,
     ExternalOneByteString::SetExternalData(result, ext_data);
     AddFinalizer(result, ext_data, ExternalOneByteString::Finalize);
   } else {
-    ASSERT(class_id == kTwoByteStringCid);
+    ASSERT((class_id == kTwoByteStringCid) || (class_id == kConsStringCid));
     used_size = ExternalTwoByteString::InstanceSize();
-    original_size = TwoByteString::InstanceSize(str_length);
+    if (class_id == kTwoByteStringCid) {
+      original_size = TwoByteString::InstanceSize(str_length);
+    }
     ASSERT(original_size >= used_size);
 
     // Copy the data into the external array.
     if (str_length > 0) {
-      memmove(array,
-              TwoByteString::CharAddr(*this, 0),
-              (str_length * kTwoByteChar));
+      if (class_id == kConsStringCid) {
+        ConsString::CopyCharacters(reinterpret_cast<uint16_t*>(array),
+                                   raw(),
+                                   0,
+                                   str_length);
+      } else {
+        memmove(array,
+                TwoByteString::CharAddr(*this, 0),
+                (str_length * kTwoByteChar));
+      }
     }
 
     // Update the class information of the object.
@@ -11850,6 +12445,8 @@ static bool EqualsIgnoringPrivateKey(const String& str1,
     case kExternalTwoByteStringCid :                                           \
       return dart::EqualsIgnoringPrivateKey<type, ExternalTwoByteString>(str1, \
                                                                          str2);\
+    case kConsStringCid :                                                      \
+      return dart::EqualsIgnoringPrivateKey<type, ConsString>(str1, str2);     \
   }                                                                            \
   UNREACHABLE();                                                               \
 
@@ -11877,6 +12474,9 @@ bool String::EqualsIgnoringPrivateKey(const String& str1,
       EQUALS_IGNORING_PRIVATE_KEY(str2_class_id,
                                   ExternalTwoByteString, str1, str2);
       break;
+    case kConsStringCid :
+      EQUALS_IGNORING_PRIVATE_KEY(str2_class_id, ConsString, str1, str2);
+      break;
   }
   UNREACHABLE();
   return false;
@@ -12305,6 +12905,195 @@ void ExternalTwoByteString::Finalize(Dart_Handle handle, void* peer) {
 }
 
 
+int32_t ConsString::CharAt(const String& str, intptr_t index) {
+  ASSERT((index >= 0) && (index < str.Length()));
+  ASSERT(str.IsConsString());
+  NoGCScope no_gc;
+  RawString* node = str.raw();
+  intptr_t class_id = kConsStringCid;
+  while (class_id == kConsStringCid) {
+    RawConsString* cons = reinterpret_cast<RawConsString*>(node);
+    node = cons->ptr()->left_;
+    const intptr_t left_length = Smi::Value(node->ptr()->length_);
+    if (index >= left_length) {
+      index -= left_length;
+      node = cons->ptr()->right_;
+    }
+    class_id = node->GetClassId();
+  }
+  switch (class_id) {
+    case kOneByteStringCid:
+      return reinterpret_cast<RawOneByteString*>(node)->ptr()->data_[index];
+    case kTwoByteStringCid:
+      return reinterpret_cast<RawTwoByteString*>(node)->ptr()->data_[index];
+    case kExternalOneByteStringCid:
+      return reinterpret_cast<RawExternalOneByteString*>(node)->
+          ptr()->external_data_->data()[index];
+    case kExternalTwoByteStringCid:
+      return reinterpret_cast<RawExternalTwoByteString*>(node)->
+          ptr()->external_data_->data()[index];
+  }
+  UNREACHABLE();
+  return 0;
+}
+
+
+template<typename T>
+void ConsString::CopyCharacters(T* dst,
+                                RawString* str,
+                                intptr_t offset,
+                                intptr_t len) {
+  ASSERT((offset >= 0) && (len >= 0));
+  ASSERT((offset + len) <= Smi::Value(str->ptr()->length_));
+  // Recurse into the left parts and iterate over the right parts, the
+  // recursion depth is bounded by kMaxDepth.
+  while (len > 0) {
+    switch (str->GetClassId()) {
+      case kOneByteStringCid: {
+        const uint8_t* src =
+            reinterpret_cast<RawOneByteString*>(str)->ptr()->data_ + offset;
+        for (intptr_t i = 0; i < len; i++) {
+          dst[i] = src[i];
+        }
+        return;
+      }
+      case kTwoByteStringCid: {
+        const uint16_t* src =
+            reinterpret_cast<RawTwoByteString*>(str)->ptr()->data_ + offset;
+        for (intptr_t i = 0; i < len; i++) {
+          ASSERT((sizeof(T) == String::kTwoByteChar) ||
+                 Utf::IsLatin1(src[i]));
+          dst[i] = src[i];
+        }
+        return;
+      }
+      case kExternalOneByteStringCid: {
+        const uint8_t* src = reinterpret_cast<RawExternalOneByteString*>(str)->
+            ptr()->external_data_->data() + offset;
+        for (intptr_t i = 0; i < len; i++) {
+          dst[i] = src[i];
+        }
+        return;
+      }
+      case kExternalTwoByteStringCid: {
+        const uint16_t* src = reinterpret_cast<RawExternalTwoByteString*>(str)->
+            ptr()->external_data_->data() + offset;
+        for (intptr_t i = 0; i < len; i++) {
+          ASSERT((sizeof(T) == String::kTwoByteChar) ||
+                 Utf::IsLatin1(src[i]));
+          dst[i] = src[i];
+        }
+        return;
+      }
+      case kConsStringCid: {
+        RawConsString* cons = reinterpret_cast<RawConsString*>(str);
+        RawString* left = cons->ptr()->left_;
+        const intptr_t left_length = Smi::Value(left->ptr()->length_);
+        if (offset < left_length) {
+          const intptr_t count = Utils::Minimum(len, left_length - offset);
+          CopyCharacters(dst, left, offset, count);
+          dst += count;
+          len -= count;
+          offset = 0;
+        } else {
+          offset -= left_length;
+        }
+        str = cons->ptr()->right_;
+        break;
+      }
+      default:
+        UNREACHABLE();
+    }
+  }
+}
+
+
+RawString* ConsString::Operand(const String& str, intptr_t* depth) {
+  *depth = 0;
+  if (!str.IsConsString()) {
+    return str.raw();
+  }
+  if (!IsFlattened(str)) {
+    *depth = Smi::Value(raw_ptr(str)->depth_);
+    if (*depth < kMaxDepth) {
+      return str.raw();
+    }
+  }
+  *depth = 0;
+  return Flatten(str);
+}
+
+
+RawString* ConsString::Concat(const String& str1,
+                              const String& str2,
+                              Heap::Space space) {
+  ASSERT(!str1.IsNull() && !str2.IsNull());
+  const intptr_t len1 = str1.Length();
+  const intptr_t len2 = str2.Length();
+  if ((len1 == 0) || (len2 == 0) ||
+      ((len1 + len2) < kMinLength) ||
+      ((len1 + len2) > String::kMaxElements)) {
+    return String::Concat(str1, str2, space);
+  }
+  intptr_t depth1 = 0;
+  intptr_t depth2 = 0;
+  const String& left = String::Handle(Operand(str1, &depth1));
+  const String& right = String::Handle(Operand(str2, &depth2));
+  const intptr_t char_size = Utils::Maximum(left.CharSize(), right.CharSize());
+  return New(left, right, Utils::Maximum(depth1, depth2) + 1, char_size, space);
+}
+
+
+RawString* ConsString::Flatten(const String& str) {
+  ASSERT(str.IsConsString());
+  if (IsFlattened(str)) {
+    return raw_ptr(str)->left_;
+  }
+  const intptr_t len = str.Length();
+  String& result = String::Handle();
+  if (CharSize(str) == String::kOneByteChar) {
+    result = OneByteString::New(len, Heap::kNew);
+  } else {
+    result = TwoByteString::New(len, Heap::kNew);
+  }
+  String::Copy(result, 0, str, 0, len);
+  if (str.HasHash()) {
+    result.SetHash(str.Hash());
+  }
+  // Drop the parts so that they can be collected.
+  str.StorePointer(&raw_ptr(str)->left_, result.raw());
+  str.StorePointer(&raw_ptr(str)->right_, String::null());
+  raw_ptr(str)->depth_ = Smi::New(0);
+  return result.raw();
+}
+
+
+RawConsString* ConsString::New(const String& left,
+                               const String& right,
+                               intptr_t depth,
+                               intptr_t char_size,
+                               Heap::Space space) {
+  ASSERT(Isolate::Current()->object_store()->cons_string_class() !=
+         Class::null());
+  ASSERT((depth > 0) && (depth <= kMaxDepth));
+  String& result = String::Handle();
+  {
+    RawObject* raw = Object::Allocate(ConsString::kClassId,
+                                      ConsString::InstanceSize(),
+                                      space);
+    NoGCScope no_gc;
+    result ^= raw;
+    result.SetLength(left.Length() + right.Length());
+    result.SetHash(0);
+    raw_ptr(result)->depth_ = Smi::New(depth);
+    raw_ptr(result)->char_size_ = Smi::New(char_size);
+  }
+  result.StorePointer(&raw_ptr(result)->left_, left.raw());
+  result.StorePointer(&raw_ptr(result)->right_, right.raw());
+  return raw(result);
+}
+
+
 RawBool* Bool::New(bool value) {
   ASSERT(Isolate::Current()->object_store()->bool_class() != Class::null());
   Bool& result = Bool::Handle();
@@ -26,6 +26,7 @@ namespace dart {
 CLASS_LIST(DEFINE_FORWARD_DECLARATION)
 #undef DEFINE_FORWARD_DECLARATION
 class Api;
+class ArgumentsDescriptor;
 class Assembler;
 class Closure;
 class Code;
@@ -918,6 +919,24 @@ class Class : public Object {
                                       intptr_t prefix_length,
                                       const String& name) const;
 
+  // Classes with at least --class_member_index_threshold functions and fields
+  // look their members up by name through a hash index. The index is an open
+  // addressed hash table (size a power of two, at most half full) of the
+  // functions and fields, probed starting at the hash of the member name.
+  // Names mangled with a private key are entered a second time under the hash
+  // of the name without the key. The index is built on the first lookup and
+  // dropped whenever the functions or fields are replaced.
+  RawArray* member_index() const { return raw_ptr()->member_index_; }
+  void set_member_index(const Array& value) const;
+  // Returns the member index, building it if needed, or null if the class
+  // has too few members to be indexed.
+  RawArray* MemberIndex() const;
+  // Enters 'member' into 'index' under the hash of 'name' (and under the
+  // hash of 'name' without its private keys).
+  static void AddToMemberIndex(const Array& index,
+                               const Object& member,
+                               const String& name);
+
   // Allocate an instance class which has a VM implementation.
   template <class FakeInstance> static RawClass* New(intptr_t id);
 
@@ -1099,6 +1118,28 @@ class TypeArguments : public AbstractTypeArguments {
     return OFFSET_OF(RawTypeArguments, length_);
   }
 
+  // The instantiations cache of an uninstantiated vector is an array of
+  // (instantiator, instantiated vector) pairs terminated by kNoInstantiator.
+  // It is probed inline by optimized code before calling the runtime.
+  static const intptr_t kNoInstantiator = 0;
+  static const intptr_t kInstantiatorIndex = 0;
+  static const intptr_t kInstantiatedIndex = 1;
+  static const intptr_t kInstantiationSizeInWords = 2;
+
+  RawArray* instantiations() const { return raw_ptr()->instantiations_; }
+  static intptr_t instantiations_offset() {
+    return OFFSET_OF(RawTypeArguments, instantiations_);
+  }
+
+  // Returns the cached instantiation of this vector by 'instantiator', or
+  // null if none is cached.
+  RawAbstractTypeArguments* LookupInstantiation(
+      const AbstractTypeArguments& instantiator) const;
+  // Returns false if the cache is full and the pair was not added.
+  bool AddInstantiation(const AbstractTypeArguments& instantiator,
+                        const AbstractTypeArguments& instantiated) const;
+  intptr_t NumInstantiations() const;
+
   static intptr_t InstanceSize() {
     ASSERT(sizeof(RawTypeArguments) == OFFSET_OF(RawTypeArguments, types_));
     return 0;
@@ -1106,7 +1147,7 @@ class TypeArguments : public AbstractTypeArguments {
 
   static intptr_t InstanceSize(intptr_t len) {
     // Ensure that the types_ is not adding to the object length.
-    ASSERT(sizeof(RawTypeArguments) == (sizeof(RawObject) + (1 * kWordSize)));
+    ASSERT(sizeof(RawTypeArguments) == (sizeof(RawObject) + (2 * kWordSize)));
     ASSERT(0 <= len && len <= kMaxElements);
     return RoundedAllocationSize(
         sizeof(RawTypeArguments) + (len * kBytesPerElement));
@@ -1117,6 +1158,7 @@ class TypeArguments : public AbstractTypeArguments {
  private:
   RawAbstractType** TypeAddr(intptr_t index) const;
   void SetLength(intptr_t value) const;
+  void set_instantiations(const Array& value) const;
 
   FINAL_HEAP_OBJECT_IMPLEMENTATION(TypeArguments, AbstractTypeArguments);
   friend class Class;
@@ -1263,6 +1305,10 @@ class Function : public Object {
   // Sets function's code and code's function.
   void SetCode(const Code& value) const;
 
+  // Drops the unoptimized code of a function that has no optimized code;
+  // the function is compiled again on its next invocation.
+  void ClearCode() const;
+
   // Disables optimized code and switches to unoptimized code.
   void SwitchToUnoptimizedCode() const;
 
@@ -1429,6 +1475,18 @@ class Function : public Object {
     raw_ptr()->usage_counter_ = value;
   }
 
+  // Number of old-space collections since the unoptimized code of this
+  // function was last entered; reset by the function prologue.
+  static intptr_t code_age_offset() {
+    return OFFSET_OF(RawFunction, code_age_);
+  }
+  intptr_t code_age() const {
+    return raw_ptr()->code_age_;
+  }
+  void set_code_age(intptr_t value) const {
+    raw_ptr()->code_age_ = value;
+  }
+
   int16_t deoptimization_counter() const {
     return raw_ptr()->deoptimization_counter_;
   }
@@ -1500,6 +1558,8 @@ class Function : public Object {
   bool AreValidArguments(int num_arguments,
                          const Array& argument_names,
                          String* error_message) const;
+  bool AreValidArguments(const ArgumentsDescriptor& args_desc,
+                         String* error_message) const;
 
   // Fully qualified name uniquely identifying the function under gdb and during
   // ast printing. The special ':' character, if present, is replaced by '_'.
@@ -2432,6 +2492,7 @@ class PcDescriptors : public Object {
     kEntryPatch,       // Location where to patch entry.
     kPatchCode,        // Buffer for patching code entry.
     kLazyDeoptJump,    // Lazy deoptimization trampoline.
+    kMonomorphicEntry, // Entry for monomorphic instance call sites.
     kIcCall,           // IC call.
     kFuncCall,         // Call to known target, e.g. static call.
     kClosureCall,      // Closure call.
@@ -2573,10 +2634,12 @@ class ExceptionHandlers : public Object {
 
   intptr_t HandlerPC(intptr_t try_index) const;
   intptr_t OuterTryIndex(intptr_t try_index) const;
+  bool NeedsStacktrace(intptr_t try_index) const;
 
   void SetHandlerInfo(intptr_t try_index,
                       intptr_t outer_try_index,
-                      intptr_t handler_pc) const;
+                      intptr_t handler_pc,
+                      bool needs_stacktrace) const;
 
   RawArray* GetHandledTypes(intptr_t try_index) const;
   void SetHandledTypes(intptr_t try_index, const Array& handled_types) const;
@@ -2856,6 +2919,8 @@ class Code : public Object {
   // Find pc, return 0 if not found.
   uword GetPatchCodePc() const;
   uword GetLazyDeoptPc() const;
+  // Returns 0 if the code has no entry for monomorphic instance calls.
+  uword GetMonomorphicEntryPc() const;
 
   uword GetPcForDeoptId(intptr_t deopt_id, PcDescriptors::Kind kind) const;
 
@@ -3110,6 +3175,10 @@ class ICData : public Object {
     return OFFSET_OF(RawICData, ic_data_);
   }
 
+  static intptr_t ic_data_hash_offset() {
+    return OFFSET_OF(RawICData, ic_data_hash_);
+  }
+
   static intptr_t function_offset() {
     return OFFSET_OF(RawICData, function_);
   }
@@ -3176,16 +3245,41 @@ class ICData : public Object {
     return (num_args + 1);
   }
 
+  // The checks are stored contiguously in the IC data array, followed by
+  // sentinel entries whose class-ids are kIllegalCid; the array is grown by
+  // doubling its capacity. Once an ICData with one argument tested has
+  // --ic_data_hash_threshold checks, its receiver class-ids are also indexed
+  // by an open addressed hash table (size a power of two, at most half full).
+  // A slot of the hash table holds the offset in words of a check in the IC
+  // data array as a Smi, or kEmptyHashSlot. Probing starts at the receiver
+  // class-id masked with the table size minus one.
+  static const intptr_t kEmptyHashSlot = -1;
+
  private:
   RawArray* ic_data() const {
     return raw_ptr()->ic_data_;
   }
 
+  RawArray* ic_data_hash() const {
+    return raw_ptr()->ic_data_hash_;
+  }
+
   void set_function(const Function& value) const;
   void set_target_name(const String& value) const;
   void set_deopt_id(intptr_t value) const;
   void set_num_args_tested(intptr_t value) const;
   void set_ic_data(const Array& value) const;
+  void set_ic_data_hash(const Array& value) const;
+  void set_num_checks(intptr_t value) const;
+
+  // Returns the position in the IC data array of a new check, growing the
+  // array if needed.
+  intptr_t AddEntry() const;
+  // Returns the index of the check for 'class_id', or -1 if there is none.
+  // Use only for num_args_tested == 1.
+  intptr_t FindReceiverCheck(intptr_t class_id) const;
+  void RehashReceiverChecks() const;
+  void AddToHash(const Array& hash, intptr_t index) const;
 
 #if defined(DEBUG)
   // Used in asserts to verify that a check is not added twice.
@@ -3262,12 +3356,28 @@ class SubtypeTestCache : public Object {
     kTestResult = 3,
     kTestEntryLength  = 4,
   };
+  static const intptr_t kTestEntryLengthLog2 = 2;
+
+  // The cache array is an open addressed hash table of test entries keyed by
+  // instance class id, followed by the number of checks as a Smi. The table
+  // has twice as many entries as home positions. Probing starts at the home
+  // position 'class_id & (NumHomeEntries - 1)' and proceeds linearly without
+  // wrapping around; the last entry is always empty, so a probe stops at the
+  // first entry whose class id is null.
+  // Shifting the Smi length of the cache array right by kHashMaskShift yields
+  // the number of home positions.
+  static const intptr_t kHashMaskShift =
+      kSmiTagShift + kTestEntryLengthLog2 + 1;
 
   intptr_t NumberOfChecks() const;
   void AddCheck(intptr_t class_id,
                 const AbstractTypeArguments& instance_type_arguments,
                 const AbstractTypeArguments& instantiator_type_arguments,
                 const Bool& test_result) const;
+  bool HasCheck(
+      intptr_t class_id,
+      const AbstractTypeArguments& instance_type_arguments,
+      const AbstractTypeArguments& instantiator_type_arguments) const;
   void GetCheck(intptr_t ix,
                 intptr_t* class_id,
                 AbstractTypeArguments* instance_type_arguments,
@@ -3293,6 +3403,17 @@ class SubtypeTestCache : public Object {
 
   intptr_t TestEntryLength() const;
 
+  static RawArray* NewTable(intptr_t num_home_entries);
+  // Returns the position of the first empty entry probed for 'class_id', or
+  // -1 if probing reaches the last entry of the table.
+  static intptr_t ProbeEmpty(const Array& table, intptr_t class_id);
+  static void SetEntry(const Array& table,
+                       intptr_t data_pos,
+                       intptr_t class_id,
+                       const Object& instance_type_arguments,
+                       const Object& instantiator_type_arguments,
+                       const Object& test_result);
+
   FINAL_HEAP_OBJECT_IMPLEMENTATION(SubtypeTestCache, Object);
   friend class Class;
 };
@@ -4295,6 +4416,10 @@ class String : public Instance {
     return raw()->GetClassId() == kExternalTwoByteStringCid;
   }
 
+  bool IsConsString() const {
+    return raw()->GetClassId() == kConsStringCid;
+  }
+
   bool IsExternal() const {
     return RawObject::IsExternalStringClassId(raw()->GetClassId());
   }
@@ -4438,6 +4563,7 @@ class String : public Instance {
   friend class TwoByteString;
   friend class ExternalOneByteString;
   friend class ExternalTwoByteString;
+  friend class ConsString;
 };
 
 
@@ -4543,6 +4669,7 @@ class OneByteString : public AllStatic {
   friend class Class;
   friend class String;
   friend class SnapshotReader;
+  friend class SimpleRegExp;
 };
 
 
@@ -4626,6 +4753,8 @@ class TwoByteString : public AllStatic {
   friend class Class;
   friend class String;
   friend class SnapshotReader;
+  friend class Jscre;
+  friend class SimpleRegExp;
 };
 
 
@@ -4692,6 +4821,7 @@ class ExternalOneByteString : public AllStatic {
   friend class Class;
   friend class String;
   friend class SnapshotReader;
+  friend class SimpleRegExp;
 };
 
 
@@ -4758,6 +4888,93 @@ class ExternalTwoByteString : public AllStatic {
   friend class Class;
   friend class String;
   friend class SnapshotReader;
+  friend class Jscre;
+  friend class SimpleRegExp;
+};
+
+
+// A string created by concatenation whose characters are copied into a flat
+// one or two byte string only when they are first needed. Repeated '+' thus
+// only allocates the small cons cells instead of copying the characters of
+// the growing prefix over and over.
+class ConsString : public AllStatic {
+ public:
+  static int32_t CharAt(const String& str, intptr_t index);
+
+  static intptr_t CharSize(const String& str) {
+    return Smi::Value(raw_ptr(str)->char_size_);
+  }
+
+  // Results shorter than this are cheaper to copy right away.
+  static const intptr_t kMinLength = 13;
+
+  // Bounds the recursion when copying characters out of a cons string. An
+  // operand nested this deep is flattened before being concatenated again.
+  static const intptr_t kMaxDepth = 32;
+
+  static intptr_t InstanceSize() {
+    return String::RoundedAllocationSize(sizeof(RawConsString));
+  }
+
+  // Returns the concatenation of 'str1' and 'str2', which is a cons string if
+  // the result is long enough and a flat string otherwise.
+  static RawString* Concat(const String& str1,
+                           const String& str2,
+                           Heap::Space space = Heap::kNew);
+
+  // Returns a flat string with the characters of 'str' and keeps it in 'str'
+  // so that the characters are copied only once.
+  static RawString* Flatten(const String& str);
+
+  static RawConsString* null() {
+    return reinterpret_cast<RawConsString*>(Object::null());
+  }
+
+  static const ClassId kClassId = kConsStringCid;
+
+ private:
+  static RawConsString* raw(const String& str) {
+    return reinterpret_cast<RawConsString*>(str.raw());
+  }
+
+  static RawConsString* raw_ptr(const String& str) {
+    return reinterpret_cast<RawConsString*>(str.raw_ptr());
+  }
+
+  static bool IsFlattened(const String& str) {
+    return raw_ptr(str)->right_ == String::null();
+  }
+
+  // Returns the string to use as an operand of a new cons string for 'str'
+  // and its depth, flattening 'str' if it is nested too deep.
+  static RawString* Operand(const String& str, intptr_t* depth);
+
+  static RawConsString* New(const String& left,
+                            const String& right,
+                            intptr_t depth,
+                            intptr_t char_size,
+                            Heap::Space space);
+
+  // Copies 'len' characters of 'str' starting at 'offset' to 'dst'.
+  template<typename T>
+  static void CopyCharacters(T* dst,
+                             RawString* str,
+                             intptr_t offset,
+                             intptr_t len);
+
+  // Writes the characters of 'str' to a snapshot as elements of type T.
+  template<typename T>
+  static void WriteCharacters(SnapshotWriter* writer, RawString* str);
+
+  static RawConsString* ReadFrom(SnapshotReader* reader,
+                                 intptr_t object_id,
+                                 intptr_t tags,
+                                 Snapshot::Kind kind);
+
+  friend class Class;
+  friend class String;
+  friend class SnapshotReader;
+  friend class RawConsString;
 };
 
 
@@ -157,6 +157,11 @@ class ObjectStore {
     external_two_byte_string_class_ = value.raw();
   }
 
+  RawClass* cons_string_class() const { return cons_string_class_; }
+  void set_cons_string_class(const Class& value) {
+    cons_string_class_ = value.raw();
+  }
+
   RawType* bool_type() const { return bool_type_; }
   void set_bool_type(const Type& value) { bool_type_ = value.raw(); }
 
@@ -443,6 +448,7 @@ class ObjectStore {
   RawClass* two_byte_string_class_;
   RawClass* external_one_byte_string_class_;
   RawClass* external_two_byte_string_class_;
+  RawClass* cons_string_class_;
   RawType* bool_type_;
   RawClass* bool_class_;
   RawClass* list_class_;
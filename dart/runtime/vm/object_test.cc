@@ -116,6 +116,95 @@ TEST_CASE(Class) {
 }
 
 
+TEST_CASE(ClassMemberIndex) {
+  // A class with enough members to be looked up through the member index.
+  const String& class_name = String::Handle(Symbols::New("ManyMembers"));
+  const Script& script = Script::Handle();
+  const Class& cls = Class::Handle(
+      Class::New(class_name, script, Scanner::kDummyTokenIndex));
+  const intptr_t kNumMembers = 40;
+  const Array& functions = Array::Handle(Array::New(2 * kNumMembers));
+  const Array& fields = Array::Handle(Array::New(kNumMembers + 1));
+  Function& function = Function::Handle();
+  Field& field = Field::Handle();
+  String& name = String::Handle();
+  char buffer[32];
+  for (intptr_t i = 0; i < kNumMembers; i++) {
+    OS::SNPrint(buffer, sizeof(buffer), "m%"Pd"", i);
+    name = Symbols::New(buffer);
+    function = Function::New(name, RawFunction::kRegularFunction,
+                             false, false, false, false, cls, 0);
+    functions.SetAt(i, function);
+    OS::SNPrint(buffer, sizeof(buffer), "get:f%"Pd"", i);
+    name = Symbols::New(buffer);
+    function = Function::New(name, RawFunction::kGetterFunction,
+                             false, false, false, false, cls, 0);
+    functions.SetAt(kNumMembers + i, function);
+    OS::SNPrint(buffer, sizeof(buffer), "f%"Pd"", i);
+    name = Symbols::New(buffer);
+    field = Field::New(name, false, false, false, cls, 0);
+    fields.SetAt(i, field);
+  }
+  name = Symbols::New("_p@12345");
+  field = Field::New(name, true, false, false, cls, 0);
+  fields.SetAt(kNumMembers, field);
+  cls.SetFunctions(functions);
+  cls.SetFields(fields);
+
+  for (intptr_t i = 0; i < kNumMembers; i++) {
+    OS::SNPrint(buffer, sizeof(buffer), "m%"Pd"", i);
+    name = Symbols::New(buffer);
+    function = cls.LookupFunction(name);
+    EXPECT_EQ(functions.At(i), function.raw());
+    name = String::New(buffer);
+    function = cls.LookupDynamicFunction(name);
+    EXPECT_EQ(functions.At(i), function.raw());
+    function = cls.LookupStaticFunction(name);
+    EXPECT(function.IsNull());
+    field = cls.LookupField(name);
+    EXPECT(field.IsNull());
+    OS::SNPrint(buffer, sizeof(buffer), "f%"Pd"", i);
+    name = String::New(buffer);
+    function = cls.LookupGetterFunction(name);
+    EXPECT_EQ(functions.At(kNumMembers + i), function.raw());
+    function = cls.LookupSetterFunction(name);
+    EXPECT(function.IsNull());
+    function = cls.LookupFunction(name);
+    EXPECT(function.IsNull());
+    field = cls.LookupField(name);
+    EXPECT_EQ(fields.At(i), field.raw());
+  }
+  name = String::New("_p");
+  field = cls.LookupField(name);
+  EXPECT_EQ(fields.At(kNumMembers), field.raw());
+  name = String::New("_p@12345");
+  field = cls.LookupField(name);
+  EXPECT_EQ(fields.At(kNumMembers), field.raw());
+  name = String::New("_p@54321");
+  field = cls.LookupField(name);
+  EXPECT(field.IsNull());
+  name = String::New("m40");
+  function = cls.LookupFunction(name);
+  EXPECT(function.IsNull());
+
+  // Added functions are found, and replaced fields are no longer found.
+  name = Symbols::New("_added@12345");
+  function = Function::New(name, RawFunction::kRegularFunction,
+                           true, false, false, false, cls, 0);
+  cls.AddFunction(function);
+  EXPECT_EQ(function.raw(), cls.LookupFunction(name));
+  EXPECT_EQ(function.raw(), cls.LookupStaticFunction(name));
+  name = String::New("_added");
+  EXPECT_EQ(function.raw(), cls.LookupFunctionAllowPrivate(name));
+  EXPECT(cls.LookupFunction(name) == Function::null());
+  cls.SetFields(Object::empty_array());
+  name = String::New("f0");
+  EXPECT(cls.LookupField(name) == Field::null());
+  name = String::New("m0");
+  EXPECT_EQ(functions.At(0), cls.LookupFunction(name));
+}
+
+
 TEST_CASE(TypeArguments) {
   const Type& type1 = Type::Handle(Type::Double());
   const Type& type2 = Type::Handle(Type::StringType());
@@ -2349,10 +2438,10 @@ TEST_CASE(ExceptionHandlers) {
   // Add an exception handler table to the code.
   ExceptionHandlers& exception_handlers = ExceptionHandlers::Handle();
   exception_handlers ^= ExceptionHandlers::New(kNumEntries);
-  exception_handlers.SetHandlerInfo(0, -1, 20);
-  exception_handlers.SetHandlerInfo(1, 0, 30);
-  exception_handlers.SetHandlerInfo(2, -1, 40);
-  exception_handlers.SetHandlerInfo(3, 1, 150);
+  exception_handlers.SetHandlerInfo(0, -1, 20, true);
+  exception_handlers.SetHandlerInfo(1, 0, 30, false);
+  exception_handlers.SetHandlerInfo(2, -1, 40, true);
+  exception_handlers.SetHandlerInfo(3, 1, 150, false);
 
   extern void GenerateIncrement(Assembler* assembler);
   Assembler _assembler_;
@@ -2371,8 +2460,11 @@ TEST_CASE(ExceptionHandlers) {
   EXPECT_EQ(-1, info.outer_try_index);
   EXPECT_EQ(20, handlers.HandlerPC(0));
   EXPECT_EQ(20, info.handler_pc);
+  EXPECT(info.needs_stacktrace);
+  EXPECT(handlers.NeedsStacktrace(0));
   EXPECT_EQ(1, handlers.OuterTryIndex(3));
   EXPECT_EQ(150, handlers.HandlerPC(3));
+  EXPECT(!handlers.NeedsStacktrace(3));
 }
 
 
@@ -2519,6 +2611,27 @@ TEST_CASE(ICData) {
   EXPECT_EQ(kSmiCid, test_class_ids[0]);
   EXPECT_EQ(kSmiCid, test_class_ids[1]);
   EXPECT_EQ(target1.raw(), test_target.raw());
+
+  // Many receiver classes grow the checks and switch to hashed lookup.
+  ICData& o3 = ICData::Handle();
+  o3 = ICData::New(function, target_name, 58, 1);
+  const intptr_t kNumClasses = 40;
+  const intptr_t kFirstCid = kNumPredefinedCids;
+  for (intptr_t i = 0; i < kNumClasses; i++) {
+    o3.AddReceiverCheck(kFirstCid + 64 * i,
+                        (i % 2 == 0) ? target1 : target2);
+  }
+  o3.AddReceiverCheck(kSmiCid, target2);
+  EXPECT_EQ(kNumClasses + 1, o3.NumberOfChecks());
+  EXPECT_EQ(kSmiCid, o3.GetReceiverClassIdAt(0));
+  for (intptr_t i = 0; i < kNumClasses; i++) {
+    EXPECT(o3.HasReceiverClassId(kFirstCid + 64 * i));
+    EXPECT_EQ(((i % 2) == 0) ? target1.raw() : target2.raw(),
+              o3.GetTargetForReceiverClassId(kFirstCid + 64 * i));
+  }
+  EXPECT_EQ(target2.raw(), o3.GetTargetForReceiverClassId(kSmiCid));
+  EXPECT(!o3.HasReceiverClassId(kFirstCid + 1));
+  EXPECT_EQ(Function::null(), o3.GetTargetForReceiverClassId(kDoubleCid));
 }
 
 
@@ -2543,6 +2656,33 @@ TEST_CASE(SubtypeTestCache) {
   EXPECT_EQ(targ_0.raw(), test_targ_0.raw());
   EXPECT_EQ(targ_1.raw(), test_targ_1.raw());
   EXPECT_EQ(Bool::True().raw(), test_result.raw());
+  EXPECT(cache.HasCheck(empty_class.id(), targ_0, targ_1));
+  EXPECT(!cache.HasCheck(empty_class.id(), targ_1, targ_0));
+
+  // Checks with colliding and distinct class ids survive growing the table.
+  const intptr_t kNumChecks = 300;
+  const AbstractTypeArguments& null_targ = AbstractTypeArguments::Handle();
+  for (intptr_t i = 1; i < kNumChecks; i++) {
+    const intptr_t class_id = ((i % 2) == 0) ? (i * 1024) : i;
+    cache.AddCheck(class_id, targ_0, null_targ,
+                   ((i % 3) == 0) ? Bool::True() : Bool::False());
+  }
+  EXPECT_EQ(kNumChecks, cache.NumberOfChecks());
+  EXPECT(cache.HasCheck(empty_class.id(), targ_0, targ_1));
+  EXPECT(cache.HasCheck(2 * 1024, targ_0, null_targ));
+  EXPECT(cache.HasCheck(kNumChecks - 1, targ_0, null_targ));
+  EXPECT(!cache.HasCheck(kNumChecks - 1, targ_1, null_targ));
+  EXPECT(!cache.HasCheck(3 * 1024, targ_0, null_targ));
+  intptr_t num_true = 0;
+  for (intptr_t i = 0; i < kNumChecks; i++) {
+    cache.GetCheck(i, &test_class_id, &test_targ_0, &test_targ_1,
+                   &test_result);
+    if (test_result.value()) {
+      num_true++;
+    }
+  }
+  // The first check and every third one added in the loop are true.
+  EXPECT_EQ(1 + (kNumChecks - 1) / 3, num_true);
 }
 
 
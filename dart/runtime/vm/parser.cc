@@ -6069,6 +6069,7 @@ AstNode* Parser::ParseTryStatement(String* label_name) {
   // operator.
   bool catch_seen = false;
   bool generic_catch_seen = false;
+  bool stack_trace_param_seen = false;
   SequenceNode* catch_handler_list = NULL;
   const intptr_t handler_pos = TokenPos();
   OpenBlock();  // Start the catch block sequence.
@@ -6102,6 +6103,7 @@ AstNode* Parser::ParseTryStatement(String* label_name) {
             &AbstractType::ZoneHandle(Type::DynamicType());
         stack_trace_param.token_pos = TokenPos();
         stack_trace_param.var = ExpectIdentifier("identifier expected");
+        stack_trace_param_seen = true;
       }
       ExpectToken(Token::kRPAREN);
     }
@@ -6246,13 +6248,20 @@ AstNode* Parser::ParseTryStatement(String* label_name) {
                       new LoadLocalNode(handler_pos, catch_excp_var),
                       new LoadLocalNode(handler_pos, catch_trace_var)));
   }
+  // Throwing only builds a stack trace if the handler can observe it: through
+  // a stack trace parameter, or by rethrowing (explicitly, or implicitly when
+  // no catch clause matches).
+  const bool needs_stacktrace = stack_trace_param_seen ||
+                                !generic_catch_seen ||
+                                end_catch_label->is_rethrow_target();
   CatchClauseNode* catch_block =
       new CatchClauseNode(handler_pos,
                           catch_handler_list,
                           Array::ZoneHandle(Array::MakeArray(handler_types)),
                           context_var,
                           catch_excp_var,
-                          catch_trace_var);
+                          catch_trace_var,
+                          needs_stacktrace);
 
   // Now create the try/catch ast node and return it. If there is a label
   // on the try/catch, close the block that's embedding the try statement
@@ -6425,6 +6434,7 @@ AstNode* Parser::ParseStatement() {
         label->FunctionLevel() != current_block_->scope->function_level()) {
       ErrorMsg(statement_pos, "rethrow of an exception is not valid here");
     }
+    label->set_is_rethrow_target();
     ASSERT(label->owner() != NULL);
     LocalScope* scope = label->owner()->parent();
     ASSERT(scope != NULL);
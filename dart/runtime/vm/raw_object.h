@@ -78,7 +78,8 @@ namespace dart {
     V(OneByteString)                                                           \
     V(TwoByteString)                                                           \
     V(ExternalOneByteString)                                                   \
-    V(ExternalTwoByteString)
+    V(ExternalTwoByteString)                                                   \
+    V(ConsString)
 
 #define CLASS_LIST_TYPED_DATA(V)                                               \
   V(Int8Array)                                                                 \
@@ -224,8 +225,9 @@ class RawObject {
     kCanonicalBit = 2,
     kFromSnapshotBit = 3,
     kRememberedBit = 4,
-    kReservedTagBit = 5,  // kReservedBit{10K,100K,1M,10M}
-    kReservedTagSize = 3,
+    kMutableBoxBit = 5,
+    kReservedTagBit = 6,  // kReservedBit{10K,100K,1M}
+    kReservedTagSize = 2,
     kSizeTagBit = 8,
     kSizeTagSize = 8,
     kClassIdTagBit = kSizeTagBit + kSizeTagSize,
@@ -344,6 +346,13 @@ class RawObject {
     ptr()->tags_ = RememberedBit::update(false, tags);
   }
 
+  // Support for the mutable box bit. A box carrying this bit is owned by a
+  // single unboxed field slot and is updated in place by optimized code, so
+  // it must be copied before it is handed out.
+  bool IsMutableBox() const {
+    return MutableBoxBit::decode(ptr()->tags_);
+  }
+
   bool IsDartInstance() {
     return (!IsHeapObject() || (GetClassId() >= kInstanceCid));
   }
@@ -406,6 +415,8 @@ class RawObject {
 
   class RememberedBit : public BitField<bool, kRememberedBit, 1> {};
 
+  class MutableBoxBit : public BitField<bool, kMutableBoxBit, 1> {};
+
   class CanonicalObjectTag : public BitField<bool, kCanonicalBit, 1> {};
 
   class CreatedFromSnapshotTag : public BitField<bool, kFromSnapshotBit, 1> {};
@@ -429,6 +440,8 @@ class RawObject {
 
   friend class Api;
   friend class Array;
+  friend class CodeAgingVisitor;
+  friend class ConsString;
   friend class FreeListElement;
   friend class GCMarker;
   friend class ExternalTypedData;
@@ -479,6 +492,7 @@ class RawClass : public RawObject {
   RawFunction* signature_function_;  // Associated function for signature class.
   RawArray* constants_;  // Canonicalized values of this class.
   RawArray* canonical_types_;  // Canonicalized types of this class.
+  RawArray* member_index_;  // Hash index of functions and fields or null.
   RawCode* allocation_stub_;  // Stub code for allocation of instances.
   RawObject** to() {
     return reinterpret_cast<RawObject**>(&ptr()->allocation_stub_);
@@ -531,8 +545,10 @@ class RawTypeArguments : public RawAbstractTypeArguments {
   RAW_HEAP_OBJECT_IMPLEMENTATION(TypeArguments);
 
   RawObject** from() {
-    return reinterpret_cast<RawObject**>(&ptr()->length_);
+    return reinterpret_cast<RawObject**>(&ptr()->instantiations_);
   }
+  // Cache of (instantiator, instantiated vector) pairs, terminated by a Smi.
+  RawArray* instantiations_;
   RawSmi* length_;
 
   // Variable length data follows here.
@@ -612,6 +628,7 @@ class RawFunction : public RawObject {
   intptr_t token_pos_;
   intptr_t end_token_pos_;
   intptr_t usage_counter_;  // Incremented while function is running.
+  intptr_t code_age_;  // Old-space GCs since unoptimized code last ran.
   int16_t num_fixed_parameters_;
   int16_t num_optional_parameters_;  // > 0: positional; < 0: named.
   uint16_t deoptimization_counter_;
@@ -930,6 +947,7 @@ class RawExceptionHandlers : public RawObject {
   struct HandlerInfo {
     intptr_t outer_try_index;  // Try block index of enclosing try block.
     intptr_t handler_pc;       // PC value of handler.
+    int8_t needs_stacktrace;   // True if the handler uses the stack trace.
   };
  private:
   RAW_HEAP_OBJECT_IMPLEMENTATION(ExceptionHandlers);
@@ -1016,11 +1034,13 @@ class RawICData : public RawObject {
   RawFunction* function_;     // Parent/calling function of this IC.
   RawString* target_name_;    // Name of target function.
   RawArray* ic_data_;         // Contains test class-ids and target functions.
+  RawArray* ic_data_hash_;    // Hash index of receiver class-ids or null.
   RawObject** to() {
-    return reinterpret_cast<RawObject**>(&ptr()->ic_data_);
+    return reinterpret_cast<RawObject**>(&ptr()->ic_data_hash_);
   }
   intptr_t deopt_id_;         // Deoptimization id corresponding to this IC.
   intptr_t num_args_tested_;  // Number of arguments tested in IC.
+  intptr_t num_checks_;       // Number of checks in ic_data_.
   uint8_t deopt_reason_;      // Last deoptimization reason.
   uint8_t is_closure_call_;   // 0 or 1.
 };
@@ -1256,6 +1276,8 @@ class RawString : public RawInstance {
   RawSmi* length_;
   RawSmi* hash_;
   RawObject** to() { return reinterpret_cast<RawObject**>(&ptr()->hash_); }
+
+  friend class ConsString;
 };
 
 
@@ -1266,6 +1288,7 @@ class RawOneByteString : public RawString {
   uint8_t data_[0];
 
   friend class ApiMessageReader;
+  friend class ConsString;
   friend class SnapshotReader;
 };
 
@@ -1276,6 +1299,7 @@ class RawTwoByteString : public RawString {
   // Variable length data follows here.
   uint16_t data_[0];
 
+  friend class ConsString;
   friend class SnapshotReader;
 };
 
@@ -1309,6 +1333,7 @@ class RawExternalOneByteString : public RawString {
 
   ExternalStringData<uint8_t>* external_data_;
   friend class Api;
+  friend class ConsString;
 };
 
 
@@ -1317,6 +1342,21 @@ class RawExternalTwoByteString : public RawString {
 
   ExternalStringData<uint16_t>* external_data_;
   friend class Api;
+  friend class ConsString;
+};
+
+
+// The concatenation of 'left_' and 'right_', whose characters are only copied
+// into a flat string when first needed. The flat copy is then kept in 'left_'
+// and 'right_' is set to null.
+class RawConsString : public RawString {
+  RAW_HEAP_OBJECT_IMPLEMENTATION(ConsString);
+
+  RawString* left_;
+  RawString* right_;
+  RawObject** to() { return reinterpret_cast<RawObject**>(&ptr()->right_); }
+  RawSmi* depth_;  // Longest path to a flat string, 0 once flattened.
+  RawSmi* char_size_;  // String::kOneByteChar or String::kTwoByteChar.
 };
 
 
@@ -1555,8 +1595,9 @@ inline bool RawObject::IsStringClassId(intptr_t index) {
   ASSERT(kOneByteStringCid == kStringCid + 1 &&
          kTwoByteStringCid == kStringCid + 2 &&
          kExternalOneByteStringCid == kStringCid + 3 &&
-         kExternalTwoByteStringCid == kStringCid + 4);
-  return (index >= kStringCid && index <= kExternalTwoByteStringCid);
+         kExternalTwoByteStringCid == kStringCid + 4 &&
+         kConsStringCid == kStringCid + 5);
+  return (index >= kStringCid && index <= kConsStringCid);
 }
 
 
@@ -1565,7 +1606,8 @@ inline bool RawObject::IsOneByteStringClassId(intptr_t index) {
   ASSERT(kOneByteStringCid == kStringCid + 1 &&
          kTwoByteStringCid == kStringCid + 2 &&
          kExternalOneByteStringCid == kStringCid + 3 &&
-         kExternalTwoByteStringCid == kStringCid + 4);
+         kExternalTwoByteStringCid == kStringCid + 4 &&
+         kConsStringCid == kStringCid + 5);
   return (index == kOneByteStringCid || index == kExternalOneByteStringCid);
 }
 
@@ -1575,7 +1617,8 @@ inline bool RawObject::IsTwoByteStringClassId(intptr_t index) {
   ASSERT(kOneByteStringCid == kStringCid + 1 &&
          kTwoByteStringCid == kStringCid + 2 &&
          kExternalOneByteStringCid == kStringCid + 3 &&
-         kExternalTwoByteStringCid == kStringCid + 4);
+         kExternalTwoByteStringCid == kStringCid + 4 &&
+         kConsStringCid == kStringCid + 5);
   return (index == kOneByteStringCid ||
           index == kTwoByteStringCid ||
           index == kExternalOneByteStringCid ||
@@ -1588,7 +1631,8 @@ inline bool RawObject::IsExternalStringClassId(intptr_t index) {
   ASSERT(kOneByteStringCid == kStringCid + 1 &&
          kTwoByteStringCid == kStringCid + 2 &&
          kExternalOneByteStringCid == kStringCid + 3 &&
-         kExternalTwoByteStringCid == kStringCid + 4);
+         kExternalTwoByteStringCid == kStringCid + 4 &&
+         kConsStringCid == kStringCid + 5);
   return (index == kExternalOneByteStringCid ||
           index == kExternalTwoByteStringCid);
 }
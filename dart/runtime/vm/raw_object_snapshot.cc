@@ -460,6 +460,9 @@ RawTypeArguments* TypeArguments::ReadFrom(SnapshotReader* reader,
       reader->isolate(), NEW_OBJECT_WITH_LEN_SPACE(TypeArguments, len, kind));
   reader->AddBackRef(object_id, &type_arguments, kIsDeserialized);
 
+  // The instantiations cache is not serialized.
+  type_arguments.raw_ptr()->instantiations_ = Array::null();
+
   // Now set all the object fields.
   for (intptr_t i = 0; i < len; i++) {
     *reader->TypeHandle() ^= reader->ReadObjectImpl();
@@ -736,6 +739,7 @@ RawFunction* Function::ReadFrom(SnapshotReader* reader,
   func.set_token_pos(reader->ReadIntptrValue());
   func.set_end_token_pos(reader->ReadIntptrValue());
   func.set_usage_counter(reader->ReadIntptrValue());
+  func.set_code_age(0);
   func.set_num_fixed_parameters(reader->ReadIntptrValue());
   func.set_num_optional_parameters(reader->ReadIntptrValue());
   func.set_deoptimization_counter(reader->ReadIntptrValue());
@@ -2010,6 +2014,105 @@ void RawExternalTwoByteString::WriteTo(SnapshotWriter* writer,
 }
 
 
+RawConsString* ConsString::ReadFrom(SnapshotReader* reader,
+                                    intptr_t object_id,
+                                    intptr_t tags,
+                                    Snapshot::Kind kind) {
+  UNREACHABLE();
+  return ConsString::null();
+}
+
+
+template<typename T>
+void ConsString::WriteCharacters(SnapshotWriter* writer, RawString* str) {
+  // The class id in the header of an object which was already visited by the
+  // writer is overwritten, so it has to be read from the writer.
+  const intptr_t class_id =
+      RawObject::ClassIdTag::decode(writer->GetObjectTags(str));
+  const intptr_t len = Smi::Value(str->ptr()->length_);
+  switch (class_id) {
+    case kOneByteStringCid: {
+      const uint8_t* data = reinterpret_cast<RawOneByteString*>(str)->
+          ptr()->data_;
+      if (sizeof(T) == String::kOneByteChar) {
+        writer->WriteBytes(data, len);
+      } else {
+        for (intptr_t i = 0; i < len; i++) {
+          writer->Write<T>(data[i]);
+        }
+      }
+      break;
+    }
+    case kTwoByteStringCid: {
+      const uint16_t* data = reinterpret_cast<RawTwoByteString*>(str)->
+          ptr()->data_;
+      for (intptr_t i = 0; i < len; i++) {
+        writer->Write<T>(data[i]);
+      }
+      break;
+    }
+    case kExternalOneByteStringCid: {
+      const uint8_t* data = reinterpret_cast<RawExternalOneByteString*>(str)->
+          ptr()->external_data_->data();
+      if (sizeof(T) == String::kOneByteChar) {
+        writer->WriteBytes(data, len);
+      } else {
+        for (intptr_t i = 0; i < len; i++) {
+          writer->Write<T>(data[i]);
+        }
+      }
+      break;
+    }
+    case kExternalTwoByteStringCid: {
+      const uint16_t* data = reinterpret_cast<RawExternalTwoByteString*>(str)->
+          ptr()->external_data_->data();
+      for (intptr_t i = 0; i < len; i++) {
+        writer->Write<T>(data[i]);
+      }
+      break;
+    }
+    case kConsStringCid: {
+      RawConsString* cons = reinterpret_cast<RawConsString*>(str);
+      WriteCharacters<T>(writer, cons->ptr()->left_);
+      if (cons->ptr()->right_ != String::null()) {
+        WriteCharacters<T>(writer, cons->ptr()->right_);
+      }
+      break;
+    }
+    default:
+      UNREACHABLE();
+  }
+}
+
+
+void RawConsString::WriteTo(SnapshotWriter* writer,
+                            intptr_t object_id,
+                            Snapshot::Kind kind) {
+  // Serialize as a flat one or two byte string, the characters of the parts
+  // are written in order without flattening the string in the heap.
+  const intptr_t class_id = (Smi::Value(ptr()->char_size_) ==
+      String::kOneByteChar) ? kOneByteStringCid : kTwoByteStringCid;
+
+  // Write out the serialization header value for this object.
+  writer->WriteInlinedObjectHeader(object_id);
+
+  // Write out the class and tags information.
+  writer->WriteIndexedObject(class_id);
+  writer->WriteIntptrValue(writer->GetObjectTags(this));
+
+  // Write out the length and hash fields.
+  writer->Write<RawObject*>(ptr()->length_);
+  writer->Write<RawObject*>(ptr()->hash_);
+
+  // Write out the string.
+  if (class_id == kOneByteStringCid) {
+    ConsString::WriteCharacters<uint8_t>(writer, this);
+  } else {
+    ConsString::WriteCharacters<uint16_t>(writer, this);
+  }
+}
+
+
 RawBool* Bool::ReadFrom(SnapshotReader* reader,
                         intptr_t object_id,
                         intptr_t tags,
@@ -140,7 +140,8 @@ class SourceLabel : public ZoneAllocated {
       break_label_(),
       join_for_break_(NULL),
       join_for_continue_(NULL),
-      is_continue_target_(false) {
+      is_continue_target_(false),
+      is_rethrow_target_(false) {
   }
 
   static SourceLabel* New(intptr_t token_pos, String* name, Kind kind) {
@@ -177,6 +178,10 @@ class SourceLabel : public ZoneAllocated {
   bool is_continue_target() const { return is_continue_target_; }
   void set_is_continue_target(bool value) { is_continue_target_ = value; }
 
+  // Set on the label of a catch block that contains a rethrow.
+  bool is_rethrow_target() const { return is_rethrow_target_; }
+  void set_is_rethrow_target() { is_rethrow_target_ = true; }
+
   void set_join_for_break(JoinEntryInstr* join) {
     ASSERT(join_for_break_ == NULL);
     join_for_break_ = join;
@@ -206,6 +211,7 @@ class SourceLabel : public ZoneAllocated {
   JoinEntryInstr* join_for_break_;
   JoinEntryInstr* join_for_continue_;
   bool is_continue_target_;  // Needed for CaseNode.
+  bool is_rethrow_target_;  // Needed for CatchClauseNode.
 
   DISALLOW_COPY_AND_ASSIGN(SourceLabel);
 };
@@ -154,7 +154,8 @@ RawCode* StackFrame::GetCodeObject() const {
 }
 
 
-bool StackFrame::FindExceptionHandler(uword* handler_pc) const {
+bool StackFrame::FindExceptionHandler(uword* handler_pc,
+                                      bool* needs_stacktrace) const {
   const Code& code = Code::Handle(LookupDartCode());
   if (code.IsNull()) {
     return false;  // Stub frames do not have exception handlers.
@@ -169,7 +170,10 @@ bool StackFrame::FindExceptionHandler(uword* handler_pc) const {
       const intptr_t try_index = descriptors.TryIndex(i);
       const ExceptionHandlers& handlers =
           ExceptionHandlers::Handle(code.exception_handlers());
-      *handler_pc = handlers.HandlerPC(try_index);
+      RawExceptionHandlers::HandlerInfo info;
+      handlers.GetHandlerInfo(try_index, &info);
+      *handler_pc = info.handler_pc;
+      *needs_stacktrace = info.needs_stacktrace;
       return true;
     }
   }
@@ -64,7 +64,7 @@ class StackFrame : public ValueObject {
 
   RawFunction* LookupDartFunction() const;
   RawCode* LookupDartCode() const;
-  bool FindExceptionHandler(uword* handler_pc) const;
+  bool FindExceptionHandler(uword* handler_pc, bool* needs_stacktrace) const;
   // Returns token_pos of the pc(), or -1 if none exists.
   intptr_t GetTokenPos() const;
 
@@ -1470,8 +1470,22 @@ void StubCode::GenerateNArgsCheckInlineCacheStub(Assembler* assembler,
 
   __ Bind(&call_target_function);
   // R0: target function.
-  __ ldr(R0, FieldAddress(R0, Function::code_offset()));
-  __ ldr(R0, FieldAddress(R0, Code::instructions_offset()));
+  Label target_compiled;
+  __ ldr(R1, FieldAddress(R0, Function::code_offset()));
+  __ CompareImmediate(R1, reinterpret_cast<intptr_t>(Object::null()));
+  __ b(&target_compiled, NE);
+  // The unoptimized code of the target was dropped by code aging.
+  __ EnterStubFrame();
+  // Preserve arguments descriptor array and IC data object, pass target
+  // function.
+  __ PushList((1 << R0) | (1 << R4) | (1 << R5));
+  __ CallRuntime(kCompileFunctionRuntimeEntry);
+  __ PopList((1 << R0) | (1 << R4) | (1 << R5));
+  __ LeaveStubFrame();
+  __ ldr(R1, FieldAddress(R0, Function::code_offset()));
+  __ Bind(&target_compiled);
+  // R1: target code.
+  __ ldr(R0, FieldAddress(R1, Code::instructions_offset()));
   __ AddImmediate(R0, Instructions::HeaderSize() - kHeapObjectTag);
   __ bx(R0);
 
@@ -1645,6 +1659,13 @@ static void GenerateSubtypeNTestCacheStub(Assembler* assembler, int n) {
   // R3: instance class id.
   // R4: instance type arguments (null if none), used only if n > 1.
   __ ldr(R2, FieldAddress(R2, SubtypeTestCache::cache_offset()));
+  // Start probing at the home entry of the instance class id.
+  __ ldr(R5, FieldAddress(R2, Array::length_offset()));
+  __ Lsr(R5, R5, SubtypeTestCache::kHashMaskShift);
+  __ sub(R5, R5, ShifterOperand(1));
+  __ and_(R5, R5, ShifterOperand(R3));
+  __ add(R2, R2, ShifterOperand(R5, LSL,
+      kWordSizeLog2 + SubtypeTestCache::kTestEntryLengthLog2));
   __ AddImmediate(R2, Array::data_offset() - kHeapObjectTag);
 
   Label loop, found, not_found, next_iteration;
@@ -1500,8 +1500,10 @@ void StubCode::GenerateNArgsCheckInlineCacheStub(Assembler* assembler,
   }
 #endif  // DEBUG
 
+  const Immediate& raw_null =
+      Immediate(reinterpret_cast<intptr_t>(Object::null()));
   // Loop that checks if there is an IC data match.
-  Label loop, update, test, found, get_class_id_as_smi;
+  Label loop, update, test, found, miss, get_class_id_as_smi;
   // ECX: IC data object (preserved).
   __ movl(EBX, FieldAddress(ECX, ICData::ic_data_offset()));
   // EBX: ic_data_array with check entries: classes and target functions.
@@ -1514,6 +1516,42 @@ void StubCode::GenerateNArgsCheckInlineCacheStub(Assembler* assembler,
   __ movl(EAX, Address(ESP, EAX, TIMES_2, 0));  // EAX (argument_count) is smi.
   __ call(&get_class_id_as_smi);
   // EAX: receiver's class ID (smi).
+  if (num_args == 1) {
+    // Probe the hash index of the receiver class ids if there is one.
+    Label linear_scan, probe, next_slot, hash_found, hash_miss;
+    __ movl(EDI, FieldAddress(ECX, ICData::ic_data_hash_offset()));
+    __ cmpl(EDI, raw_null);
+    __ j(EQUAL, &linear_scan, Assembler::kNearJump);
+    // EDI: hash index array.
+    __ pushl(EDX);  // Preserve arguments descriptor array.
+    __ pushl(ECX);  // Preserve IC data object.
+    __ movl(EDX, EAX);
+    __ SmiUntag(EDX);
+    __ Bind(&probe);
+    __ movl(ECX, FieldAddress(EDI, Array::length_offset()));
+    __ SmiUntag(ECX);
+    __ subl(ECX, Immediate(1));
+    __ andl(EDX, ECX);
+    // EDX: probed slot.
+    __ movl(ECX, FieldAddress(EDI, EDX, TIMES_4, Array::data_offset()));
+    // ECX: offset in words of a check as Smi, or kEmptyHashSlot.
+    __ cmpl(ECX, Immediate(Smi::RawValue(ICData::kEmptyHashSlot)));
+    __ j(EQUAL, &hash_miss, Assembler::kNearJump);
+    __ cmpl(EAX, Address(EBX, ECX, TIMES_HALF_WORD_SIZE, 0));
+    __ j(EQUAL, &hash_found, Assembler::kNearJump);
+    __ incl(EDX);
+    __ jmp(&probe, Assembler::kNearJump);
+    __ Bind(&hash_found);
+    __ leal(EBX, Address(EBX, ECX, TIMES_HALF_WORD_SIZE, 0));
+    __ popl(ECX);  // Restore IC data object.
+    __ popl(EDX);  // Restore arguments descriptor array.
+    __ jmp(&found);
+    __ Bind(&hash_miss);
+    __ popl(ECX);  // Restore IC data object.
+    __ popl(EDX);  // Restore arguments descriptor array.
+    __ jmp(&miss);
+    __ Bind(&linear_scan);
+  }
   __ movl(EDI, Address(EBX, 0));  // First class id (smi) to check.
   __ jmp(&test);
 
@@ -1553,8 +1591,7 @@ void StubCode::GenerateNArgsCheckInlineCacheStub(Assembler* assembler,
   __ j(NOT_EQUAL, &loop, Assembler::kNearJump);
 
   // IC miss.
-  const Immediate& raw_null =
-      Immediate(reinterpret_cast<intptr_t>(Object::null()));
+  __ Bind(&miss);
   // Compute address of arguments (first read number of arguments from
   // arguments descriptor array and then compute address on the stack).
   __ movl(EAX, FieldAddress(EDX, ArgumentsDescriptor::count_offset()));
@@ -1611,8 +1648,24 @@ void StubCode::GenerateNArgsCheckInlineCacheStub(Assembler* assembler,
 
   __ Bind(&call_target_function);
   // EAX: Target function.
-  __ movl(EAX, FieldAddress(EAX, Function::code_offset()));
-  __ movl(EAX, FieldAddress(EAX, Code::instructions_offset()));
+  Label target_compiled;
+  __ movl(EBX, FieldAddress(EAX, Function::code_offset()));
+  __ cmpl(EBX, raw_null);
+  __ j(NOT_EQUAL, &target_compiled, Assembler::kNearJump);
+  // The unoptimized code of the target was dropped by code aging.
+  __ EnterStubFrame();
+  __ pushl(EDX);  // Preserve arguments descriptor array.
+  __ pushl(ECX);  // Preserve IC data object.
+  __ pushl(EAX);  // Pass target function.
+  __ CallRuntime(kCompileFunctionRuntimeEntry);
+  __ popl(EAX);  // Restore target function.
+  __ popl(ECX);  // Restore IC data object.
+  __ popl(EDX);  // Restore arguments descriptor array.
+  __ LeaveFrame();
+  __ movl(EBX, FieldAddress(EAX, Function::code_offset()));
+  __ Bind(&target_compiled);
+  // EBX: Target code.
+  __ movl(EAX, FieldAddress(EBX, Code::instructions_offset()));
   __ addl(EAX, Immediate(Instructions::HeaderSize() - kHeapObjectTag));
   __ jmp(EAX);
 
@@ -1826,7 +1879,14 @@ static void GenerateSubtypeNTestCacheStub(Assembler* assembler, int n) {
   __ movl(EDX, Address(ESP, kCacheOffsetInBytes));
   // EDX: SubtypeTestCache.
   __ movl(EDX, FieldAddress(EDX, SubtypeTestCache::cache_offset()));
-  __ addl(EDX, Immediate(Array::data_offset() - kHeapObjectTag));
+  // Start probing at the home entry of the instance class id.
+  __ movl(EDI, FieldAddress(EDX, Array::length_offset()));
+  __ shrl(EDI, Immediate(SubtypeTestCache::kHashMaskShift));
+  __ subl(EDI, Immediate(1));
+  __ andl(EDI, ECX);
+  __ shll(EDI,
+          Immediate(kWordSizeLog2 + SubtypeTestCache::kTestEntryLengthLog2));
+  __ leal(EDX, FieldAddress(EDX, EDI, TIMES_1, Array::data_offset()));
 
   Label loop, found, not_found, next_iteration;
   // EDX: Entry start.
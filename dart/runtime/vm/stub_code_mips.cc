@@ -1620,8 +1620,27 @@ void StubCode::GenerateNArgsCheckInlineCacheStub(Assembler* assembler,
 
   __ Bind(&call_target_function);
   // T3: Target function.
-  __ lw(T3, FieldAddress(T3, Function::code_offset()));
-  __ lw(T3, FieldAddress(T3, Code::instructions_offset()));
+  Label target_compiled;
+  __ lw(T4, FieldAddress(T3, Function::code_offset()));
+  __ bne(T4, NULLREG, &target_compiled);
+  // The unoptimized code of the target was dropped by code aging.
+  __ EnterStubFrame();
+  // Preserve arguments descriptor array and IC data object, pass target
+  // function.
+  __ addiu(SP, SP, Immediate(-3 * kWordSize));
+  __ sw(S5, Address(SP, 2 * kWordSize));
+  __ sw(S4, Address(SP, 1 * kWordSize));
+  __ sw(T3, Address(SP, 0 * kWordSize));
+  __ CallRuntime(kCompileFunctionRuntimeEntry);
+  __ lw(T3, Address(SP, 0 * kWordSize));
+  __ lw(S4, Address(SP, 1 * kWordSize));
+  __ lw(S5, Address(SP, 2 * kWordSize));
+  __ addiu(SP, SP, Immediate(3 * kWordSize));
+  __ LeaveStubFrame();
+  __ lw(T4, FieldAddress(T3, Function::code_offset()));
+  __ Bind(&target_compiled);
+  // T4: Target code.
+  __ lw(T3, FieldAddress(T4, Code::instructions_offset()));
   __ AddImmediate(T3, Instructions::HeaderSize() - kHeapObjectTag);
   __ jr(T3);
   __ delay_slot()->addiu(T3, T3,
@@ -1816,6 +1835,13 @@ static void GenerateSubtypeNTestCacheStub(Assembler* assembler, int n) {
   // T0: instance class id.
   // T1: instance type arguments (null if none), used only if n > 1.
   __ lw(T2, FieldAddress(A2, SubtypeTestCache::cache_offset()));
+  // Start probing at the home entry of the instance class id.
+  __ lw(T3, FieldAddress(T2, Array::length_offset()));
+  __ srl(T3, T3, SubtypeTestCache::kHashMaskShift);
+  __ addiu(T3, T3, Immediate(-1));
+  __ and_(T3, T3, T0);
+  __ sll(T3, T3, kWordSizeLog2 + SubtypeTestCache::kTestEntryLengthLog2);
+  __ addu(T2, T2, T3);
   __ AddImmediate(T2, Array::data_offset() - kHeapObjectTag);
 
   Label loop, found, not_found, next_iteration;
@@ -1480,8 +1480,10 @@ void StubCode::GenerateNArgsCheckInlineCacheStub(Assembler* assembler,
   }
 #endif  // DEBUG
 
+  const Immediate& raw_null =
+      Immediate(reinterpret_cast<intptr_t>(Object::null()));
   // Loop that checks if there is an IC data match.
-  Label loop, update, test, found, get_class_id_as_smi;
+  Label loop, update, test, found, miss, get_class_id_as_smi;
   // RBX: IC data object (preserved).
   __ movq(R12, FieldAddress(RBX, ICData::ic_data_offset()));
   // R12: ic_data_array with check entries: classes and target functions.
@@ -1494,6 +1496,35 @@ void StubCode::GenerateNArgsCheckInlineCacheStub(Assembler* assembler,
   __ movq(RAX, Address(RSP, RAX, TIMES_4, 0));  // RAX (argument count) is Smi.
   __ call(&get_class_id_as_smi);
   // RAX: receiver's class ID as smi.
+  if (num_args == 1) {
+    // Probe the hash index of the receiver class ids if there is one.
+    Label linear_scan, probe, next_slot;
+    __ movq(R13, FieldAddress(RBX, ICData::ic_data_hash_offset()));
+    __ cmpq(R13, raw_null);
+    __ j(EQUAL, &linear_scan, Assembler::kNearJump);
+    // R13: hash index array.
+    __ movq(RDX, FieldAddress(R13, Array::length_offset()));
+    __ SmiUntag(RDX);
+    __ subq(RDX, Immediate(1));
+    // RDX: hash mask.
+    __ movq(RCX, RAX);
+    __ SmiUntag(RCX);
+    __ Bind(&probe);
+    __ andq(RCX, RDX);
+    // RCX: probed slot.
+    __ movq(RDI, FieldAddress(R13, RCX, TIMES_8, Array::data_offset()));
+    // RDI: offset in words of a check as Smi, or kEmptyHashSlot.
+    __ cmpq(RDI, Immediate(Smi::RawValue(ICData::kEmptyHashSlot)));
+    __ j(EQUAL, &miss);
+    __ cmpq(RAX, Address(R12, RDI, TIMES_HALF_WORD_SIZE, 0));
+    __ j(NOT_EQUAL, &next_slot, Assembler::kNearJump);
+    __ leaq(R12, Address(R12, RDI, TIMES_HALF_WORD_SIZE, 0));
+    __ jmp(&found);
+    __ Bind(&next_slot);
+    __ incq(RCX);
+    __ jmp(&probe, Assembler::kNearJump);
+    __ Bind(&linear_scan);
+  }
   __ movq(R13, Address(R12, 0));  // First class ID (Smi) to check.
   __ jmp(&test);
 
@@ -1533,8 +1564,7 @@ void StubCode::GenerateNArgsCheckInlineCacheStub(Assembler* assembler,
   __ j(NOT_EQUAL, &loop, Assembler::kNearJump);
 
   // IC miss.
-  const Immediate& raw_null =
-      Immediate(reinterpret_cast<intptr_t>(Object::null()));
+  __ Bind(&miss);
   // Compute address of arguments (first read number of arguments from
   // arguments descriptor array and then compute address on the stack).
   __ movq(RAX, FieldAddress(R10, ArgumentsDescriptor::count_offset()));
@@ -1589,8 +1619,24 @@ void StubCode::GenerateNArgsCheckInlineCacheStub(Assembler* assembler,
 
   __ Bind(&call_target_function);
   // RAX: Target function.
-  __ movq(RAX, FieldAddress(RAX, Function::code_offset()));
-  __ movq(RAX, FieldAddress(RAX, Code::instructions_offset()));
+  Label target_compiled;
+  __ movq(RCX, FieldAddress(RAX, Function::code_offset()));
+  __ cmpq(RCX, raw_null);
+  __ j(NOT_EQUAL, &target_compiled, Assembler::kNearJump);
+  // The unoptimized code of the target was dropped by code aging.
+  __ EnterStubFrame();
+  __ pushq(R10);  // Preserve arguments descriptor array.
+  __ pushq(RBX);  // Preserve IC data object.
+  __ pushq(RAX);  // Pass target function.
+  __ CallRuntime(kCompileFunctionRuntimeEntry);
+  __ popq(RAX);  // Restore target function.
+  __ popq(RBX);  // Restore IC data object.
+  __ popq(R10);  // Restore arguments descriptor array.
+  __ LeaveFrame();
+  __ movq(RCX, FieldAddress(RAX, Function::code_offset()));
+  __ Bind(&target_compiled);
+  // RCX: Target code.
+  __ movq(RAX, FieldAddress(RCX, Code::instructions_offset()));
   __ addq(RAX, Immediate(Instructions::HeaderSize() - kHeapObjectTag));
   __ jmp(RAX);
 
@@ -1793,7 +1839,14 @@ static void GenerateSubtypeNTestCacheStub(Assembler* assembler, int n) {
   __ movq(RDX, Address(RSP, kCacheOffsetInBytes));
   // RDX: SubtypeTestCache.
   __ movq(RDX, FieldAddress(RDX, SubtypeTestCache::cache_offset()));
-  __ addq(RDX, Immediate(Array::data_offset() - kHeapObjectTag));
+  // Start probing at the home entry of the instance class id.
+  __ movq(RDI, FieldAddress(RDX, Array::length_offset()));
+  __ shrq(RDI, Immediate(SubtypeTestCache::kHashMaskShift));
+  __ subq(RDI, Immediate(1));
+  __ andq(RDI, R10);
+  __ shlq(RDI,
+          Immediate(kWordSizeLog2 + SubtypeTestCache::kTestEntryLengthLog2));
+  __ leaq(RDX, FieldAddress(RDX, RDI, TIMES_1, Array::data_offset()));
   // RDX: Entry start.
   // R10: instance class id.
   // R13: instance type arguments.
@@ -252,7 +252,8 @@ RawString* Symbols::New(const String& str, intptr_t begin_index, intptr_t len) {
     // empty spot, index is the insertion point if symbol is null.
     symbol ^= symbol_table.At(index);
     if (symbol.IsNull()) {
-      if (str.IsOld() && begin_index == 0 && len == str.Length()) {
+      if (str.IsOld() && !str.IsConsString() &&
+          begin_index == 0 && len == str.Length()) {
         // Reuse the incoming str as the symbol value.
         symbol = str.raw();
       } else {
@@ -15,6 +15,8 @@ namespace dart {
 
 DEFINE_DEBUG_FLAG(bool, trace_zones,
                   false, "Traces allocation sizes in the zone.");
+DEFINE_FLAG(int, zone_segment_cache_size, 16,
+            "Maximum number of zone segments an isolate keeps for reuse.");
 
 
 // Zone segments represent chunks of memory: They have starting
@@ -29,8 +31,8 @@ class Zone::Segment {
   uword end() { return address(size_); }
 
   // Allocate or delete individual segments.
-  static Segment* New(intptr_t size, Segment* next);
-  static void DeleteSegmentList(Segment* segment);
+  static Segment* New(intptr_t size, Segment* next, ZoneSegmentCache* cache);
+  static void DeleteSegmentList(Segment* segment, ZoneSegmentCache* cache);
 
  private:
   Segment* next_;
@@ -39,29 +41,37 @@ class Zone::Segment {
   // Computes the address of the nth byte in this segment.
   uword address(int n) { return reinterpret_cast<uword>(this) + n; }
 
-  static void Delete(Segment* segment) { delete[] segment; }
+  static void Delete(Segment* segment, ZoneSegmentCache* cache) {
+    FreeSegmentMemory(reinterpret_cast<uint8_t*>(segment),
+                      segment->size(),
+                      cache);
+  }
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(Segment);
 };
 
 
-void Zone::Segment::DeleteSegmentList(Segment* head) {
+void Zone::Segment::DeleteSegmentList(Segment* head, ZoneSegmentCache* cache) {
   Segment* current = head;
   while (current != NULL) {
     Segment* next = current->next();
+    intptr_t size = current->size();
 #ifdef DEBUG
     // Zap the entire current segment (including the header).
-    memset(current, kZapDeletedByte, current->size());
+    memset(current, kZapDeletedByte, size);
 #endif
-    Segment::Delete(current);
+    FreeSegmentMemory(reinterpret_cast<uint8_t*>(current), size, cache);
     current = next;
   }
 }
 
 
-Zone::Segment* Zone::Segment::New(intptr_t size, Zone::Segment* next) {
+Zone::Segment* Zone::Segment::New(intptr_t size,
+                                  Zone::Segment* next,
+                                  ZoneSegmentCache* cache) {
   ASSERT(size >= 0);
-  Segment* result = reinterpret_cast<Segment*>(new uint8_t[size]);
+  Segment* result =
+      reinterpret_cast<Segment*>(AllocateSegmentMemory(size, cache));
   if (result != NULL) {
 #ifdef DEBUG
     // Zap the entire allocated segment (including the header).
@@ -74,14 +84,144 @@ Zone::Segment* Zone::Segment::New(intptr_t size, Zone::Segment* next) {
 }
 
 
-Zone::Zone()
+// Zones are created and deleted on the thread that has their isolate
+// entered, so the cache needs no locking. Zones used without an isolate
+// allocate their segments directly.
+static ZoneSegmentCache* CurrentSegmentCache() {
+  Isolate* isolate = Isolate::Current();
+  return (isolate != NULL) ? isolate->zone_segment_cache() : NULL;
+}
+
+
+uint8_t* Zone::AllocateSegmentMemory(intptr_t size, ZoneSegmentCache* cache) {
+  if ((cache != NULL) && (size == kSegmentSize)) {
+    cache->segments_in_use_++;
+    if (cache->segments_in_use_ > cache->segments_high_water_) {
+      cache->segments_high_water_ = cache->segments_in_use_;
+    }
+    uint8_t* memory = cache->Take();
+    if (memory != NULL) {
+      return memory;
+    }
+  }
+  return new uint8_t[size];
+}
+
+
+void Zone::FreeSegmentMemory(uint8_t* memory,
+                             intptr_t size,
+                             ZoneSegmentCache* cache) {
+  if ((cache != NULL) && (size == kSegmentSize)) {
+    if (cache->segments_in_use_ > 0) {
+      cache->segments_in_use_--;
+    }
+    if (cache->Put(memory)) {
+      return;
+    }
+  }
+  delete[] memory;
+}
+
+
+// Cached segments are threaded through their first word.
+class ZoneSegmentCache::Entry {
+ public:
+  Entry* next;
+};
+
+
+ZoneSegmentCache::ZoneSegmentCache()
+    : head_(NULL),
+      length_(0),
+      low_water_(0),
+      reused_(0),
+      segments_in_use_(0),
+      segments_high_water_(0) {
+  for (intptr_t i = 0; i < Zone::kNumKinds; i++) {
+    zone_size_high_water_[i] = 0;
+  }
+}
+
+
+ZoneSegmentCache::~ZoneSegmentCache() {
+  low_water_ = length_;
+  Trim();
+  ASSERT(head_ == NULL);
+}
+
+
+uint8_t* ZoneSegmentCache::Take() {
+  if (head_ == NULL) {
+    return NULL;
+  }
+  Entry* entry = head_;
+  head_ = entry->next;
+  length_--;
+  if (length_ < low_water_) {
+    low_water_ = length_;
+  }
+  reused_++;
+  return reinterpret_cast<uint8_t*>(entry);
+}
+
+
+bool ZoneSegmentCache::Put(uint8_t* memory) {
+  if (length_ >= FLAG_zone_segment_cache_size) {
+    return false;
+  }
+  Entry* entry = reinterpret_cast<Entry*>(memory);
+  entry->next = head_;
+  head_ = entry;
+  length_++;
+  return true;
+}
+
+
+void ZoneSegmentCache::Trim() {
+  // The cache never held fewer than 'low_water_' segments since the last
+  // trim, so that many of them were not needed.
+  for (intptr_t i = 0; i < low_water_; i++) {
+    ASSERT(head_ != NULL);
+    Entry* entry = head_;
+    head_ = entry->next;
+    delete[] reinterpret_cast<uint8_t*>(entry);
+  }
+  length_ -= low_water_;
+  low_water_ = length_;
+}
+
+
+void ZoneSegmentCache::RecordZoneSize(Zone::Kind kind, intptr_t size) {
+  ASSERT((kind >= 0) && (kind < Zone::kNumKinds));
+  if (size > zone_size_high_water_[kind]) {
+    zone_size_high_water_[kind] = size;
+  }
+}
+
+
+void ZoneSegmentCache::PrintStats() const {
+  static const char* kKindNames[Zone::kNumKinds] = {
+    "other", "compiler", "runtime call", "native call", "message", "api scope"
+  };
+  OS::Print("\tzone segments: %"Pd" in use at most, %"Pd" reused, "
+            "%"Pd" cached\n",
+            segments_high_water_, reused_, length_);
+  for (intptr_t i = 0; i < Zone::kNumKinds; i++) {
+    OS::Print("\tlargest %s zone: %"Pd"k\n",
+              kKindNames[i], (zone_size_high_water_[i] + KB - 1) / KB);
+  }
+}
+
+
+Zone::Zone(Kind kind)
     : initial_buffer_(buffer_, kInitialChunkSize),
       position_(initial_buffer_.start()),
       limit_(initial_buffer_.end()),
       head_(NULL),
       large_segments_(NULL),
       handles_(),
-      previous_(NULL) {
+      previous_(NULL),
+      kind_(kind) {
 #ifdef DEBUG
   // Zap the entire initial buffer.
   memset(initial_buffer_.pointer(), kZapUninitializedByte,
@@ -101,10 +241,14 @@ Zone::~Zone() {
 
 
 void Zone::DeleteAll() {
+  ZoneSegmentCache* cache = CurrentSegmentCache();
+  if (cache != NULL) {
+    cache->RecordZoneSize(kind_, SizeInBytes());
+  }
   // Traverse the chained list of segments, zapping (in debug mode)
   // and freeing every zone segment.
-  Segment::DeleteSegmentList(head_);
-  Segment::DeleteSegmentList(large_segments_);
+  Segment::DeleteSegmentList(head_, cache);
+  Segment::DeleteSegmentList(large_segments_, NULL);
 
   // Reset zone state.
 #ifdef DEBUG
@@ -157,7 +301,7 @@ uword Zone::AllocateExpand(intptr_t size) {
   }
 
   // Allocate another segment and chain it up.
-  head_ = Segment::New(kSegmentSize, head_);
+  head_ = Segment::New(kSegmentSize, head_, CurrentSegmentCache());
 
   // Recompute 'position' and 'limit' based on the new head segment.
   uword result = Utils::RoundUp(head_->start(), kAlignment);
@@ -181,7 +325,7 @@ uword Zone::AllocateLargeSegment(intptr_t size) {
   // Create a new large segment and chain it up.
   ASSERT(Utils::IsAligned(sizeof(Segment), kAlignment));
   size += sizeof(Segment);  // Account for book keeping fields in size.
-  large_segments_ = Segment::New(size, large_segments_);
+  large_segments_ = Segment::New(size, large_segments_, NULL);
 
   uword result = Utils::RoundUp(large_segments_->start(), kAlignment);
   return result;
@@ -209,9 +353,9 @@ void Zone::DumpZoneSizes() {
 #endif
 
 
-StackZone::StackZone(BaseIsolate* isolate)
+StackZone::StackZone(BaseIsolate* isolate, Zone::Kind kind)
     : StackResource(isolate),
-      zone_() {
+      zone_(kind) {
 #ifdef DEBUG
   if (FLAG_trace_zones) {
     OS::PrintErr("*** Starting a new Stack zone 0x%"Px"(0x%"Px")\n",
@@ -16,8 +16,22 @@ namespace dart {
 // chunks cannot be deallocated individually, but instead zones
 // support deallocating all chunks in one fast operation.
 
+class ZoneSegmentCache;
+
 class Zone {
  public:
+  // The subsystems whose zone usage is tracked separately by the
+  // ZoneSegmentCache of an isolate.
+  enum Kind {
+    kOther = 0,
+    kCompiler,
+    kRuntimeCall,
+    kNativeCall,
+    kMessage,
+    kApiScope,
+    kNumKinds
+  };
+
   // Allocate an array sized to hold 'len' elements of type
   // 'ElementType'.  Checks for integer overflow when performing the
   // size computation.
@@ -57,7 +71,7 @@ class Zone {
   void VisitObjectPointers(ObjectPointerVisitor* visitor);
 
  private:
-  Zone();
+  explicit Zone(Kind kind = kOther);
   ~Zone();  // Delete all memory associated with the zone.
 
   // All pointers returned from AllocateUnsafe() and New() have this alignment.
@@ -81,6 +95,13 @@ class Zone {
   // Allocate a large segment.
   uword AllocateLargeSegment(intptr_t size);
 
+  // Allocate and free the memory of a segment, going through 'cache' for
+  // segments of the standard size if it is not NULL.
+  static uint8_t* AllocateSegmentMemory(intptr_t size, ZoneSegmentCache* cache);
+  static void FreeSegmentMemory(uint8_t* memory,
+                                intptr_t size,
+                                ZoneSegmentCache* cache);
+
   // Insert zone into zone chain, after current_zone.
   void Link(Zone* current_zone) {
     previous_ = current_zone;
@@ -124,17 +145,67 @@ class Zone {
   // Used for chaining zones in order to allow unwinding of stacks.
   Zone* previous_;
 
+  // The subsystem this zone is used by.
+  const Kind kind_;
+
   friend class StackZone;
   friend class ApiZone;
+  friend class ZoneSegmentCache;
   template<typename T, typename B> friend class BaseGrowableArray;
   DISALLOW_COPY_AND_ASSIGN(Zone);
 };
 
 
+// Keeps the standard size segments freed by the zones of an isolate for reuse
+// by its later zones, which saves a malloc and free for every segment of the
+// many short lived zones. At most FLAG_zone_segment_cache_size segments are
+// kept, and Trim releases the ones that were not needed since the last call.
+// The cache also records the zone usage of each subsystem.
+class ZoneSegmentCache {
+ public:
+  ZoneSegmentCache();
+  ~ZoneSegmentCache();
+
+  // Called when the isolate goes idle.
+  void Trim();
+
+  intptr_t length() const { return length_; }
+
+  // Largest number of standard size segments in use at the same time.
+  intptr_t segments_high_water() const { return segments_high_water_; }
+
+  // Size of the largest zone of the given kind deleted so far.
+  intptr_t zone_size_high_water(Zone::Kind kind) const {
+    ASSERT((kind >= 0) && (kind < Zone::kNumKinds));
+    return zone_size_high_water_[kind];
+  }
+
+  void PrintStats() const;
+
+ private:
+  class Entry;
+
+  uint8_t* Take();
+  bool Put(uint8_t* memory);
+  void RecordZoneSize(Zone::Kind kind, intptr_t size);
+
+  Entry* head_;
+  intptr_t length_;
+  intptr_t low_water_;  // Smallest length since the last Trim.
+  intptr_t reused_;  // Number of segments taken from the cache.
+  intptr_t segments_in_use_;
+  intptr_t segments_high_water_;
+  intptr_t zone_size_high_water_[Zone::kNumKinds];
+
+  friend class Zone;
+  DISALLOW_COPY_AND_ASSIGN(ZoneSegmentCache);
+};
+
+
 class StackZone : public StackResource {
  public:
   // Create an empty zone and set is at the current zone for the Isolate.
-  explicit StackZone(BaseIsolate* isolate);
+  explicit StackZone(BaseIsolate* isolate, Zone::Kind kind = Zone::kOther);
 
   // Delete all memory associated with the zone.
   ~StackZone();
@@ -11,6 +11,7 @@
 namespace dart {
 
 DECLARE_DEBUG_FLAG(bool, trace_zones);
+DECLARE_FLAG(int, zone_segment_cache_size);
 
 UNIT_TEST_CASE(AllocateZone) {
 #if defined(DEBUG)
@@ -164,6 +165,64 @@ UNIT_TEST_CASE(ZoneAllocated) {
 }
 
 
+UNIT_TEST_CASE(ZoneSegmentCache) {
+  Isolate* isolate = Isolate::Init(NULL);
+  EXPECT(Isolate::Current() == isolate);
+  ZoneSegmentCache* cache = isolate->zone_segment_cache();
+  EXPECT(cache != NULL);
+  // Every trim releases the segments not taken since the previous one.
+  cache->Trim();
+  cache->Trim();
+  EXPECT_EQ(0, cache->length());
+
+  // Each allocation needs a segment of its own.
+  const intptr_t kAllocSize = 40 * KB;
+  {
+    StackZone zone(isolate);
+    for (int i = 0; i < 3; i++) {
+      EXPECT(zone.GetZone()->AllocUnsafe(kAllocSize) != 0);
+    }
+  }
+  EXPECT_EQ(3, cache->length());
+  EXPECT_LE(3, cache->segments_high_water());
+  EXPECT_LE(3 * kAllocSize, cache->zone_size_high_water(Zone::kOther));
+  cache->Trim();
+  EXPECT_EQ(3, cache->length());
+
+  // A new zone reuses the cached segments.
+  {
+    StackZone zone(isolate, Zone::kCompiler);
+    for (int i = 0; i < 2; i++) {
+      EXPECT(zone.GetZone()->AllocUnsafe(kAllocSize) != 0);
+    }
+    EXPECT_EQ(1, cache->length());
+  }
+  EXPECT_EQ(3, cache->length());
+  EXPECT_LE(2 * kAllocSize, cache->zone_size_high_water(Zone::kCompiler));
+
+  // One segment stayed in the cache while the compiler zone was alive.
+  cache->Trim();
+  EXPECT_EQ(2, cache->length());
+  cache->Trim();
+  EXPECT_EQ(0, cache->length());
+
+  // The cache does not grow beyond its cap.
+  const int saved_cache_size = FLAG_zone_segment_cache_size;
+  FLAG_zone_segment_cache_size = 2;
+  {
+    StackZone zone(isolate);
+    for (int i = 0; i < 3; i++) {
+      EXPECT(zone.GetZone()->AllocUnsafe(kAllocSize) != 0);
+    }
+  }
+  EXPECT_EQ(2, cache->length());
+  FLAG_zone_segment_cache_size = saved_cache_size;
+
+  isolate->Shutdown();
+  delete isolate;
+}
+
+
 TEST_CASE(PrintToString) {
   StackZone zone(Isolate::Current());
   const char* result = zone.GetZone()->PrintToString("Hello %s!", "World");
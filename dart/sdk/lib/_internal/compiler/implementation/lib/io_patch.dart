@@ -6,6 +6,9 @@ patch class _BufferUtils {
   patch static bool _isBuiltinList(List buffer) {
     throw new UnsupportedError("_isBuiltinList");
   }
+  patch static Uint8List _newPinnableBuffer(int length) {
+    throw new UnsupportedError("_newPinnableBuffer");
+  }
 }
 
 patch class _Directory {
@@ -11,7 +11,11 @@ part of dart.io;
 class _BufferList {
   const int _INIT_SIZE = 1 * 1024;
 
-  _BufferList() {
+  /**
+   * If [pinnable] is true, the buffers are allocated such that native code
+   * can use their data without copying, e.g. when they are compressed.
+   */
+  _BufferList({bool pinnable: false}) : _pinnable = pinnable {
     clear();
   }
 
@@ -34,12 +38,12 @@ class _BufferList {
     if (_buffer == null) {
       int size = pow2roundup(required);
       if (size < _INIT_SIZE) size = _INIT_SIZE;
-      _buffer = new Uint8List(size);
+      _buffer = _newBuffer(size);
     } else if (_buffer.length < required) {
       // This will give is a list in the range of 2-4 times larger than
       // required.
       int size = pow2roundup(required) * 2;
-      Uint8List newBuffer = new Uint8List(size);
+      Uint8List newBuffer = _newBuffer(size);
       newBuffer.setRange(0, _buffer.length, _buffer);
       _buffer = newBuffer;
     }
@@ -54,6 +58,11 @@ class _BufferList {
     _length = required;
   }
 
+  Uint8List _newBuffer(int size) {
+    if (_pinnable) return _BufferUtils._newPinnableBuffer(size);
+    return new Uint8List(size);
+  }
+
   /**
    * Same as [add].
    */
@@ -92,4 +101,5 @@ class _BufferList {
 
   int _length;  // Total number of bytes in the buffer.
   Uint8List _buffer;  // Internal buffer.
+  final bool _pinnable;  // Whether buffers are allocated to be pinned.
 }
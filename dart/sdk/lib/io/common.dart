@@ -130,6 +130,11 @@ class _BufferUtils {
   // if the List is a builtin VM List type and false if it is
   // a user defined List type.
   external static bool _isBuiltinList(List buffer);
+
+  // Allocate a byte buffer whose data is not moved by the garbage collector.
+  // Native code such as the zlib filters can use the data of such a buffer
+  // without copying it.
+  external static Uint8List _newPinnableBuffer(int length);
 }
 
 class _IOCrypto {
@@ -499,9 +499,10 @@ abstract class _HttpOutboundMessage<T> implements IOSink {
       stream.fold(null, (x, y) {}).catchError((_) {});
       return _headersSink.close();
     }
-    stream = stream.transform(new _BufferTransformer());
+    bool gzip = headers.chunkedTransferEncoding && _asGZip;
+    stream = stream.transform(new _BufferTransformer(pinnable: gzip));
     if (headers.chunkedTransferEncoding) {
-      if (_asGZip) {
+      if (gzip) {
         stream = stream.transform(new ZLibDeflater(gzip: true, level: 6));
       }
       stream = stream.transform(new _ChunkedTransformer());
@@ -622,7 +623,12 @@ class _BufferTransformer extends StreamEventTransformer<List<int>, List<int>> {
   const int MIN_CHUNK_SIZE = 4 * 1024;
   const int MAX_BUFFER_SIZE = 16 * 1024;
 
-  final _BufferList _buffer = new _BufferList();
+  final _BufferList _buffer;
+
+  // If [pinnable] is true, the buffered data is allocated such that it can
+  // be handed to a following ZLibDeflater without copying.
+  _BufferTransformer({bool pinnable: false})
+      : _buffer = new _BufferList(pinnable: pinnable);
 
   void handleData(List<int> data, EventSink<List<int>> sink) {
     // TODO(ajohnsen): Use timeout?
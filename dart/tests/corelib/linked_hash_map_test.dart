@@ -109,8 +109,65 @@ class LinkedHashMapTest {
     map.values.forEach(testForEachValue);
     verifyValues(valuesAfterAUpdate);
   }
+
+  // Grows the map, removes most of the keys and adds them again so that the
+  // table is rebuilt several times, and checks that the insertion order is
+  // kept throughout.
+  static void testGrowAndRemove() {
+    Map map = new LinkedHashMap();
+    List expected = [];
+    for (int i = 0; i < 1000; i++) {
+      map[new Collider(i)] = i;
+      expected.add(i);
+    }
+    map[null] = -1;
+    expected.add(null);
+    for (int round = 0; round < 3; round++) {
+      for (int i = round; i < 1000; i += 3) {
+        Expect.equals(i, map.remove(new Collider(i)));
+        expected.remove(i);
+      }
+      for (int i = round; i < 1000; i += 3) {
+        Expect.isNull(map[new Collider(i)]);
+        Expect.equals(i, map.putIfAbsent(new Collider(i), () => i));
+        expected.add(i);
+      }
+      Expect.equals(expected.length, map.length);
+      Expect.listEquals(expected,
+                        map.keys.map((k) => k == null ? null : k.value)
+                            .toList());
+      Expect.listEquals(expected.map((k) => k == null ? -1 : k).toList(),
+                        map.values.toList());
+    }
+    Expect.equals(-1, map[null]);
+    Expect.isTrue(map.containsKey(new Collider(999)));
+    Expect.isTrue(map.containsValue(999));
+    Expect.isFalse(map.containsKey(new Collider(1000)));
+
+    // Adding a key from putIfAbsent is a concurrent modification of the map,
+    // the key must still only be in the map once.
+    map.putIfAbsent(new Collider(2000), () {
+      map[new Collider(2000)] = 1;
+      return 2;
+    });
+    Expect.equals(2, map[new Collider(2000)]);
+    Expect.equals(expected.length + 1, map.length);
+
+    map.clear();
+    Expect.isTrue(map.isEmpty);
+    Expect.isNull(map[new Collider(1)]);
+  }
+}
+
+// Keys whose hash codes collide in groups of eight.
+class Collider {
+  final int value;
+  Collider(this.value);
+  int get hashCode => value ~/ 8;
+  bool operator ==(other) => other is Collider && other.value == value;
 }
 
 main() {
   LinkedHashMapTest.testMain();
+  LinkedHashMapTest.testGrowAndRemove();
 }
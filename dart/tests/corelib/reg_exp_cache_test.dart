@@ -0,0 +1,65 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+import "package:expect/expect.dart";
+
+// Dart test program for RegExps created repeatedly with the same and with
+// different patterns and flags, and for allMatches on one-byte and two-byte
+// subjects.
+
+testFlags() {
+  for (int i = 0; i < 3; i++) {
+    var plain = new RegExp("^a(b)");
+    var multiLine = new RegExp("^a(b)", multiLine: true);
+    var ignoreCase = new RegExp("^a(b)", caseSensitive: false);
+    Expect.isFalse(plain.isMultiLine);
+    Expect.isTrue(plain.isCaseSensitive);
+    Expect.isTrue(multiLine.isMultiLine);
+    Expect.isFalse(ignoreCase.isCaseSensitive);
+    Expect.isNull(plain.firstMatch("x\nab"));
+    Expect.equals("b", multiLine.firstMatch("x\nab").group(1));
+    Expect.isNull(multiLine.firstMatch("x\nAB"));
+    Expect.equals("B", ignoreCase.firstMatch("AB").group(1));
+  }
+}
+
+testManyPatterns() {
+  for (int round = 0; round < 3; round++) {
+    for (int i = 0; i < 300; i++) {
+      var re = new RegExp("x($i)y");
+      Expect.equals("x${i}y", re.pattern);
+      Expect.equals("$i", re.firstMatch("ax${i}y").group(1));
+      Expect.isNull(re.firstMatch("x${i + 1}y"));
+    }
+  }
+}
+
+testAllMatches(String subject, String word) {
+  var re = new RegExp("($word)(\\d)");
+  var matches = re.allMatches(subject).toList();
+  Expect.equals(3, matches.length);
+  for (int i = 0; i < 3; i++) {
+    Expect.equals(word, matches[i].group(1));
+    Expect.equals("$i", matches[i].group(2));
+    Expect.equals(subject.indexOf("$word$i"), matches[i].start);
+  }
+  var empty = new RegExp("(x*)").allMatches(subject).toList();
+  Expect.equals(subject.length + 1, empty.length);
+  Expect.equals(0, empty.first.start);
+  Expect.equals(subject.length, empty.last.start);
+}
+
+main() {
+  testFlags();
+  testManyPatterns();
+  testAllMatches("a0 --- a1 --- a2 -", "a");
+  testAllMatches("☃…0 ☃…1 ☃…2 -", "☃…");
+  var concatenated = "";
+  for (var char in "b0 --- b1 --- b2 -".split("")) {
+    concatenated = concatenated + char;
+  }
+  testAllMatches(concatenated, "b");
+  Expect.throws(() => new RegExp("(a"), (e) => e is FormatException);
+  Expect.throws(() => new RegExp("(a"), (e) => e is FormatException);
+}
@@ -0,0 +1,23 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+// Dart test program for the VM's cache of compiled RegExps.
+
+import "package:expect/expect.dart";
+
+main() {
+  for (int i = 0; i < 3; i++) {
+    var first = new RegExp("a(b)c");
+    Expect.identical(first, new RegExp("a(b)c"));
+    Expect.identical(first, new RegExp("a(b)c", multiLine: false));
+    var multiLine = new RegExp("a(b)c", multiLine: true);
+    Expect.isFalse(identical(first, multiLine));
+    Expect.identical(multiLine, new RegExp("a(b)c", multiLine: true));
+    var ignoreCase = new RegExp("a(b)c", caseSensitive: false);
+    Expect.isFalse(identical(first, ignoreCase));
+    Expect.isFalse(identical(multiLine, ignoreCase));
+    Expect.identical(ignoreCase, new RegExp("a(b)c", caseSensitive: false));
+    Expect.isFalse(identical(first, new RegExp("a(b)d")));
+    Expect.equals("b", first.firstMatch("xabc").group(1));
+  }
+}
@@ -0,0 +1,115 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+import "package:expect/expect.dart";
+
+// Dart test program for RegExp patterns without groups or alternatives, on
+// one-byte and two-byte subjects.
+
+match(String pattern, String subject, String expected,
+      {bool multiLine: false, bool caseSensitive: true}) {
+  var re = new RegExp(pattern, multiLine: multiLine,
+                      caseSensitive: caseSensitive);
+  var m = re.firstMatch(subject);
+  if (expected == null) {
+    Expect.isNull(m, "$pattern on $subject");
+  } else {
+    Expect.isNotNull(m, "$pattern on $subject");
+    Expect.equals(expected, m.group(0), "$pattern on $subject");
+    Expect.equals(subject.indexOf(expected, m.start), m.start);
+    Expect.equals(0, m.groupCount);
+  }
+}
+
+testLiterals() {
+  match("foo", "a foo b", "foo");
+  match("foo", "fofoo", "foo");
+  match("foo", "fo", null);
+  match("", "abc", "");
+  match("a\\.b", "axb a.b", "a.b");
+  match("\\x41\\u2603", "xA\u2603", "A\u2603");
+  match("\u2603", "abc", null);
+  match("\u00e9t\u00e9", "\u00e9t\u00e9", "\u00e9t\u00e9");
+  match("\\t\\n", "a\t\nb", "\t\n");
+}
+
+testClasses() {
+  match("[a-c]+", "xxbcaz", "bca");
+  match("[^a-c]+", "abxyc", "xy");
+  match("\\d+", "ab12345c", "12345");
+  match("\\D+", "12ab3", "ab");
+  match("\\w+", "  foo_1 ", "foo_1");
+  match("\\w", "\u00e9\u2603", null);
+  match("\\W+", "ab\u00e9\u2603-c", "\u00e9\u2603-");
+  match("\\s+", "a \t\nb", " \t\n");
+  match("\\S+", "  \u2603x ", "\u2603x");
+  match("[\\d_]+", "ab1_2c", "1_2");
+  match("[\\d-z]+", "a1-zb", "1-z");
+  match("[^\\W\\d]+", "12ab3", "ab");
+  match("[\u00e0-\u00ff]+", "a\u00e9\u00e8b", "\u00e9\u00e8");
+  match("[\u2600-\u26ff]+", "a\u2603\u2604b", "\u2603\u2604");
+  match("[^\u2600-\u26ff]+", "\u2603ab\u2604", "ab");
+  match(".+", "ab\ncd", "ab");
+  match(".+", "\u2028ab\u2029", "ab");
+}
+
+testQuantifiers() {
+  match("a*", "baa", "");
+  match("ba*", "baaa", "baaa");
+  match("ba*?", "baaa", "b");
+  match("ba+?", "baaa", "ba");
+  match("ba?a", "baaa", "baa");
+  match("ba{2}", "baaa", "baa");
+  match("ba{2,}", "baaaa", "baaaa");
+  match("ba{1,3}", "baaaa", "baaa");
+  match("ba{1,3}?", "baaaa", "ba");
+  match("a{3}", "aabaa", null);
+  match("a.*b", "xaxbxbx", "axbxb");
+  match("a.*?b", "xaxbxbx", "axb");
+  match("\\d+\\.\\d*x", "12.34.5x", "34.5x");
+  match("a{2}{", "aa{", "aa{");  // Not a quantifier.
+}
+
+testAnchors() {
+  match("^a", "ba", null);
+  match("^b", "ba", "b");
+  match("a\$", "ab", null);
+  match("b\$", "ab", "b");
+  match("^\\w+", "ab\ncd", "ab");
+  match("^c", "ab\ncd", null);
+  match("^c", "ab\ncd", "c", multiLine: true);
+  match("b\$", "ab\ncd", "b", multiLine: true);
+  match("b\$", "ab\ncd", null);
+  match("^d", "ab\u2028d", "d", multiLine: true);
+  match("\\bfoo\\b", "afoo foo", "foo");
+  match("\\Boo\\B", "foo oox", null);
+  match("\\Bo", "foo", "o");
+  match("\\b\u2603", "\u2603", null);
+}
+
+testIgnoreCase() {
+  match("foo", "xFoO", "FoO", caseSensitive: false);
+  match("[a-c]+", "xAbCd", "AbC", caseSensitive: false);
+  match("[^a]+", "aAbB", "bB", caseSensitive: false);
+  match("\\w+", "-Ab_", "Ab_", caseSensitive: false);
+  match("@", "`@", "@", caseSensitive: false);
+  match("\u00e9", "\u00c9", "\u00c9", caseSensitive: false);
+}
+
+testAllMatches() {
+  var re = new RegExp("\\d+");
+  var matches = re.allMatches("a12b3").map((m) => m.group(0)).toList();
+  Expect.listEquals(["12", "3"], matches);
+  Expect.equals("a-b-c", "a1b22c".replaceAll(new RegExp("\\d+"), "-"));
+  Expect.listEquals(["a", "b", "c"], "a, b,c".split(new RegExp(", *")));
+}
+
+main() {
+  testLiterals();
+  testClasses();
+  testQuantifiers();
+  testAnchors();
+  testIgnoreCase();
+  testAllMatches();
+}
@@ -75,6 +75,28 @@ testIdentity(x) {
   return x * y + x * z;
 }
 
+testArray(c, x, y) {
+  // Fixed-length list of constant length that does not escape: elements are
+  // accessed through constant indices only. List literals are not sunk
+  // because they are passed to the List._fromLiteral factory.
+  var a = new List(2);
+  a[0] = x - 0.5;
+  a[1] = y + 0.5;
+  // On deoptimization the list is materialized and its elements are read
+  // by the unoptimized code.
+  var d = c.p * new Point(a[0], a[1]);
+  return d + a[0] * a[1];
+}
+
+testClosure(c, x, y) {
+  // Local closure whose invocations are all inlined.
+  var f = (v) => v * 2.0;
+  var d = c.p * new Point(f(x), f(y));
+  // On deoptimization the closure is materialized and called by the
+  // unoptimized code.
+  return f(d);
+}
+
 class PointP<T> {
   var x, y;
 
@@ -94,12 +116,16 @@ main() {
   final x0 = test1(c, 11.11, 22.22);
   final y0 = testForwardingThroughEffects(c, 11.11, 22.22);
   final z0 = testIdentity(c.p);
+  final w0 = testArray(c, 11.11, 22.22);
+  final v0 = testClosure(c, 11.11, 22.22);
 
   // Force optimization.
   for (var i = 0; i < 10000; i++) {
     test1(c, i.toDouble(), i.toDouble());
     testForwardingThroughEffects(c, i.toDouble(), i.toDouble());
     testIdentity(c.p);
+    testArray(c, i.toDouble(), i.toDouble());
+    testClosure(c, i.toDouble(), i.toDouble());
     foo2();
   }
 
@@ -129,4 +155,16 @@ main() {
   final z2 = testIdentity(new F(c.p));
   Expect.equals(z0, z1);
   Expect.equals(z0, z2);
+
+  // Test that arrays are materialized with correct elements on deopt.
+  final w1 = testArray(c, 11.11, 22.22);
+  final w2 = testArray(new D(c.p), 11.11, 22.22);
+  Expect.equals(w0, w1);
+  Expect.equals(w0, w2);
+
+  // Test that closures are materialized and callable on deopt.
+  final v1 = testClosure(c, 11.11, 22.22);
+  final v2 = testClosure(new D(c.p), 11.11, 22.22);
+  Expect.equals(v0, v1);
+  Expect.equals(v0, v2);
 }
\ No newline at end of file
@@ -0,0 +1,62 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+// Test that functions whose unoptimized code was dropped by code aging are
+// compiled again when they are called through static, instance and closure
+// calls.
+// VMOptions=--code_aging_threshold=1
+// VMOptions=--code_aging_threshold=1 --optimization-counter-threshold=10
+
+import "package:expect/expect.dart";
+
+class A {
+  foo(x) => x + 1;
+}
+
+class B extends A {
+  foo(x) => x + 2;
+}
+
+coldStatic(x) => x * 2;
+
+callFoo(a, x) => a.foo(x);
+
+callAll(a, b, closure, x) {
+  return coldStatic(x) + callFoo(a, x) + callFoo(b, x) + closure(x);
+}
+
+// Triggers old space collections by allocating large lists.
+collectOldSpace() {
+  var l;
+  for (var i = 0; i < 50; i++) {
+    l = new List(1000000);
+  }
+  return l.length;
+}
+
+main() {
+  var a = new A();
+  var b = new B();
+  var closure = (x) => x - 1;
+  for (var round = 0; round < 3; round++) {
+    Expect.equals(2, coldStatic(1));
+    Expect.equals(2, callFoo(a, 1));
+    Expect.equals(0, closure(1));
+    collectOldSpace();
+  }
+
+  // Monomorphic call site whose target was dropped becomes polymorphic.
+  Expect.equals(2, callFoo(a, 1));
+  collectOldSpace();
+  Expect.equals(3, callFoo(b, 1));
+
+  // Optimized code calling functions whose code is dropped.
+  for (var i = 0; i < 50; i++) {
+    Expect.equals(5 * i + 2, callAll(a, b, closure, i));
+  }
+  collectOldSpace();
+  Expect.equals(52, callAll(a, b, closure, 10));
+  collectOldSpace();
+  collectOldSpace();
+  Expect.equals(52, callAll(a, b, closure, 10));
+}
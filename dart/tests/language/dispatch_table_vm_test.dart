@@ -0,0 +1,84 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+// Test that megamorphic calls through the dispatch table find the right
+// target for many receiver classes, for classes first instantiated after the
+// call is optimized, for method extraction, for targets that are not compiled
+// yet and for noSuchMethod, also when only the argument names do not match.
+// VMOptions=--optimization-counter-threshold=10
+// VMOptions=--optimization-counter-threshold=10 --no-use-dispatch-table
+
+import "package:expect/expect.dart";
+
+class A {
+  foo(x) => x + 1;
+  bar({y: 0}) => y;
+}
+
+class B extends A {
+  foo(x) => x + 2;
+}
+
+class C extends A {
+  foo(x) => x + 3;
+  bar({y: 0}) => y + 3;
+}
+
+class D extends A {
+  foo(x) => x + 4;
+}
+
+class E {
+  foo(x) => x + 5;
+  bar({y: 0}) => y + 5;
+}
+
+class F extends E {
+  foo(x) => x + 6;
+}
+
+class NoFoo {
+  noSuchMethod(invocation) => -1;
+}
+
+class WrongName {
+  bar({z: 0}) => z;
+  noSuchMethod(invocation) => -2;
+}
+
+// Finalized with the other classes when the script is loaded, but only
+// instantiated after the call sites are optimized. Classes finalized after
+// the table is built are covered by the DispatchTable unit test.
+class Late extends E {
+  foo(x) => x + 7;
+  bar({y: 0}) => y + 7;
+}
+
+callFoo(o, x) => o.foo(x);
+callBar(o, y) => o.bar(y: y);
+callGetter(o) => o.foo;
+
+main() {
+  var receivers = [new A(), new B(), new C(), new D(), new E(), new F()];
+  for (var i = 0; i < 50; i++) {
+    for (var j = 0; j < receivers.length; j++) {
+      Expect.equals(i + j + 1, callFoo(receivers[j], i));
+      Expect.equals(i + (j == 2 ? 3 : (j >= 4 ? 5 : 0)),
+                    callBar(receivers[j], i));
+      Expect.equals(i + j + 1, callGetter(receivers[j])(i));
+    }
+  }
+  Expect.equals(-1, callFoo(new NoFoo(), 1));
+  Expect.equals(-1, callBar(new NoFoo(), 1));
+  Expect.equals(-2, callBar(new WrongName(), 1));
+  Expect.throws(() => callFoo(null, 1), (e) => e is NoSuchMethodError);
+  Expect.throws(() => callFoo(1, 1), (e) => e is NoSuchMethodError);
+
+  var late = new Late();
+  for (var i = 0; i < 50; i++) {
+    Expect.equals(i + 7, callFoo(late, i));
+    Expect.equals(i + 7, callBar(late, i));
+    Expect.equals(i + 7, callGetter(late)(i));
+    Expect.equals(i + 1, callFoo(receivers[0], i));
+  }
+}
@@ -0,0 +1,80 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+// Test that roundToDouble and dart:math min and max computed inline in
+// optimized code handle halfway cases, signed zeros, infinities and NaN.
+// VMOptions=--optimization-counter-threshold=10
+// VMOptions=--optimization-counter-threshold=10 --no-use-sse41
+
+import "package:expect/expect.dart";
+import "dart:math";
+
+round(double d) => d.roundToDouble();
+
+// Multiplying by 1.0 makes the arguments known doubles without changing the
+// sign of zeros.
+doubleMin(double a, double b) => min(a * 1.0, b * 1.0);
+doubleMax(double a, double b) => max(a * 1.0, b * 1.0);
+smiMin(int a, int b) => min(a & 0xFFFF, b & 0xFFFF);
+smiMax(int a, int b) => max(a & 0xFFFF, b & 0xFFFF);
+
+isNegativeZero(d) => (d == 0.0) && d.isNegative;
+
+testRound() {
+  Expect.equals(3.0, round(2.5));
+  Expect.equals(-3.0, round(-2.5));
+  Expect.equals(2.0, round(2.4999999999999996));
+  Expect.equals(0.0, round(0.49999999999999994));
+  Expect.equals(1.0, round(0.5));
+  Expect.equals(-1.0, round(-0.5));
+  Expect.equals(4503599627370497.0, round(4503599627370497.0));
+  Expect.isTrue(isNegativeZero(round(-0.0)));
+  Expect.isTrue(isNegativeZero(round(-0.3)));
+  Expect.isFalse(isNegativeZero(round(0.3)));
+  Expect.equals(double.INFINITY, round(double.INFINITY));
+  Expect.equals(double.NEGATIVE_INFINITY, round(double.NEGATIVE_INFINITY));
+  Expect.isTrue(round(double.NAN).isNaN);
+}
+
+testMinMax() {
+  Expect.equals(1.5, doubleMin(1.5, 2.5));
+  Expect.equals(1.5, doubleMin(2.5, 1.5));
+  Expect.equals(2.5, doubleMax(1.5, 2.5));
+  Expect.equals(2.5, doubleMax(2.5, 1.5));
+  Expect.isTrue(isNegativeZero(doubleMin(0.0, -0.0)));
+  Expect.isTrue(isNegativeZero(doubleMin(-0.0, 0.0)));
+  Expect.isFalse(isNegativeZero(doubleMax(0.0, -0.0)));
+  Expect.isFalse(isNegativeZero(doubleMax(-0.0, 0.0)));
+  Expect.isTrue(doubleMin(double.NAN, 1.0).isNaN);
+  Expect.isTrue(doubleMin(1.0, double.NAN).isNaN);
+  Expect.isTrue(doubleMax(double.NAN, 1.0).isNaN);
+  Expect.isTrue(doubleMax(1.0, double.NAN).isNaN);
+  Expect.equals(double.NEGATIVE_INFINITY,
+                doubleMin(double.NEGATIVE_INFINITY, 1.0));
+  Expect.equals(double.INFINITY, doubleMax(double.INFINITY, 1.0));
+  Expect.equals(3, smiMin(3, 7));
+  Expect.equals(3, smiMin(7, 3));
+  Expect.equals(7, smiMax(3, 7));
+  Expect.equals(7, smiMax(7, 3));
+  Expect.equals(5, smiMax(5, 5));
+}
+
+// Calls with constant arguments are folded by constant propagation.
+testConstantMinMax() {
+  Expect.equals(1.5, min(1.5, 2.5));
+  Expect.equals(2.5, max(2.5, 1.5));
+  Expect.isTrue(isNegativeZero(min(0.0, -0.0)));
+  Expect.isTrue(isNegativeZero(min(-0.0, 0.0)));
+  Expect.isFalse(isNegativeZero(max(-0.0, 0.0)));
+  Expect.isTrue(max(double.NAN, 1.0).isNaN);
+  Expect.equals(3, min(3, 7));
+  Expect.equals(7, max(7, 3));
+}
+
+main() {
+  for (var i = 0; i < 50; i++) {
+    testRound();
+    testMinMax();
+    testConstantMinMax();
+  }
+}
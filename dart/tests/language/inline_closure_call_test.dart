@@ -0,0 +1,43 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+// Test inlining of closure calls where the closure function is known from
+// the allocation site or from a constant closure.
+
+import "package:expect/expect.dart";
+
+twice(x) => 2 * x;
+
+applyConstant(x) {
+  var f = twice;  // Implicit static closure is a constant.
+  return f(x) + f(x + 1);
+}
+
+applyLocal(x, y) {
+  add(a) => a + y;
+  var sum = 0;
+  for (var i = 0; i < 3; i++) {
+    sum = add(sum) + x;
+  }
+  return sum;
+}
+
+applyMismatch(x) {
+  var f = twice;
+  try {
+    return f(x, x);  // Wrong number of arguments: must not be inlined.
+  } on NoSuchMethodError catch (e) {
+    return -1;
+  }
+}
+
+main() {
+  for (var i = 0; i < 2000; i++) {
+    Expect.equals(10, applyConstant(2));
+    Expect.equals(12, applyLocal(1, 3));
+    Expect.equals(-1, applyMismatch(2));
+  }
+  // Deoptimize the inlined closure bodies by passing doubles.
+  Expect.equals(10.0, applyConstant(2.0));
+  Expect.equals(12.0, applyLocal(1.0, 3.0));
+}
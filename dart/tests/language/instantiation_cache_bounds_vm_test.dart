@@ -0,0 +1,36 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+// Test that type arguments violating their bounds are not cached by the
+// instantiations cache, so that every allocation reports the violation in
+// checked mode, including allocations in optimized code that probe the cache.
+// VMOptions=--enable_type_checks --optimization-counter-threshold=10
+
+import "package:expect/expect.dart";
+
+class Bounded<T extends num> {
+  Bounded();
+  factory Bounded.make() => new Bounded<T>();
+}
+
+class A<T> {
+  makeFromFactory() => new Bounded<T>.make();
+  make() => new Bounded<T>();
+}
+
+isTypeError(e) => e is TypeError;
+
+main() {
+  var ints = new A<int>();
+  var strings = new A<String>();
+  for (var i = 0; i < 50; i++) {
+    Expect.isTrue(ints.makeFromFactory() is Bounded<int>);
+    Expect.isTrue(ints.make() is Bounded<int>);
+  }
+  // The second call of each pair would hit the cache if the instantiation
+  // of the first call had been recorded in it.
+  for (var i = 0; i < 2; i++) {
+    Expect.throws(() => strings.makeFromFactory(), isTypeError);
+    Expect.throws(() => strings.make(), isTypeError);
+  }
+}
@@ -0,0 +1,60 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+// Test that type arguments instantiated through the instantiations cache are
+// correct when the cache hits, grows and overflows, including the type
+// arguments that optimized code passes to allocation stubs.
+// VMOptions=--optimization-counter-threshold=10
+// VMOptions=--optimization-counter-threshold=10 --max_cached_instantiations=1
+// VMOptions=--max_cached_instantiations=0
+
+import "package:expect/expect.dart";
+
+class Pair<S, T> {}
+
+class Box<S, T> {
+  Box();
+  factory Box.make() => new Box<S, T>();
+}
+
+class A<T> {
+  makeList() => new List<T>();
+  makePair() => new Pair<int, T>();
+  makeMap() => new Map<T, List<T>>();
+  makeBoxFromFactory() => new Box<int, T>.make();
+  makeBox() => new Box<int, T>();
+}
+
+check(a, isInt, isString) {
+  var l = a.makeList();
+  Expect.equals(isInt, l is List<int>);
+  Expect.equals(isString, l is List<String>);
+  var p = a.makePair();
+  Expect.isTrue(p is Pair<int, dynamic>);
+  Expect.equals(isInt, p is Pair<int, int>);
+  Expect.equals(isString, p is Pair<int, String>);
+  var m = a.makeMap();
+  Expect.equals(isInt, m is Map<int, List<int>>);
+  Expect.equals(isString, m is Map<String, List<String>>);
+  // The factory call instantiates <int, T> in the runtime, which fills the
+  // cache probed by the optimized allocation of the constructor call.
+  var f = a.makeBoxFromFactory();
+  var b = a.makeBox();
+  Expect.equals(f.runtimeType, b.runtimeType);
+  Expect.isTrue(b is Box<int, dynamic>);
+  Expect.equals(isInt, b is Box<int, int>);
+  Expect.equals(isString, b is Box<int, String>);
+}
+
+main() {
+  var ints = new A<int>();
+  var strings = new A<String>();
+  var doubles = new A<double>();
+  var raw = new A();
+  for (var i = 0; i < 50; i++) {
+    check(ints, true, false);
+    check(strings, false, true);
+    check(doubles, false, false);
+    check(raw, true, true);
+  }
+}
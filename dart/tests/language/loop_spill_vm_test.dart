@@ -0,0 +1,69 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+// Test that values spilled around nested loops and rematerialized constants
+// keep their values when more doubles and integers are live than there are
+// registers.
+// VMOptions=--optimization-counter-threshold=10
+
+import "package:expect/expect.dart";
+
+// Many doubles live across the inner loop, only some of them used inside it.
+double nested(int n) {
+  double a = 1.0, b = 2.0, c = 3.0, d = 4.0, e = 5.0, f = 6.0, g = 7.0;
+  double h = 8.0, k = 9.0, l = 10.0, m = 11.0, o = 12.0, p = 13.0;
+  double q = 14.0, r = 15.0, s = 16.0, t = 17.0;
+  double sum = 0.0;
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      sum += a * 0.5 + b * 0.25;
+      a += 1.0;
+      b -= 1.0;
+    }
+    sum += c + d + e + f + g + h + k + l + m + o + p + q + r + s + t;
+    c += 0.5;
+    t -= 0.5;
+  }
+  return sum + a + b + c + t;
+}
+
+double nestedExpected(int n) {
+  double a = 1.0, b = 2.0, c = 3.0, t = 17.0;
+  double sum = 0.0;
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      sum += a * 0.5 + b * 0.25;
+      a += 1.0;
+      b -= 1.0;
+    }
+    sum += c + t + 4.0 + 5.0 + 6.0 + 7.0 + 8.0 + 9.0 + 10.0 + 11.0 +
+        12.0 + 13.0 + 14.0 + 15.0 + 16.0;
+    c += 0.5;
+    t -= 0.5;
+  }
+  return sum + a + b + c + t;
+}
+
+// Constants used in registers across a call in a loop.
+int constants(List<int> list) {
+  int result = 0;
+  for (int i = 0; i < list.length; i++) {
+    var x = list[i];
+    result += (x & 0x3FF) + (x ^ 0x155) + (x | 0x2AA) + id(x) + (x >> 3);
+  }
+  return result;
+}
+
+id(x) => x;
+
+main() {
+  var list = new List<int>.generate(20, (i) => i * 37);
+  var expected = 0;
+  for (var x in list) {
+    expected += (x & 0x3FF) + (x ^ 0x155) + (x | 0x2AA) + x + (x >> 3);
+  }
+  for (var i = 0; i < 50; i++) {
+    Expect.equals(nestedExpected(i % 7), nested(i % 7));
+    Expect.equals(expected, constants(list));
+  }
+}
@@ -0,0 +1,55 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+// Test that instance call sites calling the target directly while
+// monomorphic dispatch correctly when they become polymorphic and when the
+// target is optimized or deoptimized.
+// VMOptions=--optimization-counter-threshold=10
+
+import "package:expect/expect.dart";
+
+class A {
+  foo(x) => x + 1;
+  bar() => 'A';
+}
+
+class B extends A {
+  foo(x) => x + 2;
+}
+
+class C {
+  foo(x) => x + 3;
+  bar() => 'C';
+}
+
+callFoo(o, x) => o.foo(x);
+callBar(o) => o.bar();
+
+main() {
+  var a = new A();
+  var b = new B();
+  var c = new C();
+
+  // Monomorphic call site, target gets optimized.
+  for (var i = 0; i < 50; i++) {
+    Expect.equals(i + 1, callFoo(a, i));
+  }
+  // Target deoptimizes on a double argument.
+  Expect.equals(2.5, callFoo(a, 1.5));
+  for (var i = 0; i < 50; i++) {
+    Expect.equals(i + 1, callFoo(a, i));
+  }
+  // Call site becomes polymorphic.
+  for (var i = 0; i < 50; i++) {
+    Expect.equals(i + 1, callFoo(a, i));
+    Expect.equals(i + 2, callFoo(b, i));
+    Expect.equals(i + 3, callFoo(c, i));
+  }
+
+  // Same target for different receiver classes.
+  for (var i = 0; i < 50; i++) {
+    Expect.equals('A', callBar(i.isEven ? a : b));
+  }
+  Expect.equals('C', callBar(c));
+  Expect.throws(() => callBar(1), (e) => e is NoSuchMethodError);
+}
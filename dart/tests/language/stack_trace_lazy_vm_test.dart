@@ -0,0 +1,102 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+// Test that stack traces are available to every handler that can observe
+// them, also when the VM skips collecting them for handlers that cannot.
+// VMOptions=--optimization-counter-threshold=10
+
+import "package:expect/expect.dart";
+
+class MyException {
+  final int value;
+  MyException(this.value);
+}
+
+thrower(int i) {
+  throw new MyException(i);
+}
+
+middle(int i) {
+  thrower(i);
+}
+
+checkTrace(trace) {
+  Expect.isNotNull(trace);
+  var text = trace.toString();
+  Expect.isTrue(text.contains("thrower"), text);
+  Expect.isTrue(text.contains("middle"), text);
+}
+
+catchWithTrace(int i) {
+  try {
+    middle(i);
+  } catch (e, s) {
+    Expect.equals(i, e.value);
+    checkTrace(s);
+    return true;
+  }
+  return false;
+}
+
+catchWithoutTrace(int i) {
+  try {
+    middle(i);
+  } catch (e) {
+    Expect.equals(i, e.value);
+    return true;
+  }
+  return false;
+}
+
+rethrowFromCatch(int i) {
+  try {
+    middle(i);
+  } catch (e) {
+    Expect.equals(i, e.value);
+    rethrow;
+  }
+}
+
+rethrowImplicitly(int i) {
+  try {
+    middle(i);
+  } on FormatException catch (e) {
+    Expect.fail("Unexpected $e");
+  }
+}
+
+rethrowInNestedTry(int i) {
+  try {
+    middle(i);
+  } catch (e) {
+    try {
+      rethrow;
+    } catch (e2, s2) {
+      Expect.identical(e, e2);
+      checkTrace(s2);
+      return true;
+    }
+  }
+  return false;
+}
+
+catchOuter(f, int i) {
+  try {
+    f(i);
+  } catch (e, s) {
+    Expect.equals(i, e.value);
+    checkTrace(s);
+    return true;
+  }
+  return false;
+}
+
+main() {
+  for (int i = 0; i < 30; i++) {
+    Expect.isTrue(catchWithTrace(i));
+    Expect.isTrue(catchWithoutTrace(i));
+    Expect.isTrue(catchOuter(rethrowFromCatch, i));
+    Expect.isTrue(catchOuter(rethrowImplicitly, i));
+    Expect.isTrue(rethrowInNestedTry(i));
+  }
+}
@@ -0,0 +1,75 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+// Test that strings built by many concatenations, whose characters the VM
+// only copies when they are first needed, behave like flat strings.
+// VMOptions=--optimization-counter-threshold=10
+
+import "package:expect/expect.dart";
+
+String append(List<String> parts) {
+  var result = "";
+  for (var part in parts) {
+    result = result + part;
+  }
+  return result;
+}
+
+String prepend(List<String> parts) {
+  var result = "";
+  for (var i = parts.length - 1; i >= 0; i--) {
+    result = parts[i] + result;
+  }
+  return result;
+}
+
+String halves(List<String> parts) {
+  var half = parts.length ~/ 2;
+  return append(parts.sublist(0, half)) + append(parts.sublist(half));
+}
+
+check(String expected, String actual, String needle) {
+  // Hash before anything flattens 'actual'.
+  Expect.equals(expected.hashCode, actual.hashCode);
+  Expect.equals(expected.length, actual.length);
+  Expect.isTrue(expected == actual);
+  Expect.isTrue(actual == expected);
+  Expect.equals(0, actual.compareTo(expected));
+  Expect.equals(0, expected.compareTo(actual));
+  for (var i = 0; i < expected.length; i += 7) {
+    Expect.equals(expected.codeUnitAt(i), actual.codeUnitAt(i));
+    Expect.equals(expected[i], actual[i]);
+  }
+  Expect.equals(expected.indexOf(needle), actual.indexOf(needle));
+  Expect.equals(expected.lastIndexOf(needle), actual.lastIndexOf(needle));
+  Expect.isTrue(actual.contains(needle));
+  Expect.isTrue(actual.startsWith(expected.substring(0, 20)));
+  Expect.isTrue(actual.endsWith(expected.substring(expected.length - 20)));
+  Expect.equals(expected.substring(100, 200), actual.substring(100, 200));
+  Expect.equals(expected.toUpperCase(), actual.toUpperCase());
+  Expect.equals("<$expected>", "<$actual>");
+  Expect.listEquals(expected.split(","), actual.split(","));
+  var map = new Map<String, int>();
+  map[actual] = 1;
+  Expect.equals(1, map[expected]);
+}
+
+test(List<String> parts, String needle) {
+  var expected = parts.join();
+  check(expected, append(parts), needle);
+  check(expected, prepend(parts), needle);
+  check(expected, halves(parts), needle);
+  Expect.isFalse(append(parts) == append(parts.reversed.toList()));
+}
+
+main() {
+  var oneByte = new List<String>.generate(500, (i) => "part$i,");
+  var twoByte = new List<String>.generate(500, (i) => "☃$i,");
+  var mixed = new List<String>.generate(500,
+      (i) => (i % 100 == 99) ? "é☃$i," : "part$i,");
+  for (var i = 0; i < 20; i++) {
+    test(oneByte, "part250,");
+    test(twoByte, "☃250,");
+    test(mixed, "é☃299,");
+  }
+}
@@ -0,0 +1,72 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+// Test that the intrinsified string ==, compareTo, startsWith, endsWith and
+// indexOf handle one-byte and two-byte strings, strings longer than a block
+// of 16 bytes and mismatches in every position.
+// VMOptions=--optimization-counter-threshold=10
+
+import "package:expect/expect.dart";
+
+equals(a, b) => a == b;
+compare(String a, String b) => a.compareTo(b);
+
+// Builds a fresh string so that identical() does not short-cut comparisons.
+copy(String s) => new String.fromCharCodes(s.codeUnits);
+
+testEquality(String base) {
+  Expect.isTrue(equals(base, copy(base)));
+  Expect.equals(0, compare(base, copy(base)));
+  for (var i = 0; i < base.length; i++) {
+    var codes = base.codeUnits.toList();
+    codes[i]++;
+    var bigger = new String.fromCharCodes(codes);
+    Expect.isFalse(equals(base, bigger));
+    Expect.isFalse(equals(bigger, base));
+    Expect.equals(-1, compare(base, bigger));
+    Expect.equals(1, compare(bigger, base));
+  }
+  var prefix = base.substring(0, base.length - 1);
+  Expect.isFalse(equals(base, prefix));
+  Expect.equals(1, compare(base, prefix));
+  Expect.equals(-1, compare(prefix, base));
+  Expect.isFalse(equals(base, 42));
+  Expect.isFalse(equals(base, null));
+}
+
+testSearch(String base, String needle) {
+  var text = "$base$needle$base$needle";
+  var first = base.length;
+  var second = 2 * base.length + needle.length;
+  Expect.isTrue(text.startsWith(base));
+  Expect.isFalse(text.startsWith(needle));
+  Expect.isTrue(text.endsWith(needle));
+  Expect.isTrue(text.startsWith(needle, first));
+  Expect.isFalse(text.startsWith(text + "x"));
+  Expect.equals(first, text.indexOf(needle));
+  Expect.equals(second, text.indexOf(needle, first + 1));
+  Expect.equals(-1, text.indexOf(needle, second + 1));
+  Expect.equals(-1, text.indexOf(needle + needle));
+  Expect.equals(3, text.indexOf("", 3));
+  Expect.isTrue(text.contains(needle));
+  Expect.isFalse(base.contains(needle));
+}
+
+main() {
+  var oneByte = "abcdefghijklmnopqrstuvwxyz0123456789";
+  var twoByte = "ሴbcdefghijklmnopqrstuvwxyz0123456789䌡";
+  for (var i = 0; i < 20; i++) {
+    testEquality(oneByte);
+    testEquality(twoByte);
+    testEquality("abc");
+    testSearch(oneByte, "aXa");
+    testSearch(oneByte, "Q");
+    testSearch(twoByte, "ሴX");
+    testSearch("xya", "zzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzz");
+    // Representations differ.
+    Expect.isFalse(equals("abc", "abሴ"));
+    Expect.equals(-1, compare("abc", "abሴ"));
+    Expect.equals(1, compare("Ā", "\xff"));
+    Expect.equals(-1, compare("ÿĀ", "Āÿ"));
+  }
+}
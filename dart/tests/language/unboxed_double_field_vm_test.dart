@@ -0,0 +1,71 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+// Test that double fields kept unboxed by optimized code do not leak
+// their mutable boxes and deoptimize when the field guard changes.
+// VMOptions=--optimization-counter-threshold=10
+
+import "package:expect/expect.dart";
+
+class Point {
+  var x;
+  var y;
+  Point(this.x, this.y);
+}
+
+move(p, dx, dy) {
+  p.x = p.x + dx;
+  p.y = p.y + dy;
+}
+
+// Reads the field in unoptimized code for the first iterations of the loop
+// in main, and in optimized code after that.
+getX(p) => p.x;
+
+class A {
+  double x;  // Null until assigned, the field guard must see that.
+}
+
+readX(a) => a.x;
+
+testImplicitNull() {
+  var a = new A();
+  for (var i = 0; i < 20; i++) {
+    a.x = i + 0.5;
+    Expect.equals(i + 0.5, readX(a));
+  }
+  Expect.isNull(readX(new A()));
+}
+
+main() {
+  var p = new Point(0.0, 0.0);
+  var saved = [];
+  for (var i = 0; i < 20; i++) {
+    move(p, 1.0, 2.0);
+    saved.add(getX(p));
+  }
+  for (var i = 0; i < 20; i++) {
+    // Values read earlier must not change when the field is updated.
+    Expect.equals(i + 1.0, saved[i]);
+  }
+  Expect.equals(20.0, p.x);
+  Expect.equals(40.0, p.y);
+
+  // Sharing a double between two fields must not make them alias.
+  var q = new Point(p.x, p.x);
+  move(q, 1.0, 0.0);
+  Expect.equals(21.0, q.x);
+  Expect.equals(20.0, q.y);
+  Expect.equals(20.0, p.x);
+
+  // Storing an integer changes the field guard and deoptimizes move.
+  var r = new Point(1, 2);
+  move(r, 1, 1);
+  Expect.equals(2, r.x);
+  Expect.equals(3, r.y);
+  move(p, 1.0, 1.0);
+  Expect.equals(21.0, p.x);
+  Expect.equals(41.0, p.y);
+
+  testImplicitNull();
+}
@@ -0,0 +1,71 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+// Test that bit manipulation on 32-bit typed data computed on unboxed values
+// produces the same results as the unoptimized code.
+// VMOptions=--optimization-counter-threshold=10
+
+import "package:expect/expect.dart";
+import "dart:typed_data";
+
+fnv(Uint32List list) {
+  var h = 0x811c9dc5;
+  for (var i = 0; i < list.length; i++) {
+    h = ((h ^ list[i]) * 0x01000193) & 0xFFFFFFFF;
+  }
+  return h;
+}
+
+mix(Int32List src, Int32List dst) {
+  for (var i = 0; i < src.length; i++) {
+    var s = src[i];
+    dst[i] = (s << 7) ^ (s >> 3);
+  }
+}
+
+rotate(Uint32List list) {
+  for (var i = 0; i < list.length; i++) {
+    var x = list[i];
+    list[i] = ((x << 5) | (x >> 27)) + 0x12345678;
+  }
+}
+
+high(Uint32List list, mask) {
+  // Values with bit 31 set do not fit in a smi on 32-bit platforms.
+  return (list[0] & mask) | 0x80000000;
+}
+
+main() {
+  var u = new Uint32List(64);
+  var s = new Int32List(64);
+  for (var i = 0; i < u.length; i++) {
+    u[i] = (i * 0x9E3779B9) & 0xFFFFFFFF;
+    s[i] = u[i];
+  }
+
+  var d = new Int32List(64);
+  for (var i = 0; i < 20; i++) {
+    Expect.equals(1685483269, fnv(u));
+    mix(s, d);
+    var sum = 0;
+    for (var j = 0; j < d.length; j++) sum += d[j];
+    Expect.equals(3287512064, sum);
+    Expect.equals(-2007833965, d[5]);
+  }
+
+  var r = new Uint32List(2);
+  for (var i = 0; i < 20; i++) {
+    r[0] = 0xF0000001;
+    r[1] = 1;
+    rotate(r);
+    Expect.equals(0x123456B6, r[0]);
+    Expect.equals(0x12345698, r[1]);
+  }
+
+  u[0] = 0x70000001;
+  for (var i = 0; i < 20; i++) {
+    Expect.equals(0xF0000001, high(u, 0xFFFFFFFF));
+  }
+  // Deoptimize on a non-integer mask.
+  Expect.throws(() => high(u, 1.5));
+}
@@ -0,0 +1,35 @@
+// Copyright (c) 2013, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+// VMOptions=--optimization-counter-threshold=10
+
+// Library tag to be able to run in html test framework.
+library float32x4_unboxed_field_test;
+
+import 'package:expect/expect.dart';
+import 'dart:typed_data';
+
+class Particle {
+  var position;
+  Particle(this.position);
+}
+
+step(p, v) {
+  p.position = p.position + v;
+}
+
+main() {
+  var p = new Particle(new Float32x4(0.0, 0.0, 0.0, 0.0));
+  var v = new Float32x4(1.0, 2.0, 3.0, 4.0);
+  var saved = [];
+  for (var i = 0; i < 20; i++) {
+    step(p, v);
+    saved.add(p.position);
+  }
+  for (var i = 0; i < 20; i++) {
+    Expect.equals(i + 1.0, saved[i].x);
+    Expect.equals(4.0 * (i + 1), saved[i].w);
+  }
+  Expect.equals(20.0, p.position.x);
+  Expect.equals(80.0, p.position.w);
+}